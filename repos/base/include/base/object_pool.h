@@ -20,6 +20,8 @@
 #include <util/noncopyable.h>
 #include <base/capability.h>
 #include <base/weak_ptr.h>
+#include <cpu/atomic.h>
+#include <cpu/memory_barrier.h>
 
 namespace Genode { template <typename> class Object_pool; }
 
@@ -31,6 +33,14 @@ namespace Genode { template <typename> class Object_pool; }
  *
  * The local names of a capabilities are used to differentiate multiple server
  * objects managed by one and the same object pool.
+ *
+ * Lookups via 'apply' do not take the pool lock. The tree is traversed
+ * optimistically and the result is validated against a sequence counter
+ * that is bumped by each modification. A lookup that interferes with a
+ * concurrent modification falls back to the lock. Entries removed from the
+ * pool may still be visited by lookups in flight. Therefore, 'remove' and
+ * 'remove_all' do not return before all lookups that started prior to the
+ * removal have left the tree.
  */
 template <typename OBJ_TYPE>
 class Genode::Object_pool
@@ -96,6 +106,156 @@ class Genode::Object_pool
 		Avl_tree<Entry> _tree;
 		Lock            _lock;
 
+		/*
+		 * Sequence counter of tree modifications, odd while the tree is
+		 * being modified
+		 */
+		int volatile _seq = 0;
+
+		/*
+		 * Lookups register themselves at one of two reader counters, selected
+		 * by the lowest bit of '_epoch'. A writer waiting for the readers of
+		 * the past epoch to drain sets '_grace_waiter' to the index of the
+		 * counter plus one and blocks on '_grace'.
+		 */
+		int volatile _epoch        = 0;
+		int volatile _readers[2]   = { 0, 0 };
+		int volatile _grace_waiter = 0;
+		Lock         _grace { Lock::LOCKED };
+
+		/*
+		 * Upper bound of the traversal steps of a lock-free lookup
+		 *
+		 * A consistent AVL tree of this depth would have to contain more
+		 * entries than addressable. Hence, exceeding the bound can only
+		 * happen while the tree is concurrently rebalanced.
+		 */
+		enum { MAX_LOOKUP_DEPTH = 64, MAX_LOOKUP_ATTEMPTS = 2 };
+
+		static int _atomic_add(int volatile &value, int diff)
+		{
+			for (;;) {
+				int const old_value = value;
+				if (cmpxchg(&value, old_value, old_value + diff))
+					return old_value + diff;
+			}
+		}
+
+		/**
+		 * Registration of a lock-free lookup
+		 */
+		class Read_guard
+		{
+			private:
+
+				Object_pool &_pool;
+				int          _idx = 0;
+
+			public:
+
+				Read_guard(Object_pool &pool) : _pool(pool)
+				{
+					for (;;) {
+						_idx = _pool._epoch & 1;
+						_atomic_add(_pool._readers[_idx], 1);
+						memory_barrier();
+
+						/* epoch got flipped meanwhile, register at new one */
+						if ((_pool._epoch & 1) == _idx)
+							return;
+
+						_leave();
+					}
+				}
+
+				~Read_guard() { _leave(); }
+
+			private:
+
+				void _leave()
+				{
+					memory_barrier();
+					if (_atomic_add(_pool._readers[_idx], -1))
+						return;
+
+					/* wake up writer waiting for the readers to drain */
+					if (cmpxchg(&_pool._grace_waiter, _idx + 1, 0))
+						_pool._grace.unlock();
+				}
+		};
+
+		/**
+		 * Begin modification of the tree, called with '_lock' held
+		 */
+		void _modify_begin()
+		{
+			_seq = _seq + 1;
+			memory_barrier();
+		}
+
+		/**
+		 * End modification of the tree, called with '_lock' held
+		 */
+		void _modify_end()
+		{
+			memory_barrier();
+			_seq = _seq + 1;
+		}
+
+		/**
+		 * Wait until all lookups that may still refer to removed entries
+		 * are completed, called with '_lock' held
+		 */
+		void _synchronize()
+		{
+			int const idx = _epoch & 1;
+
+			/*
+			 * The epoch must be flipped before the reader counter is
+			 * inspected. 'memory_barrier' does not order a store before a
+			 * subsequent load on x86. Hence, the stores are performed via
+			 * 'cmpxchg', which represents a full barrier.
+			 */
+			_atomic_add(_epoch, 1);
+
+			if (_readers[idx] == 0)
+				return;
+
+			cmpxchg(&_grace_waiter, 0, idx + 1);
+
+			/* the last reader may have left before '_grace_waiter' was set */
+			if (_readers[idx] == 0 && cmpxchg(&_grace_waiter, idx + 1, 0))
+				return;
+
+			_grace.lock();
+		}
+
+		/**
+		 * Look up entry by object ID
+		 *
+		 * \param complete  set to false if the traversal was cut short
+		 */
+		Entry *_lookup(unsigned long obj_id, bool &complete)
+		{
+			complete = true;
+
+			Entry *e = _tree.first();
+			for (unsigned depth = 0; e; depth++) {
+
+				if (depth == MAX_LOOKUP_DEPTH) {
+					complete = false;
+					return nullptr;
+				}
+
+				unsigned long const id = e->_obj_id();
+				if (id == obj_id)
+					return e;
+
+				e = e->child(obj_id > id);
+			}
+			return nullptr;
+		}
+
 	protected:
 
 		bool empty()
@@ -109,13 +269,21 @@ class Genode::Object_pool
 		void insert(OBJ_TYPE *obj)
 		{
 			Lock::Guard lock_guard(_lock);
+
+			_modify_begin();
 			_tree.insert(obj);
+			_modify_end();
 		}
 
 		void remove(OBJ_TYPE *obj)
 		{
 			Lock::Guard lock_guard(_lock);
+
+			_modify_begin();
 			_tree.remove(obj);
+			_modify_end();
+
+			_synchronize();
 		}
 
 		template <typename FUNC>
@@ -128,12 +296,41 @@ class Genode::Object_pool
 			using Locked_ptr     = Locked_ptr<typename Entry::Entry_lock>;
 
 			Weak_ptr ptr;
+			bool     found = false;
 
 			{
+				Read_guard read_guard(*this);
+
+				for (unsigned i = 0; !found && i < MAX_LOOKUP_ATTEMPTS; i++) {
+
+					int const seq = _seq;
+					memory_barrier();
+
+					/* tree is being modified */
+					if (seq & 1)
+						continue;
+
+					bool complete = false;
+					Entry * entry = _lookup(capid, complete);
+
+					memory_barrier();
+					if (!complete || _seq != seq)
+						continue;
+
+					/*
+					 * The entry cannot be destructed before we leave the read
+					 * guard because its removal waits for us.
+					 */
+					if (entry) ptr = entry->_lock.weak_ptr();
+					found = true;
+				}
+			}
+
+			if (!found) {
 				Lock::Guard lock_guard(_lock);
 
-				Entry * entry = _tree.first() ?
-					_tree.first()->find_by_obj_id(capid) : nullptr;
+				bool complete = false;
+				Entry * entry = _lookup(capid, complete);
 
 				if (entry) ptr = entry->_lock.weak_ptr();
 			}
@@ -172,8 +369,12 @@ class Genode::Object_pool
 						Locked_ptr lock_ptr(ptr);
 						if (!lock_ptr.valid()) return;
 
+						_modify_begin();
 						_tree.remove(obj);
+						_modify_end();
 					}
+
+					_synchronize();
 				}
 
 				func(obj);
@@ -0,0 +1,128 @@
+/*
+ * \brief  Pool of RPC entrypoints for serving sessions on multiple CPUs
+ * \author agent
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__RPC_ENTRYPOINT_POOL_H_
+#define _INCLUDE__BASE__RPC_ENTRYPOINT_POOL_H_
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/lock.h>
+#include <base/rpc_server.h>
+#include <util/reconstructible.h>
+#include <util/string.h>
+
+namespace Genode { class Rpc_entrypoint_pool; }
+
+
+/**
+ * Pool of worker entrypoints
+ *
+ * Each worker is an 'Rpc_entrypoint' with its own thread, placed on a
+ * distinct CPU of the component's affinity space where possible. RPC
+ * objects - usually sessions - are assigned to one worker when getting
+ * managed and are served by this worker only. Hence, RPCs targeting
+ * different objects may be executed in parallel whereas the RPCs of one
+ * object are still serialized.
+ *
+ * This results in the following locking contract for servers using the
+ * pool:
+ *
+ * - The state of an RPC object that is accessed only by its RPC functions
+ *   needs no locking.
+ *
+ * - State shared by RPC objects managed by different workers, e.g., a file
+ *   system shared by all sessions of a file-system server, must be
+ *   synchronized by the server, for example via 'Synced_interface'.
+ *
+ * - The allocators passed to the session objects must be thread-safe,
+ *   which is the case for 'Heap' and 'Sliced_heap'.
+ *
+ * - Signals are not handled by the workers but by the component's
+ *   'Entrypoint'. Signal handlers accessing session state must synchronize
+ *   with the worker serving the session.
+ */
+class Genode::Rpc_entrypoint_pool : Noncopyable
+{
+	public:
+
+		enum { MAX_WORKERS = 16 };
+
+	private:
+
+		Constructible<Rpc_entrypoint> _workers[MAX_WORKERS];
+
+		unsigned const _num_workers;
+
+		Lock     _lock;
+		unsigned _next = 0;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param num_workers  number of worker threads, clamped to
+		 *                     'MAX_WORKERS'
+		 * \param stack_size   stack size of each worker thread
+		 * \param name         name prefix of the worker threads
+		 */
+		Rpc_entrypoint_pool(Env &env, unsigned num_workers,
+		                    size_t stack_size, char const *name)
+		:
+			_num_workers(max(1U, min(num_workers, (unsigned)MAX_WORKERS)))
+		{
+			Affinity::Space space = env.cpu().affinity_space();
+
+			for (unsigned i = 0; i < _num_workers; i++) {
+				String<Thread::Name::capacity()> const worker_name(name, "_", i);
+				_workers[i].construct(&env.pd(), stack_size,
+				                      worker_name.string(), true,
+				                      space.location_of_index(i));
+			}
+		}
+
+		unsigned num_workers() const { return _num_workers; }
+
+		/**
+		 * Return worker by index, wrapped to the number of workers
+		 */
+		Rpc_entrypoint &worker(unsigned i) { return *_workers[i % _num_workers]; }
+
+		/**
+		 * Select worker for serving a new session
+		 *
+		 * If the session affinity refers to a single worker, this worker is
+		 * returned. Otherwise, the workers are assigned in a round-robin
+		 * fashion.
+		 */
+		Rpc_entrypoint &select(Affinity const &affinity)
+		{
+			Affinity::Location const location =
+				affinity.scale_to(Affinity::Space(_num_workers));
+
+			if (location.valid() && location.width() == 1)
+				return worker(location.xpos());
+
+			Lock::Guard guard(_lock);
+			return worker(_next++);
+		}
+
+		template <typename FN>
+		void for_each(FN const &fn)
+		{
+			for (unsigned i = 0; i < _num_workers; i++)
+				fn(*_workers[i]);
+		}
+};
+
+#endif /* _INCLUDE__BASE__RPC_ENTRYPOINT_POOL_H_ */
@@ -21,6 +21,7 @@
 #include <base/allocator.h>
 #include <base/rpc_server.h>
 #include <base/entrypoint.h>
+#include <base/rpc_entrypoint_pool.h>
 #include <base/service.h>
 #include <util/arg_string.h>
 #include <base/log.h>
@@ -107,6 +108,12 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 		 */
 		Rpc_entrypoint *_ep;
 
+		/*
+		 * Pool of entrypoints the sessions are distributed to, if the root
+		 * was constructed with a pool
+		 */
+		Rpc_entrypoint_pool *_ep_pool = nullptr;
+
 		/*
 		 * Allocator for allocating session objects.
 		 * This allocator must be used by the derived
@@ -115,6 +122,31 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 		 */
 		Allocator *_md_alloc;
 
+		/**
+		 * Call 'fn' with the session and the entrypoint that manages it
+		 */
+		template <typename FN>
+		void _apply(Session_capability session_cap, FN const &fn)
+		{
+			if (!_ep_pool) {
+				_ep->apply(session_cap, [&] (SESSION_TYPE *s) { fn(s, *_ep); });
+				return;
+			}
+
+			bool found = false;
+			_ep_pool->for_each([&] (Rpc_entrypoint &ep) {
+				if (found) return;
+				ep.apply(session_cap, [&] (SESSION_TYPE *s) {
+					if (!s) return;
+					found = true;
+					fn(s, ep);
+				});
+			});
+
+			if (!found)
+				fn(nullptr, *_ep);
+		}
+
 		/*
 		 * Used by both the legacy 'Root::session' and the new 'Factory::create'
 		 */
@@ -179,6 +211,13 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 			Arg_string::set_arg(adjusted_args, sizeof(adjusted_args),
 			                    "cap_quota", String<64>(remaining_cap_quota).string());
 
+			/*
+			 * Select the entrypoint for the new session beforehand such that
+			 * a session constructor calling 'ep()->manage' uses it.
+			 */
+			if (_ep_pool)
+				_ep = &_ep_pool->select(affinity);
+
 			SESSION_TYPE *s = 0;
 			try { s = _create_session(adjusted_args, affinity); }
 			catch (Out_of_ram)             { throw Insufficient_ram_quota(); }
@@ -267,6 +306,10 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 
 		/**
 		 * Return entrypoint that serves the root component
+		 *
+		 * If the root distributes its sessions over an entrypoint pool, the
+		 * returned entrypoint is the one selected for the most recently
+		 * created session.
 		 */
 		Rpc_entrypoint *ep() { return _ep; }
 
@@ -285,6 +328,23 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 			_ep(&ep.rpc_ep()), _md_alloc(&md_alloc)
 		{ }
 
+		/**
+		 * Constructor
+		 *
+		 * \param ep_pool   pool of entrypoints to distribute the sessions
+		 *                  of this root interface to
+		 * \param md_alloc  meta-data allocator providing the backing store
+		 *                  for session objects, must be thread-safe
+		 *
+		 * The RPC functions of each session are executed by the entrypoint
+		 * of the pool that was selected at session-creation time. See
+		 * 'Rpc_entrypoint_pool' for the resulting locking contract.
+		 */
+		Root_component(Rpc_entrypoint_pool &ep_pool, Allocator &md_alloc)
+		:
+			_ep(&ep_pool.worker(0)), _ep_pool(&ep_pool), _md_alloc(&md_alloc)
+		{ }
+
 		/**
 		 * Constructor
 		 *
@@ -338,7 +398,7 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 		{
 			if (!args.valid_string()) throw Service_denied();
 
-			_ep->apply(session, [&] (SESSION_TYPE *s) {
+			_apply(session, [&] (SESSION_TYPE *s, Rpc_entrypoint &) {
 				if (!s) return;
 
 				_upgrade_session(s, args.string());
@@ -349,11 +409,11 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 		{
 			SESSION_TYPE * session;
 
-			_ep->apply(session_cap, [&] (SESSION_TYPE *s) {
+			_apply(session_cap, [&] (SESSION_TYPE *s, Rpc_entrypoint &ep) {
 				session = s;
 
 				/* let the entry point forget the session object */
-				if (session) _ep->dissolve(session);
+				if (session) ep.dissolve(session);
 			});
 
 			if (!session) return;
@@ -30,29 +30,110 @@ class Genode::Xml_generator
 		 */
 		class Buffer_exceeded { };
 
+		/**
+		 * Backing store of the generated output
+		 */
+		struct Buffer
+		{
+			char  *base;
+			size_t capacity;
+		};
+
+		/**
+		 * Interface for enlarging the backing store on demand
+		 *
+		 * An expander allows the generation of output of unknown size in
+		 * one pass, avoiding the repeated generation with increasingly
+		 * larger buffers.
+		 */
+		struct Expander
+		{
+			/**
+			 * Provide larger backing store
+			 *
+			 * \param old           current backing store
+			 * \param min_capacity  minimum capacity of the new backing store
+			 *
+			 * \return  new backing store, which must contain the content of
+			 *          the old one
+			 *
+			 * \throw   Buffer_exceeded
+			 */
+			virtual Buffer expand(Buffer const &old, size_t min_capacity) = 0;
+		};
+
 	private:
 
+		class Backing_store
+		{
+			private:
+
+				Buffer    _buffer;
+				Expander *_expander;
+
+			public:
+
+				Backing_store(Buffer const &buffer, Expander *expander)
+				: _buffer(buffer), _expander(expander) { }
+
+				char *base() const { return _buffer.base; }
+
+				/**
+				 * Make sure that the backing store spans 'end' bytes
+				 */
+				void ensure(size_t const end)
+				{
+					if (end <= _buffer.capacity)
+						return;
+
+					if (!_expander)
+						throw Buffer_exceeded();
+
+					_buffer = _expander->expand(_buffer, end);
+
+					if (end > _buffer.capacity)
+						throw Buffer_exceeded();
+				}
+		};
+
 		/**
 		 * Buffer descriptor where the XML output goes to
 		 *
+		 * The descriptor refers to its part of the backing store by offset
+		 * because the backing store may be relocated when expanded.
+		 *
 		 * All 'append' methods may throw a 'Buffer_exceeded' exception.
 		 */
 		class Out_buffer
 		{
 			private:
 
-				char  *_dst;
-				size_t _capacity;
-				size_t _used = 0;
+				/*
+				 * Buffers that are not limited to a gap extend up to the
+				 * end of the backing store.
+				 */
+				enum : size_t { UNLIMITED = ~(size_t)0 };
+
+				Backing_store *_backing;
+				size_t         _offset;
+				size_t         _limit;
+				size_t         _used = 0;
 
-				void _check_advance(size_t const len) const {
-					if (_used + len > _capacity)
-						throw Buffer_exceeded(); }
+				char *_dst() const { return _backing->base() + _offset; }
+
+				void _check_advance(size_t const len) const
+				{
+					if (_limit != UNLIMITED && _used + len > _limit)
+						throw Buffer_exceeded();
+
+					_backing->ensure(_offset + _used + len);
+				}
 
 			public:
 
-				Out_buffer(char *dst, size_t capacity)
-				: _dst(dst), _capacity(capacity) { }
+				Out_buffer(Backing_store &backing, size_t offset,
+				           size_t limit = UNLIMITED)
+				: _backing(&backing), _offset(offset), _limit(limit) { }
 
 				void advance(size_t const len)
 				{
@@ -66,21 +147,28 @@ class Genode::Xml_generator
 				void append(char const c)
 				{
 					_check_advance(1);
-					_dst[_used] = c;
-					advance(1);
+					_dst()[_used++] = c;
 				}
 
 				/**
 				 * Append character 'n' times
 				 */
-				void append(char const c, size_t n) {
-					for (; n--; append(c)); }
+				void append(char const c, size_t n)
+				{
+					_check_advance(n);
+					memset(_dst() + _used, c, n);
+					_used += n;
+				}
 
 				/**
 				 * Append character buffer
 				 */
-				void append(char const *src, size_t len) {
-					for (; len--; append(*src++)); }
+				void append(char const *src, size_t len)
+				{
+					_check_advance(len);
+					memcpy(_dst() + _used, src, len);
+					_used += len;
+				}
 
 				/**
 				 * Append null-terminated string
@@ -115,7 +203,9 @@ class Genode::Xml_generator
 				 * Return unused part of the buffer
 				 */
 				Out_buffer remainder() const {
-					return Out_buffer(_dst + _used, _capacity - _used); }
+					return Out_buffer(*_backing, _offset + _used,
+					                  _limit == UNLIMITED ? UNLIMITED
+					                                      : _limit - _used); }
 
 				/**
 				 * Insert gap into already populated part of the buffer
@@ -126,18 +216,18 @@ class Genode::Xml_generator
 				{
 					/* don't allow the insertion into non-populated part */
 					if (at > _used)
-						return Out_buffer(_dst + at, 0);
+						return Out_buffer(*_backing, _offset + at, 0);
 
 					_check_advance(len);
-					memmove(_dst + at + len, _dst + at, _used - at);
+					memmove(_dst() + at + len, _dst() + at, _used - at);
 					advance(len);
 
-					return Out_buffer(_dst + at, len);
+					return Out_buffer(*_backing, _offset + at, len);
 				}
 
 				bool has_trailing_newline() const
 				{
-					return (_used > 1) && (_dst[_used - 1] == '\n');
+					return (_used > 1) && (_dst()[_used - 1] == '\n');
 				}
 
 				/**
@@ -147,7 +237,7 @@ class Genode::Xml_generator
 
 				void discard_trailing_whitespace()
 				{
-					for (; _used > 0 && is_whitespace(_dst[_used - 1]); _used--);
+					for (; _used > 0 && is_whitespace(_dst()[_used - 1]); _used--);
 				}
 		};
 
@@ -281,9 +371,10 @@ class Genode::Xml_generator
 				}
 		};
 
-		Out_buffer _out_buffer;
-		Node      *_curr_node   = 0;
-		unsigned   _curr_indent = 0;
+		Backing_store _backing;
+		Out_buffer    _out_buffer { _backing, 0 };
+		Node         *_curr_node   = 0;
+		unsigned      _curr_indent = 0;
 
 	public:
 
@@ -291,7 +382,7 @@ class Genode::Xml_generator
 		Xml_generator(char *dst, size_t dst_len,
 		              char const *name, FUNC const &func)
 		:
-			_out_buffer(dst, dst_len)
+			_backing(Buffer { dst, dst_len }, nullptr)
 		{
 			if (dst) {
 				node(name, func);
@@ -299,6 +390,23 @@ class Genode::Xml_generator
 			}
 		}
 
+		/**
+		 * Constructor for generating output into an expanding buffer
+		 *
+		 * \param buffer    initial backing store, may be empty
+		 * \param expander  provider of a larger backing store whenever
+		 *                  the output exceeds the current one
+		 */
+		template <typename FUNC>
+		Xml_generator(Buffer const &buffer, Expander &expander,
+		              char const *name, FUNC const &func)
+		:
+			_backing(buffer, &expander)
+		{
+			node(name, func);
+			_out_buffer.append('\n');
+		}
+
 		template <typename FUNC>
 		void node(char const *name, FUNC const &func = [] () { } )
 		{
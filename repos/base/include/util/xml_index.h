@@ -0,0 +1,370 @@
+/*
+ * \brief  Structural index of an XML document
+ * \author agent
+ * \date   2026-10-19
+ *
+ * Without an index, 'Xml_node' re-tokenizes the document on each access.
+ * Constructing a node scans the node up to its end tag, and looking up a sub
+ * node walks all preceding siblings. Code that processes large documents in
+ * a nested fashion thereby becomes quadratic in the document size.
+ *
+ * The index records the position of each node, the links to its parent,
+ * first child, and next sibling, and the names of its attributes. It is
+ * built in one pass over the document. An 'Xml_node' constructed from an
+ * index uses it transparently for all accessors.
+ *
+ * The indexer follows the syntax accepted by 'Xml_node'. If the document
+ * contains anything that would make the regular 'Xml_node' deviate from a
+ * well-formed tree, e.g., mismatching end tags, the index is marked as
+ * invalid and nodes created from it fall back to the regular scanning.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__UTIL__XML_INDEX_H_
+#define _INCLUDE__UTIL__XML_INDEX_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <util/noncopyable.h>
+#include <util/xml_node.h>
+
+namespace Genode { class Xml_index; }
+
+
+class Genode::Xml_index : public Xml_structure, Noncopyable
+{
+	private:
+
+		Allocator &_alloc;
+
+		unsigned _nodes_cap = 0;
+		unsigned _attrs_cap = 0;
+
+		/**
+		 * Exception used to abort the indexing of an unsupported document
+		 */
+		struct Unsupported { };
+
+		template <typename T>
+		void _grow(T *&array, unsigned &capacity, unsigned count)
+		{
+			if (count < capacity)
+				return;
+
+			unsigned const new_capacity = max(capacity*2, 64U);
+
+			T *new_array = nullptr;
+			if (!_alloc.alloc(new_capacity*sizeof(T), &new_array))
+				throw Unsupported();
+
+			if (array) {
+				memcpy(new_array, array, count*sizeof(T));
+				_alloc.free(array, capacity*sizeof(T));
+			}
+			array    = new_array;
+			capacity = new_capacity;
+		}
+
+		char _at(size_t pos) const { return pos < _len ? _base[pos] : 0; }
+
+		/*
+		 * Character classes as used by the tokenizer of 'Xml_node'
+		 */
+		static bool _ident_char(char c, unsigned i) {
+			return is_letter(c) || c == '_' || c == ':'
+			    || (i && (c == '-' || c == '.' || is_digit(c))); }
+
+		size_t _skip_whitespace(size_t pos) const
+		{
+			while (is_whitespace(_at(pos))) pos++;
+			return pos;
+		}
+
+		size_t _skip_ident(size_t pos) const
+		{
+			unsigned i = 0;
+			while (_ident_char(_at(pos), i)) pos++, i++;
+			return pos;
+		}
+
+		/**
+		 * Return position after the quoted string starting at 'pos'
+		 *
+		 * An unterminated string ends the token stream of 'Xml_node'.
+		 */
+		size_t _skip_quoted_string(size_t pos) const
+		{
+			for (size_t i = pos + 1; i < _len && _base[i]; i++)
+				if (_base[i] == '"' && _base[i - 1] != '\\')
+					return i + 1;
+
+			throw Unsupported();
+		}
+
+		/**
+		 * Return position of the next character that is relevant for the
+		 * structure of the content, which is a '<', a quote, or the end
+		 *
+		 * The search examines 16 characters at a time using the generic
+		 * vector extension of the compiler.
+		 */
+		size_t _find_markup(size_t pos) const
+		{
+			typedef signed char Vec16 __attribute__((vector_size(16)));
+
+			Vec16 const lt    = { '<','<','<','<','<','<','<','<',
+			                      '<','<','<','<','<','<','<','<' };
+			Vec16 const quote = { '"','"','"','"','"','"','"','"',
+			                      '"','"','"','"','"','"','"','"' };
+			Vec16 const zero  = { };
+
+			for (; pos + sizeof(Vec16) <= _len; pos += sizeof(Vec16)) {
+
+				Vec16 v;
+				__builtin_memcpy(&v, _base + pos, sizeof(v));
+
+				Vec16 const match = (v == lt) | (v == quote) | (v == zero);
+
+				uint64_t m[2];
+				__builtin_memcpy(m, &match, sizeof(m));
+				if (m[0] | m[1])
+					break;
+			}
+
+			for (; pos < _len; pos++) {
+				char const c = _base[pos];
+				if (c == '<' || c == '"' || c == 0)
+					break;
+			}
+			return pos;
+		}
+
+		bool _matches(size_t pos, char const *s) const
+		{
+			size_t const n = strlen(s);
+			return pos + n <= _len && !strcmp(_base + pos, s, n);
+		}
+
+		/**
+		 * Return position after the comment starting at 'pos', or 0
+		 */
+		size_t _comment_end(size_t pos) const
+		{
+			if (!_matches(pos, "<!--") || pos + 4 >= _len || !_base[pos + 4])
+				return 0;
+
+			for (size_t i = pos + 4; i + 3 <= _len; i++)
+				if (!strcmp(_base + i, "-->", 3))
+					return i + 3;
+
+			return 0;
+		}
+
+		enum Tag_type { START, END, EMPTY, INVALID };
+
+		struct Tag
+		{
+			Tag_type type     = INVALID;
+			size_t   name     = 0;
+			unsigned name_len = 0;
+			size_t   end      = 0;   /* position after '>' */
+		};
+
+		/**
+		 * Parse tag at 'pos' and record its attributes
+		 *
+		 * A tag that does not qualify as tag is treated as content. A
+		 * malformed attribute, however, is an error.
+		 */
+		Tag _parse_tag(size_t pos)
+		{
+			Tag tag;
+
+			size_t p = pos + 1;
+			Tag_type type = START;
+			if (_at(p) == '/') {
+				type = END;
+				p++;
+			}
+
+			if (!_ident_char(_at(p), 0))
+				return tag;
+
+			tag.name     = p;
+			p            = _skip_ident(p);
+			tag.name_len = p - tag.name;
+
+			unsigned const first_attr = _num_attrs;
+
+			if (type != END) {
+				for (;;) {
+					size_t const a = _skip_whitespace(p);
+					if (!_ident_char(_at(a), 0))
+						break;
+
+					size_t const name_end = _skip_ident(a);
+					if (_at(name_end) != '=' || _at(name_end + 1) != '"')
+						throw Unsupported();
+
+					_grow(_attrs, _attrs_cap, _num_attrs);
+					_attrs[_num_attrs++] = Attr { a, (unsigned)(name_end - a) };
+
+					p = _skip_quoted_string(name_end + 1);
+				}
+			}
+
+			p = _skip_whitespace(p);
+
+			if (_at(p) == '/') {
+				if (type == END)
+					type = INVALID;
+				else
+					type = EMPTY;
+				p++;
+			}
+
+			if (_at(p) != '>' || type == INVALID) {
+				_num_attrs = first_attr;
+				return tag;
+			}
+
+			tag.type = type;
+			tag.end  = p + 1;
+			return tag;
+		}
+
+		unsigned _add_node(size_t addr, size_t start, Tag const &tag,
+		                   unsigned parent, unsigned first_attr)
+		{
+			_grow(_nodes, _nodes_cap, _num_nodes);
+
+			unsigned const id = _num_nodes++;
+
+			_nodes[id] = Node { addr, start, tag.end, start, tag.name,
+			                    tag.name_len, parent, NONE, NONE, NONE, 0,
+			                    first_attr, _num_attrs - first_attr };
+			return id;
+		}
+
+		void _build()
+		{
+			unsigned open     = NONE;   /* innermost node without end tag */
+			unsigned last_top = NONE;   /* last node at the top level */
+
+			for (size_t pos = 0; ; ) {
+
+				pos = _find_markup(pos);
+
+				if (pos >= _len || _base[pos] == 0)
+					break;
+
+				if (_base[pos] == '"') {
+					pos = _skip_quoted_string(pos);
+					continue;
+				}
+
+				if (size_t const end = _comment_end(pos)) {
+					pos = end;
+					continue;
+				}
+
+				unsigned const first_attr = _num_attrs;
+				Tag const tag = _parse_tag(pos);
+
+				if (tag.type == INVALID) {
+					pos++;
+					continue;
+				}
+
+				if (tag.type == END) {
+					if (open == NONE)
+						throw Unsupported();
+
+					Node &node = _nodes[open];
+					if (node.name_len != tag.name_len
+					 || strcmp(_base + node.name, _base + tag.name, tag.name_len))
+						throw Unsupported();
+
+					node.end_tag = pos;
+					open = node.parent;
+					pos  = tag.end;
+					continue;
+				}
+
+				unsigned const last = (open == NONE) ? last_top
+				                                     : _nodes[open].last_child;
+
+				/*
+				 * 'Xml_node' lets the first node of a sequence begin right
+				 * after the preceding start tag, or at the begin of the
+				 * document respectively.
+				 */
+				size_t const addr = (last != NONE) ? pos
+				                  : (open != NONE) ? _nodes[open].content : 0;
+
+				/*
+				 * '_add_node' may reallocate '_nodes', so node references
+				 * must not be held across the call.
+				 */
+				unsigned const id = _add_node(addr, pos, tag, open, first_attr);
+
+				/* link node with its predecessor */
+				if (last != NONE)
+					_nodes[last].next = id;
+				else if (open != NONE)
+					_nodes[open].first_child = id;
+
+				if (open != NONE) {
+					_nodes[open].last_child = id;
+					_nodes[open].num_sub_nodes++;
+				} else {
+					last_top = id;
+				}
+
+				if (tag.type == START)
+					open = id;
+
+				pos = tag.end;
+			}
+
+			/* unterminated node */
+			if (open != NONE || _num_nodes == 0)
+				throw Unsupported();
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc  allocator for the index data
+		 * \param base   XML document
+		 * \param len    maximum length of the document
+		 */
+		Xml_index(Allocator &alloc, char const *base, size_t len)
+		:
+			Xml_structure(base, len), _alloc(alloc)
+		{
+			try {
+				_build();
+				_valid = true;
+			}
+			catch (Unsupported) { }
+			catch (Out_of_ram)  { }
+			catch (Out_of_caps) { }
+		}
+
+		~Xml_index()
+		{
+			if (_nodes) _alloc.free(_nodes, _nodes_cap*sizeof(Node));
+			if (_attrs) _alloc.free(_attrs, _attrs_cap*sizeof(Attr));
+		}
+};
+
+#endif /* _INCLUDE__UTIL__XML_INDEX_H_ */
@@ -18,11 +18,97 @@
 #include <base/exception.h>
 
 namespace Genode {
+	class Xml_structure;
 	class Xml_attribute;
 	class Xml_node;
 }
 
 
+/**
+ * Structural data of an XML document
+ *
+ * The data is produced by 'Xml_index', which is provided by
+ * 'util/xml_index.h'.
+ */
+class Genode::Xml_structure
+{
+	public:
+
+		enum { NONE = ~0U };
+
+		struct Node
+		{
+			size_t   addr;           /* begin of the node as seen by 'Xml_node' */
+			size_t   start;          /* '<' of the start tag */
+			size_t   content;        /* first character after the start tag */
+			size_t   end_tag;        /* '<' of the end tag, or 'start' if empty */
+			size_t   name;           /* first character of the node type */
+			unsigned name_len;
+			unsigned parent;
+			unsigned first_child;
+			unsigned last_child;
+			unsigned next;
+			unsigned num_sub_nodes;
+			unsigned first_attr;
+			unsigned num_attrs;
+		};
+
+		struct Attr
+		{
+			size_t   name;           /* first character of the attribute name */
+			unsigned name_len;
+		};
+
+	protected:
+
+		char const * const _base;
+		size_t       const _len;
+
+		Node    *_nodes     = nullptr;
+		unsigned _num_nodes = 0;
+
+		Attr    *_attrs     = nullptr;
+		unsigned _num_attrs = 0;
+
+		bool _valid = false;
+
+		Xml_structure(char const *base, size_t len) : _base(base), _len(len) { }
+
+	public:
+
+		/**
+		 * Return true if the data can be used for accessing the document
+		 */
+		bool valid() const { return _valid; }
+
+		char const *base() const { return _base; }
+		size_t      len()  const { return _len; }
+
+		unsigned num_nodes() const { return _num_nodes; }
+
+		Node const &node(unsigned id) const { return _nodes[id]; }
+		Attr const &attr(unsigned id) const { return _attrs[id]; }
+
+		/**
+		 * Return true if node 'id' has the specified type
+		 */
+		bool node_has_type(unsigned id, char const *type) const
+		{
+			Node const &n = _nodes[id];
+			return strlen(type) == n.name_len && !strcmp(type, _base + n.name, n.name_len);
+		}
+
+		/**
+		 * Return true if attribute 'id' has the specified name
+		 */
+		bool attr_has_name(unsigned id, char const *name) const
+		{
+			Attr const &a = _attrs[id];
+			return strlen(name) == a.name_len && !strcmp(name, _base + a.name, a.name_len);
+		}
+};
+
+
 /**
  * Representation of an XML-node attribute
  *
@@ -449,6 +535,50 @@ class Genode::Xml_node
 		Tag         _start_tag;
 		Tag         _end_tag;
 
+		/*
+		 * Structural index of the document, if available
+		 */
+		Xml_structure const *_index = nullptr;
+		unsigned         _id    = 0;
+
+		Xml_structure::Node const &_indexed() const { return _index->node(_id); }
+
+		/**
+		 * Constructor used for nodes of an indexed document
+		 */
+		Xml_node(Xml_structure const &index, unsigned id)
+		:
+			_addr(index.base() + index.node(id).addr),
+			_max_len(index.len() - index.node(id).addr),
+			_num_sub_nodes(index.node(id).num_sub_nodes),
+			_start_tag(Token(index.base() + index.node(id).start,
+			                 index.len()  - index.node(id).start)),
+			_end_tag(index.node(id).end_tag == index.node(id).start
+			         ? _start_tag
+			         : Tag(Token(index.base() + index.node(id).end_tag,
+			                     index.len() - index.node(id).end_tag))),
+			_index(&index), _id(id)
+		{ }
+
+		/**
+		 * Return indexed sub node that matches 'type', starting at node 'id'
+		 */
+		Xml_attribute _indexed_attribute(unsigned id) const
+		{
+			size_t const offset = _index->attr(id).name;
+			return Xml_attribute(Token(_index->base() + offset,
+			                           _index->len() - offset));
+		}
+
+		unsigned _indexed_sub_node(unsigned id, char const *type) const
+		{
+			for (; id != Xml_structure::NONE; id = _index->node(id).next)
+				if (!type || _index->node_has_type(id, type))
+					return id;
+
+			return Xml_structure::NONE;
+		}
+
 		/**
 		 * Search for end tag of XML node and initialize '_num_sub_nodes'
 		 *
@@ -589,6 +719,20 @@ class Genode::Xml_node
 			throw Invalid_syntax();
 		}
 
+		/**
+		 * Constructor for the top-level node of an indexed document
+		 *
+		 * If the index is invalid, the node is constructed from the
+		 * document without using the index.
+		 *
+		 * \throw Invalid_syntax
+		 */
+		explicit Xml_node(Xml_structure const &index)
+		:
+			Xml_node(index.valid() ? Xml_node(index, 0U)
+			                       : Xml_node(index.base(), index.len()))
+		{ }
+
 		/**
 		 * Request type name of XML node as null-terminated string
 		 */
@@ -720,6 +864,13 @@ class Genode::Xml_node
 		 */
 		Xml_node next() const
 		{
+			if (_index) {
+				if (_indexed().next == Xml_structure::NONE)
+					throw Nonexistent_sub_node();
+
+				return Xml_node(*_index, _indexed().next);
+			}
+
 			Token after_node = _end_tag.next_token();
 			after_node = skip_non_tag_characters(after_node);
 			try { return _sub_node(after_node.start()); }
@@ -765,6 +916,17 @@ class Genode::Xml_node
 		 */
 		Xml_node sub_node(unsigned idx = 0U) const
 		{
+			if (_index) {
+				unsigned id = _indexed().first_child;
+				for (; id != Xml_structure::NONE && idx > 0; idx--)
+					id = _index->node(id).next;
+
+				if (id == Xml_structure::NONE)
+					throw Nonexistent_sub_node();
+
+				return Xml_node(*_index, id);
+			}
+
 			if (_num_sub_nodes > 0) {
 
 				/* look up node at specified index */
@@ -786,6 +948,14 @@ class Genode::Xml_node
 		 */
 		Xml_node sub_node(const char *type) const
 		{
+			if (_index) {
+				unsigned const id = _indexed_sub_node(_indexed().first_child, type);
+				if (id == Xml_structure::NONE)
+					throw Nonexistent_sub_node();
+
+				return Xml_node(*_index, id);
+			}
+
 			if (_num_sub_nodes > 0) {
 
 				/* search for sub node of specified type */
@@ -806,6 +976,14 @@ class Genode::Xml_node
 		template <typename FN>
 		void for_each_sub_node(char const *type, FN const &fn) const
 		{
+			if (_index) {
+				for (unsigned id = _indexed_sub_node(_indexed().first_child, type);
+				     id != Xml_structure::NONE;
+				     id = _indexed_sub_node(_index->node(id).next, type))
+					fn(Xml_node(*_index, id));
+				return;
+			}
+
 			if (_num_sub_nodes == 0)
 				return;
 
@@ -839,6 +1017,14 @@ class Genode::Xml_node
 		 */
 		Xml_attribute attribute(unsigned idx) const
 		{
+			if (_index) {
+				Xml_structure::Node const &node = _indexed();
+				if (idx >= node.num_attrs)
+					throw Nonexistent_attribute();
+
+				return _indexed_attribute(node.first_attr + idx);
+			}
+
 			/* get first attribute of the node */
 			Xml_attribute a = _start_tag.attribute();
 
@@ -858,6 +1044,15 @@ class Genode::Xml_node
 		 */
 		Xml_attribute attribute(const char *type) const
 		{
+			if (_index) {
+				Xml_structure::Node const &node = _indexed();
+				for (unsigned i = 0; i < node.num_attrs; i++)
+					if (_index->attr_has_name(node.first_attr + i, type))
+						return _indexed_attribute(node.first_attr + i);
+
+				throw Nonexistent_attribute();
+			}
+
 			/* iterate, beginning with the first attribute of the node */
 			for (Xml_attribute a = _start_tag.attribute(); ; a = a.next())
 				if (a.has_type(type))
@@ -0,0 +1,179 @@
+/*
+ * \brief  Benchmark of concurrent object-pool lookups
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The benchmark populates an RPC entrypoint with a varying number of RPC
+ * objects and measures the cost of looking up the objects by their
+ * capability from one or multiple threads at the same time, which resembles
+ * the lookup performed for each RPC request.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/rpc_server.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+#include <util/construct_at.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Object_interface { GENODE_RPC_INTERFACE(); };
+	struct Object;
+	struct Lookup_thread;
+	struct Main;
+}
+
+
+struct Test::Object : Rpc_object<Object_interface> { };
+
+
+struct Test::Lookup_thread : Thread
+{
+	enum { STACK_SIZE = 8*1024*sizeof(long) };
+
+	Rpc_entrypoint      &_ep;
+	unsigned long const *_ids;
+	unsigned       const _num_ids;
+	unsigned       const _num_lookups;
+	unsigned             _seed;
+
+	unsigned long hits = 0;
+
+	Lookup_thread(Env &env, Rpc_entrypoint &ep, unsigned long const *ids,
+	              unsigned num_ids, unsigned num_lookups, unsigned index)
+	:
+		Thread(env, "lookup", STACK_SIZE,
+		       env.cpu().affinity_space().location_of_index(index),
+		       Weight(), env.cpu()),
+		_ep(ep), _ids(ids), _num_ids(num_ids), _num_lookups(num_lookups),
+		_seed(index + 1)
+	{ }
+
+	/**
+	 * Linear congruential generator, sufficient for spreading the lookups
+	 */
+	unsigned _random()
+	{
+		_seed = _seed*1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	void entry() override
+	{
+		for (unsigned i = 0; i < _num_lookups; i++) {
+			unsigned long const id = _ids[_random() % _num_ids];
+			_ep.apply(id, [&] (Rpc_object_base *obj) {
+				if (obj) hits++; });
+		}
+	}
+};
+
+
+struct Test::Main
+{
+	enum { MAX_THREADS = 16 };
+
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _max_objects =
+		_config.xml().attribute_value("max_objects", 100000U);
+
+	unsigned const _num_threads =
+		min((unsigned)MAX_THREADS,
+		    _config.xml().attribute_value("threads", 4U));
+
+	unsigned const _num_lookups =
+		_config.xml().attribute_value("lookups", 200000U);
+
+	Rpc_entrypoint _ep { &_env.pd(), 2*1024*sizeof(long), "bench_ep" };
+
+	void _measure(unsigned long const *ids, unsigned num_objects,
+	              unsigned num_threads)
+	{
+		Constructible<Lookup_thread> threads[MAX_THREADS];
+
+		for (unsigned i = 0; i < num_threads; i++)
+			threads[i].construct(_env, _ep, ids, num_objects, _num_lookups, i);
+
+		unsigned long const start_us = _timer.elapsed_us();
+
+		for (unsigned i = 0; i < num_threads; i++) threads[i]->start();
+		for (unsigned i = 0; i < num_threads; i++) threads[i]->join();
+
+		unsigned long const duration_us = max(_timer.elapsed_us() - start_us, 1UL);
+
+		unsigned long long const lookups = (unsigned long long)_num_lookups*num_threads;
+
+		unsigned long hits = 0;
+		for (unsigned i = 0; i < num_threads; i++)
+			hits += threads[i]->hits;
+
+		if (hits != lookups)
+			error("only ", hits, " of ", lookups, " lookups succeeded");
+
+		log("objects=", num_objects, " threads=", num_threads, " "
+		    "lookups=", lookups, " time=", duration_us/1000, " ms "
+		    "ns/lookup=", (duration_us*1000ULL*num_threads)/lookups, " "
+		    "lookups/ms=", (lookups*1000)/duration_us);
+	}
+
+	void _run(unsigned num_objects)
+	{
+		size_t const objects_size = sizeof(Object)*num_objects;
+		size_t const ids_size     = sizeof(unsigned long)*num_objects;
+
+		Allocator &alloc = _heap;
+
+		Object        *objects = (Object *)alloc.alloc(objects_size);
+		unsigned long *ids     = (unsigned long *)alloc.alloc(ids_size);
+
+		for (unsigned i = 0; i < num_objects; i++) {
+			construct_at<Object>(&objects[i]);
+			ids[i] = _ep.manage(&objects[i]).local_name();
+		}
+
+		_measure(ids, num_objects, 1);
+
+		if (_num_threads > 1)
+			_measure(ids, num_objects, _num_threads);
+
+		for (unsigned i = 0; i < num_objects; i++) {
+			_ep.dissolve(&objects[i]);
+			objects[i].~Object();
+		}
+
+		_heap.free(ids, ids_size);
+		_heap.free(objects, objects_size);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- object-pool benchmark ---");
+
+		for (unsigned n = 10; n <= _max_objects; n *= 10)
+			_run(n);
+
+		log("--- object-pool benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
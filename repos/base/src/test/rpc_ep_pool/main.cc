@@ -0,0 +1,163 @@
+/*
+ * \brief  Scaling benchmark of an RPC entrypoint pool
+ * \author agent
+ * \date   2026-10-19
+ *
+ * Several client threads issue RPCs to distinct server objects in parallel.
+ * The server objects are distributed over a pool of 1 to 8 worker
+ * entrypoints. Each RPC performs a configurable amount of work at the
+ * server side.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/log.h>
+#include <base/rpc_client.h>
+#include <base/rpc_entrypoint_pool.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Work;
+	struct Work_client;
+	struct Work_component;
+	struct Client_thread;
+	struct Main;
+}
+
+
+struct Test::Work
+{
+	virtual unsigned long work(unsigned iterations) = 0;
+
+	GENODE_RPC(Rpc_work, unsigned long, work, unsigned);
+	GENODE_RPC_INTERFACE(Rpc_work);
+};
+
+
+struct Test::Work_client : Rpc_client<Work>
+{
+	Work_client(Capability<Work> cap) : Rpc_client<Work>(cap) { }
+
+	unsigned long work(unsigned iterations) override {
+		return call<Rpc_work>(iterations); }
+};
+
+
+struct Test::Work_component : Rpc_object<Work>
+{
+	unsigned long work(unsigned iterations) override
+	{
+		unsigned long volatile sum = 0;
+		for (unsigned i = 0; i < iterations; i++)
+			sum = sum + i;
+
+		return sum;
+	}
+};
+
+
+struct Test::Client_thread : Thread
+{
+	enum { STACK_SIZE = 4*1024*sizeof(long) };
+
+	Work_client    _work;
+	unsigned const _num_calls;
+	unsigned const _iterations;
+
+	Client_thread(Env &env, Capability<Work> cap, unsigned num_calls,
+	              unsigned iterations, unsigned index)
+	:
+		Thread(env, "client", STACK_SIZE,
+		       env.cpu().affinity_space().location_of_index(index),
+		       Weight(), env.cpu()),
+		_work(cap), _num_calls(num_calls), _iterations(iterations)
+	{ }
+
+	void entry() override
+	{
+		for (unsigned i = 0; i < _num_calls; i++)
+			_work.work(_iterations);
+	}
+};
+
+
+struct Test::Main
+{
+	enum { MAX_CLIENTS = 16, STACK_SIZE = 2*1024*sizeof(long) };
+
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _num_clients =
+		min((unsigned)MAX_CLIENTS,
+		    _config.xml().attribute_value("clients", 8U));
+
+	unsigned const _max_workers =
+		_config.xml().attribute_value("max_workers", 8U);
+
+	unsigned const _num_calls =
+		_config.xml().attribute_value("calls", 10000U);
+
+	unsigned const _iterations =
+		_config.xml().attribute_value("work", 1000U);
+
+	void _measure(unsigned num_workers)
+	{
+		Rpc_entrypoint_pool pool(_env, num_workers, STACK_SIZE, "worker");
+
+		Work_component objects[MAX_CLIENTS];
+		Rpc_entrypoint *eps[MAX_CLIENTS];
+		Constructible<Client_thread> clients[MAX_CLIENTS];
+
+		for (unsigned i = 0; i < _num_clients; i++) {
+			eps[i] = &pool.select(Affinity());
+			clients[i].construct(_env, eps[i]->manage(&objects[i]),
+			                     _num_calls, _iterations, i);
+		}
+
+		unsigned long const start_us = _timer.elapsed_us();
+
+		for (unsigned i = 0; i < _num_clients; i++) clients[i]->start();
+		for (unsigned i = 0; i < _num_clients; i++) clients[i]->join();
+
+		unsigned long const duration_us = max(_timer.elapsed_us() - start_us, 1UL);
+
+		unsigned long long const calls = (unsigned long long)_num_calls*_num_clients;
+
+		log("workers=", pool.num_workers(), " clients=", _num_clients, " "
+		    "calls=", calls, " time=", duration_us/1000, " ms "
+		    "calls/s=", (calls*1000*1000)/duration_us);
+
+		for (unsigned i = 0; i < _num_clients; i++) {
+			clients[i].destruct();
+			eps[i]->dissolve(&objects[i]);
+		}
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- RPC entrypoint pool benchmark ---");
+
+		for (unsigned workers = 1; workers <= _max_workers; workers *= 2)
+			_measure(workers);
+
+		log("--- RPC entrypoint pool benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
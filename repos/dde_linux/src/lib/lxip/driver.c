@@ -35,15 +35,32 @@ int driver_net_xmit(struct sk_buff *skb, struct net_device *dev)
 {
 	struct net_device_stats *stats = (struct net_device_stats*) netdev_priv(dev);
 	int len                        = skb->len;
-	void* addr                     = skb->data;
+	struct net_offload offload     = { 0 };
+	void *addr;
+
+	if (skb->ip_summed == CHECKSUM_PARTIAL) {
+		offload.csum_partial = 1;
+		offload.csum_start   = skb_checksum_start_offset(skb);
+		offload.csum_offset  = skb->csum_offset;
+	}
+
+	if (skb_is_gso(skb))
+		offload.gso_size = skb_shinfo(skb)->gso_size;
 
 	/* transmit to nic-session */
-	if (net_tx(addr, len)) {
+	addr = net_tx_alloc(len, &offload);
+	if (!addr) {
 		/* tx queue is  full, could not enqueue packet */
 		pr_debug("TX packet dropped\n");
 		return NETDEV_TX_BUSY;
 	}
 
+	/* the skb may consist of several fragments if offloading is enabled */
+	if (skb_copy_bits(skb, 0, addr, len))
+		pr_debug("TX packet truncated\n");
+
+	net_tx_submit();
+
 	dev_kfree_skb(skb);
 
 	/* save timestamp */
@@ -75,6 +92,15 @@ static int driver_init(void)
 
 	dev->netdev_ops = &driver_net_ops;
 
+	/*
+	 * Let the NIC session complete checksums and segment large TCP packets,
+	 * which requires scatter-gather support for the large packets.
+	 */
+	if (net_offload_supported()) {
+		dev->hw_features = NETIF_F_SG | NETIF_F_IP_CSUM | NETIF_F_TSO;
+		dev->features   |= dev->hw_features;
+	}
+
 	/* set MAC */
 	net_mac(dev->dev_addr, ETH_ALEN);
 
@@ -95,38 +121,95 @@ out:
 module_init(driver_init);
 
 
+/**
+ * Called by 'put_page' when the last reference to a packet buffer is dropped
+ */
+void foreign_page_release(struct page *page)
+{
+	net_rx_release((void *)page->private);
+	kfree(page);
+}
+
+
 /**
  * Called by Nic_client when a packet was received
  */
-void net_driver_rx(void *addr, unsigned long size)
+int net_driver_rx(void *addr, unsigned long size,
+                  struct net_offload const *offload, void *packet)
 {
 	struct net_device_stats *stats;
+	struct sk_buff *skb;
+	struct page *page  = 0;
+	unsigned long head = size;
 
 	if (!_dev)
-		return;
+		return 0;
 
 	stats = (struct net_device_stats*) netdev_priv(_dev);
 
-	/* allocate skb */
 	enum {
-		ADDITIONAL_HEADROOM = 4, /* smallest value found by trial & error */
+		ADDITIONAL_HEADROOM = 4,   /* smallest value found by trial & error */
+		RX_COPYBREAK        = 256, /* copy small packets and all headers */
 	};
-	struct sk_buff *skb = dev_alloc_skb(size + ADDITIONAL_HEADROOM);
+
+	/*
+	 * Large packets are not copied. Only the headers are placed in the
+	 * linear part of the skb, the payload is attached as page fragment that
+	 * refers to the packet buffer of the NIC session.
+	 */
+	if (packet && size > RX_COPYBREAK
+	 && (page = (struct page *)kzalloc(sizeof(struct page), 0))) {
+		head          = RX_COPYBREAK;
+		page->addr    = addr;
+		page->mapping = PAGE_MAPPING_FOREIGN;
+		page->private = (unsigned long)packet;
+		atomic_set(&page->_count, 1);
+	}
+
+	/* allocate skb */
+	skb = dev_alloc_skb(head + ADDITIONAL_HEADROOM);
 	if (!skb) {
 		printk(KERN_NOTICE "genode_net_rx: low on mem - packet dropped!\n");
 		stats->rx_dropped++;
-		return;
+		if (page)
+			kfree(page);
+		return 0;
 	}
 
-	/* copy packet */
-	memcpy(skb_put(skb, size), addr, size);
+	/* copy packet headers */
+	memcpy(skb_put(skb, head), addr, head);
+
+	/* from here on, the packet buffer is released via 'foreign_page_release' */
+	if (page)
+		skb_add_rx_frag(skb, 0, page, head, size - head, size - head);
 
-	skb->dev       = _dev;
-	skb->protocol  = eth_type_trans(skb, _dev);
 	skb->ip_summed = CHECKSUM_NONE;
 
+	if (offload->csum_valid)
+		skb->ip_summed = CHECKSUM_UNNECESSARY;
+
+	/* the offsets are relative to the Ethernet header */
+	if (offload->csum_partial
+	 && !skb_partial_csum_set(skb, offload->csum_start, offload->csum_offset)) {
+		stats->rx_dropped++;
+		dev_kfree_skb(skb);
+		return page != 0;
+	}
+
+	/* coalesced TCP segments */
+	if (offload->gso_size) {
+		skb_shinfo(skb)->gso_size = offload->gso_size;
+		skb_shinfo(skb)->gso_type = SKB_GSO_TCPV4 | SKB_GSO_DODGY;
+		skb_shinfo(skb)->gso_segs = 0;
+	}
+
+	skb->dev      = _dev;
+	skb->protocol = eth_type_trans(skb, _dev);
+
 	netif_receive_skb(skb);
 
 	stats->rx_packets++;
 	stats->rx_bytes += size;
+
+	return page != 0;
 }
@@ -731,6 +731,15 @@ static inline void *page_address(struct page *page) { return page->addr; };
 void get_page(struct page *page);
 void put_page(struct page *page);
 
+/*
+ * Page that refers to memory not owned by the emulation, e.g., the payload
+ * of a received NIC packet. When its last reference is dropped,
+ * 'foreign_page_release' is called instead of freeing the memory.
+ */
+enum { PAGE_MAPPING_FOREIGN = -1 };
+
+void foreign_page_release(struct page *page);
+
 struct page *virt_to_head_page(const void *x);
 struct page *virt_to_page(const void *x);
 
@@ -18,9 +18,34 @@
 extern "C" {
 #endif
 
-void net_mac(void* mac, unsigned long size);
-int  net_tx(void* addr, unsigned long len);
-void net_driver_rx(void *addr, unsigned long size);
+/*
+ * Offload metadata of a packet, see 'Nic::Offload'
+ */
+struct net_offload
+{
+	int            csum_partial;  /* checksum must be completed */
+	int            csum_valid;    /* checksum was already verified */
+	unsigned short csum_start;
+	unsigned short csum_offset;
+	unsigned short gso_size;      /* MSS of a large TCPv4 packet, 0 if none */
+};
+
+void  net_mac(void* mac, unsigned long size);
+int   net_offload_supported(void);
+void *net_tx_alloc(unsigned long len, struct net_offload const *offload);
+void  net_tx_submit(void);
+
+/*
+ * Pass received packet to the IP stack
+ *
+ * If 'packet' is not null, the stack may keep referring to the packet
+ * buffer instead of copying the payload. In this case, the function returns
+ * 1 and 'net_rx_release' is called with 'packet' as soon as the buffer is no
+ * longer used, which may happen before the function returns.
+ */
+int   net_driver_rx(void *addr, unsigned long size,
+                    struct net_offload const *offload, void *packet);
+void  net_rx_release(void *packet);
 
 #ifdef __cplusplus
 }
@@ -489,12 +489,24 @@ struct page *virt_to_head_page(const void *x)
 }
 
 
+void get_page(struct page *page)
+{
+	atomic_inc(&page->_count);
+}
+
+
 void put_page(struct page *page)
 {
 	if (!atomic_dec_and_test(&page->_count))
 		return;
 
 	lx_log(DEBUG_SLAB, "put_page: %p", page);
+
+	if (page->mapping == PAGE_MAPPING_FOREIGN) {
+		foreign_page_release(page);
+		return;
+	}
+
 	Avl_page *p = tree.first()->find_by_address((Genode::addr_t)page->addr);
 
 	tree.remove(p);
@@ -30,15 +30,48 @@ class Nic_client
 		enum {
 			PACKET_SIZE = Nic::Packet_allocator::DEFAULT_PACKET_SIZE,
 			BUF_SIZE    = Nic::Session::QUEUE_SIZE * PACKET_SIZE,
+
+			/* number of packets submitted before the server gets signalled */
+			TX_BATCH_MAX = 32,
+
+			/* number of received packets referenced by the IP stack */
+			RX_HELD_MAX = Nic::Session::QUEUE_SIZE / 2,
 		};
 
 		Nic::Packet_allocator _tx_block_alloc;
 		Nic::Connection       _nic;
+		bool const            _offload;
+
+		/* packet allocated by 'net_tx_alloc' and not yet submitted */
+		Nic::Packet_descriptor _tx_packet;
+
+		/* packets submitted without signalling the server */
+		unsigned _tx_batched = 0;
+
+		/*
+		 * Received packets whose buffer is still referenced by the IP stack
+		 *
+		 * A packet released by the stack while the acknowledgement queue is
+		 * full is acknowledged on the next occasion.
+		 */
+		struct Rx_held
+		{
+			enum State { FREE, HELD, RELEASED };
+
+			State                  state;
+			Nic::Packet_descriptor packet;
+		};
+
+		Rx_held  _rx_held[RX_HELD_MAX];
+		unsigned _rx_free[RX_HELD_MAX];
+		unsigned _rx_num_free     = 0;
+		unsigned _rx_num_released = 0;
 
 		Genode::Io_signal_handler<Nic_client> _sink_ack;
 		Genode::Io_signal_handler<Nic_client> _sink_submit;
 		Genode::Io_signal_handler<Nic_client> _source_ack;
 		Genode::Io_signal_handler<Nic_client> _link_state_change;
+		Genode::Io_signal_handler<Nic_client> _tx_flush;
 
 		void (*_tick)();
 
@@ -53,6 +86,38 @@ class Nic_client
 			lxip_configure_dhcp();
 		}
 
+		/**
+		 * Signal the server about all packets submitted so far
+		 */
+		void _flush_tx()
+		{
+			if (!_tx_batched)
+				return;
+
+			_tx_batched = 0;
+			_nic.tx()->wakeup();
+		}
+
+		/**
+		 * Acknowledge packets released by the IP stack in the meantime
+		 */
+		void _ack_released()
+		{
+			for (unsigned i = 0; _rx_num_released && i < RX_HELD_MAX; i++) {
+
+				if (_rx_held[i].state != Rx_held::RELEASED)
+					continue;
+
+				if (!_nic.rx()->ready_to_ack())
+					return;
+
+				_nic.rx()->acknowledge_packet(_rx_held[i].packet);
+				_rx_held[i].state = Rx_held::FREE;
+				_rx_free[_rx_num_free++] = i;
+				_rx_num_released--;
+			}
+		}
+
 		/**
 		 * submit queue not empty anymore
 		 */
@@ -60,6 +125,8 @@ class Nic_client
 		{
 			Lx::timer_update_jiffies();
 
+			_ack_released();
+
 			/* process a batch of only MAX_PACKETS in one run */
 			enum { MAX_PACKETS = 20 };
 
@@ -69,7 +136,31 @@ class Nic_client
 			       count++ < MAX_PACKETS)
 			{
 				Nic::Packet_descriptor p = _nic.rx()->get_packet();
-				net_driver_rx(_nic.rx()->packet_content(p), p.size());
+				Nic::Offload const &o = p.offload();
+
+				net_offload const offload {
+					o.csum_partial(), o.csum_valid(), o.csum_start, o.csum_offset,
+					o.gso_type == Nic::Offload::GSO_TCPV4 ? o.gso_size : (unsigned short)0 };
+
+				/*
+				 * Let the IP stack refer to the packet buffer if a slot is
+				 * left. Otherwise, the packet gets copied.
+				 */
+				Rx_held *held = nullptr;
+				if (_rx_num_free) {
+					held = &_rx_held[_rx_free[--_rx_num_free]];
+					held->state  = Rx_held::HELD;
+					held->packet = p;
+				}
+
+				if (net_driver_rx(_nic.rx()->packet_content(p), p.size(),
+				                  &offload, held))
+					continue;
+
+				if (held) {
+					held->state = Rx_held::FREE;
+					_rx_free[_rx_num_free++] = held - _rx_held;
+				}
 
 				_nic.rx()->acknowledge_packet(p);
 			}
@@ -80,6 +171,9 @@ class Nic_client
 
 			/* tick the higher layer of the component */
 			_tick();
+
+			/* send the responses to the received packets in one batch */
+			_flush_tx();
 		}
 
 		/**
@@ -110,13 +204,20 @@ class Nic_client
 		           void (*ticker)())
 		:
 			_tx_block_alloc(&alloc),
-			_nic(env, &_tx_block_alloc, BUF_SIZE, BUF_SIZE),
+			_nic(env, &_tx_block_alloc, BUF_SIZE, BUF_SIZE, "", true),
+			_offload(_nic.offload_supported()),
 			_sink_ack(ep, *this, &Nic_client::_packet_avail),
 			_sink_submit(ep, *this, &Nic_client::_ready_to_ack),
 			_source_ack(ep, *this, &Nic_client::_ack_avail),
 			_link_state_change(ep, *this, &Nic_client::_link_state),
+			_tx_flush(ep, *this, &Nic_client::_flush_tx),
 			_tick(ticker)
 		{
+			for (unsigned i = 0; i < RX_HELD_MAX; i++) {
+				_rx_held[i].state = Rx_held::FREE;
+				_rx_free[_rx_num_free++] = i;
+			}
+
 			_nic.rx_channel()->sigh_ready_to_ack(_sink_ack);
 			_nic.rx_channel()->sigh_packet_avail(_sink_submit);
 			_nic.tx_channel()->sigh_ack_avail(_source_ack);
@@ -125,6 +226,67 @@ class Nic_client
 		}
 
 		Nic::Connection *nic() { return &_nic; }
+
+		bool offload() const { return _offload; }
+
+		/**
+		 * Allocate packet for transmission
+		 *
+		 * \return packet content, or nullptr if the packet could not be
+		 *         allocated
+		 */
+		void *tx_alloc(Genode::size_t len, Nic::Offload const &offload)
+		{
+			try {
+				_tx_packet = _nic.tx()->alloc_packet(len);
+				_tx_packet.offload(offload);
+				return _nic.tx()->packet_content(_tx_packet);
+			} catch (Nic::Session::Tx::Source::Packet_alloc_failed) {
+				return nullptr; }
+		}
+
+		/**
+		 * Submit packet allocated by 'tx_alloc'
+		 *
+		 * The server is signalled once per batch of packets. A batch ends
+		 * when the IP stack returns to the entrypoint, which dispatches the
+		 * '_tx_flush' signal, or when TX_BATCH_MAX packets are pending.
+		 */
+		void tx_submit()
+		{
+			if (!_nic.tx()->try_submit_packet(_tx_packet)) {
+
+				/* let the server drain the full submit queue */
+				_tx_batched = 0;
+				_nic.tx()->wakeup();
+				_nic.tx()->submit_packet(_tx_packet);
+				return;
+			}
+
+			if (_tx_batched++ == 0)
+				Genode::Signal_transmitter(_tx_flush).submit();
+
+			if (_tx_batched >= TX_BATCH_MAX)
+				_flush_tx();
+		}
+
+		/**
+		 * Called when the IP stack no longer refers to a received packet
+		 */
+		void rx_release(void *cookie)
+		{
+			Rx_held &held = *(Rx_held *)cookie;
+
+			if (_nic.rx()->ready_to_ack()) {
+				_nic.rx()->acknowledge_packet(held.packet);
+				held.state = Rx_held::FREE;
+				_rx_free[_rx_num_free++] = &held - _rx_held;
+				return;
+			}
+
+			held.state = Rx_held::RELEASED;
+			_rx_num_released++;
+		}
 };
 
 
@@ -166,19 +328,44 @@ void net_mac(void* mac, unsigned long size)
 }
 
 
+/**
+ * Call by back-end driver while initializing
+ */
+int net_offload_supported(void)
+{
+	return _nic_client->offload();
+}
+
+
 /**
  * Call by back-end driver when a packet should be sent
  */
-int net_tx(void* addr, unsigned long len)
+void *net_tx_alloc(unsigned long len, net_offload const *offload)
+{
+	Nic::Offload o;
+
+	if (offload->csum_partial) {
+		o.flags      |= Nic::Offload::CSUM_PARTIAL;
+		o.csum_start  = offload->csum_start;
+		o.csum_offset = offload->csum_offset;
+	}
+
+	if (offload->gso_size) {
+		o.gso_type = Nic::Offload::GSO_TCPV4;
+		o.gso_size = offload->gso_size;
+	}
+
+	return _nic_client->tx_alloc(len, o);
+}
+
+
+void net_tx_submit(void)
 {
-	try {
-		Nic::Packet_descriptor packet = _nic_client->nic()->tx()->alloc_packet(len);
-		void* content                 = _nic_client->nic()->tx()->packet_content(packet);
+	_nic_client->tx_submit();
+}
 
-		Genode::memcpy((char *)content, addr, len);
-		_nic_client->nic()->tx()->submit_packet(packet);
 
-		return 0;
-	/* Packet_alloc_failed */
-	} catch(...) { return 1; }
+void net_rx_release(void *packet)
+{
+	_nic_client->rx_release(packet);
 }
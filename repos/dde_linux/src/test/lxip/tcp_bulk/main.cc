@@ -0,0 +1,167 @@
+/*
+ * \brief  Measure the throughput of a TCP bulk transfer
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The component acts either as server, which receives data until the client
+ * closes the connection, or as client, which sends the configured amount of
+ * data to the server. Both sides report the achieved throughput.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <libc/component.h>
+#include <timer_session/connection.h>
+
+/* libc includes */
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+using namespace Genode;
+
+
+struct Failure : Genode::Exception { };
+
+
+enum { BUF_SIZE = 64*1024 };
+
+static char buf[BUF_SIZE];
+
+
+static void report(char const *what, unsigned long long bytes,
+                   unsigned long ms)
+{
+	unsigned long long const kbit = (bytes*8/1000) * 1000 / (ms ? ms : 1);
+
+	log(what, " ", bytes/(1024*1024), " MiB in ", ms, " ms: ",
+	    kbit/1000, ".", (kbit%1000)/100, " Mbit/s");
+}
+
+
+static void server(Xml_node config, Timer::Connection &timer)
+{
+	unsigned const port = config.attribute_value("port", 5001U);
+
+	int const s = socket(AF_INET, SOCK_STREAM, 0);
+	if (s < 0) {
+		error("no socket available");
+		throw Failure();
+	}
+
+	sockaddr_in addr { };
+	addr.sin_family      = AF_INET;
+	addr.sin_port        = htons(port);
+	addr.sin_addr.s_addr = INADDR_ANY;
+
+	if (bind(s, (sockaddr *)&addr, sizeof(addr)) || listen(s, 1)) {
+		error("could not listen on port ", port);
+		throw Failure();
+	}
+
+	log("server listening on port ", port);
+
+	int const c = accept(s, nullptr, nullptr);
+	if (c < 0) {
+		error("accept failed");
+		throw Failure();
+	}
+
+	unsigned long      const start = timer.elapsed_ms();
+	unsigned long long       bytes = 0;
+
+	for (;;) {
+		ssize_t const n = recv(c, buf, sizeof(buf), 0);
+		if (n <= 0)
+			break;
+		bytes += n;
+	}
+
+	report("received", bytes, timer.elapsed_ms() - start);
+	close(c);
+	close(s);
+}
+
+
+static void client(Xml_node config, Timer::Connection &timer)
+{
+	typedef String<16> Ip;
+	Ip                 const server_ip = config.attribute_value("server_ip", Ip());
+	unsigned           const port      = config.attribute_value("port", 5001U);
+	unsigned long long const bytes     = config.attribute_value("size_mb", 256ULL)*1024*1024;
+
+	sockaddr_in addr { };
+	addr.sin_family      = AF_INET;
+	addr.sin_port        = htons(port);
+	addr.sin_addr.s_addr = inet_addr(server_ip.string());
+
+	/* retry until the server is up */
+	int s = -1;
+	for (unsigned i = 0; i < 50; i++) {
+		s = socket(AF_INET, SOCK_STREAM, 0);
+		if (s < 0) {
+			error("no socket available");
+			throw Failure();
+		}
+		if (connect(s, (sockaddr *)&addr, sizeof(addr)) == 0)
+			break;
+
+		close(s);
+		s = -1;
+		timer.msleep(200);
+	}
+
+	if (s < 0) {
+		error("could not connect to ", server_ip, ":", port);
+		throw Failure();
+	}
+
+	unsigned long      const start = timer.elapsed_ms();
+	unsigned long long       sent  = 0;
+
+	while (sent < bytes) {
+		size_t  const len = min((unsigned long long)sizeof(buf), bytes - sent);
+		ssize_t const n   = send(s, buf, len, 0);
+		if (n <= 0) {
+			error("send failed after ", sent, " bytes");
+			throw Failure();
+		}
+		sent += n;
+	}
+
+	close(s);
+	report("sent", sent, timer.elapsed_ms() - start);
+}
+
+
+struct Main
+{
+	Main(Genode::Env &env)
+	{
+		Genode::Attached_rom_dataspace config_rom { env, "config" };
+		Timer::Connection              timer      { env };
+
+		Xml_node const config = config_rom.xml();
+
+		Libc::with_libc([&] () {
+			if (config.attribute_value("mode", String<8>()) == "server")
+				server(config, timer);
+			else
+				client(config, timer);
+		});
+
+		log("Test done");
+	}
+};
+
+
+void Libc::Component::construct(Libc::Env &env) { static Main main(env); }
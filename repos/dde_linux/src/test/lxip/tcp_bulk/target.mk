@@ -0,0 +1,3 @@
+TARGET   = test-lxip_tcp_bulk
+LIBS     = libc libc_lxip
+SRC_CC   = main.cc
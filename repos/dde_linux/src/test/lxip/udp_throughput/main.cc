@@ -0,0 +1,188 @@
+/*
+ * \brief  Measure the UDP throughput of a single lxip instance
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The component sends numbered datagrams to the broadcast address of its
+ * network. When connected to a loopback NIC, the datagrams are reflected to
+ * the sending IP stack, which passes them to the receiving socket of the
+ * component. Hence, the transmit and the receive path of the stack are
+ * exercised in an iperf-like fashion without a second IP stack.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <libc/component.h>
+#include <timer_session/connection.h>
+
+/* libc includes */
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+using namespace Genode;
+
+
+struct Failure : Genode::Exception { };
+
+
+enum { MAX_DATAGRAM = 1472 };
+
+static char tx_buf[MAX_DATAGRAM];
+static char rx_buf[MAX_DATAGRAM];
+
+
+static void report(char const *what, unsigned long datagrams,
+                   unsigned long long bytes, unsigned long ms)
+{
+	unsigned long long const kbit = (bytes*8/1000) * 1000 / (ms ? ms : 1);
+
+	log(what, " ", datagrams, " datagrams (", bytes/1024, " KiB) in ", ms,
+	    " ms: ", kbit/1000, ".", (kbit%1000)/100, " Mbit/s");
+}
+
+
+static int udp_socket()
+{
+	int const s = socket(AF_INET, SOCK_DGRAM, 0);
+	if (s < 0) {
+		error("no socket available");
+		throw Failure();
+	}
+	return s;
+}
+
+
+struct Receiver
+{
+	int const socket;
+
+	unsigned long      datagrams = 0;
+	unsigned long long bytes     = 0;
+	unsigned long      last_seq  = 0;
+
+	Receiver(int socket) : socket(socket) { }
+
+	/**
+	 * Fetch all datagrams available at the socket
+	 *
+	 * \return  true if at least one datagram was received
+	 */
+	bool drain()
+	{
+		bool progress = false;
+
+		for (;;) {
+			ssize_t const n = recv(socket, rx_buf, sizeof(rx_buf), 0);
+			if (n < (ssize_t)sizeof(unsigned long))
+				return progress;
+
+			progress = true;
+
+			/* count each datagram only once */
+			unsigned long const seq = *(unsigned long *)rx_buf;
+			if (seq <= last_seq)
+				continue;
+
+			last_seq = seq;
+			datagrams++;
+			bytes += n;
+		}
+	}
+};
+
+
+static void measure(Xml_node config, Timer::Connection &timer)
+{
+	typedef String<16> Ip;
+	Ip            const dst_ip  = config.attribute_value("dst", Ip("10.0.0.255"));
+	unsigned      const port    = config.attribute_value("port", 5001U);
+	unsigned long const packets = config.attribute_value("packets", 100000UL);
+	unsigned      const burst   = config.attribute_value("burst", 64U);
+	size_t        const size    = max(sizeof(unsigned long),
+	                                  min((size_t)MAX_DATAGRAM,
+	                                      config.attribute_value("size", (size_t)1400)));
+
+	sockaddr_in addr { };
+	addr.sin_family      = AF_INET;
+	addr.sin_port        = htons(port);
+	addr.sin_addr.s_addr = INADDR_ANY;
+
+	Receiver receiver { udp_socket() };
+	if (bind(receiver.socket, (sockaddr *)&addr, sizeof(addr))) {
+		error("could not bind to port ", port);
+		throw Failure();
+	}
+	fcntl(receiver.socket, F_SETFL, O_NONBLOCK);
+
+	int const tx = udp_socket();
+	int const on = 1;
+	setsockopt(tx, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on));
+
+	addr.sin_addr.s_addr = inet_addr(dst_ip.string());
+
+	log("sending ", packets, " datagrams of ", size, " bytes to ", dst_ip,
+	    ":", port);
+
+	unsigned long      const start = timer.elapsed_ms();
+	unsigned long long       sent  = 0;
+
+	for (unsigned long seq = 1; seq <= packets; seq++) {
+
+		*(unsigned long *)tx_buf = seq;
+
+		ssize_t const n = sendto(tx, tx_buf, size, 0, (sockaddr *)&addr,
+		                         sizeof(addr));
+		if (n < 0) {
+			error("sendto failed after ", seq - 1, " datagrams");
+			throw Failure();
+		}
+		sent += n;
+
+		if (seq % burst == 0)
+			receiver.drain();
+	}
+
+	unsigned long const sent_ms = timer.elapsed_ms() - start;
+
+	/* collect the datagrams still in flight */
+	for (unsigned idle_ms = 0; idle_ms < 200; idle_ms += 10) {
+		if (receiver.drain())
+			idle_ms = 0;
+		timer.msleep(10);
+	}
+
+	report("sent",     packets, sent, sent_ms);
+	report("received", receiver.datagrams, receiver.bytes,
+	       timer.elapsed_ms() - start);
+
+	close(tx);
+	close(receiver.socket);
+}
+
+
+struct Main
+{
+	Main(Genode::Env &env)
+	{
+		Genode::Attached_rom_dataspace config_rom { env, "config" };
+		Timer::Connection              timer      { env };
+
+		Libc::with_libc([&] () { measure(config_rom.xml(), timer); });
+
+		log("Test done");
+	}
+};
+
+
+void Libc::Component::construct(Libc::Env &env) { static Main main(env); }
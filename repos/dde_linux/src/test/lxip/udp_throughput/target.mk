@@ -0,0 +1,3 @@
+TARGET   = test-lxip_udp_throughput
+LIBS     = libc libc_lxip
+SRC_CC   = main.cc
@@ -129,10 +129,16 @@ struct Nitpicker_buffer
 		return Alpha_surface(alpha_surface_ds.local_addr<Pixel_alpha8>(), size());
 	}
 
-	void reset_surface()
+	/**
+	 * Reset area of the back buffer
+	 */
+	void reset_surface(Rect rect)
 	{
-		Genode::size_t const num_pixels = pixel_surface().size().count();
-		Genode::memset(alpha_surface().addr(), 0, num_pixels);
+		rect = Rect::intersect(rect, Rect(Point(0, 0), size()));
+		if (!rect.valid())
+			return;
+
+		unsigned const line_len = size().w();
 
 		/*
 		 * Initialize color buffer with 50% gray
@@ -140,15 +146,28 @@ struct Nitpicker_buffer
 		 * We do not use black to limit the bleeding of black into antialiased
 		 * drawing operations applied onto an initially transparent background.
 		 */
-		Pixel_surface pixels = pixel_surface();
-		Pixel_rgb888 *dst    = pixels.addr();
-
 		Pixel_rgb888 const gray(127, 127, 127, 255);
 
-		for (unsigned n = pixels.size().count(); n; n--)
-			*dst++ = gray;
+		Pixel_rgb888 *pixel_line = pixel_surface().addr()
+		                         + rect.y1()*line_len + rect.x1();
+		Pixel_alpha8 *alpha_line = alpha_surface().addr()
+		                         + rect.y1()*line_len + rect.x1();
+
+		for (unsigned y = rect.h(); y--; ) {
+
+			Genode::memset(alpha_line, 0, rect.w());
+
+			Pixel_rgb888 *dst = pixel_line;
+			for (unsigned n = rect.w(); n; n--)
+				*dst++ = gray;
+
+			pixel_line += line_len;
+			alpha_line += line_len;
+		}
 	}
 
+	void reset_surface() { reset_surface(Rect(Point(0, 0), size())); }
+
 	template <typename DST_PT, typename SRC_PT>
 	void _convert_back_to_front(DST_PT                        *front_base,
 	                            Genode::Texture<SRC_PT> const &texture,
@@ -161,17 +180,19 @@ struct Nitpicker_buffer
 		Dither_painter::paint(surface, texture, Point());
 	}
 
-	void _update_input_mask()
+	void _update_input_mask(Rect const rect)
 	{
 		unsigned const num_pixels = size().count();
+		unsigned const line_len   = size().w();
+		unsigned const offset     = rect.y1()*line_len + rect.x1();
 
 		unsigned char * const alpha_base = fb_ds.local_addr<unsigned char>()
 		                                 + mode.bytes_per_pixel()*num_pixels;
 
 		unsigned char * const input_base = alpha_base + num_pixels;
 
-		unsigned char const *src = alpha_base;
-		unsigned char       *dst = input_base;
+		unsigned char const *src_line = alpha_base + offset;
+		unsigned char       *dst_line = input_base + offset;
 
 		/*
 		 * Set input mask for all pixels where the alpha value is above a
@@ -180,30 +201,45 @@ struct Nitpicker_buffer
 		 */
 		unsigned char const threshold = 100;
 
-		for (unsigned i = 0; i < num_pixels; i++)
-			*dst++ = (*src++) > threshold;
+		for (unsigned y = rect.h(); y--; ) {
+
+			unsigned char const *src = src_line;
+			unsigned char       *dst = dst_line;
+
+			for (unsigned i = rect.w(); i; i--)
+				*dst++ = (*src++) > threshold;
+
+			src_line += line_len;
+			dst_line += line_len;
+		}
 	}
 
-	void flush_surface()
+	/**
+	 * Transfer area of the back buffer to the nitpicker buffer
+	 */
+	void flush_surface(Rect rect)
 	{
+		rect = Rect::intersect(rect, Rect(Point(0, 0), size()));
+		if (!rect.valid())
+			return;
+
 		/* represent back buffer as texture */
 		Genode::Texture<Pixel_rgb888>
 			texture(pixel_surface_ds.local_addr<Pixel_rgb888>(),
 			        alpha_surface_ds.local_addr<unsigned char>(),
 			        size());
 
-		// XXX track dirty rectangles
-		Rect const clip_rect(Genode::Surface_base::Point(0, 0), size());
-
 		Pixel_rgb565 *pixel_base = fb_ds.local_addr<Pixel_rgb565>();
 		Pixel_alpha8 *alpha_base = fb_ds.local_addr<Pixel_alpha8>()
 		                         + mode.bytes_per_pixel()*size().count();
 
-		_convert_back_to_front(pixel_base, texture, clip_rect);
-		_convert_back_to_front(alpha_base, texture, clip_rect);
+		_convert_back_to_front(pixel_base, texture, rect);
+		_convert_back_to_front(alpha_base, texture, rect);
 
-		_update_input_mask();
+		_update_input_mask(rect);
 	}
+
+	void flush_surface() { flush_surface(Rect(Point(0, 0), size())); }
 };
 
 #endif /* _INCLUDE__GEMS__NITPICKER_BUFFER_H_ */
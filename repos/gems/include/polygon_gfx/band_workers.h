@@ -0,0 +1,184 @@
+/*
+ * \brief  Pool of threads for painting polygons in horizontal bands
+ * \author agent
+ * \date   2026-10-19
+ *
+ * Once the edge buffers of a polygon are computed, the spans of different
+ * scanlines can be painted independently from each other. For large
+ * polygons, the scanlines are split into bands, which are painted by the
+ * worker threads and the calling thread in parallel.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__POLYGON_GFX__BAND_WORKERS_H_
+#define _INCLUDE__POLYGON_GFX__BAND_WORKERS_H_
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/semaphore.h>
+#include <base/thread.h>
+#include <util/reconstructible.h>
+
+namespace Polygon { class Band_workers; }
+
+
+class Polygon::Band_workers : Genode::Noncopyable
+{
+	public:
+
+		enum { MAX_WORKERS = 8 };
+
+		/*
+		 * Minimum number of scanlines per band, polygons with fewer
+		 * scanlines are not worth the synchronization costs
+		 */
+		enum { MIN_BAND_HEIGHT = 32 };
+
+	private:
+
+		enum { STACK_SIZE = 8*1024*sizeof(long) };
+
+		struct Job
+		{
+			virtual unsigned long paint(int y_start, int y_end) = 0;
+		};
+
+		template <typename FN>
+		struct Fn_job : Job
+		{
+			FN const &fn;
+
+			Fn_job(FN const &fn) : fn(fn) { }
+
+			unsigned long paint(int y_start, int y_end) override {
+				return fn(y_start, y_end); }
+		};
+
+		struct Worker : Genode::Thread
+		{
+			Band_workers      &_workers;
+			Genode::Semaphore  _start { };
+			bool               _exit = false;
+
+			/* band assigned to the worker for the current job */
+			int           _y_start = 0, _y_end = 0;
+			unsigned long _result  = 0;
+
+			Worker(Genode::Env &env, Band_workers &workers, unsigned index)
+			:
+				Genode::Thread(env, "band_worker", STACK_SIZE,
+				               env.cpu().affinity_space().location_of_index(index),
+				               Weight(), env.cpu()),
+				_workers(workers)
+			{ }
+
+			void entry() override
+			{
+				for (;;) {
+					_start.down();
+
+					if (_exit)
+						return;
+
+					_result = _workers._job->paint(_y_start, _y_end);
+					_workers._done.up();
+				}
+			}
+		};
+
+		/*
+		 * The calling thread paints a band as well. Hence, one worker thread
+		 * less than the configured number of workers is needed.
+		 */
+		unsigned const _num_threads;
+
+		Genode::Constructible<Worker> _workers[MAX_WORKERS];
+
+		Genode::Semaphore _done { };
+
+		Job *_job = nullptr;
+
+	public:
+
+		Band_workers(Genode::Env &env, unsigned num_workers)
+		:
+			_num_threads(Genode::min(Genode::max(num_workers, 1U),
+			                         (unsigned)MAX_WORKERS) - 1)
+		{
+			/* leave the first CPU to the calling thread */
+			for (unsigned i = 0; i < _num_threads; i++) {
+				_workers[i].construct(env, *this, i + 1);
+				_workers[i]->start();
+			}
+		}
+
+		~Band_workers()
+		{
+			for (unsigned i = 0; i < _num_threads; i++) {
+				_workers[i]->_exit = true;
+				_workers[i]->_start.up();
+				_workers[i]->join();
+			}
+		}
+
+		unsigned num_workers() const { return _num_threads + 1; }
+
+		/**
+		 * Call 'fn' for bands of the scanline range [y_start, y_end)
+		 *
+		 * \param fn  functor taking the arguments 'int y_start, int y_end'
+		 *            and returning the number of painted pixels as
+		 *            'unsigned long'
+		 *
+		 * \return  sum of the values returned by 'fn'
+		 *
+		 * The functor is called concurrently by different threads and must
+		 * not modify state shared between bands.
+		 */
+		template <typename FN>
+		unsigned long apply(int y_start, int y_end, FN const &fn)
+		{
+			int const height = y_end - y_start;
+
+			unsigned const num_bands =
+				Genode::min(_num_threads + 1, (unsigned)Genode::max(height, 0)
+				                              / MIN_BAND_HEIGHT);
+
+			if (num_bands < 2)
+				return fn(y_start, y_end);
+
+			Fn_job<FN> job(fn);
+			_job = &job;
+
+			int const band_height = (height + num_bands - 1)/num_bands;
+
+			/* the calling thread paints the first band */
+			unsigned const num_started = num_bands - 1;
+
+			for (unsigned i = 0; i < num_started; i++) {
+				Worker &worker = *_workers[i];
+				worker._y_start = y_start + (i + 1)*band_height;
+				worker._y_end   = Genode::min(y_end, worker._y_start + band_height);
+				worker._start.up();
+			}
+
+			unsigned long result = fn(y_start, y_start + band_height);
+
+			for (unsigned i = 0; i < num_started; i++)
+				_done.down();
+
+			for (unsigned i = 0; i < num_started; i++)
+				result += _workers[i]->_result;
+
+			_job = nullptr;
+			return result;
+		}
+};
+
+#endif /* _INCLUDE__POLYGON_GFX__BAND_WORKERS_H_ */
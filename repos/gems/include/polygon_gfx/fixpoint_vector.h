@@ -0,0 +1,34 @@
+/*
+ * \brief  Vectors of fixpoint values used for interpolating along spans
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The compiler maps the arithmetic on these types to SIMD instructions where
+ * available, e.g., SSE2 on x86_64 or NEON on ARM, and to scalar code
+ * otherwise.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__POLYGON_GFX__FIXPOINT_VECTOR_H_
+#define _INCLUDE__POLYGON_GFX__FIXPOINT_VECTOR_H_
+
+namespace Polygon {
+
+	/*
+	 * 16.16 fixpoint values of texture coordinates (u, v)
+	 */
+	typedef int Fixpoint_vec2 __attribute__((vector_size(2*sizeof(int))));
+
+	/*
+	 * 16.16 fixpoint values of color components (r, g, b, a)
+	 */
+	typedef int Fixpoint_vec4 __attribute__((vector_size(4*sizeof(int))));
+}
+
+#endif /* _INCLUDE__POLYGON_GFX__FIXPOINT_VECTOR_H_ */
@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <util/color.h>
+#include <polygon_gfx/fixpoint_vector.h>
 
 namespace Polygon {
 
@@ -42,28 +43,24 @@ static inline void Polygon::interpolate_rgba(Polygon::Color start,
 	if (num_values == 0) return;
 
 	/* use 16.16 fixpoint values for the calculation */
-	int const r_ascent = ((end.r - start.r)<<16) / (int)num_values,
-	          g_ascent = ((end.g - start.g)<<16) / (int)num_values,
-	          b_ascent = ((end.b - start.b)<<16) / (int)num_values,
-	          a_ascent = ((end.a - start.a)<<16) / (int)num_values;
+	Fixpoint_vec4 const ascent = { ((end.r - start.r)<<16) / (int)num_values,
+	                               ((end.g - start.g)<<16) / (int)num_values,
+	                               ((end.b - start.b)<<16) / (int)num_values,
+	                               ((end.a - start.a)<<16) / (int)num_values };
 
 	/* set start values for color components */
-	int r = start.r<<16,
-	    g = start.g<<16,
-	    b = start.b<<16,
-	    a = start.a<<16;
+	Fixpoint_vec4 rgba = { start.r<<16, start.g<<16, start.b<<16, start.a<<16 };
 
 	for ( ; num_values--; dst++, dst_alpha++) {
 
+		Fixpoint_vec4 const c = rgba >> 16;
+
 		/* combine current color value with existing pixel via alpha blending */
-		*dst        = PT::mix(*dst, PT(r>>16, g>>16, b>>16), a>>16);
-		*dst_alpha += ((255 - *dst_alpha)*a) >> (16 + 8);
+		*dst        = PT::mix(*dst, PT(c[0], c[1], c[2]), c[3]);
+		*dst_alpha += ((255 - *dst_alpha)*rgba[3]) >> (16 + 8);
 
-		/* increment color-component values by ascent */
-		r += r_ascent;
-		g += g_ascent;
-		b += b_ascent;
-		a += a_ascent;
+		/* increment all color components by their ascent at once */
+		rgba += ascent;
 	}
 }
 
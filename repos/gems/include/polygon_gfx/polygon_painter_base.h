@@ -19,6 +19,7 @@
 #include <util/geometry.h>
 #include <util/misc_math.h>
 #include <polygon_gfx/clipping.h>
+#include <polygon_gfx/band_workers.h>
 
 namespace Polygon { class Painter_base; }
 
@@ -27,6 +28,8 @@ class Polygon::Painter_base
 {
 	private:
 
+		Band_workers *_band_workers = nullptr;
+
 		/**
 		 * Interpolate linearly between start value and end value
 		 */
@@ -217,6 +220,30 @@ class Polygon::Painter_base
 		}
 
 
+		/**
+		 * Distribute the painting of scanlines over band workers
+		 *
+		 * \param fn  functor taking the arguments 'int y_start, int y_end',
+		 *            painting the spans of the scanlines [y_start, y_end),
+		 *            and returning the number of painted pixels
+		 *
+		 * Polygons that are too small to be split into bands are painted by
+		 * the calling thread.
+		 */
+		template <typename FN>
+		unsigned long paint_bands(Rect const bbox, FN const &fn)
+		{
+			if (_band_workers)
+				return _band_workers->apply(bbox.y1(), bbox.y2(), fn);
+
+			return fn(bbox.y1(), bbox.y2());
+		}
+
+		/**
+		 * Use band workers for painting large polygons
+		 */
+		void band_workers(Band_workers &workers) { _band_workers = &workers; }
+
 		/**
 		 * Calculate edge buffers for a polygon
 		 *
@@ -88,11 +88,13 @@ class Polygon::Shaded_painter : public Polygon::Painter_base
 		 * \param points      Array of polygon points
 		 * \param num_points  Number of polygon points
 		 *
+		 * \return            number of painted pixels
+		 *
 		 * The pixel surface and the alpha surface must have the same
-		 * dimensions.
+		 * dimensions. Fully transparent spans are skipped.
 		 */
 		template <typename PT, typename AT>
-		void paint(Genode::Surface<PT> &pixel_surface,
+		unsigned long paint(Genode::Surface<PT> &pixel_surface,
 		           Genode::Surface<AT> &alpha_surface,
 		           Point const points[], unsigned num_points)
 		{
@@ -115,30 +117,44 @@ class Polygon::Shaded_painter : public Polygon::Painter_base
 			int * const a_l_edge = _edges.left (ATTR_A);
 			int * const a_r_edge = _edges.right(ATTR_A);
 
-			/* calculate begin of first destination scanline */
 			unsigned const dst_w = pixel_surface.size().w();
-			PT        *dst_pixel = pixel_surface.addr() + dst_w*bbox.y1();
-			AT        *dst_alpha = alpha_surface.addr() + dst_w*bbox.y1();
 
-			for (int y = bbox.y1(); y < bbox.y2(); y++) {
+			auto paint_spans = [&] (int y_start, int y_end)
+			{
+				unsigned long num_pixels = 0;
+
+				/* calculate begin of first destination scanline */
+				PT *dst_pixel = pixel_surface.addr() + dst_w*y_start;
+				AT *dst_alpha = alpha_surface.addr() + dst_w*y_start;
+
+				for (int y = y_start; y < y_end; y++, dst_pixel += dst_w,
+				                                      dst_alpha += dst_w) {
+
+					int const x_l = x_l_edge[y];
+					int const x_r = x_r_edge[y];
 
-				/* read left and right color values from corresponding edge buffers */
-				Color l_color = Color(r_l_edge[y], g_l_edge[y], b_l_edge[y], a_l_edge[y]);
-				Color r_color = Color(r_r_edge[y], g_r_edge[y], b_r_edge[y], a_r_edge[y]);
+					/* skip empty and fully transparent spans */
+					if (x_l >= x_r || (a_l_edge[y] == 0 && a_r_edge[y] == 0))
+						continue;
 
-				int const x_l = x_l_edge[y];
-				int const x_r = x_r_edge[y];
+					/* read left and right color values from corresponding edge buffers */
+					Color l_color = Color(r_l_edge[y], g_l_edge[y], b_l_edge[y], a_l_edge[y]);
+					Color r_color = Color(r_r_edge[y], g_r_edge[y], b_r_edge[y], a_r_edge[y]);
 
-				if (x_l < x_r)
 					interpolate_rgba(l_color, r_color, dst_pixel + x_l,
 					                 (unsigned char *)dst_alpha + x_l,
 					                 x_r - x_l, x_l, y);
 
-				dst_pixel += dst_w;
-				dst_alpha += dst_w;
-			}
+					num_pixels += x_r - x_l;
+				}
+				return num_pixels;
+			};
+
+			unsigned long const num_pixels = paint_bands(bbox, paint_spans);
 
 			pixel_surface.flush_pixels(bbox);
+
+			return num_pixels;
 		}
 };
 
@@ -85,11 +85,13 @@ class Polygon::Textured_painter : public Polygon::Painter_base
 		 * \param points      Array of polygon points
 		 * \param num_points  Number of polygon points
 		 *
+		 * \return            number of painted pixels
+		 *
 		 * The pixel surface and the alpha surface must have the same
 		 * dimensions.
 		 */
 		template <typename PT, typename AT>
-		void paint(Genode::Surface<PT> &pixel_surface,
+		unsigned long paint(Genode::Surface<PT> &pixel_surface,
 		           Genode::Surface<AT> &alpha_surface,
 		           Point const points[], unsigned num_points,
 		           Genode::Texture<PT> const &texture)
@@ -113,33 +115,46 @@ class Polygon::Textured_painter : public Polygon::Painter_base
 			PT            const *src_pixel = texture.pixel();
 			unsigned char const *src_alpha = texture.alpha();
 
-			/* calculate begin of destination scanline */
 			unsigned const dst_w = pixel_surface.size().w();
-			PT        *dst_pixel = pixel_surface.addr() + dst_w*bbox.y1();
-			AT        *dst_alpha = alpha_surface.addr() + dst_w*bbox.y1();
 
-			for (int y = bbox.y1(); y < bbox.y2(); y++) {
+			auto paint_spans = [&] (int y_start, int y_end)
+			{
+				unsigned long num_pixels = 0;
+
+				/* calculate begin of destination scanline */
+				PT *dst_pixel = pixel_surface.addr() + dst_w*y_start;
+				AT *dst_alpha = alpha_surface.addr() + dst_w*y_start;
+
+				for (int y = y_start; y < y_end; y++, dst_pixel += dst_w,
+				                                      dst_alpha += dst_w) {
+
+					int const x_l = x_l_edge[y];
+					int const x_r = x_r_edge[y];
 
-				/*
-				 * Read left and right texture coordinates (u,v) from
-				 * corresponding edge buffers.
-				 */
-				Genode::Point<> const l_texpos(u_l_edge[y], v_l_edge[y]);
-				Genode::Point<> const r_texpos(u_r_edge[y], v_r_edge[y]);
+					if (x_l >= x_r)
+						continue;
 
-				int const x_l = x_l_edge[y];
-				int const x_r = x_r_edge[y];
+					/*
+					 * Read left and right texture coordinates (u,v) from
+					 * corresponding edge buffers.
+					 */
+					Genode::Point<> const l_texpos(u_l_edge[y], v_l_edge[y]);
+					Genode::Point<> const r_texpos(u_r_edge[y], v_r_edge[y]);
 
-				if (x_l < x_r)
 					texturize_rgba(l_texpos, r_texpos,
 					               dst_pixel + x_l, (unsigned char *)dst_alpha + x_l,
 					               x_r - x_l, src_pixel, src_alpha, src_w);
 
-				dst_pixel += dst_w;
-				dst_alpha += dst_w;
-			}
+					num_pixels += x_r - x_l;
+				}
+				return num_pixels;
+			};
+
+			unsigned long const num_pixels = paint_bands(bbox, paint_spans);
 
 			pixel_surface.flush_pixels(bbox);
+
+			return num_pixels;
 		}
 };
 
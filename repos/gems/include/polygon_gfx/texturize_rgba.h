@@ -18,6 +18,7 @@
 #include <util/color.h>
 #include <os/pixel_rgba.h>
 #include <util/geometry.h>
+#include <polygon_gfx/fixpoint_vector.h>
 
 namespace Polygon {
 
@@ -43,17 +44,18 @@ static inline void Polygon::texturize_rgba(Genode::Point<> start, Genode::Point<
 	if (num_values <= 0) return;
 
 	/* use 16.16 fixpoint values for the calculation */
-	int tx_ascent = ((end.x() - start.x())<<16)/(int)num_values,
-	    ty_ascent = ((end.y() - start.y())<<16)/(int)num_values;
+	Fixpoint_vec2 const ascent = { ((end.x() - start.x())<<16)/(int)num_values,
+	                               ((end.y() - start.y())<<16)/(int)num_values };
 
-	/* set start values for color components */
-	int tx = start.x()<<16,
-	    ty = start.y()<<16;
+	/* set start values for texture coordinates */
+	Fixpoint_vec2 texpos = { start.x()<<16, start.y()<<16 };
 
 	for ( ; num_values--; dst++, dst_alpha++) {
 
+		Fixpoint_vec2 const t = texpos >> 16;
+
 		/* blend pixel from texture with destination point on surface */
-		unsigned long src_offset = (ty>>16)*texture_width + (tx>>16);
+		unsigned long src_offset = t[1]*texture_width + t[0];
 
 		int const a = alpha_base[src_offset];
 
@@ -61,8 +63,7 @@ static inline void Polygon::texturize_rgba(Genode::Point<> start, Genode::Point<
 		*dst_alpha += ((255 - *dst_alpha)*a) >> 8;
 
 		/* walk through texture */
-		tx += tx_ascent;
-		ty += ty_ascent;
+		texpos += ascent;
 	}
 }
 
@@ -155,6 +155,8 @@ struct Menu_view::Button_widget : Widget, Animator::Item
 	{
 		blend.animate();
 
+		_content_changed = true;
+
 		animated(blend != blend.dst());
 	}
 };
@@ -461,6 +461,9 @@ struct Menu_view::Depgraph_widget : Widget
 
 		update_list_model_from_xml(_model_update_policy, _children, node);
 
+		/* the connections depend on the sub nodes */
+		_content_changed = true;
+
 		/*
 		 * Import dependencies
 		 */
@@ -660,6 +663,8 @@ struct Menu_view::Depgraph_widget : Widget
 		for (Widget *w = _children.first(); w; w = w->next())
 			w->size(w->geometry().area());
 	}
+
+	bool _draws_between_children() const override { return true; }
 };
 
 #endif /* _DEPGRAPH_WIDGET_H_ */
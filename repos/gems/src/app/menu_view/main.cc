@@ -25,6 +25,7 @@
 #include <input/event.h>
 #include <os/reporter.h>
 #include <timer_session/connection.h>
+#include <framebuffer_session/damage.h>
 
 /* gems includes */
 #include <gems/nitpicker_buffer.h>
@@ -40,6 +41,8 @@ struct Menu_view::Main
 
 	Constructible<Nitpicker_buffer> _buffer;
 
+	Constructible<Framebuffer::Refresh_batch> _refresh_batch;
+
 	Nitpicker::Session::View_handle _view_handle = _nitpicker.create_view();
 
 	Point _position;
@@ -121,6 +124,11 @@ struct Menu_view::Main
 
 	bool _schedule_redraw = false;
 
+	/**
+	 * Log the number of redrawn pixels per redraw
+	 */
+	bool _redraw_stats = false;
+
 	/**
 	 * Frame of last call of 'handle_frame_timer'
 	 */
@@ -201,6 +209,8 @@ void Menu_view::Main::_handle_config()
 		_hover_reporter.enabled(false);
 	}
 
+	_redraw_stats = _config.xml().attribute_value("redraw_stats", false);
+
 	_handle_dialog_update();
 }
 
@@ -269,23 +279,50 @@ void Menu_view::Main::_handle_frame_timer()
 		Area const old_size = _buffer.constructed() ? _buffer->size() : Area();
 		Area const size     = _root_widget.min_size();
 
-		if (!_buffer.constructed() || size.w() > old_size.w() || size.h() > old_size.h())
+		if (!_buffer.constructed() || size.w() > old_size.w() || size.h() > old_size.h()) {
 			_buffer.construct(_nitpicker, size, _env.ram(), _env.rm());
-		else
-			_buffer->reset_surface();
+			_refresh_batch.construct(_env.rm(), *_nitpicker.framebuffer());
+			_widget_factory.damage.mark_as_dirty(Rect(Point(0, 0), _buffer->size()));
+		}
 
 		_root_widget.size(size);
 		_root_widget.position(Point(0, 0));
 
+		_root_widget.mark_damaged_areas(Point(0, 0));
+
 		Surface<Pixel_rgb888> pixel_surface = _buffer->pixel_surface();
 		Surface<Pixel_alpha8> alpha_surface = _buffer->alpha_surface();
 
-		// XXX restrict redraw to dirty regions
-		//     don't perform a full dialog update
-		_root_widget.draw(pixel_surface, alpha_surface, Point(0, 0));
+		unsigned num_rects  = 0;
+		size_t   num_pixels = 0;
+
+		/* redraw the whole widget tree clipped to each dirty area */
+		_widget_factory.damage.flush([&] (Rect const &dirty) {
+
+			Rect const rect = Rect::intersect(dirty, Rect(Point(0, 0), _buffer->size()));
+			if (!rect.valid())
+				return;
+
+			_buffer->reset_surface(rect);
+
+			pixel_surface.clip(rect);
+			alpha_surface.clip(rect);
+
+			_root_widget.draw(pixel_surface, alpha_surface, Point(0, 0));
+
+			_buffer->flush_surface(rect);
+			_refresh_batch->add(rect.x1(), rect.y1(), rect.w(), rect.h());
+
+			num_rects++;
+			num_pixels += rect.area().count();
+		});
+
+		_refresh_batch->flush();
+
+		if (_redraw_stats)
+			log("redraw: ", num_rects, " rects, ", num_pixels, " of ",
+			    _buffer->size().count(), " pixels");
 
-		_buffer->flush_surface();
-		_nitpicker.framebuffer()->refresh(0, 0, _buffer->size().w(), _buffer->size().h());
 		_update_view();
 
 		_schedule_redraw = false;
@@ -26,6 +26,7 @@
 #include <os/pixel_alpha8.h>
 #include <os/texture_rgb888.h>
 #include <util/reconstructible.h>
+#include <util/dirty_rect.h>
 #include <nitpicker_gfx/text_painter.h>
 #include <libc/component.h>
 
@@ -38,6 +39,8 @@ namespace Menu_view {
 	typedef Surface_base::Point Point;
 	typedef Surface_base::Area  Area;
 	typedef Surface_base::Rect  Rect;
+
+	typedef Genode::Dirty_rect<Rect, 4> Dirty_rect;
 }
 
 #endif /* _TYPES_H_ */
@@ -95,6 +95,101 @@ class Menu_view::Widget : public List<Widget>::Element
 
 		Unique_id const _unique_id;
 
+		/*
+		 * Digests of the XML node of the last update, covering the whole
+		 * subtree and the widget's own attributes only
+		 *
+		 * An update is skipped only if both the size and the 64-bit FNV-1a
+		 * checksum of the content are unchanged. Keeping a copy of the
+		 * content instead would make the comparison exact but would cost
+		 * memory for each nesting level of the menu. The remaining risk of
+		 * a collision between two contents of equal size is negligible,
+		 * and its effect is limited to a stale widget until the next
+		 * change.
+		 */
+		struct Digest
+		{
+			uint64_t checksum;
+			size_t   size;
+
+			bool operator == (Digest const &other) const {
+				return checksum == other.checksum && size == other.size; }
+		};
+
+		Digest _subtree_digest { 0, 0 };
+		Digest _attr_digest    { 0, 0 };
+
+		static uint64_t _checksum(char const *s, size_t len,
+		                          uint64_t checksum = 14695981039346656037ULL)
+		{
+			for (; len--; s++)
+				checksum = (checksum ^ (unsigned char)*s)*1099511628211ULL;
+
+			return checksum;
+		}
+
+		/**
+		 * Return digest of XML node with its sub nodes left out
+		 */
+		static Digest _attr_digest_of(Xml_node node)
+		{
+			char const *start  = node.addr();
+			Digest      digest { _checksum(start, 0), 0 };
+
+			auto add = [&] (char const *end) {
+				digest.checksum = _checksum(start, end - start, digest.checksum);
+				digest.size    += end - start; };
+
+			node.for_each_sub_node([&] (Xml_node sub_node) {
+				add(sub_node.addr());
+				start = sub_node.addr() + sub_node.size();
+			});
+
+			add(node.addr() + node.size());
+			return digest;
+		}
+
+		/**
+		 * Update widget unless its XML node remained unchanged
+		 *
+		 * The layout of an unchanged subtree is kept as is.
+		 */
+		void _update_if_changed(Xml_node node)
+		{
+			Digest const subtree_digest { _checksum(node.addr(), node.size()),
+			                              node.size() };
+			if (subtree_digest == _subtree_digest)
+				return;
+
+			_subtree_digest = subtree_digest;
+
+			Digest const attr_digest = _attr_digest_of(node);
+			if (!(attr_digest == _attr_digest)) {
+				_attr_digest     = attr_digest;
+				_content_changed = true;
+			}
+
+			update(node);
+		}
+
+		/*
+		 * Absolute position and size of the widget, and its geometry, as
+		 * drawn by the last redraw
+		 */
+		Rect _drawn_rect     { };
+		Rect _drawn_geometry { };
+
+		static bool _equal(Rect const &r1, Rect const &r2)
+		{
+			return r1.p1() == r2.p1() && r1.p2() == r2.p2();
+		}
+
+		void _mark_as_dirty(Rect const &rect)
+		{
+			if (rect.valid())
+				_factory.damage.mark_as_dirty(rect);
+		}
+
 	protected:
 
 		Widget_factory &_factory;
@@ -117,7 +212,7 @@ class Menu_view::Widget : public List<Widget>::Element
 				throw Unknown_element_type();
 			}
 
-			void update_element(Widget &w, Xml_node node) { w.update(node); }
+			void update_element(Widget &w, Xml_node node) { w._update_if_changed(node); }
 
 			static bool element_matches_xml_node(Widget const &w, Xml_node node)
 			{
@@ -136,12 +231,35 @@ class Menu_view::Widget : public List<Widget>::Element
 		                    Surface<Pixel_alpha8> &alpha_surface,
 		                    Point at) const
 		{
-			for (Widget const *w = _children.first(); w; w = w->next())
-				w->draw(pixel_surface, alpha_surface, at + w->_animated_geometry.p1());
+			Rect const clip = pixel_surface.clip();
+
+			for (Widget const *w = _children.first(); w; w = w->next()) {
+
+				Rect const rect(at + w->_animated_geometry.p1(),
+				                w->_animated_geometry.area());
+
+				/* skip children outside the area to redraw */
+				if (Rect::intersect(clip, rect).valid())
+					w->draw(pixel_surface, alpha_surface, rect.p1());
+			}
 		}
 
 		virtual void _layout() { }
 
+		/**
+		 * Set if the appearance of the widget changed apart from its geometry
+		 */
+		bool _content_changed = true;
+
+		/**
+		 * Return true if the widget paints between its children
+		 *
+		 * Such a widget is redrawn as a whole whenever one of its children
+		 * is redrawn, which is needed for painting lines that cannot be
+		 * clipped partially.
+		 */
+		virtual bool _draws_between_children() const { return false; }
+
 		Rect _inner_geometry() const
 		{
 			return Rect(Point(margin.left, margin.top),
@@ -196,6 +314,9 @@ class Menu_view::Widget : public List<Widget>::Element
 				_children.remove(w);
 				_model_update_policy.destroy_element(*w);
 			}
+
+			/* the area previously covered by the widget must be redrawn */
+			_mark_as_dirty(_drawn_rect);
 		}
 
 		bool has_name(Name const &name) const { return name == _name; }
@@ -220,6 +341,40 @@ class Menu_view::Widget : public List<Widget>::Element
 			_geometry = Rect(position, _geometry.area());
 		}
 
+		/**
+		 * Mark areas changed since the last redraw as dirty
+		 *
+		 * \param at  absolute position of the widget, as used for 'draw'
+		 *
+		 * \return true if any part of the widget was marked as dirty
+		 */
+		bool mark_damaged_areas(Point at)
+		{
+			Rect const rect(at, _animated_geometry.area());
+
+			bool const damaged = _content_changed
+			                  || !_equal(rect, _drawn_rect)
+			                  || !_equal(_geometry, _drawn_geometry);
+
+			if (damaged) {
+				_mark_as_dirty(_drawn_rect);
+				_mark_as_dirty(rect);
+			}
+
+			bool children_damaged = false;
+			for (Widget *w = _children.first(); w; w = w->next())
+				children_damaged |= w->mark_damaged_areas(at + w->_animated_geometry.p1());
+
+			if (children_damaged && _draws_between_children())
+				_mark_as_dirty(rect);
+
+			_drawn_rect      = rect;
+			_drawn_geometry  = _geometry;
+			_content_changed = false;
+
+			return damaged || children_damaged;
+		}
+
 		/**
 		 * Return unique ID of inner-most hovered widget
 		 *
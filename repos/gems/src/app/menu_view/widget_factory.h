@@ -39,6 +39,11 @@ class Menu_view::Widget_factory
 		Style_database &styles;
 		Animator       &animator;
 
+		/*
+		 * Areas of the dialog to be redrawn
+		 */
+		Dirty_rect damage { };
+
 		Widget_factory(Allocator &alloc, Style_database &styles, Animator &animator)
 		:
 			alloc(alloc), styles(styles), animator(animator)
@@ -15,29 +15,36 @@
 #include <base/heap.h>
 #include <base/component.h>
 #include <base/attached_rom_dataspace.h>
+#include <base/attached_ram_dataspace.h>
+#include <timer_session/connection.h>
 #include <polygon_gfx/shaded_polygon_painter.h>
 #include <polygon_gfx/interpolate_rgb565.h>
 #include <polygon_gfx/textured_polygon_painter.h>
+#include <polygon_gfx/band_workers.h>
 #include <nano3d/dodecahedron_shape.h>
 #include <nano3d/cube_shape.h>
 #include <nano3d/scene.h>
 #include <nano3d/sqrt.h>
 
 
+/**
+ * Renderer of the animated shapes, independent from the output
+ */
 template <typename PT>
-class Scene : public Nano3d::Scene<PT>
+class Shape_renderer
 {
 	public:
 
 		enum Shape { SHAPE_DODECAHEDRON, SHAPE_CUBE };
 		enum Painter { PAINTER_SHADED, PAINTER_TEXTURED };
 
-	private:
-
-		Genode::Env  &_env;
-		Genode::Heap  _heap { _env.ram(), _env.rm() };
+		struct Stats
+		{
+			unsigned long polygons = 0;
+			unsigned long pixels   = 0;
+		};
 
-		Nitpicker::Area const _size;
+	private:
 
 		struct Radial_texture
 		{
@@ -77,47 +84,8 @@ class Scene : public Nano3d::Scene<PT>
 
 		Radial_texture _texture;
 
-		Shape   _shape   = SHAPE_DODECAHEDRON;
-		Painter _painter = PAINTER_TEXTURED;
-
-		Genode::Attached_rom_dataspace _config { _env, "config" };
-
-		void _handle_config()
-		{
-			_config.update();
-
-			try {
-				_shape = SHAPE_DODECAHEDRON;
-				if (_config.xml().attribute("shape").has_value("cube"))
-					_shape = SHAPE_CUBE;
-			} catch (...) { }
-
-			try {
-				_painter = PAINTER_TEXTURED;
-				if (_config.xml().attribute("painter").has_value("shaded"))
-					_painter = PAINTER_SHADED;
-			} catch (...) { }
-		}
-
-		Genode::Signal_handler<Scene> _config_handler;
-
-	public:
-
-		Scene(Genode::Env &env, unsigned update_rate_ms,
-		      Nitpicker::Point pos, Nitpicker::Area size)
-		:
-			Nano3d::Scene<PT>(env, update_rate_ms, pos, size),
-			_env(env), _size(size),
-			_config_handler(env.ep(), *this, &Scene::_handle_config)
-		{
-			_config.sigh(_config_handler);
-			_handle_config();
-		}
-
-	private:
-
-		Polygon::Shaded_painter   _shaded_painter   { _heap, _size.h() };
-		Polygon::Textured_painter _textured_painter { _heap, _size.h() };
+		Polygon::Shaded_painter   _shaded_painter;
+		Polygon::Textured_painter _textured_painter;
 
 		Nano3d::Cube_shape         const _cube         { 7000 };
 		Nano3d::Dodecahedron_shape const _dodecahedron { 10000 };
@@ -125,8 +93,8 @@ class Scene : public Nano3d::Scene<PT>
 		template <typename SHAPE>
 		void _render_shape(Genode::Surface<PT>                   &pixel,
 		                   Genode::Surface<Genode::Pixel_alpha8> &alpha,
-		                   SHAPE const &shape, unsigned frame,
-		                   bool backward_facing)
+		                   SHAPE const &shape, Painter painter, unsigned frame,
+		                   bool backward_facing, Stats &stats)
 		{
 			typedef Genode::Color Color;
 
@@ -138,7 +106,7 @@ class Scene : public Nano3d::Scene<PT>
 			vertices.project(1600, 800);
 			vertices.translate(200, 200, 0);
 
-			if (_painter == PAINTER_TEXTURED) {
+			if (painter == PAINTER_TEXTURED) {
 
 				typedef Polygon::Textured_painter::Point Textured_point;
 
@@ -166,12 +134,14 @@ class Scene : public Nano3d::Scene<PT>
 						point = Textured_point(vertex.x(), vertex.y(), u, v);
 					}
 
-					_textured_painter.paint(pixel, alpha, points, num_vertices,
-					                        _texture.texture);
+					stats.pixels += _textured_painter.paint(pixel, alpha,
+					                                        points, num_vertices,
+					                                        _texture.texture);
+					stats.polygons++;
 				});
 			}
 
-			if (_painter == PAINTER_SHADED) {
+			if (painter == PAINTER_SHADED) {
 
 				typedef Polygon::Shaded_painter::Point Shaded_point;
 
@@ -195,14 +165,102 @@ class Scene : public Nano3d::Scene<PT>
 						point = Shaded_point(v.x(), v.y(), color);
 					}
 
-					_shaded_painter.paint(pixel, alpha,
-					                      points, num_vertices);
+					stats.pixels += _shaded_painter.paint(pixel, alpha,
+					                                      points, num_vertices);
+					stats.polygons++;
 				});
 			}
 		}
 
 	public:
 
+		Shape_renderer(Genode::Allocator &alloc, unsigned max_height)
+		:
+			_shaded_painter(alloc, max_height),
+			_textured_painter(alloc, max_height)
+		{ }
+
+		/**
+		 * Paint large polygons using multiple threads
+		 */
+		void band_workers(Polygon::Band_workers &workers)
+		{
+			_shaded_painter  .band_workers(workers);
+			_textured_painter.band_workers(workers);
+		}
+
+		Stats render(Genode::Surface<PT>                   &pixel,
+		             Genode::Surface<Genode::Pixel_alpha8> &alpha,
+		             Shape shape, Painter painter, unsigned frame)
+		{
+			Stats stats;
+
+			if (shape == SHAPE_DODECAHEDRON) {
+
+				_render_shape(pixel, alpha, _dodecahedron, painter, frame, true,  stats);
+				_render_shape(pixel, alpha, _dodecahedron, painter, frame, false, stats);
+
+			} else if (shape == SHAPE_CUBE) {
+
+				_render_shape(pixel, alpha, _cube, painter, frame, true,  stats);
+				_render_shape(pixel, alpha, _cube, painter, frame, false, stats);
+			}
+			return stats;
+		}
+};
+
+
+template <typename PT>
+class Scene : public Nano3d::Scene<PT>
+{
+	private:
+
+		typedef Shape_renderer<PT> Renderer;
+
+		Genode::Env  &_env;
+		Genode::Heap  _heap { _env.ram(), _env.rm() };
+
+		Nitpicker::Area const _size;
+
+		typename Renderer::Shape   _shape   = Renderer::SHAPE_DODECAHEDRON;
+		typename Renderer::Painter _painter = Renderer::PAINTER_TEXTURED;
+
+		Genode::Attached_rom_dataspace _config { _env, "config" };
+
+		void _handle_config()
+		{
+			_config.update();
+
+			try {
+				_shape = Renderer::SHAPE_DODECAHEDRON;
+				if (_config.xml().attribute("shape").has_value("cube"))
+					_shape = Renderer::SHAPE_CUBE;
+			} catch (...) { }
+
+			try {
+				_painter = Renderer::PAINTER_TEXTURED;
+				if (_config.xml().attribute("painter").has_value("shaded"))
+					_painter = Renderer::PAINTER_SHADED;
+			} catch (...) { }
+		}
+
+		Genode::Signal_handler<Scene> _config_handler;
+
+		Renderer _renderer { _heap, _size.h() };
+
+	public:
+
+		Scene(Genode::Env &env, unsigned update_rate_ms,
+		      Nitpicker::Point pos, Nitpicker::Area size)
+		:
+			Nano3d::Scene<PT>(env, update_rate_ms, pos, size),
+			_env(env), _size(size),
+			_config_handler(env.ep(), *this, &Scene::_handle_config)
+		{
+			_config.sigh(_config_handler);
+			_handle_config();
+		}
+
 		/**
 		 * Scene interface
 		 */
@@ -211,16 +269,97 @@ class Scene : public Nano3d::Scene<PT>
 		{
 			unsigned const frame = (this->elapsed_ms()/10) % 1024;
 
-			if (_shape == SHAPE_DODECAHEDRON) {
+			_renderer.render(pixel, alpha, _shape, _painter, frame);
+		}
+};
 
-				_render_shape(pixel, alpha, _dodecahedron, frame, true);
-				_render_shape(pixel, alpha, _dodecahedron, frame, false);
 
-			} else if (_shape == SHAPE_CUBE) {
+/**
+ * Headless benchmark of the polygon painters
+ *
+ * The scene is rendered into a RAM buffer for a given number of frames
+ * for each combination of shape and painter.
+ */
+template <typename PT>
+class Benchmark
+{
+	private:
+
+		typedef Shape_renderer<PT> Renderer;
+
+		Genode::Env  &_env;
+		Genode::Heap  _heap { _env.ram(), _env.rm() };
+
+		Timer::Connection _timer { _env };
+
+		Genode::Surface_base::Area const _size { 400, 400 };
+
+		Genode::Attached_ram_dataspace _pixel_ds {
+			_env.ram(), _env.rm(), _size.count()*sizeof(PT) };
+
+		Genode::Attached_ram_dataspace _alpha_ds {
+			_env.ram(), _env.rm(), _size.count() };
+
+		Genode::Constructible<Polygon::Band_workers> _band_workers;
+
+		Renderer _renderer { _heap, _size.h() };
+
+		void _run(char const *shape_name,   typename Renderer::Shape   shape,
+		          char const *painter_name, typename Renderer::Painter painter,
+		          unsigned num_frames)
+		{
+			Genode::Surface<PT> pixel(_pixel_ds.local_addr<PT>(), _size);
+			Genode::Surface<Genode::Pixel_alpha8>
+				alpha(_alpha_ds.local_addr<Genode::Pixel_alpha8>(), _size);
+
+			typename Renderer::Stats total;
+
+			unsigned long const start_ms = _timer.elapsed_ms();
+
+			for (unsigned frame = 0; frame < num_frames; frame++) {
 
-				_render_shape(pixel, alpha, _cube, frame, true);
-				_render_shape(pixel, alpha, _cube, frame, false);
+				Genode::memset(_pixel_ds.local_addr<void>(), 0, _pixel_ds.size());
+				Genode::memset(_alpha_ds.local_addr<void>(), 0, _alpha_ds.size());
+
+				typename Renderer::Stats const stats =
+					_renderer.render(pixel, alpha, shape, painter, frame % 1024);
+
+				total.polygons += stats.polygons;
+				total.pixels   += stats.pixels;
 			}
+
+			unsigned long const ms = Genode::max(1UL, _timer.elapsed_ms() - start_ms);
+
+			Genode::log(shape_name, " ", painter_name, ": ",
+			            num_frames, " frames in ", ms, " ms, ",
+			            total.polygons*1000/ms, " polygons/s, ",
+			            total.pixels*1000/ms, " pixels/s");
+		}
+
+	public:
+
+		Benchmark(Genode::Env &env, Genode::Xml_node config) : _env(env)
+		{
+			unsigned const num_frames  = config.attribute_value("frames",  1000U);
+			unsigned const num_workers = config.attribute_value("workers", 1U);
+
+			if (num_workers > 1) {
+				_band_workers.construct(_env, num_workers);
+				_renderer.band_workers(*_band_workers);
+			}
+
+			Genode::log("--- nano3d benchmark started (", num_workers, " workers) ---");
+
+			_run("dodecahedron", Renderer::SHAPE_DODECAHEDRON,
+			     "shaded",       Renderer::PAINTER_SHADED, num_frames);
+			_run("dodecahedron", Renderer::SHAPE_DODECAHEDRON,
+			     "textured",     Renderer::PAINTER_TEXTURED, num_frames);
+			_run("cube",         Renderer::SHAPE_CUBE,
+			     "shaded",       Renderer::PAINTER_SHADED, num_frames);
+			_run("cube",         Renderer::SHAPE_CUBE,
+			     "textured",     Renderer::PAINTER_TEXTURED, num_frames);
+
+			Genode::log("--- nano3d benchmark finished ---");
 		}
 };
 
@@ -229,6 +368,17 @@ void Component::construct(Genode::Env &env)
 {
 	enum { UPDATE_RATE_MS = 20 };
 
+	/* run headless benchmark if configured */
+	{
+		Genode::Attached_rom_dataspace config(env, "config");
+
+		if (config.xml().has_sub_node("benchmark")) {
+			static Benchmark<Genode::Pixel_rgb565>
+				benchmark(env, config.xml().sub_node("benchmark"));
+			return;
+		}
+	}
+
 	static Scene<Genode::Pixel_rgb565>
 		scene(env, UPDATE_RATE_MS,
 		      Nitpicker::Point(-200, -200), Nitpicker::Area(400, 400));
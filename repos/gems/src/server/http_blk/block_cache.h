@@ -0,0 +1,115 @@
+/*
+ * \brief  In-memory cache of remote blocks
+ * \author agent
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _BLOCK_CACHE_H_
+#define _BLOCK_CACHE_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <block_session/block_session.h>
+#include <util/string.h>
+
+class Block_cache
+{
+	typedef Genode::size_t  size_t;
+	typedef Block::sector_t sector_t;
+
+	private:
+
+		Genode::Allocator &_alloc;
+
+		size_t   const _block_size;
+		unsigned const _num_entries;
+
+		enum : sector_t { INVALID = ~(sector_t)0 };
+
+		/*
+		 * The cache is direct mapped, the entry of a block is determined by
+		 * its block number modulo the number of entries. Hence, consecutive
+		 * blocks never evict each other.
+		 */
+		sector_t *_tags = nullptr;
+		char     *_data = nullptr;
+
+		char *_entry(sector_t block_nr) {
+			return _data + (block_nr % _num_entries)*_block_size; }
+
+		bool _cached(sector_t block_nr) const {
+			return _tags[block_nr % _num_entries] == block_nr; }
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param cache_size  size of cached data in bytes, a size smaller
+		 *                    than one block disables the cache
+		 */
+		Block_cache(Genode::Allocator &alloc, size_t block_size,
+		            size_t cache_size)
+		:
+			_alloc(alloc), _block_size(block_size),
+			_num_entries(block_size ? cache_size / block_size : 0)
+		{
+			if (!_num_entries)
+				return;
+
+			_tags = (sector_t *)_alloc.alloc(_num_entries*sizeof(sector_t));
+			_data = (char *)_alloc.alloc(_num_entries*_block_size);
+
+			for (unsigned i = 0; i < _num_entries; i++)
+				_tags[i] = INVALID;
+		}
+
+		~Block_cache()
+		{
+			if (!_num_entries)
+				return;
+
+			_alloc.free(_tags, _num_entries*sizeof(sector_t));
+			_alloc.free(_data, _num_entries*_block_size);
+		}
+
+		/**
+		 * Copy blocks from the cache
+		 *
+		 * \return  true if all requested blocks were cached
+		 */
+		bool lookup(sector_t block_nr, size_t count, char *dst)
+		{
+			if (!_num_entries || count > _num_entries)
+				return false;
+
+			for (size_t i = 0; i < count; i++)
+				if (!_cached(block_nr + i))
+					return false;
+
+			for (size_t i = 0; i < count; i++, dst += _block_size)
+				Genode::memcpy(dst, _entry(block_nr + i), _block_size);
+
+			return true;
+		}
+
+		void insert(sector_t block_nr, size_t count, char const *src)
+		{
+			if (!_num_entries)
+				return;
+
+			for (size_t i = 0; i < count; i++, src += _block_size) {
+				Genode::memcpy(_entry(block_nr + i), src, _block_size);
+				_tags[(block_nr + i) % _num_entries] = block_nr + i;
+			}
+		}
+};
+
+#endif /* _BLOCK_CACHE_H_ */
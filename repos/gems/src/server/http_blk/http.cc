@@ -34,6 +34,10 @@ enum {
 
 	/* Size of our local buffer */
 	HTTP_BUF = 2048,
+
+	/* Size of buffers for received data and pipelined requests */
+	RX_BUF = 16*1024,
+	TX_BUF = 8*1024,
 };
 
 /* Tokenizer policy */
@@ -52,6 +56,7 @@ void Http::cmd_head()
 {
 	const char *http_templ = "%s %s HTTP/1.1\r\n"
 	                         "Host: %s\r\n"
+	                         "Connection: keep-alive\r\n"
 	                         "\r\n";
 
 	int length = snprintf(_http_buf, HTTP_BUF, http_templ, "HEAD", _path, _host);
@@ -78,7 +83,23 @@ void Http::connect()
 }
 
 
-void Http::reconnect(){ close(_fd); connect(); }
+void Http::reopen()
+{
+	close(_fd);
+
+	/* drop data received via the old connection */
+	_rx_pos = _rx_len = 0;
+	_close  = false;
+
+	connect();
+}
+
+
+void Http::reconnect()
+{
+	_tx_len = 0;
+	reopen();
+}
 
 
 void Http::resolve_uri()
@@ -94,13 +115,29 @@ void Http::resolve_uri()
 }
 
 
+void Http::fill_rx_buf()
+{
+	if (_rx_pos < _rx_len)
+		return;
+
+	ssize_t const len = read(_fd, _rx_buf, RX_BUF);
+	if (len <= 0)
+		throw Http::Socket_closed();
+
+	_rx_pos = 0;
+	_rx_len = len;
+}
+
+
 Genode::size_t Http::read_header()
 {
 	bool header = true; size_t i = 0;
 
 	while (header) {
-		if (!read(_fd, &_http_buf[i], 1))
-			throw Http::Socket_closed();
+
+		/* take the header from the receive buffer instead of reading bytewise */
+		fill_rx_buf();
+		_http_buf[i] = _rx_buf[_rx_pos++];
 
 		if (i >= 3 && _http_buf[i - 3] == '\r' && _http_buf[i - 2] == '\n'
 		 && _http_buf[i - 1] == '\r' && _http_buf[i - 0] == '\n')
@@ -131,14 +168,13 @@ Genode::size_t Http::read_header()
 }
 
 
-void Http::get_capacity()
+bool Http::header_field(size_t header_len, char const *key,
+                        char *value, size_t value_len)
 {
-	cmd_head();
-	size_t  len = read_header();
 	char buf[32];
-	Http_token t(_http_buf, len);
+	Http_token t(_http_buf, header_len);
 
-	bool key = false;
+	bool found = false;
 	while (t) {
 
 		if (t.type() != Http_token::IDENT) {
@@ -146,32 +182,52 @@ void Http::get_capacity()
 			continue;
 		}
 
-		if (key) {
-			ascii_to(t.start(), _size);
-			break;
+		if (found) {
+			t.string(value, value_len);
+			return true;
 		}
 
 		t.string(buf, 32);
 
-		if (!Genode::strcmp(buf, "Content-Length", 32))
-			key = true;
+		if (!Genode::strcmp(buf, key, 32))
+			found = true;
 
 		t = t.next();
 	}
+	return false;
 }
 
 
-void Http::do_read(void * buf, size_t size)
+void Http::get_capacity()
+{
+	cmd_head();
+	size_t len = read_header();
+	char buf[32];
+
+	if (header_field(len, "Content-Length", buf, sizeof(buf)))
+		ascii_to(buf, _size);
+}
+
+
+void Http::read_body(void * buf, size_t size)
 {
 	size_t buf_fill = 0;
 
+	/* consume data already received along with the header */
+	if (_rx_pos < _rx_len) {
+		buf_fill = min(size, _rx_len - _rx_pos);
+		Genode::memcpy(buf, _rx_buf + _rx_pos, buf_fill);
+		_rx_pos += buf_fill;
+	}
+
+	/* read the remaining data directly into the destination buffer */
 	while (buf_fill < size) {
 
 		int part;
 		if ((part = read(_fd, (void *)((addr_t)buf + buf_fill),
 		                      size - buf_fill)) <= 0) {
 			error("could not read data (", errno, ")");
-			throw Http::Socket_error();
+			throw Http::Socket_closed();
 		}
 
 		buf_fill += part;
@@ -180,9 +236,12 @@ void Http::do_read(void * buf, size_t size)
 
 
 Http::Http(Genode::Heap &heap, ::String &uri)
-: _heap(heap), _port((char *)"80")
+: _heap(heap), _port((char *)"80"), _close(false),
+  _rx_pos(0), _rx_len(0), _tx_len(0), _body_len(0), _body_len_known(false)
 {
 	_heap.alloc(HTTP_BUF, (void**)&_http_buf);
+	_heap.alloc(RX_BUF,   (void**)&_rx_buf);
+	_heap.alloc(TX_BUF,   (void**)&_tx_buf);
 
 	/* parse URI */
 	parse_uri(uri);
@@ -203,6 +262,8 @@ Http::~Http()
 	_heap.free(_host, Genode::strlen(_host) + 1);
 	_heap.free(_path, Genode::strlen(_path) + 2);
 	_heap.free(_http_buf, HTTP_BUF);
+	_heap.free(_rx_buf,   RX_BUF);
+	_heap.free(_tx_buf,   TX_BUF);
 	_heap.free(_info, sizeof(struct addrinfo));
 }
 
@@ -239,40 +300,81 @@ void Http::parse_uri(::String & u)
 }
 
 
-void Http::cmd_get(size_t file_offset, size_t size, addr_t buffer)
+void Http::queue_get(size_t file_offset, size_t size)
 {
-	while (true) {
+	const char *http_templ = "GET %s HTTP/1.1\r\n"
+	                         "Host: %s\r\n"
+	                         "Connection: keep-alive\r\n"
+	                         "Range: bytes=%lu-%lu\r\n"
+	                         "\r\n";
 
-		const char *http_templ = "GET %s HTTP/1.1\r\n"
-		                         "Host: %s\r\n"
-		                         "Range: bytes=%lu-%lu\r\n"
-		                         "\r\n";
+	int length = snprintf(_http_buf, HTTP_BUF, http_templ, _path, _host,
+	                      file_offset, file_offset + size - 1);
 
-		int length = snprintf(_http_buf, HTTP_BUF, http_templ, _path, _host,
-		                      file_offset, file_offset + size - 1);
+	if (_tx_len + length > TX_BUF)
+		flush_requests();
 
-		if (write(_fd, _http_buf, length) < 0) {
+	Genode::memcpy(_tx_buf + _tx_len, _http_buf, length);
+	_tx_len += length;
+}
 
-			if (errno == ESHUTDOWN)
-				reconnect();
 
-			if (write(_fd, _http_buf, length) < 0)
-				throw Http::Socket_error();
-		}
+void Http::flush_requests()
+{
+	/* keep queued requests when re-establishing the connection */
+	if (_close)
+		reopen();
 
-		try {
-			read_header();
-		} catch (Http::Socket_closed) {
-			reconnect();
-			continue;
-		}
+	size_t const length = _tx_len;
+	_tx_len = 0;
 
-		if (_http_ret != HTTP_SUCC_PARTIAL) {
-			error("cmd_get: server returned ", _http_ret);
-			throw Http::Server_error();
-		}
+	/* send all pipelined requests at once */
+	for (size_t sent = 0; sent < length; ) {
 
-		do_read((void *)(buffer), size);
-		return;
+		ssize_t const part = write(_fd, _tx_buf + sent, length - sent);
+		if (part <= 0)
+			throw Http::Socket_closed();
+
+		sent += part;
+	}
+}
+
+
+void Http::read_response()
+{
+	/* server closed the connection after the previous response */
+	if (_close)
+		throw Http::Socket_closed();
+
+	size_t const len = read_header();
+
+	char buf[32];
+	_close = header_field(len, "Connection", buf, sizeof(buf))
+	      && !Genode::strcmp(buf, "close", 5);
+
+	_body_len       = 0;
+	_body_len_known = header_field(len, "Content-Length", buf, sizeof(buf));
+	if (_body_len_known)
+		ascii_to(buf, _body_len);
+
+	if (_http_ret != HTTP_SUCC_PARTIAL) {
+		error("read_response: server returned ", _http_ret);
+		throw Http::Server_error();
+	}
+}
+
+
+bool Http::skip_body()
+{
+	if (!_body_len_known || _close)
+		return false;
+
+	while (_body_len) {
+		fill_rx_buf();
+
+		size_t const n = min(_body_len, _rx_len - _rx_pos);
+		_rx_pos   += n;
+		_body_len -= n;
 	}
+	return true;
 }
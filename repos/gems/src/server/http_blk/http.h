@@ -34,10 +34,21 @@ class Http
 		char            *_path;      /* absolute file path on host */
 		char            *_http_buf;  /* internal data buffer */
 		unsigned         _http_ret;  /* HTTP status code */
+		bool             _close;     /* server closes connection after response */
 		struct addrinfo *_info;      /* Resolved address info for host */
 		int              _fd;        /* Socket file handle */
 		addr_t          _base_addr; /* Address of I/O dataspace */
 
+		char            *_rx_buf;    /* received data not consumed yet */
+		size_t           _rx_pos;    /* read position within '_rx_buf' */
+		size_t           _rx_len;    /* number of valid bytes in '_rx_buf' */
+
+		char            *_tx_buf;    /* pipelined requests not sent yet */
+		size_t           _tx_len;    /* number of bytes in '_tx_buf' */
+
+		size_t           _body_len;       /* body length of current response */
+		bool             _body_len_known; /* response has 'Content-Length' */
+
 		/*
 		 * Send 'HEAD' command
 		 */
@@ -49,9 +60,9 @@ class Http
 		void connect();
 
 		/*
-		 * Re-connect to host
+		 * Re-establish connection to host, keeping queued requests
 		 */
-		void reconnect();
+		void reopen();
 
 		/*
 		 * Set URI of remote file
@@ -63,20 +74,26 @@ class Http
 		 */
 		void resolve_uri();
 
+		/*
+		 * Receive data into '_rx_buf' if all received data was consumed
+		 */
+		void fill_rx_buf();
+
 		/*
 		 * Read HTTP header and parse server-status code
 		 */
 		size_t read_header();
 
 		/*
-		 * Determine remote-file size
+		 * Look up value of header field, copied into 'value'
 		 */
-		void get_capacity();
+		bool header_field(size_t header_len, char const *key,
+		                  char *value, size_t value_len);
 
 		/*
-		 * Read 'size' bytes into buffer
+		 * Determine remote-file size
 		 */
-		void do_read(void * buf, size_t size);
+		void get_capacity();
 
 	public:
 
@@ -105,13 +122,69 @@ class Http
 		void  base_addr(addr_t base_addr) { _base_addr = base_addr; }
 
 		/**
-		 * Send 'GET' command
+		 * Re-connect to host
+		 *
+		 * Requests and responses not processed yet are discarded.
+		 */
+		void reconnect();
+
+		/**
+		 * Queue 'GET' command
 		 *
 		 * \param file_offset  Read from offset of remote file
-		 * \param size         Number of byts to transfer
-		 * \param buffer       address in I/O dataspace
+		 * \param size         Number of bytes to transfer
+		 *
+		 * The requests are sent by 'flush_requests'. The server answers
+		 * pipelined requests in order. Each response must be consumed via
+		 * 'read_response' and 'read_body' before sending new requests.
+		 *
+		 * \throw Socket_closed
+		 */
+		void queue_get(size_t file_offset, size_t size);
+
+		/**
+		 * Send queued requests
+		 *
+		 * If the server closed the connection after the last response, the
+		 * connection is re-established before.
+		 *
+		 * \throw Socket_closed
+		 */
+		void flush_requests();
+
+		/**
+		 * Read header of the next response
+		 *
+		 * \throw Socket_closed  server closed the connection, the remaining
+		 *                       requests must be sent again after 'reconnect'
+		 * \throw Server_error   server did not return the requested range
+		 */
+		void read_response();
+
+		/**
+		 * Discard the body of the current response
+		 *
+		 * This way, the responses to subsequent pipelined requests can be
+		 * read after a 'Server_error'.
+		 *
+		 * \return  false if the length of the body is unknown, in which
+		 *          case the connection must be re-established
+		 * \throw   Socket_closed
+		 */
+		bool skip_body();
+
+		/**
+		 * Return true if the server announced to close the connection
+		 * after the current response
+		 */
+		bool close_announced() const { return _close; }
+
+		/**
+		 * Read 'size' bytes of the body of the current response
+		 *
+		 * \throw Socket_closed
 		 */
-		void cmd_get(size_t file_offset, size_t size, addr_t buffer);
+		void read_body(void *buf, size_t size);
 
 		/* Exceptions */
 		class Exception     : public ::Genode::Exception { };
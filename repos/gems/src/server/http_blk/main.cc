@@ -19,6 +19,7 @@
 #include <libc/component.h>
 
 /* local includes */
+#include "block_cache.h"
 #include "http.h"
 
 using namespace Genode;
@@ -27,15 +28,158 @@ class Driver : public Block::Driver
 {
 	private:
 
-		size_t _block_size;
-		Http   _http;
+		enum {
+			/* maximum number of requests processed as one batch */
+			MAX_REQUESTS = 16,
+
+			/* attempts to complete a batch if the server closes connections */
+			MAX_ATTEMPTS = 3,
+		};
+
+		struct Request
+		{
+			Block::sector_t          block_nr;
+			size_t                   count;
+			char                    *buffer;
+			Block::Packet_descriptor packet;
+		};
+
+		/*
+		 * Adjacent requests of a batch, fetched via a single 'GET'
+		 */
+		struct Range
+		{
+			Block::sector_t block_nr;
+			size_t          count;
+			unsigned        first;     /* index of first request */
+			unsigned        num;       /* number of requests */
+			bool            complete;
+		};
+
+		size_t      _block_size;
+		Http        _http;
+		Block_cache _cache;
+
+		Request  _pending[MAX_REQUESTS];
+		unsigned _num_pending = 0;
+
+		Signal_handler<Driver> _request_handler;
+
+		/*
+		 * Requests are not issued from within 'read' but collected until
+		 * the session component has passed all submitted packets. This way,
+		 * all requests of a batch are sent to the server at once and
+		 * requests for adjacent blocks are coalesced.
+		 */
+		void _handle_requests()
+		{
+			Request  batch[MAX_REQUESTS];
+			unsigned const num = _num_pending;
+
+			for (unsigned i = 0; i < num; i++)
+				batch[i] = _pending[i];
+
+			_num_pending = 0;
+
+			Range    ranges[MAX_REQUESTS];
+			unsigned num_ranges = 0;
+
+			for (unsigned i = 0; i < num; i++) {
+
+				Request const &r = batch[i];
+
+				if (num_ranges) {
+					Range &last = ranges[num_ranges - 1];
+					if (last.block_nr + last.count == r.block_nr) {
+						last.count += r.count;
+						last.num++;
+						continue;
+					}
+				}
+
+				ranges[num_ranges++] = { r.block_nr, r.count, i, 1, false };
+			}
+
+			/*
+			 * Only a connection closed without progress counts as failed
+			 * attempt. An error response fails its range only.
+			 */
+			struct Resend { };
+
+			unsigned done = 0;
+			for (unsigned attempt = 0; done < num_ranges; ) {
+
+				unsigned const first = done;
+
+				try {
+					for (unsigned i = done; i < num_ranges; i++)
+						_http.queue_get(ranges[i].block_nr*_block_size,
+						                ranges[i].count*_block_size);
+
+					_http.flush_requests();
+
+					for (; done < num_ranges; done++) {
+
+						Range &range = ranges[done];
+
+						try { _http.read_response(); }
+						catch (Http::Server_error) {
+							error("could not read blocks ", range.block_nr,
+							      "-", range.block_nr + range.count - 1);
+
+							if (_http.skip_body())
+								continue;
+
+							/* the connection state is undefined */
+							done++;
+							throw Resend();
+						}
+
+						for (unsigned i = range.first; i < range.first + range.num; i++) {
+							Request const &r = batch[i];
+							_http.read_body(r.buffer, r.count*_block_size);
+							_cache.insert(r.block_nr, r.count, r.buffer);
+						}
+
+						range.complete = true;
+					}
+				}
+				catch (Resend) {
+					/* send requests without response again */
+					try { _http.reconnect(); }
+					catch (Http::Exception) { break; }
+				}
+				catch (Http::Socket_closed) {
+
+					/*
+					 * A close announced by the server, e.g., because of a
+					 * limit of requests per connection, is no failure
+					 */
+					if (done > first || _http.close_announced())
+						attempt = 0;
+					else if (++attempt == MAX_ATTEMPTS)
+						break;
+
+					try { _http.reconnect(); }
+					catch (Http::Exception) { break; }
+				}
+				catch (Http::Exception) { break; }
+			}
+
+			for (unsigned i = 0; i < num_ranges; i++)
+				for (unsigned j = ranges[i].first;
+				     j < ranges[i].first + ranges[i].num; j++)
+					ack_packet(batch[j].packet, ranges[i].complete);
+		}
 
 	public:
 
-		Driver(Heap &heap, Ram_session &ram,
-		       size_t block_size, ::String &uri)
+		Driver(Entrypoint &ep, Heap &heap, Ram_session &ram,
+		       size_t block_size, size_t cache_size, ::String &uri)
 		: Block::Driver(ram),
-		  _block_size(block_size), _http(heap, uri) {}
+		  _block_size(block_size), _http(heap, uri),
+		  _cache(heap, block_size, cache_size),
+		  _request_handler(ep, *this, &Driver::_handle_requests) {}
 
 
 		/*******************************
@@ -57,9 +201,18 @@ class Driver : public Block::Driver
 		          char                     *buffer,
 		          Block::Packet_descriptor &packet)
 		{
-			_http.cmd_get(block_nr * _block_size, block_count * _block_size,
-			              (addr_t)buffer);
-			ack_packet(packet);
+			if (_cache.lookup(block_nr, block_count, buffer)) {
+				ack_packet(packet);
+				return;
+			}
+
+			if (_num_pending == MAX_REQUESTS)
+				throw Request_congestion();
+
+			if (_num_pending == 0)
+				Signal_transmitter(_request_handler).submit();
+
+			_pending[_num_pending++] = { block_nr, block_count, buffer, packet };
 		}
 	};
 
@@ -73,11 +226,12 @@ class Factory : public Block::Driver_factory
 		Attached_rom_dataspace _config { _env, "config" };
 		::String               _uri;
 		size_t                 _blk_sz;
+		Number_of_bytes        _cache_sz;
 
 	public:
 
 		Factory(Env &env, Heap &heap)
-		: _env(env), _heap(heap), _blk_sz(512)
+		: _env(env), _heap(heap), _blk_sz(512), _cache_sz(0)
 		{
 			try {
 				_config.xml().attribute("uri").value(&_uri);
@@ -85,12 +239,18 @@ class Factory : public Block::Driver_factory
 			}
 			catch (...) { }
 
+			_cache_sz = _config.xml().attribute_value("cache_size", _cache_sz);
+
 			log("Using file=", _uri, " as device with block size ",
 			    Hex(_blk_sz, Hex::OMIT_PREFIX), ".");
+
+			if (_cache_sz)
+				log("Caching ", _cache_sz, " of remote blocks");
 		}
 
 		Block::Driver *create() {
-			return new (&_heap) Driver(_heap, _env.ram(), _blk_sz, _uri); }
+			return new (&_heap) Driver(_env.ep(), _heap, _env.ram(), _blk_sz,
+			                           _cache_sz, _uri); }
 
 	void destroy(Block::Driver *driver) {
 		Genode::destroy(&_heap, driver); }
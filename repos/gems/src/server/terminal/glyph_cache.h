@@ -0,0 +1,149 @@
+/*
+ * \brief  Cache of pre-rendered character cells
+ * \author agent
+ * \date   2026-10-19
+ *
+ * Rendering a glyph involves blending each pixel between the foreground and
+ * background color. Because a terminal typically uses only a few color
+ * combinations, the blended cells are kept per character and color pair.
+ * Drawing a cached cell boils down to copying one row of pixels per line.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _GLYPH_CACHE_H_
+#define _GLYPH_CACHE_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <util/color.h>
+#include <util/string.h>
+#include <nitpicker_gfx/text_painter.h>
+
+namespace Terminal { template <typename> class Glyph_cache; }
+
+
+template <typename PT>
+class Terminal::Glyph_cache
+{
+	public:
+
+		typedef Text_painter::Font Font;
+
+		/**
+		 * Function used to render a cell into the cache
+		 *
+		 * The arguments correspond to the 'draw_glyph' function.
+		 */
+		typedef void (*Render_fn)(Genode::Color, Genode::Color,
+		                          unsigned char const *, unsigned,
+		                          unsigned, unsigned, unsigned, PT *, unsigned);
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Glyph_cache(Glyph_cache const &);
+		Glyph_cache &operator = (Glyph_cache const &);
+
+		enum { NUM_SLOTS = 512 };
+
+		struct Key
+		{
+			Genode::uint32_t fg = 0, bg = 0;
+			unsigned         ascii = 0;
+			bool             valid = false;
+
+			bool operator == (Key const &other) const {
+				return valid == other.valid && ascii == other.ascii
+				    && fg    == other.fg    && bg    == other.bg; }
+		};
+
+		Genode::Allocator &_alloc;
+		Font        const &_font;
+		Render_fn   const  _render;
+
+		unsigned const _cell_w;
+		unsigned const _cell_h;
+		Genode::size_t const _slot_size = _cell_w*_cell_h*sizeof(PT);
+
+		Key  _keys[NUM_SLOTS];
+		PT  *_pixels = (PT *)_alloc.alloc(_slot_size*NUM_SLOTS);
+
+		static Genode::uint32_t _rgb(Genode::Color c) {
+			return (c.r << 16) | (c.g << 8) | c.b; }
+
+		static unsigned _slot(Key const &key)
+		{
+			Genode::uint32_t h = key.ascii*0x9e3779b1u;
+			h ^= key.fg*0x85ebca6bu;
+			h ^= key.bg*0xc2b2ae35u;
+			return (h ^ (h >> 15)) % NUM_SLOTS;
+		}
+
+		/*
+		 * Statistics
+		 */
+		unsigned long _hits = 0, _misses = 0;
+
+	public:
+
+		Glyph_cache(Genode::Allocator &alloc, Font const &font, Render_fn render,
+		            unsigned cell_w, unsigned cell_h)
+		:
+			_alloc(alloc), _font(font), _render(render),
+			_cell_w(cell_w), _cell_h(cell_h)
+		{ }
+
+		~Glyph_cache() { _alloc.free(_pixels, _slot_size*NUM_SLOTS); }
+
+		/**
+		 * Return pixels of the rendered cell
+		 *
+		 * The returned buffer has a line width of 'cell_w' pixels.
+		 */
+		PT const *cell(unsigned char ascii, Genode::Color fg, Genode::Color bg)
+		{
+			Key key;
+			key.fg = _rgb(fg); key.bg = _rgb(bg); key.ascii = ascii; key.valid = true;
+
+			unsigned const slot   = _slot(key);
+			PT     * const pixels = _pixels + slot*_cell_w*_cell_h;
+
+			if (_keys[slot] == key) {
+				_hits++;
+				return pixels;
+			}
+
+			_misses++;
+
+			_render(fg, bg, _font.img + _font.otab[ascii], _font.wtab[ascii],
+			        (unsigned)_font.img_w, _cell_h, _cell_w, pixels, _cell_w);
+
+			_keys[slot] = key;
+			return pixels;
+		}
+
+		/**
+		 * Copy cached cell to the framebuffer
+		 */
+		void draw(unsigned char ascii, Genode::Color fg, Genode::Color bg,
+		          PT *dst, unsigned dst_line_w)
+		{
+			PT const *src = cell(ascii, fg, bg);
+
+			for (unsigned y = 0; y < _cell_h; y++, src += _cell_w, dst += dst_line_w)
+				Genode::memcpy(dst, src, _cell_w*sizeof(PT));
+		}
+
+		unsigned long hits()   const { return _hits; }
+		unsigned long misses() const { return _misses; }
+};
+
+#endif /* _GLYPH_CACHE_H_ */
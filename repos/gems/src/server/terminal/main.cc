@@ -36,6 +36,9 @@
 /* nitpicker graphic back end */
 #include <nitpicker_gfx/text_painter.h>
 
+/* local includes */
+#include <glyph_cache.h>
+
 namespace Terminal {
 	using namespace Genode;
 	struct Main;
@@ -174,62 +177,147 @@ inline void draw_glyph(Color                fg_color,
 }
 
 
+/**
+ * Area of the framebuffer touched by 'update_pixels'
+ */
+struct Damage
+{
+	unsigned x1 = ~0U, y1 = ~0U, x2 = 0, y2 = 0;
+
+	void add(unsigned x, unsigned y, unsigned w, unsigned h)
+	{
+		x1 = Genode::min(x1, x);     y1 = Genode::min(y1, y);
+		x2 = Genode::max(x2, x + w); y2 = Genode::max(y2, y + h);
+	}
+
+	bool valid() const { return x1 < x2 && y1 < y2; }
+};
+
+
+/**
+ * Move rendered lines according to the scroll operations of the cell array
+ *
+ * \return false if the line movements cannot be expressed as blit operations
+ */
 template <typename PT>
-static void convert_char_array_to_pixels(Cell_array<Char_cell> *cell_array,
-                                         PT                    *fb_base,
-                                         unsigned               fb_width,
-                                         unsigned               fb_height,
-                                         Font_family const     &font_family)
+static bool scroll_pixels(Cell_array<Char_cell> &cell_array,
+                          PT *fb_base, unsigned fb_width,
+                          unsigned num_lines, unsigned line_height,
+                          Damage &damage)
+{
+	/*
+	 * Scrolling retains the order of the moved lines. Under this condition,
+	 * moving lines upwards in ascending order and lines downwards in
+	 * descending order never overwrites a source line before it is copied.
+	 */
+	int last_origin = -1;
+	for (unsigned line = 0; line < num_lines; line++) {
+		int const origin = cell_array.line_state(line).origin;
+		if (origin < 0)
+			continue;
+		if (origin <= last_origin || origin >= (int)num_lines)
+			return false;
+		last_origin = origin;
+	}
+
+	Genode::size_t const line_bytes = fb_width*line_height*sizeof(PT);
+
+	auto move_line = [&] (unsigned line) {
+		int const origin = cell_array.line_state(line).origin;
+		Genode::memmove(fb_base + fb_width*line_height*line,
+		                fb_base + fb_width*line_height*origin, line_bytes);
+		damage.add(0, line*line_height, fb_width, line_height);
+	};
+
+	for (unsigned line = 0; line < num_lines; line++)
+		if (cell_array.line_state(line).origin > (int)line)
+			move_line(line);
+
+	for (unsigned line = num_lines; line-- > 0; )
+		if (cell_array.line_state(line).origin >= 0
+		 && cell_array.line_state(line).origin < (int)line)
+			move_line(line);
+
+	return true;
+}
+
+
+/**
+ * Bring the pixels up to date with the cell array
+ *
+ * Only lines that are not available as rendered pixels and cells that changed
+ * are drawn. All lines are marked as clean afterwards.
+ */
+template <typename PT>
+static Damage update_pixels(Cell_array<Char_cell>     &cell_array,
+                            PT                        *fb_base,
+                            unsigned                   fb_width,
+                            unsigned                   fb_height,
+                            Terminal::Glyph_cache<PT> &glyph_cache,
+                            Font_family const         &font_family)
 {
 	Font const &regular_font = *font_family.font(Font_face::REGULAR);
-	unsigned glyph_height = regular_font.img_h,
-	         glyph_step_x = regular_font.wtab['m'];
+	unsigned const glyph_height = regular_font.img_h,
+	               glyph_step_x = regular_font.wtab['m'];
 
-	unsigned y = 0;
-	for (unsigned line = 0; line < cell_array->num_lines(); line++) {
+	unsigned const num_lines = Genode::min(cell_array.num_lines(),
+	                                       fb_height / glyph_height);
+	unsigned const num_cols  = Genode::min(cell_array.num_cols(),
+	                                       fb_width / glyph_step_x);
+	Damage damage;
 
-		if (cell_array->line_dirty(line)) {
+	bool const scrolled = scroll_pixels(cell_array, fb_base, fb_width,
+	                                    num_lines, glyph_height, damage);
 
-			if (verbose)
-				Genode::log("convert line ", line);
+	for (unsigned line = 0; line < num_lines; line++) {
 
-			unsigned x = 0;
-			for (unsigned column = 0; column < cell_array->num_cols(); column++) {
+		Cell_array<Char_cell>::Line_state const state = cell_array.line_state(line);
 
-				Char_cell      cell  = cell_array->get_cell(column, line);
-				Font const    *font  = font_family.font(cell.font_face());
-				unsigned char  ascii = cell.ascii;
+		cell_array.mark_line_as_clean(line);
 
-				if (ascii == 0)
-					ascii = ' ';
+		unsigned first = state.dirty_first, last = state.dirty_last;
 
-				unsigned char const *glyph_base  = font->img + font->otab[ascii];
+		/* redraw the whole line if its pixels are not available */
+		if (state.origin < 0 || !scrolled) {
+			first = 0;
+			last  = num_cols - 1;
+		}
 
-				unsigned glyph_width = regular_font.wtab[ascii];
+		if (first > last)
+			continue;
 
-				if (x + glyph_width > fb_width)	break;
+		if (verbose)
+			Genode::log("convert line ", line, " columns ", first, "..", last);
 
-				Color fg_color = foreground_color(cell);
-				Color bg_color = background_color(cell);
+		last = Genode::min(last, num_cols - 1);
 
-				if (cell.has_cursor()) {
-					fg_color = Color( 63,  63,  63);
-					bg_color = Color(255, 255, 255);
-				}
+		PT * const line_base = fb_base + fb_width*glyph_height*line;
+
+		for (unsigned column = first; column <= last; column++) {
+
+			Char_cell     cell  = cell_array.get_cell(column, line);
+			unsigned char ascii = cell.ascii;
+
+			if (ascii == 0)
+				ascii = ' ';
 
-				draw_glyph<PT>(fg_color, bg_color,
-				               glyph_base, glyph_width,
-				               (unsigned)font->img_w, (unsigned)font->img_h,
-				               glyph_step_x, fb_base + x, fb_width);
+			Color fg_color = foreground_color(cell);
+			Color bg_color = background_color(cell);
 
-				x += glyph_step_x;
+			if (cell.has_cursor()) {
+				fg_color = Color( 63,  63,  63);
+				bg_color = Color(255, 255, 255);
 			}
+
+			glyph_cache.draw(ascii, fg_color, bg_color,
+			                 line_base + column*glyph_step_x, fb_width);
 		}
-		y       += glyph_height;
-		fb_base += fb_width*glyph_height;
 
-		if (y + glyph_height > fb_height) break;
+		damage.add(first*glyph_step_x, line*glyph_height,
+		           (last - first + 1)*glyph_step_x, glyph_height);
 	}
+
+	return damage;
 }
 
 
@@ -306,6 +394,8 @@ namespace Terminal {
 
 			Font_family const               &_font_family;
 
+			Glyph_cache<Pixel_rgb565>        _glyph_cache;
+
 			/**
 			 * Initialize framebuffer-related attributes
 			 */
@@ -353,7 +443,10 @@ namespace Terminal {
 				_char_cell_array_character_screen(_char_cell_array),
 				_decoder(_char_cell_array_character_screen),
 
-				_font_family(font_family)
+				_font_family(font_family),
+				_glyph_cache(alloc, *font_family.font(Font_face::REGULAR),
+				             draw_glyph<Pixel_rgb565>,
+				             font_family.cell_width(), font_family.cell_height())
 			{
 				using namespace Genode;
 
@@ -376,30 +469,17 @@ namespace Terminal {
 			{
 				Genode::Lock::Guard guard(_lock);
 
-				convert_char_array_to_pixels<Pixel_rgb565>(&_char_cell_array,
-				                                           (Pixel_rgb565 *)_fb_addr,
-				                                           _fb_mode.width(),
-				                                           _fb_mode.height(),
-				                                           _font_family);
-
-				
-				int first_dirty_line =  10000,
-				    last_dirty_line  = -10000;
-
-				for (int line = 0; line < (int)_char_cell_array.num_lines(); line++) {
-					if (!_char_cell_array.line_dirty(line)) continue;
-
-					first_dirty_line = Genode::min(line, first_dirty_line);
-					last_dirty_line  = Genode::max(line, last_dirty_line);
-
-					_char_cell_array.mark_line_as_clean(line);
-				}
-
-				int num_dirty_lines = last_dirty_line - first_dirty_line + 1;
-				if (num_dirty_lines > 0)
-					_framebuffer.refresh(0, first_dirty_line*_char_height,
-					                     _fb_mode.width(),
-					                     num_dirty_lines*_char_height);
+				Damage const damage =
+					update_pixels<Pixel_rgb565>(_char_cell_array,
+					                            (Pixel_rgb565 *)_fb_addr,
+					                            _fb_mode.width(),
+					                            _fb_mode.height(),
+					                            _glyph_cache,
+					                            _font_family);
+				if (damage.valid())
+					_framebuffer.refresh(damage.x1, damage.y1,
+					                     damage.x2 - damage.x1,
+					                     damage.y2 - damage.y1);
 			}
 
 
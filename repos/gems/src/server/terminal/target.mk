@@ -2,3 +2,4 @@ TARGET  = terminal
 SRC_CC  = main.cc
 LIBS    = base
 SRC_BIN = $(notdir $(wildcard $(PRG_DIR)/*.tff))
+INC_DIR += $(PRG_DIR)
@@ -0,0 +1,184 @@
+/*
+ * \brief  Read throughput of a block device backed by http_blk
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The device is read sequentially twice, which shows the effect of the
+ * block cache of http_blk on the second run, followed by reads of random
+ * blocks.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <block_session/connection.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+class Benchmark
+{
+	private:
+
+		enum { TX_BUFFER = 1024*1024 };
+
+		enum Run { SEQUENTIAL, SEQUENTIAL_CACHED, RANDOM, DONE };
+
+		Env &_env;
+
+		Attached_rom_dataspace _config { _env, "config" };
+
+		Heap              _heap    { _env.ram(), _env.rm() };
+		Allocator_avl     _alloc   { &_heap };
+		Block::Connection _session { _env, &_alloc, TX_BUFFER };
+		Timer::Connection _timer   { _env };
+
+		Signal_handler<Benchmark> _ack_handler {
+			_env.ep(), *this, &Benchmark::_handle_ack };
+
+		Signal_handler<Benchmark> _submit_handler {
+			_env.ep(), *this, &Benchmark::_submit };
+
+		Block::sector_t _blk_count = 0;
+		size_t          _blk_size  = 0;
+
+		/* number of blocks per request */
+		size_t const _count;
+
+		/* number of requests of the random run */
+		unsigned long const _random_requests;
+
+		Run             _run       = SEQUENTIAL;
+		unsigned long   _submitted = 0;
+		unsigned long   _acked     = 0;
+		unsigned long   _start_ms  = 0;
+		Block::sector_t _current   = 0;
+		unsigned        _seed      = 1;
+
+		unsigned long _requests() const
+		{
+			return _run == RANDOM ? _random_requests
+			                      : (unsigned long)(_blk_count / _count);
+		}
+
+		/* linear congruential generator, reproducible across runs */
+		Block::sector_t _random_block()
+		{
+			_seed = _seed*1103515245 + 12345;
+			return (_seed >> 8) % (_blk_count - _count + 1);
+		}
+
+		void _start_run()
+		{
+			_submitted = _acked = 0;
+			_current   = 0;
+			_start_ms  = _timer.elapsed_ms();
+			_submit();
+		}
+
+		void _finish_run()
+		{
+			static char const *name[] = { "sequential", "sequential (cached)",
+			                              "random" };
+
+			unsigned long const ms    = max(_timer.elapsed_ms() - _start_ms, 1UL);
+			unsigned long const bytes = _acked*_count*_blk_size;
+
+			log(name[_run], ": ", bytes/1024, " KiB in ", ms, " ms (",
+			    (bytes*1000/ms)/(1024*1024), ".",
+			    ((bytes*1000/ms)%(1024*1024))*100/(1024*1024), " MiB/s)");
+
+			_run = (Run)(_run + 1);
+
+			if (_run == DONE) {
+				log("--- http_blk benchmark finished ---");
+				return;
+			}
+
+			_start_run();
+		}
+
+		void _submit()
+		{
+			if (_run == DONE)
+				return;
+
+			try {
+				while (_submitted < _requests()
+				    && _session.tx()->ready_to_submit()) {
+
+					Block::sector_t const block_nr =
+						_run == RANDOM ? _random_block() : _current;
+
+					Block::Packet_descriptor p(
+						_session.tx()->alloc_packet(_count*_blk_size),
+						Block::Packet_descriptor::READ, block_nr, _count);
+
+					_session.tx()->submit_packet(p);
+
+					_current += _count;
+					_submitted++;
+				}
+			} catch (Block::Session::Tx::Source::Packet_alloc_failed) { }
+		}
+
+		void _handle_ack()
+		{
+			while (_session.tx()->ack_avail()) {
+
+				Block::Packet_descriptor p = _session.tx()->get_acked_packet();
+				if (!p.succeeded())
+					error("packet error: block: ", p.block_number(), " "
+					      "count: ", p.block_count());
+
+				_session.tx()->release_packet(p);
+				_acked++;
+			}
+
+			if (_acked == _requests()) {
+				_finish_run();
+				return;
+			}
+
+			_submit();
+		}
+
+	public:
+
+		Benchmark(Env &env)
+		:
+			_env(env),
+			_count(_config.xml().attribute_value("request_blocks", 8UL)),
+			_random_requests(_config.xml().attribute_value("random_requests", 1024UL))
+		{
+			_session.tx_channel()->sigh_ack_avail(_ack_handler);
+			_session.tx_channel()->sigh_ready_to_submit(_submit_handler);
+
+			Block::Session::Operations ops;
+			_session.info(&_blk_count, &_blk_size, &ops);
+
+			log("block count ", _blk_count, " size ", _blk_size, ", ",
+			    _count, " blocks per request");
+
+			if (_blk_count < _count || _count*_blk_size > TX_BUFFER/2) {
+				error("invalid request size");
+				return;
+			}
+
+			_start_run();
+		}
+};
+
+
+void Component::construct(Env &env) { static Benchmark benchmark(env); }
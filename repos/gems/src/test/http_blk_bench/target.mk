@@ -0,0 +1,3 @@
+TARGET = test-http_blk_bench
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,111 @@
+/*
+ * \brief  Benchmark for the incremental redraw of the menu view
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The benchmark replays a stream of dialog updates that resemble the typical
+ * use of a menu, i.e., moving the hover state from one button to the next and
+ * occasionally changing a label. The menu view, configured with
+ * 'redraw_stats="yes"', logs the number of pixels painted per redraw.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/attached_rom_dataspace.h>
+#include <os/reporter.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+	using namespace Genode;
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _num_buttons =
+		_config.xml().attribute_value("buttons", 16U);
+
+	unsigned const _num_updates =
+		_config.xml().attribute_value("updates", 200U);
+
+	unsigned long const _period_ms =
+		_config.xml().attribute_value("period_ms", 50UL);
+
+	Timer::Connection _timer { _env };
+
+	Reporter _dialog_reporter { _env, "dialog" };
+
+	unsigned _update = 0;
+
+	void _generate_dialog()
+	{
+		unsigned const hovered  = _update % _num_buttons;
+		unsigned const selected = (_update / _num_buttons) % _num_buttons;
+
+		Reporter::Xml_generator xml(_dialog_reporter, [&] () {
+			xml.node("frame", [&] () {
+				xml.node("vbox", [&] () {
+					for (unsigned i = 0; i < _num_buttons; i++) {
+						xml.node("button", [&] () {
+							xml.attribute("name", i);
+
+							if (i == hovered)  xml.attribute("hovered",  "yes");
+							if (i == selected) xml.attribute("selected", "yes");
+
+							xml.node("label", [&] () {
+
+								/* change the text of the selected button */
+								String<32> const text("Item ", i, i == selected
+								                      ? " (selected)" : "");
+								xml.attribute("text", text);
+							});
+						});
+					}
+				});
+			});
+		});
+	}
+
+	void _handle_timeout()
+	{
+		if (_update == _num_updates) {
+			log("--- menu_view benchmark finished ---");
+			return;
+		}
+
+		_generate_dialog();
+		_update++;
+
+		_timer.trigger_once(_period_ms*1000);
+	}
+
+	Signal_handler<Main> _timeout_handler {
+		_env.ep(), *this, &Main::_handle_timeout };
+
+	Main(Env &env) : _env(env)
+	{
+		_dialog_reporter.enabled(true);
+
+		log("--- menu_view benchmark started (", _num_buttons, " buttons, ",
+		    _num_updates, " updates) ---");
+
+		_timer.sigh(_timeout_handler);
+		_timer.trigger_once(_period_ms*1000);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-menu_view_bench
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,100 @@
+/*
+ * \brief  Terminal output-throughput benchmark
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The benchmark writes colored lines to the terminal as fast as the session
+ * accepts them, which lets the terminal scroll continuously. Because the
+ * terminal renders on the same entrypoint that serves the write requests,
+ * the achieved character rate reflects the rendering cost.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/attached_rom_dataspace.h>
+#include <terminal_session/connection.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+	using namespace Genode;
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection    _timer    { _env };
+	Terminal::Connection _terminal { _env };
+
+	char _line[256];
+
+	/**
+	 * Fill line buffer with the n-th line of output
+	 *
+	 * \return length of the line
+	 */
+	size_t _generate_line(unsigned long n, size_t columns)
+	{
+		size_t len = 0;
+		auto append = [&] (char c) { if (len < sizeof(_line)) _line[len++] = c; };
+
+		/* switch the foreground color every few lines */
+		append(27); append('['); append('3'); append('0' + n % 8); append('m');
+
+		for (size_t i = 0; i < columns; i++)
+			append(32 + (n + i) % 95);
+
+		append(27); append('['); append('0'); append('m');
+		append('\r'); append('\n');
+		return len;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		Xml_node const config = _config.xml();
+
+		unsigned long const duration_ms =
+			config.attribute_value("duration_ms", 10000UL);
+		size_t const columns =
+			min(config.attribute_value("columns", 78UL), sizeof(_line) - 16);
+
+		log("--- terminal benchmark started ---");
+
+		unsigned long const start_ms = _timer.elapsed_ms();
+		unsigned long       chars    = 0, lines = 0;
+
+		while (_timer.elapsed_ms() - start_ms < duration_ms) {
+
+			/* check the time only every few lines to keep the overhead low */
+			for (unsigned i = 0; i < 64; i++, lines++) {
+				size_t const len = _generate_line(lines, columns);
+
+				for (size_t written = 0; written < len; )
+					written += _terminal.write(_line + written, len - written);
+
+				chars += columns;
+			}
+		}
+
+		unsigned long const ms = max(1UL, _timer.elapsed_ms() - start_ms);
+
+		log(lines, " lines, ", chars, " characters in ", ms, " ms, ",
+		    chars*1000 / ms, " chars/s");
+		log("--- terminal benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -18,6 +18,7 @@
 #include <util/list.h>
 
 #include <netdb.h>
+#include <spawn.h>
 #include <sys/select.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
@@ -55,6 +56,7 @@ namespace Libc {
 			virtual bool supports_mkdir(const char *path, mode_t mode);
 			virtual bool supports_open(const char *pathname, int flags);
 			virtual bool supports_pipe();
+			virtual bool supports_posix_spawn(char const *path);
 			virtual bool supports_readlink(const char *path, char *buf, ::size_t bufsiz);
 			virtual bool supports_rename(const char *oldpath, const char *newpath);
 			virtual bool supports_rmdir(const char *path);
@@ -115,6 +117,16 @@ namespace Libc {
 			virtual int msync(void *addr, ::size_t len, int flags);
 			virtual File_descriptor *open(const char *pathname, int flags);
 			virtual int pipe(File_descriptor *pipefd[2]);
+
+			/**
+			 * Create new process from executable
+			 *
+			 * \return 0 on success, or error number
+			 */
+			virtual int posix_spawn(pid_t *pid, char const *path,
+			                        posix_spawn_file_actions_t const *file_actions,
+			                        posix_spawnattr_t const *attr,
+			                        char *const argv[], char *const envp[]);
 			virtual ssize_t read(File_descriptor *, void *buf, ::size_t count);
 			virtual ssize_t readlink(const char *path, char *buf, ::size_t bufsiz);
 			virtual ssize_t recv(File_descriptor *, void *buf, ::size_t len, int flags);
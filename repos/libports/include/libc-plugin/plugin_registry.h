@@ -35,6 +35,7 @@ struct Libc::Plugin_registry : List<Plugin>
 	Plugin *get_plugin_for_mkdir(const char *path, mode_t mode);
 	Plugin *get_plugin_for_open(const char *pathname, int flags);
 	Plugin *get_plugin_for_pipe();
+	Plugin *get_plugin_for_posix_spawn(char const *path);
 	Plugin *get_plugin_for_readlink(const char *path, char *buf, ::size_t bufsiz);
 	Plugin *get_plugin_for_rename(const char *oldpath, const char *newpath);
 	Plugin *get_plugin_for_rmdir(const char *path);
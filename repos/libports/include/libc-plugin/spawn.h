@@ -0,0 +1,57 @@
+/*
+ * \brief  Representation of 'posix_spawn' attributes and file actions
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The types are opaque to applications but visible to libc plugins that
+ * implement 'posix_spawn' natively.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIBC_PLUGIN__SPAWN_H_
+#define _LIBC_PLUGIN__SPAWN_H_
+
+/* libc includes */
+#include <sched.h>
+#include <signal.h>
+#include <spawn.h>
+
+
+struct __posix_spawnattr
+{
+	short              flags;
+	pid_t              pgroup;
+	struct sched_param schedparam;
+	int                schedpolicy;
+	sigset_t           sigdefault;
+	sigset_t           sigmask;
+};
+
+
+struct __posix_spawn_file_actions
+{
+	enum { MAX_ACTIONS = 16 };
+
+	struct Action
+	{
+		enum Type { OPEN, DUP2, CLOSE };
+
+		Type   type;
+		int    fd;      /* descriptor to open, duplicate, or close */
+		int    new_fd;  /* target descriptor of 'DUP2' */
+		char  *path;    /* path of 'OPEN', owned by the action */
+		int    oflag;
+		mode_t mode;
+	};
+
+	Action   action[MAX_ACTIONS];
+	unsigned num;
+};
+
+#endif /* _LIBC_PLUGIN__SPAWN_H_ */
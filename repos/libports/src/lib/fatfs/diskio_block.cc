@@ -56,16 +56,518 @@ extern "C" {
 	void block_init(Genode::Env &env, Genode::Allocator &alloc) {
 		_platform.construct(env, alloc); }
 
+	/**
+	 * Block connection with a write-back sector cache
+	 *
+	 * Requests smaller than a cache line, i.e., file-system meta data and
+	 * partial sectors of files, are served from a set-associative cache.
+	 * Dirty sectors are written back on eviction and on sync.
+	 *
+	 * Larger requests, i.e., whole clusters, bypass the cache. They are
+	 * split into multiple requests submitted at once. Writes are not
+	 * awaited but acknowledged lazily, write errors are reported by the
+	 * next write or sync.
+	 *
+	 * The drive also keeps the free-cluster bitmap consulted by the
+	 * cluster allocator of ff.c (see 'free_cluster_map.patch').
+	 */
 	struct Drive : Block::Connection
 	{
-		Block::sector_t block_count;
-		Genode::size_t  block_size;
+		typedef Block::sector_t sector_t;
+
+		enum {
+			TX_BUF_SIZE   = 512*1024,
+			LINE_SIZE     = 4096,
+			CACHE_SIZE    = 512*1024,
+			WAYS          = 4,
+			MAX_PACKET    = 64*1024,
+			MAX_IN_FLIGHT = 32,
+		};
+
+		struct Line
+		{
+			sector_t      nr;      /* first sector */
+			unsigned      valid;   /* bit mask of valid sectors */
+			unsigned      dirty;   /* bit mask of modified sectors */
+			unsigned long used;    /* LRU time stamp */
+			char         *data;
+		};
+
+		/*
+		 * Sector range of a write request not acknowledged yet
+		 */
+		struct Write
+		{
+			bool     used;
+			sector_t nr;
+			size_t   count;
+		};
+
+		Genode::Allocator &alloc;
+
+		sector_t                   block_count;
+		Genode::size_t             block_size;
 		Block::Session::Operations ops;
 
+		unsigned line_sectors = 1;
+		unsigned num_sets     = 0;
+		Line    *lines        = nullptr;
+		char    *line_data    = nullptr;
+		char    *fill_buf     = nullptr;  /* line read from device */
+
+		unsigned long lru_clock = 0;
+
+		Write    writes[MAX_IN_FLIGHT];
+		unsigned num_writes  = 0;
+		bool     write_error = false;
+
+		/*
+		 * Bitmap of clusters known to be in use
+		 *
+		 * The bitmap is a hint only. It starts empty and learns about used
+		 * clusters from the FAT updates and from candidates rejected by
+		 * ff.c, which checks each candidate against the FAT and falls back
+		 * to scanning the FAT if no candidate is left.
+		 */
+		Genode::uint32_t *used_map         = nullptr;
+		DWORD             used_map_entries = 0;
+
 		Drive(Platform &platform, char const *label)
-		: Block::Connection(platform.env, &platform.tx_alloc, 128*1024, label)
+		: Block::Connection(platform.env, &platform.tx_alloc, TX_BUF_SIZE, label),
+		  alloc(platform.alloc)
 		{
 			info(&block_count, &block_size, &ops);
+
+			line_sectors = Genode::max((size_t)1, LINE_SIZE / block_size);
+			num_sets     = Genode::max((size_t)1, CACHE_SIZE / (line_size()*WAYS));
+
+			lines     = (Line *)alloc.alloc(num_lines()*sizeof(Line));
+			line_data = (char *)alloc.alloc(num_lines()*line_size());
+			fill_buf  = (char *)alloc.alloc(line_size());
+
+			for (unsigned i = 0; i < num_lines(); i++)
+				lines[i] = Line { ~(sector_t)0, 0, 0, 0, line_data + i*line_size() };
+
+			for (unsigned i = 0; i < MAX_IN_FLIGHT; i++)
+				writes[i].used = false;
+		}
+
+		~Drive()
+		{
+			flush();
+			alloc.free(lines,     num_lines()*sizeof(Line));
+			alloc.free(line_data, num_lines()*line_size());
+			alloc.free(fill_buf,  line_size());
+			if (used_map)
+				alloc.free(used_map, used_map_size(used_map_entries));
+		}
+
+		unsigned num_lines() const { return num_sets*WAYS; }
+		size_t   line_size() const { return line_sectors*block_size; }
+
+		/* number of sectors of a line, the last line may be incomplete */
+		unsigned sectors_of(sector_t nr) const {
+			return Genode::min((sector_t)line_sectors, block_count - nr); }
+
+		static unsigned mask(unsigned first, unsigned count) {
+			return (count >= 32 ? ~0U : ((1U << count) - 1)) << first; }
+
+		/***************************
+		 ** Free-cluster bitmap **
+		 ***************************/
+
+		static size_t used_map_size(DWORD entries) {
+			return ((entries + 31) / 32)*sizeof(Genode::uint32_t); }
+
+		/**
+		 * Return true if the bitmap covers the given number of FAT entries
+		 */
+		bool used_map_for(DWORD entries)
+		{
+			if (used_map && used_map_entries == entries)
+				return true;
+
+			if (used_map)
+				alloc.free(used_map, used_map_size(used_map_entries));
+
+			used_map         = nullptr;
+			used_map_entries = 0;
+
+			/* called from C code of ff.c, which must not see exceptions */
+			try {
+				if (!alloc.alloc(used_map_size(entries), &used_map))
+					return false;
+			}
+			catch (Out_of_ram)  { return false; }
+			catch (Out_of_caps) { return false; }
+
+			Genode::memset(used_map, 0, used_map_size(entries));
+			used_map_entries = entries;
+			return true;
+		}
+
+		void mark_cluster(DWORD entries, DWORD clst, bool used)
+		{
+			if (clst < 2 || clst >= entries || !used_map_for(entries))
+				return;
+
+			Genode::uint32_t const bit = 1U << (clst % 32);
+			if (used) used_map[clst / 32] |=  bit;
+			else      used_map[clst / 32] &= ~bit;
+		}
+
+		/**
+		 * Return next cluster after 'scl' not known to be in use, or 0
+		 */
+		DWORD free_cluster(DWORD entries, DWORD scl)
+		{
+			if (entries <= 2 || !used_map_for(entries))
+				return 0;
+
+			DWORD const words = (entries + 31) / 32;
+			DWORD const start = (scl + 1 >= 2 && scl + 1 < entries) ? scl + 1 : 2;
+
+			/* the first word is visited twice to cover its bits below 'start' */
+			for (DWORD i = 0; i <= words; i++) {
+				DWORD const w = (start / 32 + i) % words;
+				if (used_map[w] == ~0U)
+					continue;
+
+				for (unsigned b = 0; b < 32; b++) {
+					DWORD const clst = w*32 + b;
+					if (i == 0 && clst < start)  continue;
+					if (clst < 2 || clst >= entries) continue;
+					if (!(used_map[w] & (1U << b)))
+						return clst;
+				}
+			}
+			return 0;
+		}
+
+		/********************
+		 ** Packet helpers **
+		 ********************/
+
+		void complete_write(Block::Packet_descriptor p)
+		{
+			for (unsigned i = 0; i < MAX_IN_FLIGHT; i++) {
+				if (!writes[i].used || writes[i].nr != p.block_number())
+					continue;
+				writes[i].used = false;
+				break;
+			}
+			num_writes--;
+
+			if (!p.succeeded()) {
+				Genode::error("write failed at sector ", p.block_number(),
+				              ", count ", p.block_count());
+				write_error = true;
+			}
+
+			tx()->release_packet(p);
+		}
+
+		/**
+		 * Wait for the next acknowledgement of a write request
+		 */
+		void collect_write() { complete_write(tx()->get_acked_packet()); }
+
+		void drain()
+		{
+			while (num_writes)
+				collect_write();
+		}
+
+		/**
+		 * Wait for writes overlapping the given sector range
+		 */
+		void drain(sector_t nr, size_t count)
+		{
+			for (unsigned i = 0; i < MAX_IN_FLIGHT; i++) {
+				if (!writes[i].used)
+					continue;
+
+				if (writes[i].nr < nr + count && nr < writes[i].nr + writes[i].count) {
+					drain();
+					return;
+				}
+			}
+		}
+
+		Block::Packet_descriptor alloc_packet(size_t size)
+		{
+			for (;;) {
+				try { return tx()->alloc_packet(size); }
+				catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+					if (!num_writes)
+						throw;
+					collect_write();
+				}
+			}
+		}
+
+		/**
+		 * Submit write request without waiting for its acknowledgement
+		 */
+		void submit_write(sector_t nr, size_t count, char const *src)
+		{
+			if (num_writes == MAX_IN_FLIGHT || !tx()->ready_to_submit())
+				collect_write();
+
+			drain(nr, count);
+
+			Block::Packet_descriptor p(alloc_packet(count*block_size),
+			                           Block::Packet_descriptor::WRITE, nr, count);
+
+			Genode::memcpy(tx()->packet_content(p), src, count*block_size);
+
+			for (unsigned i = 0; i < MAX_IN_FLIGHT; i++) {
+				if (writes[i].used)
+					continue;
+				writes[i] = Write { true, nr, count };
+				break;
+			}
+			num_writes++;
+
+			tx()->submit_packet(p);
+		}
+
+		/**
+		 * Read sectors from the device via requests submitted at once
+		 *
+		 * The data is copied from the packet buffer because 'disk_read'
+		 * must fill the buffer passed by FatFs, i.e., the buffer of the
+		 * 'f_read' caller.
+		 */
+		bool read_device(sector_t nr, size_t count, char *dst)
+		{
+			drain(nr, count);
+
+			size_t const max_count = MAX_PACKET / block_size;
+
+			bool     ok        = true;
+			unsigned submitted = 0;
+
+			for (size_t done = 0; done < count || submitted; ) {
+
+				/* submit as many requests as possible */
+				if (done < count && tx()->ready_to_submit()) {
+					size_t const n = Genode::min(count - done, max_count);
+					try {
+						Block::Packet_descriptor p(tx()->alloc_packet(n*block_size),
+						                           Block::Packet_descriptor::READ,
+						                           nr + done, n);
+						tx()->submit_packet(p);
+						submitted++;
+						done += n;
+						continue;
+					}
+					catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+						if (!submitted && !num_writes)
+							throw;
+					}
+				}
+
+				Block::Packet_descriptor p = tx()->get_acked_packet();
+
+				/* writes not overlapping the range may still be in flight */
+				if (p.operation() == Block::Packet_descriptor::WRITE) {
+					complete_write(p);
+					continue;
+				}
+
+				submitted--;
+
+				size_t const len = p.block_count()*block_size;
+				if (p.succeeded() && p.size() >= len)
+					Genode::memcpy(dst + (p.block_number() - nr)*block_size,
+					               tx()->packet_content(p), len);
+				else
+					ok = false;
+
+				tx()->release_packet(p);
+			}
+			return ok;
+		}
+
+		/*****************
+		 ** Cache lines **
+		 *****************/
+
+		Line *lookup(sector_t nr)
+		{
+			Line *set = &lines[(nr / line_sectors) % num_sets * WAYS];
+
+			for (unsigned i = 0; i < WAYS; i++)
+				if (set[i].nr == nr) {
+					set[i].used = ++lru_clock;
+					return &set[i];
+				}
+
+			return nullptr;
+		}
+
+		void write_back(Line &line)
+		{
+			unsigned const n = sectors_of(line.nr);
+
+			/* write contiguous runs of dirty sectors */
+			for (unsigned i = 0; i < n; ) {
+				if (!(line.dirty & mask(i, 1))) { i++; continue; }
+
+				unsigned j = i;
+				while (j < n && (line.dirty & mask(j, 1))) j++;
+
+				submit_write(line.nr + i, j - i, line.data + i*block_size);
+				i = j;
+			}
+			line.dirty = 0;
+		}
+
+		/**
+		 * Return line for sector range, evict least-recently used line
+		 */
+		Line &line(sector_t nr)
+		{
+			if (Line *line = lookup(nr))
+				return *line;
+
+			Line *set    = &lines[(nr / line_sectors) % num_sets * WAYS];
+			Line *victim = &set[0];
+			for (unsigned i = 1; i < WAYS; i++)
+				if (set[i].used < victim->used)
+					victim = &set[i];
+
+			if (victim->dirty)
+				write_back(*victim);
+
+			*victim = Line { nr, 0, 0, ++lru_clock, victim->data };
+			return *victim;
+		}
+
+		/**
+		 * Call 'fn' for each part of a sector range within a cache line
+		 *
+		 * \param fn  functor taking the arguments 'sector_t line_nr,
+		 *            unsigned first, unsigned count, size_t offset'
+		 */
+		template <typename FN>
+		void for_each_line(sector_t nr, size_t count, FN const &fn)
+		{
+			for (size_t done = 0; done < count; ) {
+				sector_t const line_nr = (nr + done) - (nr + done) % line_sectors;
+				unsigned const first   = (nr + done) - line_nr;
+				unsigned const n       = Genode::min((size_t)(line_sectors - first),
+				                                     count - done);
+				fn(line_nr, first, n, done*block_size);
+				done += n;
+			}
+		}
+
+		bool cached(size_t count) const { return count == 1 || count < line_sectors; }
+
+		/***************
+		 ** Interface **
+		 ***************/
+
+		bool read(sector_t nr, size_t count, char *dst)
+		{
+			if (!cached(count)) {
+				if (!read_device(nr, count, dst))
+					return false;
+
+				/* the cache may hold sectors not written back yet */
+				for_each_line(nr, count, [&] (sector_t line_nr, unsigned first,
+				                              unsigned n, size_t offset) {
+					Line *line = lookup(line_nr);
+					if (!line) return;
+					for (unsigned i = first; i < first + n; i++)
+						if (line->dirty & mask(i, 1))
+							Genode::memcpy(dst + offset + (i - first)*block_size,
+							               line->data + i*block_size, block_size);
+				});
+				return true;
+			}
+
+			bool ok = true;
+			for_each_line(nr, count, [&] (sector_t line_nr, unsigned first,
+			                              unsigned n, size_t offset) {
+				Line &l = line(line_nr);
+
+				unsigned const needed = mask(first, n);
+				if ((l.valid & needed) != needed) {
+
+					/* fetch whole line, keeping sectors already cached */
+					unsigned const all = sectors_of(line_nr);
+					if (!read_device(line_nr, all, fill_buf)) {
+						ok = false;
+						return;
+					}
+					for (unsigned i = 0; i < all; i++)
+						if (!(l.valid & mask(i, 1)))
+							Genode::memcpy(l.data + i*block_size,
+							               fill_buf + i*block_size, block_size);
+					l.valid = mask(0, all);
+				}
+
+				Genode::memcpy(dst + offset, l.data + first*block_size, n*block_size);
+			});
+			return ok;
+		}
+
+		bool write(sector_t nr, size_t count, char const *src)
+		{
+			if (write_error) {
+				write_error = false;
+				return false;
+			}
+
+			if (!cached(count)) {
+
+				/* drop cached sectors superseded by the write */
+				for_each_line(nr, count, [&] (sector_t line_nr, unsigned first,
+				                              unsigned n, size_t) {
+					if (Line *line = lookup(line_nr)) {
+						line->valid &= ~mask(first, n);
+						line->dirty &= ~mask(first, n);
+					}
+				});
+
+				size_t const max_count = MAX_PACKET / block_size;
+				for (size_t done = 0; done < count; ) {
+					size_t const n = Genode::min(count - done, max_count);
+					submit_write(nr + done, n, src + done*block_size);
+					done += n;
+				}
+				return true;
+			}
+
+			for_each_line(nr, count, [&] (sector_t line_nr, unsigned first,
+			                              unsigned n, size_t offset) {
+				Line &l = line(line_nr);
+				Genode::memcpy(l.data + first*block_size, src + offset, n*block_size);
+				l.valid |= mask(first, n);
+				l.dirty |= mask(first, n);
+			});
+			return true;
+		}
+
+		/**
+		 * Write back cached sectors and wait for all writes
+		 *
+		 * \return  false if a write failed since the last flush
+		 */
+		bool flush()
+		{
+			for (unsigned i = 0; i < num_lines(); i++)
+				if (lines[i].dirty)
+					write_back(lines[i]);
+
+			drain();
+
+			bool const ok = !write_error;
+			write_error = false;
+			return ok;
 		}
 	};
 }
@@ -130,25 +632,12 @@ extern "C" DRESULT disk_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count)
 
 	Drive &drive = *_platform->drives[pdrv];
 
-	Genode::size_t const op_len = drive.block_size*count;
-
-	/* allocate packet-descriptor for reading */
-	Block::Packet_descriptor p(drive.tx()->alloc_packet(op_len),
-	                           Block::Packet_descriptor::READ, sector, count);
-	drive.tx()->submit_packet(p);
-	p = drive.tx()->get_acked_packet();
-
-	DRESULT res;
-	if (p.succeeded() && p.size() >= op_len) {
-		Genode::memcpy(buff, drive.tx()->packet_content(p), op_len);
-		res = RES_OK;
-	} else {
+	if (!drive.read(sector, count, (char *)buff)) {
 		Genode::error(__func__, " failed at sector ", sector, ", count ", count);
-		res = RES_ERROR;
+		return RES_ERROR;
 	}
 
-	drive.tx()->release_packet(p);
-	return res;
+	return RES_OK;
 }
 
 
@@ -160,29 +649,32 @@ extern "C" DRESULT disk_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT c
 
 	Drive &drive = *_platform->drives[pdrv];
 
-	Genode::size_t const op_len = drive.block_size*count;
+	if (!drive.write(sector, count, (char const *)buff)) {
+		Genode::error(__func__, " failed at sector ", sector, ", count ", count);
+		return RES_ERROR;
+	}
 
-	/* allocate packet-descriptor for writing */
-	Block::Packet_descriptor p(drive.tx()->alloc_packet(op_len),
-	                           Block::Packet_descriptor::WRITE, sector, count);
+	return RES_OK;
+}
+#endif /* _READONLY */
 
-	Genode::memcpy(drive.tx()->packet_content(p), buff, op_len);
 
-	drive.tx()->submit_packet(p);
-	p = drive.tx()->get_acked_packet();
+extern "C" DWORD ff_free_cluster (BYTE pdrv, DWORD n_fatent, DWORD scl)
+{
+	if (pdrv >= Platform::MAX_DEV_NUM || !_platform->drives[pdrv])
+		return 0;
+
+	return _platform->drives[pdrv]->free_cluster(n_fatent, scl);
+}
 
-	DRESULT res;
-	if (p.succeeded()) {
-		res = RES_OK;
-	} else {
-		Genode::error(__func__, " failed at sector ", sector, ", count ", count);
-		res = RES_ERROR;
-	}
 
-	drive.tx()->release_packet(p);
-	return res;
+extern "C" void ff_mark_cluster (BYTE pdrv, DWORD n_fatent, DWORD clst, int used)
+{
+	if (pdrv >= Platform::MAX_DEV_NUM || !_platform->drives[pdrv])
+		return;
+
+	_platform->drives[pdrv]->mark_cluster(n_fatent, clst, used);
 }
-#endif /* _READONLY */
 
 
 extern "C" DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff)
@@ -194,6 +686,8 @@ extern "C" DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff)
 
 	switch (cmd) {
 	case CTRL_SYNC:
+		if (!drive.flush())
+			return RES_ERROR;
 		drive.sync();
 		return RES_OK;
 
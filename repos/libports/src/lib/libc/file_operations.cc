@@ -38,6 +38,7 @@
 #include "libc_mem_alloc.h"
 #include "libc_mmap_registry.h"
 #include "libc_errno.h"
+#include "libc_spawn.h"
 
 using namespace Libc;
 
@@ -302,6 +303,39 @@ extern "C" int execve(char const *filename, char *const argv[],
 }
 
 
+extern char **environ;
+
+
+extern "C" int posix_spawn(pid_t *pid, char const *path,
+                           posix_spawn_file_actions_t const *file_actions,
+                           posix_spawnattr_t const *attr,
+                           char *const argv[], char *const envp[])
+{
+	if (!envp)
+		envp = environ;
+
+	Absolute_path resolved_path;
+	try {
+		resolve_symlinks(path, resolved_path);
+	} catch (Symlink_resolve_error) {
+		return errno;
+	}
+
+	/*
+	 * A plugin may create the new process directly from the executable,
+	 * which spares the duplication of the calling process by 'vfork'.
+	 */
+	Plugin *plugin =
+		plugin_registry()->get_plugin_for_posix_spawn(resolved_path.base());
+
+	if (plugin)
+		return plugin->posix_spawn(pid, resolved_path.base(), file_actions,
+		                           attr, argv, envp);
+
+	return Libc::spawn_via_vfork(pid, path, file_actions, attr, argv, envp);
+}
+
+
 extern "C" int fchdir(int libc_fd)
 {
 	File_descriptor *fd = libc_fd_to_fd(libc_fd, "fchdir");
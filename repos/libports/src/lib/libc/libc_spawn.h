@@ -0,0 +1,35 @@
+/*
+ * \brief  Generic implementation of 'posix_spawn'
+ * \author agent
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIBC_SPAWN_H_
+#define _LIBC_SPAWN_H_
+
+/* libc includes */
+#include <spawn.h>
+
+namespace Libc {
+
+	/**
+	 * Create process via 'vfork' and 'execve'
+	 *
+	 * Used if no plugin implements 'posix_spawn' natively.
+	 *
+	 * \return 0 on success, or error number
+	 */
+	int spawn_via_vfork(pid_t *pid, char const *path,
+	                    posix_spawn_file_actions_t const *file_actions,
+	                    posix_spawnattr_t const *attr,
+	                    char *const argv[], char *const envp[]);
+}
+
+#endif /* _LIBC_SPAWN_H_ */
@@ -19,6 +19,9 @@
 #include <libc-plugin/plugin_registry.h>
 #include <libc-plugin/plugin.h>
 
+/* libc includes */
+#include <errno.h>
+
 using namespace Genode;
 using namespace Libc;
 
@@ -73,6 +76,12 @@ bool Plugin::supports_pipe()
 }
 
 
+bool Plugin::supports_posix_spawn(char const *)
+{
+	return false;
+}
+
+
 bool Plugin::supports_readlink(const char *path, char *buf, ::size_t bufsiz)
 {
 	return false;
@@ -189,6 +198,8 @@ DUMMY(void *, (void *)(-1), mmap, (void *addr, ::size_t length, int prot, int fl
 DUMMY(int, -1, munmap,       (void *, ::size_t));
 DUMMY(int, -1, msync,        (void *addr, ::size_t len, int flags));
 DUMMY(int, -1, pipe,         (File_descriptor*[2]));
+DUMMY(int, ENOSYS, posix_spawn, (pid_t *, char const *, posix_spawn_file_actions_t const *,
+                                 posix_spawnattr_t const *, char *const[], char *const[]));
 DUMMY(ssize_t, -1, readlink, (const char *, char *, ::size_t));
 DUMMY(int, -1, rename,       (const char *, const char *));
 DUMMY(int, -1, rmdir,        (const char*));
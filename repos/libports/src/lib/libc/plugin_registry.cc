@@ -57,6 +57,10 @@ Plugin *Plugin_registry::get_plugin_for_pipe() {
 	GET_PLUGIN_FOR(pipe) }
 
 
+Plugin *Plugin_registry::get_plugin_for_posix_spawn(char const *path) {
+	GET_PLUGIN_FOR(posix_spawn, path) }
+
+
 Plugin *Plugin_registry::get_plugin_for_readlink(const char *path, char *buf, ::size_t bufsiz) {
 	GET_PLUGIN_FOR(readlink, path, buf, bufsiz) }
 
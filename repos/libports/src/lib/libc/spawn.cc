@@ -0,0 +1,402 @@
+/*
+ * \brief  'posix_spawn' attributes, file actions, and generic back end
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The 'posix_spawn' front end resides in 'file_operations.cc'. It hands the
+ * request to a libc plugin that implements the function natively or falls
+ * back to the generic implementation based on 'vfork' and 'execve'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode-specific libc interfaces */
+#include <libc-plugin/spawn.h>
+
+/* libc includes */
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <paths.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* libc-internal includes */
+#include "libc_spawn.h"
+
+typedef __posix_spawn_file_actions::Action Spawn_action;
+
+
+/******************
+ ** File actions **
+ ******************/
+
+extern "C" int posix_spawn_file_actions_init(posix_spawn_file_actions_t *ret)
+{
+	__posix_spawn_file_actions *fa = (__posix_spawn_file_actions *)
+		malloc(sizeof(__posix_spawn_file_actions));
+	if (!fa)
+		return ENOMEM;
+
+	fa->num = 0;
+	*ret = fa;
+	return 0;
+}
+
+
+extern "C" int posix_spawn_file_actions_destroy(posix_spawn_file_actions_t *fa)
+{
+	for (unsigned i = 0; i < (*fa)->num; i++)
+		if ((*fa)->action[i].type == Spawn_action::OPEN)
+			free((*fa)->action[i].path);
+
+	free(*fa);
+	return 0;
+}
+
+
+static Spawn_action *alloc_action(posix_spawn_file_actions_t *fa,
+                                  Spawn_action::Type type, int fd)
+{
+	if ((*fa)->num == __posix_spawn_file_actions::MAX_ACTIONS)
+		return nullptr;
+
+	Spawn_action &action = (*fa)->action[(*fa)->num];
+	memset(&action, 0, sizeof(action));
+	action.type = type;
+	action.fd   = fd;
+	return &action;
+}
+
+
+extern "C" int posix_spawn_file_actions_addopen(posix_spawn_file_actions_t *fa,
+                                                int fd, char const *path,
+                                                int oflag, mode_t mode)
+{
+	if (fd < 0)
+		return EBADF;
+
+	Spawn_action *action = alloc_action(fa, Spawn_action::OPEN, fd);
+	if (!action)
+		return ENOMEM;
+
+	action->path = strdup(path);
+	if (!action->path)
+		return ENOMEM;
+
+	action->oflag = oflag;
+	action->mode  = mode;
+	(*fa)->num++;
+	return 0;
+}
+
+
+extern "C" int posix_spawn_file_actions_adddup2(posix_spawn_file_actions_t *fa,
+                                                int fd, int new_fd)
+{
+	if (fd < 0 || new_fd < 0)
+		return EBADF;
+
+	Spawn_action *action = alloc_action(fa, Spawn_action::DUP2, fd);
+	if (!action)
+		return ENOMEM;
+
+	action->new_fd = new_fd;
+	(*fa)->num++;
+	return 0;
+}
+
+
+extern "C" int posix_spawn_file_actions_addclose(posix_spawn_file_actions_t *fa,
+                                                 int fd)
+{
+	if (fd < 0)
+		return EBADF;
+
+	if (!alloc_action(fa, Spawn_action::CLOSE, fd))
+		return ENOMEM;
+
+	(*fa)->num++;
+	return 0;
+}
+
+
+/****************
+ ** Attributes **
+ ****************/
+
+extern "C" int posix_spawnattr_init(posix_spawnattr_t *ret)
+{
+	__posix_spawnattr *attr = (__posix_spawnattr *)
+		malloc(sizeof(__posix_spawnattr));
+	if (!attr)
+		return ENOMEM;
+
+	memset(attr, 0, sizeof(*attr));
+	*ret = attr;
+	return 0;
+}
+
+
+extern "C" int posix_spawnattr_destroy(posix_spawnattr_t *attr)
+{
+	free(*attr);
+	return 0;
+}
+
+
+extern "C" int posix_spawnattr_getflags(posix_spawnattr_t const *attr, short *flags)
+{
+	*flags = (*attr)->flags;
+	return 0;
+}
+
+
+extern "C" int posix_spawnattr_getpgroup(posix_spawnattr_t const *attr, pid_t *pgroup)
+{
+	*pgroup = (*attr)->pgroup;
+	return 0;
+}
+
+
+extern "C" int posix_spawnattr_getschedparam(posix_spawnattr_t const *attr,
+                                             struct sched_param *schedparam)
+{
+	*schedparam = (*attr)->schedparam;
+	return 0;
+}
+
+
+extern "C" int posix_spawnattr_getschedpolicy(posix_spawnattr_t const *attr,
+                                              int *schedpolicy)
+{
+	*schedpolicy = (*attr)->schedpolicy;
+	return 0;
+}
+
+
+extern "C" int posix_spawnattr_getsigdefault(posix_spawnattr_t const *attr,
+                                             sigset_t *sigdefault)
+{
+	*sigdefault = (*attr)->sigdefault;
+	return 0;
+}
+
+
+extern "C" int posix_spawnattr_getsigmask(posix_spawnattr_t const *attr,
+                                          sigset_t *sigmask)
+{
+	*sigmask = (*attr)->sigmask;
+	return 0;
+}
+
+
+extern "C" int posix_spawnattr_setflags(posix_spawnattr_t *attr, short flags)
+{
+	(*attr)->flags = flags;
+	return 0;
+}
+
+
+extern "C" int posix_spawnattr_setpgroup(posix_spawnattr_t *attr, pid_t pgroup)
+{
+	(*attr)->pgroup = pgroup;
+	return 0;
+}
+
+
+extern "C" int posix_spawnattr_setschedparam(posix_spawnattr_t *attr,
+                                             struct sched_param const *schedparam)
+{
+	(*attr)->schedparam = *schedparam;
+	return 0;
+}
+
+
+extern "C" int posix_spawnattr_setschedpolicy(posix_spawnattr_t *attr,
+                                              int schedpolicy)
+{
+	(*attr)->schedpolicy = schedpolicy;
+	return 0;
+}
+
+
+extern "C" int posix_spawnattr_setsigdefault(posix_spawnattr_t *attr,
+                                             sigset_t const *sigdefault)
+{
+	(*attr)->sigdefault = *sigdefault;
+	return 0;
+}
+
+
+extern "C" int posix_spawnattr_setsigmask(posix_spawnattr_t *attr,
+                                          sigset_t const *sigmask)
+{
+	(*attr)->sigmask = *sigmask;
+	return 0;
+}
+
+
+/******************
+ ** posix_spawnp **
+ ******************/
+
+extern "C" int posix_spawnp(pid_t *pid, char const *file,
+                            posix_spawn_file_actions_t const *file_actions,
+                            posix_spawnattr_t const *attr,
+                            char *const argv[], char *const envp[])
+{
+	if (strchr(file, '/'))
+		return posix_spawn(pid, file, file_actions, attr, argv, envp);
+
+	char const *search_path = getenv("PATH");
+	if (!search_path)
+		search_path = _PATH_DEFPATH;
+
+	size_t const file_len = strlen(file);
+
+	for (char const *dir = search_path; ; ) {
+
+		char const *end = strchr(dir, ':');
+		size_t const dir_len = end ? (size_t)(end - dir) : strlen(dir);
+
+		/* an empty element refers to the current directory */
+		char candidate[PATH_MAX];
+		if (dir_len + file_len + 2 <= sizeof(candidate)) {
+			if (dir_len) {
+				memcpy(candidate, dir, dir_len);
+				candidate[dir_len] = '/';
+				memcpy(candidate + dir_len + 1, file, file_len + 1);
+			} else {
+				memcpy(candidate, file, file_len + 1);
+			}
+
+			if (access(candidate, X_OK) == 0)
+				return posix_spawn(pid, candidate, file_actions, attr, argv, envp);
+		}
+
+		if (!end)
+			break;
+
+		dir = end + 1;
+	}
+	return ENOENT;
+}
+
+
+/**********************
+ ** Generic back end **
+ **********************/
+
+static int apply_attr(__posix_spawnattr const &attr)
+{
+	if (attr.flags & POSIX_SPAWN_SETPGROUP)
+		if (setpgid(0, attr.pgroup) != 0)
+			return errno;
+
+	if (attr.flags & POSIX_SPAWN_SETSCHEDULER) {
+		if (sched_setscheduler(0, attr.schedpolicy, &attr.schedparam) != 0)
+			return errno;
+	} else if (attr.flags & POSIX_SPAWN_SETSCHEDPARAM) {
+		if (sched_setparam(0, &attr.schedparam) != 0)
+			return errno;
+	}
+
+	if (attr.flags & POSIX_SPAWN_RESETIDS)
+		if (setegid(getgid()) != 0 || seteuid(getuid()) != 0)
+			return errno;
+
+	if (attr.flags & POSIX_SPAWN_SETSIGMASK)
+		if (sigprocmask(SIG_SETMASK, &attr.sigmask, nullptr) != 0)
+			return errno;
+
+	if (attr.flags & POSIX_SPAWN_SETSIGDEF) {
+		struct sigaction sa;
+		memset(&sa, 0, sizeof(sa));
+		sa.sa_handler = SIG_DFL;
+
+		for (int sig = 1; sig < _SIG_MAXSIG; sig++)
+			if (sigismember(&attr.sigdefault, sig))
+				if (sigaction(sig, &sa, nullptr) != 0)
+					return errno;
+	}
+	return 0;
+}
+
+
+static int apply_file_action(Spawn_action const &action)
+{
+	switch (action.type) {
+
+	case Spawn_action::OPEN:
+		{
+			int const fd = open(action.path, action.oflag, action.mode);
+			if (fd < 0)
+				return errno;
+
+			if (fd != action.fd) {
+				if (dup2(fd, action.fd) < 0)
+					return errno;
+				close(fd);
+			}
+			return 0;
+		}
+
+	case Spawn_action::DUP2:
+		return dup2(action.fd, action.new_fd) < 0 ? errno : 0;
+
+	case Spawn_action::CLOSE:
+
+		/* closing a descriptor that is not open is not an error */
+		close(action.fd);
+		return 0;
+	}
+	return EINVAL;
+}
+
+
+int Libc::spawn_via_vfork(pid_t *pid, char const *path,
+                          posix_spawn_file_actions_t const *file_actions,
+                          posix_spawnattr_t const *attr,
+                          char *const argv[], char *const envp[])
+{
+	/* shared with the child as long as 'vfork' is not emulated by 'fork' */
+	volatile int error = 0;
+
+	pid_t const p = vfork();
+
+	if (p == -1)
+		return errno;
+
+	if (p == 0) {
+		if (attr && *attr)
+			error = apply_attr(**attr);
+
+		if (!error && file_actions && *file_actions)
+			for (unsigned i = 0; !error && i < (*file_actions)->num; i++)
+				error = apply_file_action((*file_actions)->action[i]);
+
+		if (!error) {
+			execve(path, argv, envp);
+			error = errno;
+		}
+		_exit(127);
+	}
+
+	if (error) {
+		waitpid(p, nullptr, WNOHANG);
+		return error;
+	}
+
+	if (pid)
+		*pid = p;
+
+	return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * \brief  Throughput of copying files onto a FAT file system
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The files are written from a memory buffer via the VFS. The throughput
+ * includes the final sync of the file system.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/log.h>
+#include <libc/component.h>
+#include <timer_session/connection.h>
+
+/* libc includes */
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace Genode;
+
+
+struct Main
+{
+	Libc::Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	Number_of_bytes const _total_size =
+		_config.xml().attribute_value("total_size", Number_of_bytes(1024*1024*1024));
+
+	Number_of_bytes const _file_size =
+		_config.xml().attribute_value("file_size", Number_of_bytes(64*1024*1024));
+
+	Number_of_bytes const _chunk_size =
+		_config.xml().attribute_value("chunk_size", Number_of_bytes(64*1024));
+
+	typedef String<64> Path;
+
+	Path const _dir = _config.xml().attribute_value("dir", Path("/fat"));
+
+	Attached_ram_dataspace _chunk_ds { _env.ram(), _env.rm(), _chunk_size };
+
+	char * const _chunk = _chunk_ds.local_addr<char>();
+
+	bool _write_file(char const *path, size_t size)
+	{
+		int const fd = open(path, O_CREAT | O_WRONLY | O_TRUNC, 0644);
+		if (fd < 0) {
+			error("could not create ", path);
+			return false;
+		}
+
+		bool ok = true;
+		for (size_t written = 0; ok && written < size; ) {
+			size_t const n = min(size - written, (size_t)_chunk_size);
+
+			ok = (write(fd, _chunk, n) == (ssize_t)n);
+			written += n;
+		}
+
+		close(fd);
+
+		if (!ok)
+			error("could not write ", path);
+		return ok;
+	}
+
+	Main(Libc::Env &env) : _env(env)
+	{
+		for (size_t i = 0; i < _chunk_size; i++)
+			_chunk[i] = (char)i;
+
+		unsigned const num_files = max(_total_size / max((size_t)_file_size, (size_t)1),
+		                               (size_t)1);
+
+		log("copy ", num_files, " files of ", _file_size, " in chunks of ",
+		    _chunk_size, " to ", _dir);
+
+		bool ok = true;
+
+		unsigned long const start_ms = _timer.elapsed_ms();
+
+		Libc::with_libc([&] () {
+
+			for (unsigned i = 0; ok && i < num_files; i++) {
+				String<128> const path(_dir, "/file_", i);
+				ok = _write_file(path.string(), _file_size);
+			}
+
+			sync();
+		});
+
+		unsigned long const ms    = max(_timer.elapsed_ms() - start_ms, 1UL);
+		unsigned long const bytes = num_files*(size_t)_file_size;
+
+		log("wrote ", bytes/1024, " KiB in ", ms, " ms (",
+		    (bytes/1024)*1000/ms/1024, " MiB/s)");
+
+		log("--- fatfs benchmark ", ok ? "finished" : "failed", " ---");
+
+		_env.parent().exit(ok ? 0 : 1);
+	}
+};
+
+
+void Libc::Component::construct(Libc::Env &env) { static Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-fatfs_bench
+LIBS   = libc
+SRC_CC = main.cc
@@ -24,6 +24,12 @@
  *
  * Note: That most components right now only support: "(front) left" and
  * "(front) right".
+ *
+ * By default, a packet carries 'PERIOD' samples at 'SAMPLE_RATE'. A client
+ * may request a different sample rate and a shorter period via the optional
+ * 'sample_rate' and 'period' session arguments. In this case, only the first
+ * 'period' samples of each packet are used. Currently, only the mixer
+ * evaluates these arguments. Audio drivers ignore them.
  */
 
 /*
@@ -51,8 +57,12 @@ namespace Audio_out {
 	enum {
 		QUEUE_SIZE  = 256,           /* buffer queue size */
 		PERIOD      = 512,           /* samples per period (~11.6ms) */
+		MIN_PERIOD  = 64,            /* shortest negotiable period (~1.5ms) */
 		SAMPLE_RATE = 44100,
 		SAMPLE_SIZE = sizeof(float),
+
+		/* session quota needed by a server for sample-rate conversion */
+		CONVERSION_QUOTA = 64*1024,
 	};
 }
 
@@ -135,6 +145,14 @@ class Audio_out::Packet
 		 * Mark a packet as played
 		 */
 		void mark_as_played() { _wait_for_play = false; }
+
+		/**
+		 * Mark a packet as submitted
+		 *
+		 * This is needed by servers that produce packets on behalf of a
+		 * client, e.g., after converting the client's sample rate.
+		 */
+		void mark_as_submitted() { _submit(); }
 };
 
 
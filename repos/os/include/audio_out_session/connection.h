@@ -28,10 +28,20 @@ struct Audio_out::Connection : Genode::Connection<Session>, Audio_out::Session_c
 	 *
 	 * \noapi
 	 */
-	Capability<Audio_out::Session> _session(Genode::Parent &parent, char const *channel)
+	Capability<Audio_out::Session> _session(Genode::Parent &parent, char const *channel,
+	                                        unsigned sample_rate, unsigned period)
 	{
-		return session(parent, "ram_quota=%ld, cap_quota=%ld, channel=\"%s\"",
-		               2*4096 + 2048 + sizeof(Stream), CAP_QUOTA, channel);
+		/* sessions that need conversion donate quota for the server-side state */
+		bool const native = (sample_rate == SAMPLE_RATE) && (period == PERIOD);
+
+		if (native)
+			return session(parent, "ram_quota=%ld, cap_quota=%ld, channel=\"%s\"",
+			               2*4096 + 2048 + sizeof(Stream), CAP_QUOTA, channel);
+
+		return session(parent, "ram_quota=%ld, cap_quota=%ld, channel=\"%s\", "
+		               "sample_rate=%u, period=%u",
+		               2*4096 + 2048 + sizeof(Stream) + CONVERSION_QUOTA,
+		               CAP_QUOTA, channel, sample_rate, period);
 	}
 
 	/**
@@ -43,13 +53,18 @@ struct Audio_out::Connection : Genode::Connection<Session>, Audio_out::Session_c
 	 * \param progress_signal  install progress signal, the client may then
 	 *                         call 'wait_for_progress', which is sent when the
 	 *                         server processed one or more packets
+	 * \param sample_rate      sample rate of the submitted packets
+	 * \param period           number of samples used per packet
 	 */
 	Connection(Genode::Env &env,
 	           char const  *channel,
-	           bool         alloc_signal = true,
-	           bool         progress_signal = false)
+	           bool         alloc_signal    = true,
+	           bool         progress_signal = false,
+	           unsigned     sample_rate     = SAMPLE_RATE,
+	           unsigned     period          = PERIOD)
 	:
-		Genode::Connection<Session>(env, _session(env.parent(), channel)),
+		Genode::Connection<Session>(env, _session(env.parent(), channel,
+		                                          sample_rate, period)),
 		Session_client(env.rm(), cap(), alloc_signal, progress_signal)
 	{ }
 
@@ -64,7 +79,8 @@ struct Audio_out::Connection : Genode::Connection<Session>, Audio_out::Session_c
 	           bool        alloc_signal = true,
 	           bool        progress_signal = false) __attribute__((deprecated))
 	:
-		Genode::Connection<Session>(_session(*Genode::env_deprecated()->parent(), channel)),
+		Genode::Connection<Session>(_session(*Genode::env_deprecated()->parent(), channel,
+		                                     SAMPLE_RATE, PERIOD)),
 		Session_client(*Genode::env_deprecated()->rm_session(), cap(), alloc_signal, progress_signal)
 	{ }
 };
@@ -0,0 +1,318 @@
+/*
+ * \brief  Sparse block-device image with chunk index
+ * \author agent
+ * \date   2026-10-19
+ *
+ * A sparse image consists of a header, followed by an index with one entry
+ * per chunk of the image, followed by the chunk data. Chunks that contain
+ * only zeros are not stored. Stored chunks are either raw or compressed in
+ * the LZ4 block format. All values are little endian.
+ *
+ * ! Header: magic "GNSPARSE", u32 version (1), u32 chunk size,
+ * !         u64 image size in bytes, u64 number of chunks
+ * ! Index:  per chunk u64 data offset, u32 data size, u32 type
+ * !         (0: zero, 1: raw, 2: LZ4)
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BLOCK__SPARSE_IMAGE_H_
+#define _INCLUDE__BLOCK__SPARSE_IMAGE_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <base/exception.h>
+#include <base/stdint.h>
+#include <util/string.h>
+
+namespace Block { class Sparse_image; }
+
+
+class Block::Sparse_image
+{
+	public:
+
+		typedef Genode::uint64_t uint64_t;
+		typedef Genode::uint32_t uint32_t;
+		typedef Genode::uint8_t  uint8_t;
+		typedef Genode::size_t   size_t;
+
+		struct Header
+		{
+			char     magic[8];
+			uint32_t version;
+			uint32_t chunk_size;
+			uint64_t image_size;
+			uint64_t num_chunks;
+		} __attribute__((packed));
+
+		struct Chunk
+		{
+			enum Type { ZERO = 0, RAW = 1, LZ4 = 2 };
+
+			uint64_t offset;
+			uint32_t size;
+			uint32_t type;
+		} __attribute__((packed));
+
+		class Invalid : Genode::Exception { };
+
+		/**
+		 * Return true if the data starts with the header of a sparse image
+		 */
+		static bool detect(void const *base, size_t size)
+		{
+			return size >= sizeof(Header)
+			    && !Genode::strcmp((char const *)base, "GNSPARSE", 8);
+		}
+
+		/**
+		 * Decompress LZ4 block
+		 *
+		 * \return  number of decompressed bytes, or -1 if the input is
+		 *          malformed or exceeds the destination buffer
+		 */
+		static long lz4_decompress(uint8_t const *src, size_t src_len,
+		                           uint8_t *dst, size_t dst_len)
+		{
+			uint8_t const *ip = src, * const iend = src + src_len;
+			uint8_t       *op = dst, * const oend = dst + dst_len;
+
+			auto length = [&] (size_t len, bool &ok) {
+				for (uint8_t b = 255; len >= 15 && b == 255; len += b) {
+					if (ip == iend) { ok = false; return len; }
+					b = *ip++;
+				}
+				return len;
+			};
+
+			while (ip < iend) {
+
+				unsigned const token = *ip++;
+				bool ok = true;
+
+				/* literals */
+				size_t const literals = length(token >> 4, ok);
+				if (!ok || literals > (size_t)(iend - ip)
+				        || literals > (size_t)(oend - op))
+					return -1;
+
+				Genode::memcpy(op, ip, literals);
+				op += literals;
+				ip += literals;
+
+				/* the last sequence consists of literals only */
+				if (ip == iend)
+					break;
+
+				/* match */
+				if (iend - ip < 2)
+					return -1;
+
+				size_t const offset = ip[0] | (ip[1] << 8);
+				ip += 2;
+
+				if (offset == 0 || offset > (size_t)(op - dst))
+					return -1;
+
+				size_t const match = length(token & 15, ok) + 4;
+				if (!ok || match > (size_t)(oend - op))
+					return -1;
+
+				/* the match may overlap with the bytes produced */
+				for (uint8_t const *m = op - offset, *end = op + match; op < end; )
+					*op++ = *m++;
+			}
+			return op - dst;
+		}
+
+	private:
+
+		Genode::Allocator &_alloc;
+
+		uint8_t const * const _base;
+		size_t          const _size;
+
+		Header const &_header = *(Header const *)_base;
+		Chunk  const *_index  = (Chunk const *)(_base + sizeof(Header));
+
+		/*
+		 * Decompressed LZ4 chunks, replaced in least-recently-used order
+		 */
+		struct Slot
+		{
+			uint64_t      chunk;
+			unsigned long used;
+			char         *data;
+		};
+
+		enum : uint64_t { INVALID = ~(uint64_t)0 };
+
+		unsigned      _num_slots = 0;
+		Slot         *_slots     = nullptr;
+		unsigned long _lru_clock = 0;
+
+		void _validate()
+		{
+			if (!detect(_base, _size) || _header.version != 1)
+				throw Invalid();
+
+			uint32_t const cs = _header.chunk_size;
+			if (cs < 512 || (cs & (cs - 1)))
+				throw Invalid();
+
+			/*
+			 * All values are checked such that crafted images cannot
+			 * provoke an overflow of the calculations below
+			 */
+			uint64_t const image_size = _header.image_size;
+			uint64_t const num_chunks = _header.num_chunks;
+
+			if (image_size > ~(uint64_t)0 - cs
+			 || num_chunks != (image_size + cs - 1) / cs)
+				throw Invalid();
+
+			if (num_chunks > (_size - sizeof(Header)) / sizeof(Chunk))
+				throw Invalid();
+
+			uint64_t const index_end = sizeof(Header)
+			                         + num_chunks*sizeof(Chunk);
+
+			for (uint64_t i = 0; i < num_chunks; i++) {
+				Chunk const &c = _index[i];
+
+				if (c.type == Chunk::ZERO)
+					continue;
+
+				if (c.type > Chunk::LZ4 || c.offset < index_end
+				 || c.offset > _size || c.size > _size - c.offset
+				 || (c.type == Chunk::RAW && c.size < _chunk_length(i)))
+					throw Invalid();
+			}
+		}
+
+		size_t _chunk_length(uint64_t nr) const
+		{
+			return (size_t)Genode::min((uint64_t)_header.chunk_size,
+			                           _header.image_size
+			                           - nr*_header.chunk_size);
+		}
+
+		/**
+		 * Return decompressed content of LZ4 chunk
+		 */
+		char const *_decompressed(uint64_t nr)
+		{
+			Slot *slot = &_slots[0];
+			for (unsigned i = 0; i < _num_slots; i++) {
+				if (_slots[i].chunk == nr) {
+					_slots[i].used = ++_lru_clock;
+					return _slots[i].data;
+				}
+				if (_slots[i].used < slot->used)
+					slot = &_slots[i];
+			}
+
+			Chunk const &c = _index[nr];
+			size_t const length = _chunk_length(nr);
+
+			slot->chunk = INVALID;
+
+			if (lz4_decompress(_base + c.offset, c.size,
+			                   (uint8_t *)slot->data, length) != (long)length)
+				return nullptr;
+
+			slot->chunk = nr;
+			slot->used  = ++_lru_clock;
+			return slot->data;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param base        local address of the image
+		 * \param size        size of the image data
+		 * \param cache_size  memory used for decompressed chunks, at least
+		 *                    one chunk is cached
+		 *
+		 * \throw Invalid
+		 */
+		Sparse_image(Genode::Allocator &alloc, void const *base, size_t size,
+		             size_t cache_size)
+		:
+			_alloc(alloc), _base((uint8_t const *)base), _size(size)
+		{
+			_validate();
+
+			_num_slots = Genode::max((size_t)1, cache_size / chunk_size());
+			_slots     = (Slot *)_alloc.alloc(_num_slots*sizeof(Slot));
+
+			for (unsigned i = 0; i < _num_slots; i++)
+				_slots[i] = Slot { INVALID, 0,
+				                   (char *)_alloc.alloc(chunk_size()) };
+		}
+
+		~Sparse_image()
+		{
+			for (unsigned i = 0; i < _num_slots; i++)
+				_alloc.free(_slots[i].data, chunk_size());
+
+			_alloc.free(_slots, _num_slots*sizeof(Slot));
+		}
+
+		uint64_t size()       const { return _header.image_size; }
+		size_t   chunk_size() const { return _header.chunk_size; }
+
+		/**
+		 * Copy part of the image
+		 *
+		 * \return  false if a compressed chunk is corrupt
+		 */
+		bool read(uint64_t offset, size_t size, char *dst)
+		{
+			if (offset > _header.image_size || size > _header.image_size - offset)
+				return false;
+
+			while (size) {
+				uint64_t const nr     = offset / chunk_size();
+				size_t   const within = offset % chunk_size();
+				size_t   const n      = Genode::min(size, chunk_size() - within);
+
+				Chunk const &c = _index[nr];
+
+				switch (c.type) {
+				case Chunk::ZERO:
+					Genode::memset(dst, 0, n);
+					break;
+
+				case Chunk::RAW:
+					Genode::memcpy(dst, _base + c.offset + within, n);
+					break;
+
+				case Chunk::LZ4:
+					{
+						char const *data = _decompressed(nr);
+						if (!data)
+							return false;
+
+						Genode::memcpy(dst, data + within, n);
+						break;
+					}
+				}
+
+				offset += n;
+				size   -= n;
+				dst    += n;
+			}
+			return true;
+		}
+};
+
+#endif /* _INCLUDE__BLOCK__SPARSE_IMAGE_H_ */
@@ -38,6 +38,11 @@ struct Framebuffer::Session_client : Genode::Rpc_client<Session>
 
 	void refresh(int x, int y, int w, int h) override {
 		call<Rpc_refresh>(x, y, w, h); }
+
+	Genode::Dataspace_capability damage_dataspace() override {
+		return call<Rpc_damage_dataspace>(); }
+
+	void refresh_batch() override { call<Rpc_refresh_batch>(); }
 };
 
 #endif /* _INCLUDE__FRAMEBUFFER_SESSION__CLIENT_H_ */
@@ -0,0 +1,228 @@
+/*
+ * \brief  Batched refresh of framebuffer regions
+ * \author agent
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__FRAMEBUFFER_SESSION__DAMAGE_H_
+#define _INCLUDE__FRAMEBUFFER_SESSION__DAMAGE_H_
+
+/* Genode includes */
+#include <base/attached_dataspace.h>
+#include <framebuffer_session/framebuffer_session.h>
+#include <util/reconstructible.h>
+
+namespace Framebuffer {
+
+	struct Damage;
+	class  Refresh_batch;
+}
+
+
+/**
+ * Layout of the damage dataspace shared between client and server
+ *
+ * The client records the regions to update, the server evaluates them on
+ * the call of 'refresh_batch'. Because the client may modify the content at
+ * any time, the server operates on a private copy.
+ */
+struct Framebuffer::Damage
+{
+	struct Rect
+	{
+		int x1, y1, x2, y2;  /* inclusive coordinates */
+
+		bool intersects(Rect const &other) const
+		{
+			return x1 <= other.x2 && other.x1 <= x2
+			    && y1 <= other.y2 && other.y1 <= y2;
+		}
+
+		void unite(Rect const &other)
+		{
+			x1 = Genode::min(x1, other.x1); y1 = Genode::min(y1, other.y1);
+			x2 = Genode::max(x2, other.x2); y2 = Genode::max(y2, other.y2);
+		}
+
+		/**
+		 * Limit rectangle to a screen of the given size
+		 *
+		 * \return  false if no part of the rectangle is visible
+		 *
+		 * The coordinates are provided by the client. Once clamped, 'w'
+		 * and 'h' cannot overflow.
+		 */
+		bool clamp(int width, int height)
+		{
+			if (x1 > x2 || y1 > y2 || x2 < 0 || y2 < 0
+			 || x1 >= width || y1 >= height)
+				return false;
+
+			x1 = Genode::max(x1, 0);         y1 = Genode::max(y1, 0);
+			x2 = Genode::min(x2, width - 1); y2 = Genode::min(y2, height - 1);
+			return true;
+		}
+
+		int w() const { return x2 - x1 + 1; }
+		int h() const { return y2 - y1 + 1; }
+	};
+
+	/*
+	 * Beyond 'MERGE_LIMIT' rectangles, the regions are collapsed to their
+	 * bounding box instead of merged pairwise, which has cubic costs.
+	 */
+	enum { CAPACITY = 255, MERGE_LIMIT = 16 };
+
+	unsigned num;
+	Rect     rect[CAPACITY];
+
+	void reset() { num = 0; }
+
+	/**
+	 * Record region, called by the client
+	 *
+	 * If the damage list is exhausted, the region is merged into the last
+	 * element.
+	 */
+	void add(int x, int y, int w, int h)
+	{
+		if (w <= 0 || h <= 0)
+			return;
+
+		Rect const r { x, y, x + w - 1, y + h - 1 };
+
+		if (num >= CAPACITY) {
+			num = CAPACITY;
+			rect[CAPACITY - 1].unite(r);
+			return;
+		}
+
+		rect[num++] = r;
+	}
+
+	/**
+	 * Merge overlapping rectangles in place
+	 *
+	 * \return  number of remaining rectangles
+	 */
+	static unsigned merge(Rect *rects, unsigned num)
+	{
+		if (num > MERGE_LIMIT) {
+			for (unsigned i = 1; i < num; i++)
+				rects[0].unite(rects[i]);
+			return 1;
+		}
+
+		for (bool merged = true; merged; ) {
+			merged = false;
+
+			for (unsigned i = 0; i < num; i++) {
+				for (unsigned j = i + 1; j < num; ) {
+
+					if (!rects[i].intersects(rects[j])) {
+						j++;
+						continue;
+					}
+
+					rects[i].unite(rects[j]);
+					rects[j] = rects[--num];
+					merged = true;
+				}
+			}
+		}
+		return num;
+	}
+
+	/**
+	 * Call 'fn' for each merged region, called by the server
+	 *
+	 * \param screen  mode of the framebuffer, regions are limited to it
+	 * \param fn      functor taking the arguments 'x, y, w, h'
+	 */
+	template <typename FN>
+	void for_each_merged(Mode const &screen, FN const &fn) const
+	{
+		Rect rects[CAPACITY];
+
+		unsigned const total = Genode::min(num, (unsigned)CAPACITY);
+
+		unsigned n = 0;
+		for (unsigned i = 0; i < total; i++) {
+			rects[n] = rect[i];
+			if (rects[n].clamp(screen.width(), screen.height()))
+				n++;
+		}
+
+		n = merge(rects, n);
+
+		for (unsigned i = 0; i < n; i++)
+			fn(rects[i].x1, rects[i].y1, rects[i].w(), rects[i].h());
+	}
+};
+
+
+/**
+ * Client-side utility for refreshing multiple regions at once
+ *
+ * If the server does not support batching, each region is refreshed
+ * individually.
+ */
+class Framebuffer::Refresh_batch
+{
+	private:
+
+		Session &_framebuffer;
+
+		Genode::Constructible<Genode::Attached_dataspace> _ds;
+
+		Damage *_damage = nullptr;
+
+	public:
+
+		Refresh_batch(Genode::Region_map &rm, Session &framebuffer)
+		:
+			_framebuffer(framebuffer)
+		{
+			Genode::Dataspace_capability const ds = framebuffer.damage_dataspace();
+			if (!ds.valid())
+				return;
+
+			_ds.construct(rm, ds);
+			_damage = _ds->local_addr<Damage>();
+			_damage->reset();
+		}
+
+		/**
+		 * Return true if the server supports batched refreshes
+		 */
+		bool batched() const { return _damage != nullptr; }
+
+		void add(int x, int y, int w, int h)
+		{
+			if (_damage)
+				_damage->add(x, y, w, h);
+			else
+				_framebuffer.refresh(x, y, w, h);
+		}
+
+		/**
+		 * Flush regions recorded since the last call
+		 */
+		void flush()
+		{
+			if (!_damage || _damage->num == 0)
+				return;
+
+			_framebuffer.refresh_batch();
+			_damage->reset();
+		}
+};
+
+#endif /* _INCLUDE__FRAMEBUFFER_SESSION__DAMAGE_H_ */
@@ -88,9 +88,10 @@ struct Framebuffer::Session : Genode::Session
 	/*
 	 * A framebuffer session consumes a dataspace capability for the server's
 	 * session-object allocation, a dataspace capability for the framebuffer
-	 * dataspace, and its session capability.
+	 * dataspace, a dataspace capability for the damage dataspace, and its
+	 * session capability.
 	 */
-	enum { CAP_QUOTA = 3 };
+	enum { CAP_QUOTA = 4 };
 
 	typedef Session_client Client;
 
@@ -138,6 +139,22 @@ struct Framebuffer::Session : Genode::Session
 	 */
 	virtual void sync_sigh(Genode::Signal_context_capability) = 0;
 
+	/**
+	 * Request dataspace for recording the regions of a batched refresh
+	 *
+	 * The dataspace has the layout of 'Framebuffer::Damage'. Servers that
+	 * do not support batched refreshes return an invalid capability.
+	 */
+	virtual Genode::Dataspace_capability damage_dataspace() {
+		return Genode::Dataspace_capability(); }
+
+	/**
+	 * Flush all pixel regions recorded in the damage dataspace
+	 *
+	 * The server merges overlapping regions before flushing them.
+	 */
+	virtual void refresh_batch() { }
+
 
 	/*********************
 	 ** RPC declaration **
@@ -148,9 +165,11 @@ struct Framebuffer::Session : Genode::Session
 	GENODE_RPC(Rpc_refresh, void, refresh, int, int, int, int);
 	GENODE_RPC(Rpc_mode_sigh, void, mode_sigh, Genode::Signal_context_capability);
 	GENODE_RPC(Rpc_sync_sigh, void, sync_sigh, Genode::Signal_context_capability);
+	GENODE_RPC(Rpc_damage_dataspace, Genode::Dataspace_capability, damage_dataspace);
+	GENODE_RPC(Rpc_refresh_batch, void, refresh_batch);
 
 	GENODE_RPC_INTERFACE(Rpc_dataspace, Rpc_mode, Rpc_mode_sigh, Rpc_refresh,
-	                     Rpc_sync_sigh);
+	                     Rpc_sync_sigh, Rpc_damage_dataspace, Rpc_refresh_batch);
 };
 
 #endif /* _INCLUDE__FRAMEBUFFER_SESSION__FRAMEBUFFER_SESSION_H_ */
@@ -0,0 +1,97 @@
+/*
+ * \brief  Sample-processing kernels of the mixer
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The kernels operate on blocks of four samples using the generic vector
+ * extension of GCC. The compiler maps those to SSE on x86 and NEON on ARM
+ * and falls back to scalar code on other architectures. Buffers need not be
+ * aligned, the tail that does not fill a whole block is processed
+ * sample-wise.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__MIXER__DSP_H_
+#define _INCLUDE__MIXER__DSP_H_
+
+namespace Mixer { namespace Dsp {
+
+	typedef float Vec4 __attribute__((vector_size(16)));
+
+	enum { VEC_SAMPLES = 4 };
+
+	static inline Vec4 load(float const *src)
+	{
+		Vec4 v;
+		__builtin_memcpy(&v, src, sizeof(v));
+		return v;
+	}
+
+	static inline void store(float *dst, Vec4 v) {
+		__builtin_memcpy(dst, &v, sizeof(v)); }
+
+	static inline Vec4 splat(float f) { return (Vec4){ f, f, f, f }; }
+
+	static inline Vec4 clip(Vec4 v)
+	{
+		Vec4 const one = splat(1.f), minus_one = splat(-1.f);
+		v = v > one       ? one       : v;
+		v = v < minus_one ? minus_one : v;
+		return v;
+	}
+
+	static inline float clip(float f) { return f > 1.f ? 1.f : (f < -1.f ? -1.f : f); }
+
+	/**
+	 * Store scaled input samples into output buffer
+	 */
+	static inline void scale(float *out, float const *in, float vol, unsigned n)
+	{
+		Vec4 const v = splat(vol);
+
+		unsigned i = 0;
+		for (; i + VEC_SAMPLES <= n; i += VEC_SAMPLES)
+			store(out + i, load(in + i)*v);
+
+		for (; i < n; i++)
+			out[i] = in[i]*vol;
+	}
+
+	/**
+	 * Accumulate scaled input samples onto output buffer
+	 */
+	static inline void accumulate(float *out, float const *in, float vol, unsigned n)
+	{
+		Vec4 const v = splat(vol);
+
+		unsigned i = 0;
+		for (; i + VEC_SAMPLES <= n; i += VEC_SAMPLES)
+			store(out + i, load(out + i) + load(in + i)*v);
+
+		for (; i < n; i++)
+			out[i] += in[i]*vol;
+	}
+
+	/**
+	 * Clip samples to [-1.0, 1.0] and apply output volume
+	 */
+	static inline void clip_and_scale(float *out, float vol, unsigned n)
+	{
+		Vec4 const v = splat(vol);
+
+		unsigned i = 0;
+		for (; i + VEC_SAMPLES <= n; i += VEC_SAMPLES)
+			store(out + i, clip(load(out + i))*v);
+
+		for (; i < n; i++)
+			out[i] = clip(out[i])*vol;
+	}
+} }
+
+#endif /* _INCLUDE__MIXER__DSP_H_ */
@@ -0,0 +1,193 @@
+/*
+ * \brief  Sample-rate converter
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The converter implements band-limited interpolation with a polyphase
+ * windowed-sinc filter (Blackman window). Coefficients between two adjacent
+ * filter phases are linearly interpolated. The read position is maintained
+ * in 32.32 fixed point so that long streams do not drift.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__MIXER__RESAMPLER_H_
+#define _INCLUDE__MIXER__RESAMPLER_H_
+
+#include <util/string.h>
+#include <mixer/dsp.h>
+
+namespace Mixer { class Resampler; }
+
+
+class Mixer::Resampler
+{
+	public:
+
+		enum {
+			TAPS      = 16,
+			HALF      = TAPS / 2,
+			PHASES    = 64,
+			MAX_INPUT = 1024,   /* input samples buffered at most */
+		};
+
+	private:
+
+		typedef Genode::uint64_t uint64_t;
+
+		float _filter[PHASES + 1][TAPS];
+
+		float    _in[MAX_INPUT + TAPS];
+		unsigned _in_count = HALF - 1;   /* zero history as filter lead-in */
+
+		uint64_t       _pos = (uint64_t)(HALF - 1) << 32;
+		uint64_t const _step;
+
+		static double constexpr _pi = 3.14159265358979323846;
+
+		/*
+		 * The base library provides no libm, the coefficients are computed
+		 * once per converter so a Taylor series suffices.
+		 */
+		static double _sin(double x)
+		{
+			while (x >  _pi) x -= 2*_pi;
+			while (x < -_pi) x += 2*_pi;
+
+			double term = x, sum = x;
+			for (int n = 1; n < 12; n++) {
+				term *= -x*x / ((2*n)*(2*n + 1));
+				sum  += term;
+			}
+			return sum;
+		}
+
+		static double _cos(double x) { return _sin(x + _pi/2); }
+
+		static double _kernel(double d, double cutoff)
+		{
+			if (d <= -HALF || d >= HALF)
+				return 0;
+
+			double const x    = 2*cutoff*d;
+			double const sinc = (x == 0) ? 1 : _sin(_pi*x) / (_pi*x);
+			double const w    = 0.42 + 0.5*_cos(_pi*d/HALF)
+			                         + 0.08*_cos(2*_pi*d/HALF);
+			return 2*cutoff*sinc*w;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param in_rate   sample rate of the input
+		 * \param out_rate  sample rate of the output
+		 */
+		Resampler(unsigned in_rate, unsigned out_rate)
+		:
+			_step(((uint64_t)in_rate << 32) / out_rate)
+		{
+			/*
+			 * Cut off at 90% of the lower Nyquist frequency to leave room
+			 * for the transition band of the short filter.
+			 */
+			double const ratio  = (double)out_rate / in_rate;
+			double const cutoff = 0.5*0.9*(ratio < 1 ? ratio : 1);
+
+			for (unsigned p = 0; p <= PHASES; p++) {
+				double sum = 0;
+				double taps[TAPS];
+				for (unsigned k = 0; k < TAPS; k++) {
+					taps[k] = _kernel((double)k - (HALF - 1) - (double)p/PHASES, cutoff);
+					sum += taps[k];
+				}
+
+				/* normalize for unity gain at DC */
+				for (unsigned k = 0; k < TAPS; k++)
+					_filter[p][k] = (float)(taps[k] / sum);
+			}
+
+			Genode::memset(_in, 0, sizeof(_in));
+		}
+
+		/**
+		 * Return number of input samples that can be pushed
+		 */
+		unsigned space() const { return MAX_INPUT + TAPS - _in_count; }
+
+		/**
+		 * Append input samples
+		 *
+		 * \return number of samples taken
+		 */
+		unsigned push(float const *src, unsigned n)
+		{
+			if (n > space()) n = space();
+
+			Genode::memcpy(_in + _in_count, src, n*sizeof(float));
+			_in_count += n;
+			return n;
+		}
+
+		/**
+		 * Produce up to 'n' output samples from the buffered input
+		 *
+		 * \return number of samples produced
+		 */
+		unsigned pull(float *dst, unsigned n)
+		{
+			using namespace Dsp;
+
+			unsigned produced = 0;
+
+			for (; produced < n; produced++) {
+
+				unsigned const center = (unsigned)(_pos >> 32);
+				if (center + HALF >= _in_count)
+					break;
+
+				/* select the two adjacent phases and the blend factor */
+				Genode::uint32_t const frac  = (Genode::uint32_t)_pos;
+				unsigned         const phase = (unsigned)(((uint64_t)frac*PHASES) >> 32);
+				float            const blend = (float)(((uint64_t)frac*PHASES) & 0xffffffff)
+				                             / 4294967296.0f;
+
+				float const *x  = _in + center - (HALF - 1);
+				float const *h0 = _filter[phase];
+				float const *h1 = _filter[phase + 1];
+
+				Vec4 acc0 = splat(0), acc1 = splat(0);
+				for (unsigned k = 0; k < TAPS; k += VEC_SAMPLES) {
+					Vec4 const in = load(x + k);
+					acc0 += in*load(h0 + k);
+					acc1 += in*load(h1 + k);
+				}
+
+				Vec4 const acc = acc0 + (acc1 - acc0)*splat(blend);
+				dst[produced] = acc[0] + acc[1] + acc[2] + acc[3];
+
+				_pos += _step;
+			}
+
+			/* drop input samples that are no longer covered by the filter */
+			unsigned const center = (unsigned)(_pos >> 32);
+			if (center > HALF - 1) {
+				unsigned drop = center - (HALF - 1);
+				if (drop > _in_count) drop = _in_count;
+
+				Genode::memmove(_in, _in + drop, (_in_count - drop)*sizeof(float));
+				_in_count -= drop;
+				_pos      -= (uint64_t)drop << 32;
+			}
+
+			return produced;
+		}
+};
+
+#endif /* _INCLUDE__MIXER__RESAMPLER_H_ */
@@ -54,6 +54,10 @@ class Nic::Session_component : Communication_buffers, public Session_rpc_object
 		Genode::Entrypoint               &_ep;
 		Genode::Signal_context_capability _link_state_sigh;
 
+		/*
+		 * True if the client accepts packets with offload metadata
+		 */
+		bool _client_offload = false;
 
 		/**
 		 * Signal link-state change to client
@@ -113,6 +117,11 @@ class Nic::Session_component : Communication_buffers, public Session_rpc_object
 			_link_state_sigh = sigh;
 		}
 
+		/**
+		 * Set whether the client announced the support of offload metadata
+		 */
+		void client_offload(bool offload) { _client_offload = offload; }
+
 		/**
 		 * Return the current link state
 		 */
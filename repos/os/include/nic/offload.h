@@ -0,0 +1,240 @@
+/*
+ * \brief  Software fallbacks for NIC offload features
+ * \author agent
+ * \date   2026-10-19
+ *
+ * A component that forwards a packet with offload metadata to a receiver
+ * without offload support must complete the packet's checksum or split it
+ * into MTU-sized segments. The utilities operate on Ethernet frames that
+ * carry IPv4.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__NIC__OFFLOAD_H_
+#define _INCLUDE__NIC__OFFLOAD_H_
+
+#include <util/string.h>
+#include <nic_session/nic_session.h>
+
+namespace Nic {
+
+	class Segmenter;
+
+	using Genode::size_t;
+	using Genode::uint8_t;
+	using Genode::uint16_t;
+	using Genode::uint32_t;
+
+	/**
+	 * Return one's complement sum of the given data added to 'sum'
+	 */
+	static inline uint32_t checksum_add(uint32_t sum, void const *data, size_t len)
+	{
+		uint8_t const *bytes = (uint8_t const *)data;
+
+		size_t i = 0;
+		for (; i + 1 < len; i += 2)
+			sum += (bytes[i] << 8) | bytes[i + 1];
+
+		if (i < len)
+			sum += bytes[i] << 8;
+
+		return sum;
+	}
+
+	static inline uint16_t checksum_fold(uint32_t sum)
+	{
+		while (sum >> 16)
+			sum = (sum & 0xffff) + (sum >> 16);
+
+		return sum;
+	}
+
+	static inline uint16_t read_be16(char const *p) {
+		return ((uint8_t)p[0] << 8) | (uint8_t)p[1]; }
+
+	static inline void write_be16(char *p, uint16_t v) {
+		p[0] = v >> 8; p[1] = v & 0xff; }
+
+	/**
+	 * Complete the checksum of a frame with a partial checksum
+	 *
+	 * The checksum field contains the folded checksum of the pseudo
+	 * header. Summing up the data starting at 'csum_start' including this
+	 * field yields the final checksum.
+	 */
+	static inline void complete_checksum(char *frame, size_t size,
+	                                     Offload const &offload)
+	{
+		size_t const start = offload.csum_start;
+		size_t const field = start + offload.csum_offset;
+
+		if (!offload.csum_partial() || field + 2 > size)
+			return;
+
+		uint16_t const sum = checksum_fold(checksum_add(0, frame + start,
+		                                                size - start));
+		write_be16(frame + field, ~sum);
+	}
+
+	/**
+	 * Update the pseudo-header checksum of a frame with a partial checksum
+	 *
+	 * This is needed after the IPv4 addresses or the length of the
+	 * transport-layer data of the frame were changed.
+	 */
+	static inline void update_partial_checksum(char *frame, size_t size,
+	                                           Offload const &offload)
+	{
+		enum { ETH_HDR = 14 };
+
+		size_t const field = offload.csum_start + offload.csum_offset;
+
+		if (!offload.csum_partial() || field + 2 > size || size < ETH_HDR + 20)
+			return;
+
+		char const *ip = frame + ETH_HDR;
+
+		size_t const ihl    = (ip[0] & 0xf)*4;
+		size_t const l4_len = read_be16(ip + 2) - ihl;
+
+		uint32_t sum = checksum_add(0, ip + 12, 8);   /* addresses */
+		sum += (uint8_t)ip[9];                        /* protocol */
+		sum += l4_len;
+
+		write_be16(frame + field, checksum_fold(sum));
+	}
+}
+
+
+/**
+ * Software segmentation of a large TCP/IPv4 frame
+ *
+ * Each segment receives a copy of the Ethernet, IPv4, and TCP headers and
+ * at most 'gso_size' bytes of payload. The IPv4 identification, TCP
+ * sequence number, flags, and all checksums are adjusted accordingly.
+ */
+class Nic::Segmenter
+{
+	private:
+
+		enum { ETH_HDR = 14,
+		       IP_TOTAL_LEN = 2, IP_ID = 4, IP_CSUM = 10,
+		       TCP_SEQ = 4, TCP_FLAGS = 13, TCP_CSUM = 16,
+		       TCP_FIN = 0x01, TCP_PSH = 0x08, TCP_CWR = 0x80 };
+
+		char const * const _frame;
+		size_t       const _size;
+
+		size_t _ip_hdr  = 0;
+		size_t _tcp_hdr = 0;
+		size_t _mss     = 0;
+
+		size_t _hdr_len()     const { return ETH_HDR + _ip_hdr + _tcp_hdr; }
+		size_t _payload_len() const { return _size - _hdr_len(); }
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * If the frame is no TCP/IPv4 frame that requires segmentation,
+		 * the segmenter produces the unmodified frame as single segment.
+		 */
+		Segmenter(char const *frame, size_t size, Offload const &offload)
+		:
+			_frame(frame), _size(size)
+		{
+			if (!offload.gso() || offload.gso_type != Offload::GSO_TCPV4
+			 || !offload.gso_size || size < ETH_HDR + 20)
+				return;
+
+			char const *ip = frame + ETH_HDR;
+
+			size_t const ip_hdr = (ip[0] & 0xf)*4;
+			if (ETH_HDR + ip_hdr + 20 > size)
+				return;
+
+			size_t const tcp_hdr = ((uint8_t)ip[ip_hdr + 12] >> 4)*4;
+			if (ETH_HDR + ip_hdr + tcp_hdr > size)
+				return;
+
+			_ip_hdr  = ip_hdr;
+			_tcp_hdr = tcp_hdr;
+			_mss     = offload.gso_size;
+		}
+
+		unsigned num_segments() const
+		{
+			if (!_mss)
+				return 1;
+
+			return Genode::max((size_t)1, (_payload_len() + _mss - 1) / _mss);
+		}
+
+		size_t segment_size(unsigned i) const
+		{
+			if (!_mss)
+				return _size;
+
+			size_t const offset = i*_mss;
+			return _hdr_len() + Genode::min(_mss, _payload_len() - offset);
+		}
+
+		/**
+		 * Write segment 'i' to 'dst', which must hold 'segment_size(i)' bytes
+		 */
+		void write_segment(unsigned i, char *dst) const
+		{
+			size_t const size = segment_size(i);
+
+			if (!_mss) {
+				Genode::memcpy(dst, _frame, size);
+				return;
+			}
+
+			size_t const hdr_len     = _hdr_len();
+			size_t const payload_len = size - hdr_len;
+			bool   const last        = (i + 1 == num_segments());
+
+			Genode::memcpy(dst, _frame, hdr_len);
+			Genode::memcpy(dst + hdr_len, _frame + hdr_len + i*_mss, payload_len);
+
+			/* IPv4 header */
+			char *ip = dst + ETH_HDR;
+			write_be16(ip + IP_TOTAL_LEN, _ip_hdr + _tcp_hdr + payload_len);
+			write_be16(ip + IP_ID, read_be16(ip + IP_ID) + i);
+			write_be16(ip + IP_CSUM, 0);
+			write_be16(ip + IP_CSUM, ~checksum_fold(checksum_add(0, ip, _ip_hdr)));
+
+			/* TCP header */
+			char *tcp = ip + _ip_hdr;
+
+			uint32_t const seq = ((uint32_t)read_be16(tcp + TCP_SEQ) << 16)
+			                   | read_be16(tcp + TCP_SEQ + 2);
+			uint32_t const new_seq = seq + i*_mss;
+			write_be16(tcp + TCP_SEQ,     new_seq >> 16);
+			write_be16(tcp + TCP_SEQ + 2, new_seq & 0xffff);
+
+			if (!last) tcp[TCP_FLAGS] &= ~(TCP_FIN | TCP_PSH);
+			if (i)     tcp[TCP_FLAGS] &= ~TCP_CWR;
+
+			size_t const tcp_len = _tcp_hdr + payload_len;
+
+			uint32_t sum = checksum_add(0, ip + 12, 8);
+			sum += (uint8_t)ip[9];
+			sum += tcp_len;
+
+			write_be16(tcp + TCP_CSUM, 0);
+			sum = checksum_add(sum, tcp, tcp_len);
+			write_be16(tcp + TCP_CSUM, ~checksum_fold(sum));
+		}
+};
+
+#endif /* _INCLUDE__NIC__OFFLOAD_H_ */
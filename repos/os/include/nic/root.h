@@ -59,9 +59,12 @@ class Nic::Root : public Genode::Root_component<SESSION_COMPONENT,
 				throw Genode::Insufficient_ram_quota();
 			}
 
-			return new (Root::md_alloc())
+			SESSION_COMPONENT *session = new (Root::md_alloc())
 			            SESSION_COMPONENT(tx_buf_size, rx_buf_size,
 			                             _md_alloc, _env);
+
+			session->client_offload(Arg_string::find_arg(args, "offload").bool_value(false));
+			return session;
 		}
 
 	public:
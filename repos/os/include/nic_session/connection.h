@@ -31,12 +31,14 @@ struct Nic::Connection : Genode::Connection<Session>, Session_client
 	Capability<Nic::Session> _session(Genode::Parent &parent,
 	                                  char const *label,
 	                                  Genode::size_t tx_buf_size,
-	                                  Genode::size_t rx_buf_size)
+	                                  Genode::size_t rx_buf_size,
+	                                  bool offload = false)
 	{
 		return session(parent,
-		               "ram_quota=%ld, cap_quota=%ld, tx_buf_size=%ld, rx_buf_size=%ld, label=\"%s\"",
+		               "ram_quota=%ld, cap_quota=%ld, tx_buf_size=%ld, rx_buf_size=%ld, label=\"%s\", offload=%s",
 		               32*1024*sizeof(long) + tx_buf_size + rx_buf_size,
-		               CAP_QUOTA, tx_buf_size, rx_buf_size, label);
+		               CAP_QUOTA, tx_buf_size, rx_buf_size, label,
+		               offload ? "yes" : "no");
 	}
 
 	/**
@@ -46,15 +48,18 @@ struct Nic::Connection : Genode::Connection<Session>, Session_client
 	 *                         transmission buffer
 	 * \param tx_buf_size      size of transmission buffer in bytes
 	 * \param rx_buf_size      size of reception buffer in bytes
+	 * \param offload          client accepts packets with offload metadata
 	 */
 	Connection(Genode::Env             &env,
 	           Genode::Range_allocator *tx_block_alloc,
 	           Genode::size_t           tx_buf_size,
 	           Genode::size_t           rx_buf_size,
-	           char const              *label = "")
+	           char const              *label = "",
+	           bool                     offload = false)
 	:
 		Genode::Connection<Session>(env, _session(env.parent(), label,
-		                                          tx_buf_size, rx_buf_size)),
+		                                          tx_buf_size, rx_buf_size,
+		                                          offload)),
 		Session_client(cap(), *tx_block_alloc, env.rm())
 	{ }
 
@@ -31,10 +31,82 @@ namespace Nic {
 	using Genode::Packet_stream_sink;
 	using Genode::Packet_stream_source;
 
-	typedef Genode::Packet_descriptor Packet_descriptor;
+	struct Offload;
+	class  Packet_descriptor;
 }
 
 
+/**
+ * Offload metadata of a packet
+ *
+ * The metadata allows the transfer of frames whose checksum is not yet
+ * computed and of TCP segments that exceed the MTU. Its semantics follow
+ * the header of virtio-net devices.
+ *
+ * A client that is able to receive such packets announces this ability
+ * via the 'offload' session argument. The server reports its ability to
+ * accept such packets via 'Session::offload_supported'. Packets with
+ * metadata are exchanged only if the respective side supports them.
+ */
+struct Nic::Offload
+{
+	enum Flags { CSUM_PARTIAL = 1,   /* checksum must be completed */
+	             CSUM_VALID   = 2 }; /* checksum was already verified */
+
+	enum Gso_type { GSO_NONE = 0, GSO_TCPV4 = 1 };
+
+	Genode::uint8_t  flags       = 0;
+	Genode::uint8_t  gso_type    = GSO_NONE;
+
+	/*
+	 * Maximum segment size of a large TCP packet
+	 */
+	Genode::uint16_t gso_size    = 0;
+
+	/*
+	 * If 'CSUM_PARTIAL' is set, the checksum covers the frame data starting
+	 * at 'csum_start' and is stored at 'csum_start + csum_offset'. The
+	 * checksum field holds the checksum of the pseudo header.
+	 */
+	Genode::uint16_t csum_start  = 0;
+	Genode::uint16_t csum_offset = 0;
+
+	bool csum_partial() const { return flags & CSUM_PARTIAL; }
+	bool csum_valid()   const { return flags & CSUM_VALID; }
+	bool gso()          const { return gso_type != GSO_NONE; }
+
+	/**
+	 * Return true if the frame must be processed before it can be handed
+	 * out to a receiver without offload support
+	 */
+	bool pending() const { return csum_partial() || gso(); }
+};
+
+
+/**
+ * Packet descriptor of the NIC session, carrying offload metadata
+ */
+class Nic::Packet_descriptor : public Genode::Packet_descriptor
+{
+	private:
+
+		Offload _offload { };
+
+	public:
+
+		Packet_descriptor(Genode::off_t offset, Genode::size_t size)
+		: Genode::Packet_descriptor(offset, size) { }
+
+		Packet_descriptor(Genode::Packet_descriptor packet = Genode::Packet_descriptor(),
+		                  Offload                   offload = Offload())
+		: Genode::Packet_descriptor(packet), _offload(offload) { }
+
+		Offload const &offload() const { return _offload; }
+
+		void offload(Offload const &offload) { _offload = offload; }
+};
+
+
 /*
  * NIC session interface
  *
@@ -60,7 +132,7 @@ struct Nic::Session : Genode::Session
 	 * The acknowledgement queue has always the same size as the submit
 	 * queue. We access the packet content as a char pointer.
 	 */
-	typedef Genode::Packet_stream_policy<Genode::Packet_descriptor,
+	typedef Genode::Packet_stream_policy<Nic::Packet_descriptor,
 	                                     QUEUE_SIZE, QUEUE_SIZE, char> Policy;
 
 	typedef Packet_stream_tx::Channel<Policy> Tx;
@@ -116,6 +188,11 @@ struct Nic::Session : Genode::Session
 	 */
 	virtual void link_state_sigh(Genode::Signal_context_capability sigh) = 0;
 
+	/**
+	 * Return true if the server accepts packets with offload metadata
+	 */
+	virtual bool offload_supported() { return false; }
+
 	/*******************
 	 ** RPC interface **
 	 *******************/
@@ -126,9 +203,11 @@ struct Nic::Session : Genode::Session
 	GENODE_RPC(Rpc_link_state, bool, link_state);
 	GENODE_RPC(Rpc_link_state_sigh, void, link_state_sigh,
 	           Genode::Signal_context_capability);
+	GENODE_RPC(Rpc_offload_supported, bool, offload_supported);
 
 	GENODE_RPC_INTERFACE(Rpc_mac_address, Rpc_link_state,
-	                     Rpc_link_state_sigh, Rpc_tx_cap, Rpc_rx_cap);
+	                     Rpc_link_state_sigh, Rpc_tx_cap, Rpc_rx_cap,
+	                     Rpc_offload_supported);
 };
 
 #endif /* _INCLUDE__NIC_SESSION__NIC_SESSION_H_ */
@@ -0,0 +1,98 @@
+/*
+ * \brief  Heap-backed buffer for generating XML of unknown size
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The buffer serves as expander of an 'Xml_generator'. Whenever the output
+ * exceeds the buffer, the buffer is replaced by one of twice the size and the
+ * generation continues. Hence, the content is generated exactly once and the
+ * total copying cost is linear in the output size.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__OS__EXPANDING_XML_BUFFER_H_
+#define _INCLUDE__OS__EXPANDING_XML_BUFFER_H_
+
+#include <base/allocator.h>
+#include <util/xml_generator.h>
+#include <util/noncopyable.h>
+
+namespace Genode { class Expanding_xml_buffer; }
+
+
+class Genode::Expanding_xml_buffer : public Xml_generator::Expander, Noncopyable
+{
+	private:
+
+		Allocator &_alloc;
+
+		Xml_generator::Buffer _buffer;
+
+		size_t _used = 0;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc             backing store of the buffer
+		 * \param initial_capacity  size of the initial buffer
+		 */
+		Expanding_xml_buffer(Allocator &alloc, size_t initial_capacity = 4096)
+		:
+			_alloc(alloc),
+			_buffer({ (char *)_alloc.alloc(initial_capacity), initial_capacity })
+		{ }
+
+		~Expanding_xml_buffer() { _alloc.free(_buffer.base, _buffer.capacity); }
+
+		/**
+		 * Xml_generator::Expander interface
+		 */
+		Xml_generator::Buffer expand(Xml_generator::Buffer const &old,
+		                             size_t min_capacity) override
+		{
+			size_t const capacity = max(min_capacity, 2*old.capacity);
+
+			char *base = nullptr;
+			if (!_alloc.alloc(capacity, &base))
+				throw Xml_generator::Buffer_exceeded();
+
+			memcpy(base, old.base, old.capacity);
+			_alloc.free(old.base, old.capacity);
+
+			_buffer = { base, capacity };
+			return _buffer;
+		}
+
+		/**
+		 * Generate XML content
+		 *
+		 * \param node_name  name of the top-level node
+		 * \param fn         functor called with the 'Xml_generator &' as
+		 *                   argument
+		 *
+		 * \throw Xml_generator::Buffer_exceeded  backing store exhausted
+		 */
+		template <typename FN>
+		void generate(char const *node_name, FN const &fn)
+		{
+			_used = 0;
+
+			Xml_generator xml(_buffer, *this, node_name, [&] () { fn(xml); });
+
+			_used = xml.used();
+		}
+
+		char const *content()      const { return _buffer.base; }
+		size_t      content_size() const { return _used; }
+		size_t      capacity()     const { return _buffer.capacity; }
+};
+
+#endif /* _INCLUDE__OS__EXPANDING_XML_BUFFER_H_ */
@@ -330,6 +330,27 @@ class Genode::Packet_descriptor_transmitter
 				_rx_ready.submit();
 		}
 
+		/**
+		 * Put packet into the tx queue without notifying the receiver
+		 *
+		 * \return false if the tx queue is full
+		 */
+		bool try_tx(typename TX_QUEUE::Packet_descriptor packet)
+		{
+			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+			return _tx_queue->add(packet);
+		}
+
+		/**
+		 * Notify the receiver about packets put into the queue via 'try_tx'
+		 */
+		void tx_wakeup()
+		{
+			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+			if (!_tx_queue->empty())
+				_rx_ready.submit();
+		}
+
 		/**
 		 * Return number of slots left to be put into the tx queue
 		 */
@@ -681,6 +702,12 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return _submit_transmitter.ready_for_tx();
 		}
 
+		/**
+		 * Returns number of slots left in the submit queue
+		 */
+		unsigned submit_slots_free() {
+			return _submit_transmitter.tx_slots_free(); }
+
 		/**
 		 * Tell sink about a packet to process
 		 */
@@ -689,6 +716,24 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			_submit_transmitter.tx(packet);
 		}
 
+		/**
+		 * Tell sink about a packet to process without sending a signal
+		 *
+		 * This method never blocks. It allows the submission of a batch of
+		 * packets, followed by a single call of 'wakeup'.
+		 *
+		 * \return false if the submit queue is full
+		 */
+		bool try_submit_packet(Packet_descriptor packet)
+		{
+			return _submit_transmitter.try_tx(packet);
+		}
+
+		/**
+		 * Signal the sink about packets submitted via 'try_submit_packet'
+		 */
+		void wakeup() { _submit_transmitter.tx_wakeup(); }
+
 		/**
 		 * Returns true if one or more packet acknowledgements are available
 		 */
@@ -871,6 +916,20 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 
 		Genode::Dataspace_capability dataspace() {
 			return Packet_stream_base::_dataspace(); }
+
+		/**
+		 * Return local address of the bulk buffer
+		 *
+		 * This is useful for servers that register the bulk buffer as a
+		 * whole with an I/O facility instead of passing it packet by packet.
+		 */
+		Genode::addr_t bulk_buffer_local_base() {
+			return Packet_stream_base::_bulk_buffer_local_base(); }
+
+		/**
+		 * Return size of the bulk buffer in bytes
+		 */
+		Genode::size_t bulk_buffer_size() const { return _bulk_buffer_size; }
 };
 
 #endif /* _INCLUDE__OS__PACKET_STREAM_H_ */
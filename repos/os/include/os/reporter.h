@@ -20,7 +20,11 @@
 #include <util/xml_generator.h>
 
 
-namespace Genode { class Reporter; }
+namespace Genode {
+
+	class Reporter;
+	class Expanding_reporter;
+}
 
 
 class Genode::Reporter : Noncopyable
@@ -152,4 +156,108 @@ class Genode::Reporter : Noncopyable
 		};
 };
 
+
+/**
+ * Reporter that enlarges its report buffer on demand
+ *
+ * The XML content is generated directly into the dataspace of the report
+ * session. Should the content exceed the dataspace, a new report session with
+ * a buffer of twice the size is opened, the already generated content is
+ * copied over, and the generation continues. The previous session is closed
+ * only after the new one is established so that the report server retains the
+ * last report in the meantime. The content is thereby generated exactly once.
+ */
+class Genode::Expanding_reporter : public Xml_generator::Expander, Noncopyable
+{
+	public:
+
+		typedef Reporter::Name Name;
+
+	private:
+
+		Env &_env;
+
+		Name const _xml_name;
+		Name const _label;
+
+		struct Connection
+		{
+			Report::Connection report;
+			Attached_dataspace ds;
+
+			Connection(Env &env, char const *label, size_t buffer_size)
+			:
+				report(env, label, buffer_size), ds(env.rm(), report.dataspace())
+			{ }
+		};
+
+		/* the connection is replaced by the other slot when expanded */
+		Constructible<Connection> _conn[2];
+
+		unsigned _curr = 0;
+
+		Xml_generator::Buffer _buffer() {
+			return { _conn[_curr]->ds.local_addr<char>(), _conn[_curr]->ds.size() }; }
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param buffer_size  initial size of the report buffer
+		 */
+		Expanding_reporter(Env &env, char const *xml_name,
+		                   char const *label = nullptr,
+		                   size_t buffer_size = 4096)
+		:
+			_env(env), _xml_name(xml_name), _label(label ? label : xml_name)
+		{
+			_conn[_curr].construct(_env, _label.string(), buffer_size);
+		}
+
+		/**
+		 * Xml_generator::Expander interface
+		 */
+		Xml_generator::Buffer expand(Xml_generator::Buffer const &old,
+		                             size_t min_capacity) override
+		{
+			size_t const size = align_addr(max(min_capacity, 2*old.capacity), 12);
+
+			unsigned const next = !_curr;
+			try { _conn[next].construct(_env, _label.string(), size); }
+			catch (...) { throw Xml_generator::Buffer_exceeded(); }
+
+			memcpy(_conn[next]->ds.local_addr<char>(), old.base, old.capacity);
+
+			_conn[_curr].destruct();
+			_curr = next;
+
+			return _buffer();
+		}
+
+		/**
+		 * Generate and submit report
+		 *
+		 * \param fn  functor called with the 'Xml_generator &' as argument
+		 *
+		 * \throw Xml_generator::Buffer_exceeded  report buffer cannot be
+		 *                                        enlarged
+		 */
+		template <typename FN>
+		void generate(FN const &fn)
+		{
+			Xml_generator xml(_buffer(), *this, _xml_name.string(),
+			                  [&] () { fn(xml); });
+
+			_conn[_curr]->report.submit(xml.used());
+		}
+
+		Name name() const { return _label; }
+
+		/**
+		 * Return current size of the report buffer
+		 */
+		size_t buffer_size() const { return _conn[_curr]->ds.size(); }
+};
+
 #endif /* _INCLUDE__OS__REPORTER_H_ */
@@ -18,12 +18,14 @@
 #include <util/reconstructible.h>
 #include <os/session_policy.h>
 #include <base/attached_ram_dataspace.h>
+#include <base/allocator.h>
 
 namespace Rom {
 	using Genode::size_t;
 	using Genode::Constructible;
 	using Genode::Attached_ram_dataspace;
 
+	class Snapshot;
 	class Module;
 	class Readable_module;
 	class Registry;
@@ -34,6 +36,7 @@ namespace Rom {
 	typedef Genode::List<Module> Module_list;
 	typedef Genode::List<Reader> Reader_list;
 	typedef Genode::List<Writer> Writer_list;
+	typedef Genode::List<Snapshot> Snapshot_list;
 }
 
 
@@ -50,6 +53,36 @@ struct Rom::Reader : Reader_list::Element
 };
 
 
+/**
+ * Content of a ROM module at a specific version
+ *
+ * A snapshot is never modified while being used by a reader. Hence, the
+ * snapshot's dataspace can be handed out to all readers without copying.
+ */
+class Rom::Snapshot : public Snapshot_list::Element
+{
+	private:
+
+		friend class Module;
+
+		Attached_ram_dataspace _ds;
+
+		size_t        _size    = 0;
+		unsigned long _version = 0;
+		unsigned      _users   = 0;
+
+	public:
+
+		Snapshot(Genode::Ram_session &ram, Genode::Region_map &rm, size_t capacity)
+		: _ds(ram, rm, capacity) { }
+
+		Genode::Dataspace_capability ds() const { return _ds.cap(); }
+
+		size_t        size()    const { return _size; }
+		unsigned long version() const { return _version; }
+};
+
+
 struct Rom::Readable_module
 {
 	/**
@@ -68,6 +101,29 @@ struct Rom::Readable_module
 	                            size_t dst_len) const = 0;
 
 	virtual size_t size() const = 0;
+
+	/**
+	 * Obtain snapshot of the current content
+	 *
+	 * The snapshot stays unmodified until it is released by the reader.
+	 *
+	 * \return snapshot, or nullptr if no content is readable by 'reader'
+	 */
+	virtual Snapshot *acquire_snapshot(Reader const &reader) = 0;
+
+	virtual void release_snapshot(Snapshot &snapshot) = 0;
+
+	/**
+	 * Return true if 'snapshot' is the current content for 'reader'
+	 */
+	virtual bool current(Reader const &reader, Snapshot const *snapshot) const = 0;
+
+	/**
+	 * Return true if readers obtain the snapshot dataspaces directly
+	 *
+	 * Otherwise, each reader obtains a copy of the content.
+	 */
+	virtual bool snapshots_shared() const = 0;
 };
 
 
@@ -119,6 +175,7 @@ struct Rom::Module : Module_list::Element, Readable_module
 
 		Genode::Ram_session &_ram;
 		Genode::Region_map  &_rm;
+		Genode::Allocator   &_alloc;
 
 		Read_policy  const &_read_policy;
 		Write_policy const &_write_policy;
@@ -132,19 +189,108 @@ struct Rom::Module : Module_list::Element, Readable_module
 		Writer const *_last_writer = nullptr;
 
 		/**
-		 * Dataspace used as backing store
+		 * Snapshots used as backing store
 		 *
-		 * The buffer for the content is not allocated from the heap to
-		 * allow for the immediate release of the underlying backing store when
-		 * the module gets destructed.
+		 * Each report is written to a snapshot that is not in use by any
+		 * reader. So while readers keep up, the module alternates between
+		 * two snapshots. The buffers for the content are not allocated from
+		 * the heap to allow for the immediate release of the underlying
+		 * backing store when the module gets destructed.
+		 */
+		Snapshot_list _snapshots;
+
+		/**
+		 * Snapshot holding the current content, or nullptr if empty
 		 */
-		Constructible<Attached_ram_dataspace> _ds;
+		Snapshot *_current = nullptr;
 
 		/**
-		 * Content size, which may less than the capacilty of '_ds'.
+		 * Version of the content, incremented with each change
 		 */
-		size_t _size = 0;
+		unsigned long _version = 0;
 
+		/**
+		 * Hand out snapshots to the readers instead of copies
+		 *
+		 * There is no way to hand out RAM dataspaces read-only. Hence, all
+		 * readers of a module with shared snapshots must be trusted not to
+		 * modify the content.
+		 */
+		bool const _shared;
+
+		/**
+		 * Suppress notifications about reports that do not change the content
+		 */
+		bool const _deduplicate;
+
+		Genode::uint64_t _hash = 0;
+
+		/**
+		 * FNV-1a hash of the report content
+		 */
+		static Genode::uint64_t _hash_content(char const *src, size_t len)
+		{
+			Genode::uint64_t h = 0xcbf29ce484222325ULL;
+			for (size_t i = 0; i < len; i++)
+				h = (h ^ (unsigned char)src[i])*0x100000001b3ULL;
+			return h;
+		}
+
+		bool _unused(Snapshot const &s) const { return &s != _current && !s._users; }
+
+		/**
+		 * Return snapshot that can take content of 'len' bytes
+		 */
+		Snapshot &_alloc_snapshot(size_t len)
+		{
+			/* reuse unused snapshot, release the ones that are too small */
+			for (Snapshot *s = _snapshots.first(), *next = nullptr; s; s = next) {
+				next = s->next();
+
+				if (!_unused(*s))
+					continue;
+
+				if (s->_ds.size() >= len)
+					return *s;
+
+				_snapshots.remove(s);
+				Genode::destroy(_alloc, s);
+			}
+
+			Snapshot &s = *new (_alloc) Snapshot(_ram, _rm, len);
+			_snapshots.insert(&s);
+			return s;
+		}
+
+		/**
+		 * Release snapshots left behind by slow readers
+		 *
+		 * One unused snapshot is kept as target of the next report.
+		 */
+		void _release_unused_snapshots()
+		{
+			bool spare = false;
+			for (Snapshot *s = _snapshots.first(), *next = nullptr; s; s = next) {
+				next = s->next();
+
+				if (!_unused(*s))
+					continue;
+
+				if (!spare) {
+					spare = true;
+					continue;
+				}
+
+				_snapshots.remove(s);
+				Genode::destroy(_alloc, s);
+			}
+		}
+
+		bool _readable(Reader const &reader) const
+		{
+			return _current && _last_writer
+			    && _read_policy.read_permitted(*this, *_last_writer, reader);
+		}
 
 		/********************************
 		 ** Interface used by registry **
@@ -159,23 +305,31 @@ struct Rom::Module : Module_list::Element, Readable_module
 		 *                      backing store
 		 * \param rm            region map of the local address space, needed
 		 *                      to access the allocated backing store
+		 * \param alloc         allocator for the snapshot meta data
 		 * \param name          module name
 		 * \param read_policy   policy hook function that is evaluated each
 		 *                      time when the module content is obtained
 		 * \param write_policy  policy hook function that is evaluated each
 		 *                      time when the module content is changed
+		 * \param shared        hand out snapshots to readers without copying
+		 * \param deduplicate   notify readers only if the content changed
 		 */
 		Module(Genode::Ram_session &ram,
 		       Genode::Region_map  &rm,
+		       Genode::Allocator   &alloc,
 		       Name          const &name,
 		       Read_policy   const &read_policy,
-		       Write_policy  const &write_policy)
+		       Write_policy  const &write_policy,
+		       bool                 shared      = false,
+		       bool                 deduplicate = false)
 		:
-			_name(name), _ram(ram), _rm(rm),
-			_read_policy(read_policy), _write_policy(write_policy)
+			_name(name), _ram(ram), _rm(rm), _alloc(alloc),
+			_read_policy(read_policy), _write_policy(write_policy),
+			_shared(shared), _deduplicate(deduplicate)
 		{ }
 
 
+
 		/*************************************************
 		 ** Interface to be used by the 'Registry' only **
 		 *************************************************/
@@ -204,9 +358,10 @@ struct Rom::Module : Module_list::Element, Readable_module
 
 			/* clear content if its origin disappears */
 			if (_last_writer == &writer) {
-				Genode::memset(_ds->local_addr<char>(), 0, _size);
-				_size = 0;
+				_current     = nullptr;
 				_last_writer = nullptr;
+				_version++;
+				_release_unused_snapshots();
 			}
 		}
 
@@ -228,6 +383,14 @@ struct Rom::Module : Module_list::Element, Readable_module
 
 	public:
 
+		~Module()
+		{
+			while (Snapshot *s = _snapshots.first()) {
+				_snapshots.remove(s);
+				Genode::destroy(_alloc, s);
+			}
+		}
+
 		/**
 		 * Assign new content to the ROM module
 		 *
@@ -238,26 +401,39 @@ struct Rom::Module : Module_list::Element, Readable_module
 			if (!_write_policy.write_permitted(*this, writer))
 				return;
 
-			_size = 0;
+			/*
+			 * Skip report that leaves the content unchanged. The hash
+			 * merely spares the comparison of reports that differ.
+			 */
+			Genode::uint64_t const hash = _deduplicate ? _hash_content(src, src_len) : 0;
+			if (_deduplicate && _current && _last_writer == &writer
+			 && _current->_size == src_len && _hash == hash
+			 && !Genode::memcmp(_current->_ds.local_addr<char>(), src, src_len))
+				return;
 
+			_hash        = hash;
 			_last_writer = &writer;
 
 			/*
-			 * Realloc backing store if needed
-			 *
 			 * Take a terminating zero into account, which we append to each
 			 * report. This way, we do not need to trust report clients to
 			 * append a zero termination to textual reports.
 			 */
-			if (!_ds.constructed() || _ds->size() < (src_len + 1))
-				_ds.construct(_ram, _rm, (src_len + 1));
+			Snapshot &snapshot = _alloc_snapshot(src_len + 1);
 
 			/* copy content into backing store */
-			_size = src_len;
-			Genode::memcpy(_ds->local_addr<char>(), src, _size);
+			char * const dst = snapshot._ds.local_addr<char>();
+			Genode::memcpy(dst, src, src_len);
+
+			/* append zero termination, clear remainder of a reused snapshot */
+			size_t const used = Genode::max(snapshot._size, src_len) + 1;
+			Genode::memset(dst + src_len, 0, Genode::min(used, snapshot._ds.size()) - src_len);
+
+			snapshot._size    = src_len;
+			snapshot._version = ++_version;
+			_current          = &snapshot;
 
-			/* append zero termination */
-			_ds->local_addr<char>()[src_len] = 0;
+			_release_unused_snapshots();
 
 			/* notify ROM clients that access the module */
 			for (Reader *r = _readers.first(); r; r = r->next()) {
@@ -274,20 +450,41 @@ struct Rom::Module : Module_list::Element, Readable_module
 		 */
 		size_t read_content(Reader const &reader, char *dst, size_t dst_len) const override
 		{
-			if (!_ds.constructed() || !_last_writer)
+			if (!_readable(reader))
 				return 0;
 
-			if (!_read_policy.read_permitted(*this, *_last_writer, reader))
-				return 0;
-
-			if (dst_len < _size)
+			if (dst_len < _current->_size)
 				throw Buffer_too_small();
 
-			Genode::memcpy(dst, _ds->local_addr<char>(), _size);
-			return _size;
+			Genode::memcpy(dst, _current->_ds.local_addr<char>(), _current->_size);
+			return _current->_size;
 		}
 
-		virtual size_t size() const override { return _size; }
+		size_t size() const override { return _current ? _current->_size : 0; }
+
+		Snapshot *acquire_snapshot(Reader const &reader) override
+		{
+			if (!_readable(reader))
+				return nullptr;
+
+			_current->_users++;
+			return _current;
+		}
+
+		void release_snapshot(Snapshot &snapshot) override
+		{
+			snapshot._users--;
+			_release_unused_snapshots();
+		}
+
+		bool current(Reader const &reader, Snapshot const *snapshot) const override
+		{
+			return snapshot == (_readable(reader) ? _current : nullptr);
+		}
+
+		bool snapshots_shared() const override { return _shared; }
+
+		unsigned long version() const { return _version; }
 
 		Name name() const { return _name; }
 };
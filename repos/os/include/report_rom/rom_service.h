@@ -51,10 +51,59 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 				throw Genode::Service_denied(); }
 		}
 
+		/**
+		 * Snapshot of the module content handed out to the client
+		 *
+		 * Used if the module shares its snapshots with the readers.
+		 * Otherwise, the client obtains a copy of the content in '_ds'.
+		 */
+		Snapshot *_snapshot = nullptr;
+
 		Constructible<Genode::Attached_ram_dataspace> _ds;
 
 		size_t _content_size = 0;
 
+		void _release_snapshot()
+		{
+			if (_snapshot)
+				_module.release_snapshot(*_snapshot);
+
+			_snapshot = nullptr;
+		}
+
+		Genode::Dataspace_capability _shared_dataspace()
+		{
+			/* switch to the snapshot of the current content */
+			_release_snapshot();
+			_snapshot = _module.acquire_snapshot(*this);
+
+			_valid = _snapshot && _snapshot->size() > 0;
+
+			if (_snapshot)
+				return _snapshot->ds();
+
+			/* no readable content */
+			if (!_ds.constructed())
+				_ds.construct(_ram, _rm, 1);
+
+			return _ds->cap();
+		}
+
+		Genode::Dataspace_capability _private_dataspace()
+		{
+			/* replace dataspace by new one */
+			/* XXX we could keep the old dataspace if the size fits */
+			_ds.construct(_ram, _rm, _module.size());
+
+			/* fill dataspace content with report contained in module */
+			_content_size =
+				_module.read_content(*this, _ds->local_addr<char>(), _ds->size());
+
+			_valid = _content_size > 0;
+
+			return _ds->cap();
+		}
+
 		/**
 		 * Keep state of valid content to notify the client only once when
 		 * the ROM module becomes invalid.
@@ -95,6 +144,7 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		~Session_component()
 		{
+			_release_snapshot();
 			_registry.release(*this, _module);
 		}
 
@@ -104,23 +154,23 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 		{
 			using namespace Genode;
 
-				/* replace dataspace by new one */
-				/* XXX we could keep the old dataspace if the size fits */
-				_ds.construct(_ram, _rm, _module.size());
-
-				/* fill dataspace content with report contained in module */
-				_content_size =
-					_module.read_content(*this, _ds->local_addr<char>(), _ds->size());
-
-				_valid = _content_size > 0;
+			Dataspace_capability const ds_cap = _module.snapshots_shared()
+			                                  ? _shared_dataspace()
+			                                  : _private_dataspace();
 
-				/* cast RAM into ROM dataspace capability */
-				Dataspace_capability ds_cap = static_cap_cast<Dataspace>(_ds->cap());
-				return static_cap_cast<Rom_dataspace>(ds_cap);
+			/* cast RAM into ROM dataspace capability */
+			return static_cap_cast<Rom_dataspace>(ds_cap);
 		}
 
 		bool update() override
 		{
+			/*
+			 * Snapshots are never modified. So the client has to obtain a
+			 * new dataspace whenever the content changed.
+			 */
+			if (_module.snapshots_shared())
+				return _module.current(*this, _snapshot);
+
 			if (!_ds.constructed() || _module.size() > _ds->size())
 				return false;
 
@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <base/allocator.h>
+#include <util/misc_math.h>
 
 
 /**
@@ -28,13 +29,33 @@
 template <typename CELL>
 class Cell_array
 {
+	public:
+
+		/**
+		 * Damage state of a line
+		 *
+		 * The 'origin' denotes the line at which the content of the line was
+		 * located when the array was marked as clean the last time. A
+		 * graphical back end can thereby implement scrolling by moving
+		 * already rendered pixels. An origin of -1 means that the whole line
+		 * must be redrawn. Modified cells are tracked as column range.
+		 */
+		struct Line_state
+		{
+			int      origin;
+			unsigned dirty_first;
+			unsigned dirty_last;
+
+			bool cells_dirty() const { return dirty_first <= dirty_last; }
+		};
+
 	private:
 
 		unsigned           _num_cols;
 		unsigned           _num_lines;
 		Genode::Allocator *_alloc;
 		CELL             **_array;
-		bool              *_line_dirty;
+		Line_state        *_line_state;
 
 		typedef CELL *Char_cell_line;
 
@@ -44,30 +65,44 @@ class Cell_array
 				*line++ = CELL();
 		}
 
-		void _mark_lines_as_dirty(int start, int end)
+		void _mark_cell_as_dirty(int column, int line)
 		{
-			for (int line = start; line <= end; line++)
-				_line_dirty[line] = true;
+			Line_state &state = _line_state[line];
+
+			if (!state.cells_dirty()) {
+				state.dirty_first = state.dirty_last = column;
+				return;
+			}
+			state.dirty_first = Genode::min(state.dirty_first, (unsigned)column);
+			state.dirty_last  = Genode::max(state.dirty_last,  (unsigned)column);
 		}
 
 		void _scroll_vertically(int start, int end, bool up)
 		{
 			/* rotate lines of the scroll region */
-			Char_cell_line yanked_line = _array[up ? start : end];
+			Char_cell_line yanked_line  = _array[up ? start : end];
 
 			if (up) {
-				for (int line = start; line <= end - 1; line++)
-					_array[line] = _array[line + 1];
+				for (int line = start; line <= end - 1; line++) {
+					_array[line]      = _array[line + 1];
+					_line_state[line] = _line_state[line + 1];
+				}
 			} else {
-				for (int line = end; line >= start + 1; line--)
-					_array[line] = _array[line - 1];
+				for (int line = end; line >= start + 1; line--) {
+					_array[line]      = _array[line - 1];
+					_line_state[line] = _line_state[line - 1];
+				}
 			}
 
 			_clear_line(yanked_line);
 
-			_array[up ? end: start] = yanked_line;
+			int const new_line = up ? end: start;
+
+			_array[new_line] = yanked_line;
 
-			_mark_lines_as_dirty(start, end);
+			/* the moved lines keep their origin, only the new line is dirty */
+			_line_state[new_line].origin = -1;
+			mark_line_as_dirty(new_line);
 		}
 
 	public:
@@ -81,9 +116,9 @@ class Cell_array
 		{
 			_array = new (alloc) Char_cell_line[num_lines];
 
-			_line_dirty = new (alloc) bool[num_lines];
+			_line_state = new (alloc) Line_state[num_lines];
 			for (unsigned i = 0; i < num_lines; i++)
-				_line_dirty[i] = false;
+				mark_line_as_clean(i);
 
 			for (unsigned i = 0; i < num_lines; i++)
 				_array[i] = new (alloc) CELL[num_cols];
@@ -94,14 +129,14 @@ class Cell_array
 			for (unsigned i = 0; i < _num_lines; i++)
 				Genode::destroy(_alloc, _array[i]);
 
-			Genode::destroy(_alloc, _line_dirty);
+			Genode::destroy(_alloc, _line_state);
 			Genode::destroy(_alloc, _array);
 		}
 
 		void set_cell(int column, int line, CELL cell)
 		{
 			_array[line][column] = cell;
-			_line_dirty[line] = true;
+			_mark_cell_as_dirty(column, line);
 		}
 
 		CELL get_cell(int column, int line)
@@ -109,16 +144,38 @@ class Cell_array
 			return _array[line][column];
 		}
 
-		bool line_dirty(int line) { return _line_dirty[line]; }
+		/**
+		 * Return true if the line changed since it was marked as clean
+		 */
+		bool line_dirty(int line)
+		{
+			Line_state const &state = _line_state[line];
+			return state.cells_dirty() || state.origin != line;
+		}
+
+		Line_state line_state(int line) const { return _line_state[line]; }
 
 		void mark_line_as_clean(int line)
 		{
-			_line_dirty[line] = false;
+			_line_state[line] = Line_state { line, 1, 0 };
 		}
 
 		void mark_line_as_dirty(int line)
 		{
-			_line_dirty[line] = true;
+			_line_state[line].dirty_first = 0;
+			_line_state[line].dirty_last  = _num_cols - 1;
+		}
+
+		/**
+		 * Request the complete redraw of a line
+		 *
+		 * In contrast to 'mark_line_as_dirty', the line's previous rendering
+		 * is not considered as valid.
+		 */
+		void invalidate_line(int line)
+		{
+			_line_state[line].origin = -1;
+			mark_line_as_dirty(line);
 		}
 
 		void scroll_up(int region_start, int region_end)
@@ -133,10 +190,10 @@ class Cell_array
 
 		void clear(int region_start, int region_end)
 		{
-			for (int line = region_start; line <= region_end; line++)
+			for (int line = region_start; line <= region_end; line++) {
 				_clear_line(_array[line]);
-
-			_mark_lines_as_dirty(region_start, region_end);
+				invalidate_line(line);
+			}
 		}
 
 		void cursor(Terminal::Position pos, bool enable, bool mark_dirty = false)
@@ -153,7 +210,7 @@ class Cell_array
 				cell.clear_cursor();
 
 			if (mark_dirty)
-				_line_dirty[pos.y] = true;
+				_mark_cell_as_dirty(pos.x, pos.y);
 		}
 
 		unsigned num_cols()  { return _num_cols; }
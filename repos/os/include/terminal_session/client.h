@@ -18,10 +18,14 @@
 #include <util/misc_math.h>
 #include <util/string.h>
 #include <base/lock.h>
+#include <base/log.h>
+#include <base/signal.h>
 #include <base/rpc_client.h>
 #include <base/attached_dataspace.h>
+#include <util/reconstructible.h>
 
 #include <terminal_session/terminal_session.h>
+#include <terminal_session/ring.h>
 
 namespace Terminal { class Session_client; }
 
@@ -38,28 +42,88 @@ class Terminal::Session_client : public Genode::Rpc_client<Session>
 		 */
 		Genode::Attached_dataspace _io_buffer;
 
+		/**
+		 * Shared-memory rings, used if supported by the server
+		 */
+		Genode::Constructible<Genode::Attached_dataspace> _ring_ds;
+
+		Genode::Signal_context_capability _ring_sigh;
+
+		Genode::Signal_context_capability _read_avail_sigh;
+
+		Rings &_rings() { return *_ring_ds->local_addr<Rings>(); }
+
+		void _init_rings(Genode::Region_map &local_rm)
+		{
+			Genode::Dataspace_capability const ds = call<Rpc_ring_dataspace>();
+			if (!ds.valid())
+				return;
+
+			_ring_ds.construct(local_rm, ds);
+			_ring_sigh = call<Rpc_ring_sigh>();
+		}
+
+		void _wakeup_server() { Genode::Signal_transmitter(_ring_sigh).submit(); }
+
+		/**
+		 * Stop using the rings after the server corrupted their counters
+		 */
+		void _ring_violated()
+		{
+			Genode::error("server corrupted the terminal rings, falling back to RPC");
+			_ring_ds.destruct();
+		}
+
 	public:
 
 		Session_client(Genode::Region_map &local_rm, Genode::Capability<Session> cap)
 		:
 			Genode::Rpc_client<Session>(cap),
 			_io_buffer(local_rm, call<Rpc_dataspace>())
-		{ }
+		{
+			_init_rings(local_rm);
+		}
 
 		Session_client(Genode::Capability<Session> cap) __attribute__((deprecated))
 		:
 			Genode::Rpc_client<Session>(cap),
 			_io_buffer(*Genode::env_deprecated()->rm_session(), call<Rpc_dataspace>())
-		{ }
+		{
+			_init_rings(*Genode::env_deprecated()->rm_session());
+		}
 
 		Size size() { return call<Rpc_size>(); }
 
-		bool avail() { return call<Rpc_avail>(); }
+		bool avail()
+		{
+			if (_ring_ds.constructed())
+				return _rings().to_client.avail() > 0;
+
+			return call<Rpc_avail>();
+		}
 
 		Genode::size_t read(void *buf, Genode::size_t buf_size)
 		{
 			Genode::Lock::Guard _guard(_lock);
 
+			if (_ring_ds.constructed()) try {
+				bool wakeup = false;
+				Genode::size_t const n = _rings().to_client.read(buf, buf_size, wakeup);
+				if (wakeup)
+					_wakeup_server();
+
+				/*
+				 * The server signals only if the ring becomes non-empty. For
+				 * clients that read once per signal, re-trigger the signal
+				 * while data is left.
+				 */
+				if (_rings().to_client.avail() && _read_avail_sigh.valid())
+					Genode::Signal_transmitter(_read_avail_sigh).submit();
+
+				return n;
+			}
+			catch (Ring::Protocol_violation) { _ring_violated(); }
+
 			/* instruct server to fill the I/O buffer */
 			Genode::size_t num_bytes = call<Rpc_read>(buf_size);
 
@@ -77,6 +141,19 @@ class Terminal::Session_client : public Genode::Rpc_client<Session>
 			Genode::size_t     written_bytes = 0;
 			char const * const src           = (char const *)buf;
 
+			/*
+			 * Write as much as possible to the ring. Only if the ring is
+			 * full, the remaining data is passed via the RPC interface, which
+			 * synchronizes the client with the server.
+			 */
+			if (_ring_ds.constructed()) try {
+				bool wakeup = false;
+				written_bytes = _rings().to_server.write(src, num_bytes, wakeup);
+				if (wakeup)
+					_wakeup_server();
+			}
+			catch (Ring::Protocol_violation) { _ring_violated(); }
+
 			while (written_bytes < num_bytes) {
 
 				/* copy payload to I/O buffer */
@@ -104,6 +181,7 @@ class Terminal::Session_client : public Genode::Rpc_client<Session>
 
 		void read_avail_sigh(Genode::Signal_context_capability cap)
 		{
+			_read_avail_sigh = cap;
 			call<Rpc_read_avail_sigh>(cap);
 		}
 
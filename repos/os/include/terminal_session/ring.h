@@ -0,0 +1,242 @@
+/*
+ * \brief  Shared-memory byte rings of a terminal session
+ * \author agent
+ * \date   2026-10-19
+ *
+ * Each ring has exactly one producer and one consumer, which live in
+ * different components. The producer only modifies the head counter, the
+ * consumer only modifies the tail counter. Both counters wrap naturally, the
+ * ring position is derived by masking.
+ *
+ * To keep the number of signals low, a party that runs out of work announces
+ * that it waits by setting a flag. The other party submits a wakeup only if
+ * it finds the flag set, i.e., on the transition from empty to non-empty
+ * (consumer waiting) or from full to non-full (producer waiting).
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__TERMINAL_SESSION__RING_H_
+#define _INCLUDE__TERMINAL_SESSION__RING_H_
+
+/* Genode includes */
+#include <base/exception.h>
+#include <util/misc_math.h>
+#include <util/string.h>
+#include <cpu/atomic.h>
+#include <cpu/memory_barrier.h>
+
+namespace Terminal {
+
+	class Ring;
+	struct Rings;
+}
+
+
+class Terminal::Ring
+{
+	public:
+
+		enum { CAPACITY = 32*1024 };   /* must be a power of two */
+
+		/**
+		 * The counters of the ring do not describe a valid fill level
+		 */
+		class Protocol_violation : Genode::Exception { };
+
+	private:
+
+		typedef Genode::size_t size_t;
+
+		unsigned long volatile _head = 0;
+		unsigned long volatile _tail = 0;
+
+		int volatile _consumer_waiting = 1;
+		int volatile _producer_waiting = 0;
+
+		char _data[CAPACITY];
+
+		static size_t _pos(unsigned long counter) { return counter & (CAPACITY - 1); }
+
+		/**
+		 * Return number of bytes in the ring
+		 *
+		 * The counters reside in memory shared with the other party, which
+		 * may have forged them.
+		 *
+		 * \throw Protocol_violation
+		 */
+		static size_t _used(unsigned long head, unsigned long tail)
+		{
+			if (head - tail > CAPACITY)
+				throw Protocol_violation();
+
+			return head - tail;
+		}
+
+		/**
+		 * Call 'fn' for the contiguous parts of the range [from, from + len)
+		 *
+		 * The functor returns the number of bytes it processed. The iteration
+		 * stops as soon as a part is not processed completely.
+		 *
+		 * \return number of processed bytes
+		 */
+		template <typename FN>
+		size_t _for_each_part(unsigned long from, size_t len, FN const &fn)
+		{
+			size_t const first  = Genode::min(len, (size_t)CAPACITY - _pos(from));
+			size_t const done   = fn(_data + _pos(from), first);
+
+			if (done < first || first == len)
+				return done;
+
+			return done + fn(_data, len - first);
+		}
+
+		size_t _write(char const *src, size_t len)
+		{
+			unsigned long const head = _head;
+			len = Genode::min(len, (size_t)CAPACITY - _used(head, _tail));
+
+			_for_each_part(head, len, [&] (char *dst, size_t n) {
+				Genode::memcpy(dst, src, n);
+				src += n;
+				return n;
+			});
+
+			/* publish data before the new head */
+			Genode::memory_barrier();
+			_head = head + len;
+			return len;
+		}
+
+		template <typename FN>
+		size_t _consume(size_t len, FN const &fn)
+		{
+			unsigned long const tail = _tail;
+			len = Genode::min(len, _used(_head, tail));
+
+			/* read head before data */
+			Genode::memory_barrier();
+
+			size_t const done = _for_each_part(tail, len, fn);
+
+			/* finish reading before releasing the space */
+			Genode::memory_barrier();
+			_tail = tail + done;
+			return done;
+		}
+
+		/*
+		 * Clearing the flag with 'cmpxchg' acts as full memory barrier
+		 * between the update of the own counter and the check of the flag.
+		 * Without it, the check could be ordered before the update becomes
+		 * visible, which would lose the wakeup.
+		 */
+		static bool _take_flag(int volatile &flag) { return Genode::cmpxchg(&flag, 1, 0); }
+		static void _set_flag (int volatile &flag) { Genode::cmpxchg(&flag, 0, 1); }
+
+	public:
+
+		/**
+		 * Return number of bytes available for reading
+		 *
+		 * A fill level beyond the capacity is reported by 'read' and
+		 * 'consume'.
+		 */
+		size_t avail() const {
+			return Genode::min((size_t)(_head - _tail), (size_t)CAPACITY); }
+
+		/**
+		 * Append bytes to the ring (producer side)
+		 *
+		 * \param wakeup  set to true if the consumer must be signalled
+		 *
+		 * \return number of bytes written
+		 *
+		 * \throw Protocol_violation
+		 */
+		size_t write(void const *src, size_t len, bool &wakeup)
+		{
+			char const *s = (char const *)src;
+
+			size_t n = _write(s, len);
+			if (n < len) {
+				/* announce that we wait, then look again to close the race */
+				_set_flag(_producer_waiting);
+				n += _write(s + n, len - n);
+			}
+
+			if (n && _take_flag(_consumer_waiting))
+				wakeup = true;
+
+			return n;
+		}
+
+		/**
+		 * Pass readable bytes to 'fn' without copying (consumer side)
+		 *
+		 * \param fn      functor called with 'char const *' and length,
+		 *                returning the number of bytes it took
+		 * \param wakeup  set to true if the producer must be signalled
+		 *
+		 * \return number of consumed bytes
+		 *
+		 * \throw Protocol_violation
+		 */
+		template <typename FN>
+		size_t consume(FN const &fn, bool &wakeup)
+		{
+			size_t n = _consume(~(size_t)0, fn);
+
+			if (avail() == 0) {
+				_set_flag(_consumer_waiting);
+				if (avail())
+					n += _consume(~(size_t)0, fn);
+			}
+
+			if (n && _take_flag(_producer_waiting))
+				wakeup = true;
+
+			return n;
+		}
+
+		/**
+		 * Copy bytes out of the ring (consumer side)
+		 *
+		 * \param wakeup  set to true if the producer must be signalled
+		 *
+		 * \return number of bytes read
+		 *
+		 * \throw Protocol_violation
+		 */
+		size_t read(void *dst, size_t len, bool &wakeup)
+		{
+			char *d = (char *)dst;
+
+			return consume([&] (char const *src, size_t n) {
+				n = Genode::min(n, len);
+				Genode::memcpy(d, src, n);
+				d += n; len -= n;
+				return n;
+			}, wakeup);
+		}
+};
+
+
+/**
+ * Layout of the ring dataspace shared between client and server
+ */
+struct Terminal::Rings
+{
+	Ring to_server;   /* written by the client */
+	Ring to_client;   /* written by the server */
+};
+
+#endif /* _INCLUDE__TERMINAL_SESSION__RING_H_ */
@@ -93,6 +93,32 @@ struct Terminal::Session : Genode::Session
 	 */
 	virtual void read_avail_sigh(Genode::Signal_context_capability cap) = 0;
 
+	/**
+	 * Request shared-memory rings for bulk transfers
+	 *
+	 * The returned dataspace has the layout of 'Terminal::Rings'. Servers
+	 * that do not support rings return an invalid capability, in which case
+	 * the client keeps using the RPC-based transfer.
+	 *
+	 * Once the ring dataspace was handed out, the server delivers all data to
+	 * be read by the client via the 'to_client' ring and submits the
+	 * read-avail signal when the client waits for data. Data written by the
+	 * client is accepted via the 'to_server' ring and via 'write'. The
+	 * latter consumes the ring content first so that the order of the
+	 * written data is retained.
+	 */
+	virtual Genode::Dataspace_capability _ring_dataspace() {
+		return Genode::Dataspace_capability(); }
+
+	/**
+	 * Return signal context used by the client to wake up the server
+	 *
+	 * The client submits the signal whenever the server waits for data in
+	 * the 'to_server' ring or for free space in the 'to_client' ring.
+	 */
+	virtual Genode::Signal_context_capability _ring_sigh() {
+		return Genode::Signal_context_capability(); }
+
 
 	/*******************
 	 ** RPC interface **
@@ -105,10 +131,12 @@ struct Terminal::Session : Genode::Session
 	GENODE_RPC(Rpc_connected_sigh, void, connected_sigh, Genode::Signal_context_capability);
 	GENODE_RPC(Rpc_read_avail_sigh, void, read_avail_sigh, Genode::Signal_context_capability);
 	GENODE_RPC(Rpc_dataspace, Genode::Dataspace_capability, _dataspace);
+	GENODE_RPC(Rpc_ring_dataspace, Genode::Dataspace_capability, _ring_dataspace);
+	GENODE_RPC(Rpc_ring_sigh, Genode::Signal_context_capability, _ring_sigh);
 
 	GENODE_RPC_INTERFACE(Rpc_size, Rpc_avail, Rpc_read, Rpc_write,
 	                     Rpc_connected_sigh, Rpc_read_avail_sigh,
-	                     Rpc_dataspace);
+	                     Rpc_dataspace, Rpc_ring_dataspace, Rpc_ring_sigh);
 };
 
 #endif /* _INCLUDE__TERMINAL_SESSION__TERMINAL_SESSION_H_ */
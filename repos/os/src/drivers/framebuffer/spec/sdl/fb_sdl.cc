@@ -15,7 +15,8 @@
 /* Genode includes */
 #include <base/attached_rom_dataspace.h>
 #include <base/component.h>
-#include <framebuffer_session/framebuffer_session.h>
+#include <base/attached_ram_dataspace.h>
+#include <framebuffer_session/damage.h>
 #include <input/root.h>
 #include <timer_session/connection.h>
 
@@ -49,6 +50,42 @@ class Framebuffer::Session_component : public Rpc_object<Session>
 
 		Timer::Connection _timer;
 
+		Attached_ram_dataspace _damage_ds;
+
+		/**
+		 * Copy pixels of clipped region to the SDL surface
+		 *
+		 * \return  false if the region lies outside the screen
+		 */
+		bool _copy(int x, int y, int w, int h, SDL_Rect &sdl_rect)
+		{
+			/* clip refresh area to screen boundaries */
+			int x1 = max(x, 0);
+			int y1 = max(y, 0);
+			int x2 = min(x + w - 1, _mode.width()  - 1);
+			int y2 = min(y + h - 1, _mode.height() - 1);
+
+			if (x1 > x2 || y1 > y2)
+				return false;
+
+			/* copy pixels from shared dataspace to sdl surface */
+			const int start_offset = _mode.bytes_per_pixel()*(y1*_mode.width() + x1);
+			const int line_len     = _mode.bytes_per_pixel()*(x2 - x1 + 1);
+			const int pitch        = _mode.bytes_per_pixel()*_mode.width();
+
+			char *src = (char *)_fb_ds_addr     + start_offset;
+			char *dst = (char *)_screen->pixels + start_offset;
+
+			for (int i = y1; i <= y2; i++, src += pitch, dst += pitch)
+				Genode::memcpy(dst, src, line_len);
+
+			sdl_rect.x = x1;
+			sdl_rect.y = y1;
+			sdl_rect.w = x2 - x1 + 1;
+			sdl_rect.h = y2 - y1 + 1;
+			return true;
+		}
+
 	public:
 
 		/**
@@ -57,7 +94,8 @@ class Framebuffer::Session_component : public Rpc_object<Session>
 		Session_component(Env &env, Framebuffer::Mode mode,
 		                  Dataspace_capability fb_ds_cap, void *fb_ds_addr)
 		:
-			_mode(mode), _fb_ds_cap(fb_ds_cap), _fb_ds_addr(fb_ds_addr), _timer(env)
+			_mode(mode), _fb_ds_cap(fb_ds_cap), _fb_ds_addr(fb_ds_addr), _timer(env),
+			_damage_ds(env.ram(), env.rm(), sizeof(Damage))
 		{ }
 
 		void screen(SDL_Surface *screen) { _screen = screen; }
@@ -77,28 +115,29 @@ class Framebuffer::Session_component : public Rpc_object<Session>
 
 		void refresh(int x, int y, int w, int h) override
 		{
-			/* clip refresh area to screen boundaries */
-			int x1 = max(x, 0);
-			int y1 = max(y, 0);
-			int x2 = min(x + w - 1, _mode.width()  - 1);
-			int y2 = min(y + h - 1, _mode.height() - 1);
+			SDL_Rect rect;
+			if (!_copy(x, y, w, h, rect))
+				return;
 
-			if (x1 <= x2 && y1 <= y2) {
+			/* flush pixels in sdl window */
+			SDL_UpdateRect(_screen, rect.x, rect.y, rect.w, rect.h);
+		}
 
-				/* copy pixels from shared dataspace to sdl surface */
-				const int start_offset = _mode.bytes_per_pixel()*(y1*_mode.width() + x1);
-				const int line_len     = _mode.bytes_per_pixel()*(x2 - x1 + 1);
-				const int pitch        = _mode.bytes_per_pixel()*_mode.width();
+		Dataspace_capability damage_dataspace() override { return _damage_ds.cap(); }
 
-				char *src = (char *)_fb_ds_addr     + start_offset;
-				char *dst = (char *)_screen->pixels + start_offset;
+		void refresh_batch() override
+		{
+			SDL_Rect rects[Damage::CAPACITY];
+			int      num = 0;
 
-				for (int i = y1; i <= y2; i++, src += pitch, dst += pitch)
-					Genode::memcpy(dst, src, line_len);
+			_damage_ds.local_addr<Damage const>()->for_each_merged(_mode,
+				[&] (int x, int y, int w, int h) {
+					if (_copy(x, y, w, h, rects[num]))
+						num++; });
 
-				/* flush pixels in sdl window */
-				SDL_UpdateRect(_screen, x1, y1, x2 - x1 + 1, y2 - y1 + 1);
-			}
+			/* flush all regions in sdl window at once */
+			if (num)
+				SDL_UpdateRects(_screen, num, rects);
 		}
 };
 
@@ -0,0 +1,92 @@
+/*
+ * \brief  Interface of the packet backends of the Linux NIC driver
+ * \author agent
+ * \date   2026-10-19
+ *
+ * A backend transfers Ethernet frames between the driver and the Linux
+ * host. All operations work on batches of packets so that a backend can
+ * use vectored system calls. Backends are non-blocking. The driver waits
+ * for incoming packets by watching the file descriptors reported by
+ * 'rx_fds'.
+ *
+ * A backend that is able to exchange offload metadata with the host reports
+ * this via 'offload'. For other backends, the driver completes checksums
+ * and segments large packets before transmission.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _DRIVERS__NIC__SPEC__LINUX__BACKEND_H_
+#define _DRIVERS__NIC__SPEC__LINUX__BACKEND_H_
+
+/* Genode includes */
+#include <base/stdint.h>
+#include <base/exception.h>
+#include <nic_session/nic_session.h>
+
+namespace Linux_nic {
+
+	using Genode::size_t;
+
+	struct Packet;
+	struct Backend;
+
+	/**
+	 * Exception type, thrown if a backend cannot be set up
+	 */
+	struct Backend_unavailable : Genode::Exception { };
+}
+
+
+struct Linux_nic::Packet
+{
+	char   *base;
+	size_t  size;   /* buffer capacity on receive, frame size otherwise */
+
+	Nic::Offload offload;
+};
+
+
+struct Linux_nic::Backend
+{
+	enum { MAX_FDS = 16 };
+
+	virtual ~Backend() { }
+
+	/**
+	 * Return true if the backend transfers offload metadata
+	 */
+	virtual bool offload() const { return false; }
+
+	/**
+	 * Return file descriptors that become readable on incoming packets
+	 *
+	 * \return number of file descriptors written to 'fds'
+	 *
+	 * A backend without file descriptors produces packets whenever the
+	 * driver asks for them.
+	 */
+	virtual unsigned rx_fds(int fds[], unsigned max) const = 0;
+
+	/**
+	 * Receive up to 'num' packets
+	 *
+	 * \return  number of received packets, the sizes of the packets are
+	 *          updated to the sizes of the received frames
+	 */
+	virtual unsigned receive(Packet packets[], unsigned num) = 0;
+
+	/**
+	 * Transmit 'num' packets
+	 *
+	 * Packets that cannot be transmitted are dropped.
+	 */
+	virtual void transmit(Packet const packets[], unsigned num) = 0;
+};
+
+#endif /* _DRIVERS__NIC__SPEC__LINUX__BACKEND_H_ */
@@ -7,12 +7,23 @@
  *
  * Configuration options are:
  *
+ * - Backend (default is "tap")
  * - TAP device to connect to (default is tap0)
+ * - Number of queues of a multi-queue TAP device (default is 1)
+ * - Use of virtio-net headers on the TAP device (default is no)
+ * - Socket path and peer socket path of the "socket" backend
+ * - Replayed and recorded files of the "pcap" backend
  * - MAC address (default is 02-00-00-00-00-01)
  *
  * These can be set in the config section as follows:
  *  <config>
- *  	<nic mac="12:23:34:45:56:67" tap="tap1"/>
+ *  	<nic mac="12:23:34:45:56:67" tap="tap1" queues="2" vnet_hdr="yes"/>
+ *  </config>
+ *
+ * The "socket" and "pcap" backends need no privileges on the host:
+ *  <config>
+ *  	<nic backend="socket" socket="nic0.sock" peer="nic1.sock"/>
+ *  	<nic backend="pcap" rx="in.pcap" tx="out.pcap" loops="0"/>
  *  </config>
  */
 
@@ -35,16 +46,19 @@
 #include <base/component.h>
 #include <base/heap.h>
 #include <base/thread.h>
+#include <base/lock.h>
+#include <base/semaphore.h>
 #include <base/log.h>
 #include <nic/root.h>
+#include <nic/offload.h>
+
+/* local includes */
+#include <tap_backend.h>
+#include <socket_backend.h>
+#include <pcap_backend.h>
 
 /* Linux */
-#include <errno.h>
-#include <unistd.h>
-#include <fcntl.h>
-#include <sys/ioctl.h>
-#include <net/if.h>
-#include <linux/if_tun.h>
+#include <poll.h>
 
 namespace Server {
 	using namespace Genode;
@@ -57,27 +71,67 @@ class Linux_session_component : public Nic::Session_component
 {
 	private:
 
+		enum { BATCH = 32, QUEUE_SIZE = Nic::Session::QUEUE_SIZE };
+
+		typedef Linux_nic::Packet  Packet;
+		typedef Linux_nic::Backend Backend;
+
+		/**
+		 * Thread that signals the arrival of packets to the entrypoint
+		 *
+		 * After signalling, the thread waits until the entrypoint has
+		 * drained the backend. Otherwise, each wakeup of 'poll' would
+		 * result in a signal as long as packets are pending.
+		 */
 		struct Rx_signal_thread : Genode::Thread
 		{
-			int                               fd;
+			int                               fds[Backend::MAX_FDS];
+			unsigned                          num_fds;
 			Genode::Signal_context_capability sigh;
 
-			Rx_signal_thread(Genode::Env &env, int fd, Genode::Signal_context_capability sigh)
-			: Genode::Thread(env, "rx_signal", 0x1000), fd(fd), sigh(sigh) { }
+			Genode::Lock      lock;
+			Genode::Semaphore drained;
+			bool              waiting = false;
+
+			Rx_signal_thread(Genode::Env &env, Backend const &backend,
+			                 Genode::Signal_context_capability sigh)
+			:
+				Genode::Thread(env, "rx_signal", 0x1000),
+				num_fds(backend.rx_fds(fds, Backend::MAX_FDS)), sigh(sigh)
+			{ }
+
+			/**
+			 * Called by the entrypoint once all pending packets are received
+			 */
+			void wakeup()
+			{
+				Genode::Lock::Guard guard(lock);
+				if (waiting) {
+					waiting = false;
+					drained.up();
+				}
+			}
 
 			void entry()
 			{
+				pollfd pfds[Backend::MAX_FDS];
+				for (unsigned i = 0; i < num_fds; i++)
+					pfds[i] = pollfd { fds[i], POLLIN, 0 };
+
 				while (true) {
-					/* wait for packet arrival on fd */
-					int    ret;
-					fd_set rfds;
+					/* wait for packet arrival on fds */
+					int ret;
+					do { ret = poll(pfds, num_fds, -1); } while (ret < 0);
 
-					FD_ZERO(&rfds);
-					FD_SET(fd, &rfds);
-					do { ret = select(fd + 1, &rfds, 0, 0, 0); } while (ret < 0);
+					{
+						Genode::Lock::Guard guard(lock);
+						waiting = true;
+					}
 
 					/* signal incoming packet */
 					Genode::Signal_transmitter(sigh).submit();
+
+					drained.down();
 				}
 			}
 		};
@@ -85,120 +139,235 @@ class Linux_session_component : public Nic::Session_component
 		Genode::Attached_rom_dataspace _config_rom;
 
 		Nic::Mac_address _mac_addr;
-		int              _tap_fd;
+
+		Genode::Constructible<Linux_nic::Tap_backend>    _tap;
+		Genode::Constructible<Linux_nic::Socket_backend> _socket;
+		Genode::Constructible<Linux_nic::Pcap_backend>   _pcap;
+
+		Backend &_backend;
+
 		Rx_signal_thread _rx_thread;
 
-		int _setup_tap_fd()
+		/* number of RX packets submitted to the client but not acknowledged */
+		unsigned _rx_in_flight = 0;
+
+		/*
+		 * Buffer for the software segmentation of large TCP packets for
+		 * backends without offload support
+		 */
+		enum { SEGMENT_BUF_SIZE = 96*1024 };
+
+		char _segment_buf[SEGMENT_BUF_SIZE];
+
+		Backend &_create_backend()
 		{
-			/* open TAP device */
-			int ret;
-			struct ifreq ifr;
-
-			int fd = open("/dev/net/tun", O_RDWR);
-			if (fd < 0) {
-				Genode::error("could not open /dev/net/tun: no virtual network emulation");
-				/* this error is fatal */
-				throw Genode::Exception();
+			using namespace Linux_nic;
+
+			Genode::Xml_node const config = _config_rom.xml();
+			Genode::Xml_node const nic = config.has_sub_node("nic")
+			                           ? config.sub_node("nic")
+			                           : Genode::Xml_node("<nic/>");
+
+			typedef Genode::String<16> Type;
+			Type const type = nic.attribute_value("backend", Type("tap"));
+
+			if (type == "socket") {
+				typedef Socket_backend::Path Path;
+				Path const path = nic.attribute_value("socket", Path("nic.sock"));
+				Path const peer = nic.attribute_value("peer",   path);
+				Genode::log("using socket \"", path, "\" with peer \"", peer, "\"");
+				_socket.construct(path, peer);
+				return *_socket;
 			}
 
-			/* set fd to non-blocking */
-			if (fcntl(fd, F_SETFL, O_NONBLOCK) < 0) {
-				Genode::error("could not set /dev/net/tun to non-blocking");
-				throw Genode::Exception();
+			if (type == "pcap") {
+				typedef Pcap_backend::Path Path;
+				Path     const rx    = nic.attribute_value("rx", Path());
+				Path     const tx    = nic.attribute_value("tx", Path());
+				unsigned const loops = nic.attribute_value("loops", 1U);
+				Genode::log("using pcap files rx=\"", rx, "\" tx=\"", tx, "\"");
+				_pcap.construct(rx, tx, loops);
+				return *_pcap;
 			}
 
-			Genode::memset(&ifr, 0, sizeof(ifr));
-			ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+			if (type != "tap")
+				Genode::warning("unknown backend \"", type, "\", using tap");
 
-			/* get tap device from config */
-			try {
-				Genode::Xml_node nic_node = _config_rom.xml().sub_node("nic");
-				nic_node.attribute("tap").value(ifr.ifr_name, sizeof(ifr.ifr_name));
-				Genode::log("using tap device \"", Genode::Cstring(ifr.ifr_name), "\"");
-			} catch (...) {
-				/* use tap0 if no config has been provided */
-				Genode::strncpy(ifr.ifr_name, "tap0", sizeof(ifr.ifr_name));
-				Genode::log("no config provided, using tap0");
-			}
+			/* use tap0 if no config has been provided */
+			Tap_backend::Name const name =
+				nic.attribute_value("tap", Tap_backend::Name("tap0"));
 
-			ret = ioctl(fd, TUNSETIFF, (void *) &ifr);
-			if (ret != 0) {
-				Genode::error("could not configure /dev/net/tun: no virtual network emulation");
-				close(fd);
-				/* this error is fatal */
-				throw Genode::Exception();
-			}
+			unsigned const queues   = nic.attribute_value("queues", 1U);
+			bool     const vnet_hdr = nic.attribute_value("vnet_hdr", false);
 
-			return fd;
+			Genode::log("using tap device \"", name, "\"");
+			_tap.construct(name, queues, vnet_hdr);
+			return *_tap;
 		}
 
-		bool _send()
+		/**
+		 * Transmit large packet of a client via a backend without offload
+		 */
+		void _transmit_segmented(Packet const &packet)
 		{
-			using namespace Genode;
+			Nic::Segmenter const segmenter(packet.base, packet.size, packet.offload);
 
-			if (!_tx.sink()->ready_to_ack())
-				return false;
+			Packet   segments[BATCH];
+			unsigned num = 0;
+			size_t   used = 0;
 
-			if (!_tx.sink()->packet_avail())
-				return false;
+			for (unsigned i = 0; i < segmenter.num_segments(); i++) {
 
-			Packet_descriptor packet = _tx.sink()->get_packet();
-			if (!packet.size()) {
-				warning("invalid tx packet");
-				return true;
+				size_t const size = segmenter.segment_size(i);
+
+				if (num == BATCH || used + size > SEGMENT_BUF_SIZE) {
+					_backend.transmit(segments, num);
+					num = 0; used = 0;
+				}
+
+				if (size > SEGMENT_BUF_SIZE) {
+					Genode::warning("dropping oversized tx packet");
+					return;
+				}
+
+				segmenter.write_segment(i, _segment_buf + used);
+				segments[num++] = Packet { _segment_buf + used, size };
+				used += size;
 			}
+			_backend.transmit(segments, num);
+		}
 
-			int ret;
+		void _send()
+		{
+			Packet                 packets[BATCH];
+			Nic::Packet_descriptor descriptors[BATCH];
 
-			/* non-blocking-write packet to TAP */
-			do {
-				ret = write(_tap_fd, _tx.sink()->packet_content(packet), packet.size());
-				/* drop packet if write would block */
-				if (ret < 0 && errno == EAGAIN)
-					continue;
+			bool const resolve = !_backend.offload();
 
-				if (ret < 0) Genode::error("write: errno=", errno);
-			} while (ret < 0);
+			for (;;) {
 
-			_tx.sink()->acknowledge_packet(packet);
+				/*
+				 * Each fetched packet must be acknowledged without blocking,
+				 * which limits the batch to the free acknowledgement slots.
+				 */
+				unsigned const max = Genode::min((unsigned)BATCH,
+				                                 _tx.sink()->ack_slots_free());
+				unsigned num = 0, fetched = 0;
 
-			return true;
+				while (fetched < max && _tx.sink()->packet_avail()) {
+
+					Nic::Packet_descriptor const packet = _tx.sink()->get_packet();
+					descriptors[fetched++] = packet;
+
+					char *content = _tx.sink()->packet_content(packet);
+					if (!packet.size() || !content) {
+						Genode::warning("invalid tx packet");
+						continue;
+					}
+
+					Packet const p { content, packet.size(), packet.offload() };
+
+					if (!resolve || !p.offload.pending()) {
+						packets[num++] = p;
+						continue;
+					}
+
+					if (!p.offload.gso()) {
+						Nic::complete_checksum(p.base, p.size, p.offload);
+						packets[num++] = Packet { p.base, p.size };
+						continue;
+					}
+
+					/* preserve the order of the transmitted packets */
+					_backend.transmit(packets, num);
+					num = 0;
+					_transmit_segmented(p);
+				}
+
+				if (!fetched)
+					return;
+
+				_backend.transmit(packets, num);
+
+				for (unsigned i = 0; i < fetched; i++)
+					_tx.sink()->acknowledge_packet(descriptors[i]);
+			}
 		}
 
+		/**
+		 * Receive packets until the backend is drained
+		 *
+		 * \return false if the reception stopped because the client has
+		 *         not yet processed enough packets
+		 */
 		bool _receive()
 		{
 			unsigned const max_size = Nic::Packet_allocator::DEFAULT_PACKET_SIZE;
 
-			if (!_rx.source()->ready_to_submit())
-				return false;
+			Packet                 packets[BATCH];
+			Nic::Packet_descriptor descriptors[BATCH];
 
-			Nic::Packet_descriptor p;
-			try {
-				p = _rx.source()->alloc_packet(max_size);
-			} catch (Session::Rx::Source::Packet_alloc_failed) { return false; }
+			for (;;) {
 
-			int size = read(_tap_fd, _rx.source()->packet_content(p), max_size);
-			if (size <= 0) {
-				_rx.source()->release_packet(p);
-				return false;
-			}
+				/*
+				 * Limit the batch such that submitting the received packets
+				 * never blocks.
+				 */
+				unsigned const max = Genode::min((unsigned)BATCH,
+				                                 QUEUE_SIZE - 1 - _rx_in_flight);
+				unsigned num = 0;
 
-			/* adjust packet size */
-			Nic::Packet_descriptor p_adjust(p.offset(), size);
-			_rx.source()->submit_packet(p_adjust);
+				for (; num < max; num++) {
+					try {
+						descriptors[num] = _rx.source()->alloc_packet(max_size);
+					} catch (Session::Rx::Source::Packet_alloc_failed) { break; }
 
-			return true;
+					packets[num] = Packet { _rx.source()->packet_content(descriptors[num]),
+					                        max_size };
+				}
+
+				unsigned const received = num ? _backend.receive(packets, num) : 0;
+
+				for (unsigned i = 0; i < received; i++) {
+
+					/* adjust packet size */
+					Nic::Packet_descriptor p(descriptors[i].offset(), packets[i].size);
+
+					/* hand out offload metadata only if the client supports it */
+					if (_client_offload)
+						p.offload(packets[i].offload);
+					else
+						Nic::complete_checksum(packets[i].base, packets[i].size,
+						                       packets[i].offload);
+
+					_rx.source()->submit_packet(p);
+					_rx_in_flight++;
+				}
+
+				for (unsigned i = received; i < num; i++)
+					_rx.source()->release_packet(descriptors[i]);
+
+				if (received < num)
+					return true;
+
+				if (num < BATCH)
+					return false;
+			}
 		}
 
 	protected:
 
 		void _handle_packet_stream() override
 		{
-			while (_rx.source()->ack_avail())
+			while (_rx.source()->ack_avail()) {
 				_rx.source()->release_packet(_rx.source()->get_acked_packet());
+				_rx_in_flight--;
+			}
+
+			_send();
 
-			while (_send()) ;
-			while (_receive()) ;
+			if (_receive())
+				_rx_thread.wakeup();
 		}
 
 	public:
@@ -210,7 +379,8 @@ class Linux_session_component : public Nic::Session_component
 		:
 			Session_component(tx_buf_size, rx_buf_size, rx_block_md_alloc, env),
 			_config_rom(env, "config"),
-			_tap_fd(_setup_tap_fd()), _rx_thread(env, _tap_fd, _packet_stream_dispatcher)
+			_backend(_create_backend()),
+			_rx_thread(env, _backend, _packet_stream_dispatcher)
 		{
 			/* try using configured MAC address */
 			try {
@@ -227,11 +397,24 @@ class Linux_session_component : public Nic::Session_component
 				_mac_addr.addr[5] = 0x01;
 			}
 
-			_rx_thread.start();
+			/*
+			 * A backend without file descriptors produces packets on
+			 * demand, driven by the packet-stream signals of the client.
+			 */
+			if (_rx_thread.num_fds)
+				_rx_thread.start();
+			else
+				Genode::Signal_transmitter(_packet_stream_dispatcher).submit();
 		}
 
 	bool link_state() override              { return true; }
 	Nic::Mac_address mac_address() override { return _mac_addr; }
+
+	/*
+	 * Packets with offload metadata are resolved in software if the
+	 * backend does not support them
+	 */
+	bool offload_supported() override { return true; }
 };
 
 
@@ -0,0 +1,274 @@
+/*
+ * \brief  Backend replaying and recording packets from and to pcap files
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The backend delivers the frames of a pcap file as received packets and
+ * appends transmitted frames to another pcap file. It needs no network
+ * access at all and produces packets as fast as the client consumes them.
+ * Transmitted frames of one batch are written with a single 'writev'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _DRIVERS__NIC__SPEC__LINUX__PCAP_BACKEND_H_
+#define _DRIVERS__NIC__SPEC__LINUX__PCAP_BACKEND_H_
+
+/* Genode includes */
+#include <base/log.h>
+#include <util/string.h>
+
+/* local includes */
+#include <backend.h>
+
+/* Linux includes */
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+
+namespace Linux_nic { class Pcap_backend; }
+
+
+class Linux_nic::Pcap_backend : public Backend
+{
+	public:
+
+		typedef Genode::String<256> Path;
+
+	private:
+
+		typedef Genode::uint32_t uint32_t;
+		typedef Genode::uint16_t uint16_t;
+
+		enum { MAGIC         = 0xa1b2c3d4,
+		       MAGIC_NSEC    = 0xa1b23c4d,
+		       LINKTYPE_ETH  = 1,
+		       SNAPLEN       = 65535,
+		       BATCH         = 64 };
+
+		struct File_header
+		{
+			uint32_t magic;
+			uint16_t version_major, version_minor;
+			uint32_t thiszone, sigfigs, snaplen, linktype;
+		} __attribute__((packed));
+
+		struct Record_header
+		{
+			uint32_t ts_sec, ts_usec, incl_len, orig_len;
+		} __attribute__((packed));
+
+		static uint32_t _swap(uint32_t v) { return __builtin_bswap32(v); }
+
+		/*
+		 * Replayed file, mapped as a whole
+		 */
+		char const *_rx_base = nullptr;
+		size_t      _rx_size = 0;
+		size_t      _rx_pos  = 0;
+		bool        _rx_swap = false;
+
+		unsigned _loops;   /* remaining replays, 0 for infinite */
+
+		int _tx_fd = -1;
+
+		void _map_rx_file(Path const &path)
+		{
+			int const fd = open(path.string(), O_RDONLY);
+			if (fd < 0) {
+				Genode::error("could not open ", path, ": errno=", errno);
+				throw Backend_unavailable();
+			}
+
+			struct stat st;
+			if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(File_header)) {
+				Genode::error(path, " is not a pcap file");
+				close(fd);
+				throw Backend_unavailable();
+			}
+
+			void *base = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			close(fd);
+
+			if (base == MAP_FAILED) {
+				Genode::error("could not map ", path, ": errno=", errno);
+				throw Backend_unavailable();
+			}
+
+			_rx_base = (char const *)base;
+			_rx_size = st.st_size;
+
+			File_header const &header = *(File_header const *)_rx_base;
+
+			uint32_t const magic = header.magic;
+			_rx_swap = (magic == _swap(MAGIC) || magic == _swap(MAGIC_NSEC));
+
+			uint32_t const linktype = _rx_swap ? _swap(header.linktype)
+			                                   : header.linktype;
+
+			if ((!_rx_swap && magic != MAGIC && magic != MAGIC_NSEC)
+			 || linktype != LINKTYPE_ETH) {
+				Genode::error(path, " is not a pcap file of Ethernet frames");
+				munmap((void *)_rx_base, _rx_size);
+				throw Backend_unavailable();
+			}
+
+			_rx_pos = sizeof(File_header);
+		}
+
+		void _open_tx_file(Path const &path)
+		{
+			_tx_fd = open(path.string(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+			if (_tx_fd < 0) {
+				Genode::error("could not create ", path, ": errno=", errno);
+				throw Backend_unavailable();
+			}
+
+			File_header const header { MAGIC, 2, 4, 0, 0, SNAPLEN, LINKTYPE_ETH };
+			if (write(_tx_fd, &header, sizeof(header)) != sizeof(header))
+				Genode::error("could not write pcap header to ", path);
+		}
+
+		/**
+		 * Return next record of the replayed file, or nullptr at the end
+		 */
+		Record_header const *_next_record()
+		{
+			for (;;) {
+				if (_rx_pos + sizeof(Record_header) <= _rx_size) {
+
+					Record_header const &record =
+						*(Record_header const *)(_rx_base + _rx_pos);
+
+					size_t const len = _rx_swap ? _swap(record.incl_len)
+					                            : record.incl_len;
+
+					if (_rx_pos + sizeof(Record_header) + len <= _rx_size)
+						return &record;
+				}
+
+				/* end of file reached, start over if replays are left */
+				bool const no_records = (_rx_pos == sizeof(File_header));
+				if (_loops == 1 || no_records)
+					return nullptr;
+
+				if (_loops)
+					_loops--;
+
+				_rx_pos = sizeof(File_header);
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param rx     pcap file to replay, or invalid path
+		 * \param tx     pcap file to record to, or invalid path
+		 * \param loops  number of replays of the 'rx' file, 0 for infinite
+		 *
+		 * \throw Backend_unavailable
+		 */
+		Pcap_backend(Path const &rx, Path const &tx, unsigned loops)
+		:
+			_loops(loops)
+		{
+			if (rx.valid())
+				_map_rx_file(rx);
+
+			try {
+				if (tx.valid())
+					_open_tx_file(tx);
+			} catch (...) {
+				if (_rx_base)
+					munmap((void *)_rx_base, _rx_size);
+				throw;
+			}
+		}
+
+		~Pcap_backend()
+		{
+			if (_rx_base)
+				munmap((void *)_rx_base, _rx_size);
+
+			if (_tx_fd >= 0)
+				close(_tx_fd);
+		}
+
+
+		/*************
+		 ** Backend **
+		 *************/
+
+		unsigned rx_fds(int [], unsigned) const override { return 0; }
+
+		unsigned receive(Packet packets[], unsigned num) override
+		{
+			if (!_rx_base)
+				return 0;
+
+			unsigned received = 0;
+			for (; received < num; received++) {
+
+				Record_header const *record = _next_record();
+				if (!record)
+					break;
+
+				size_t const len = _rx_swap ? _swap(record->incl_len)
+				                            : record->incl_len;
+
+				Packet &packet = packets[received];
+				packet.size = Genode::min(len, packet.size);
+				Genode::memcpy(packet.base, record + 1, packet.size);
+
+				_rx_pos += sizeof(Record_header) + len;
+			}
+			return received;
+		}
+
+		void transmit(Packet const packets[], unsigned num) override
+		{
+			if (_tx_fd < 0)
+				return;
+
+			timeval tv;
+			gettimeofday(&tv, nullptr);
+
+			Record_header records[BATCH];
+			iovec         iovs[2*BATCH];
+
+			while (num) {
+
+				unsigned const batch = Genode::min(num, (unsigned)BATCH);
+
+				for (unsigned i = 0; i < batch; i++) {
+
+					uint32_t const len = packets[i].size;
+
+					records[i] = { (uint32_t)tv.tv_sec, (uint32_t)tv.tv_usec,
+					               len, len };
+
+					iovs[2*i]     = { &records[i], sizeof(records[i]) };
+					iovs[2*i + 1] = { packets[i].base, packets[i].size };
+				}
+
+				if (writev(_tx_fd, iovs, 2*batch) < 0)
+					Genode::error("writev: errno=", errno);
+
+				packets += batch;
+				num     -= batch;
+			}
+		}
+};
+
+#endif /* _DRIVERS__NIC__SPEC__LINUX__PCAP_BACKEND_H_ */
@@ -0,0 +1,177 @@
+/*
+ * \brief  Backend using a Unix-domain datagram socket
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The backend binds a datagram socket to a path in the host file system
+ * and sends all frames to a peer socket. It requires no privileges. Two
+ * drivers can be connected with each other by using each other's socket as
+ * peer. A driver whose peer is its own socket reflects all transmitted
+ * frames, which is useful for benchmarking the packet path. Frames are
+ * transferred in batches via 'sendmmsg' and 'recvmmsg'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _DRIVERS__NIC__SPEC__LINUX__SOCKET_BACKEND_H_
+#define _DRIVERS__NIC__SPEC__LINUX__SOCKET_BACKEND_H_
+
+/* Genode includes */
+#include <base/log.h>
+#include <util/string.h>
+
+/* local includes */
+#include <backend.h>
+
+/* Linux includes */
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace Linux_nic { class Socket_backend; }
+
+
+class Linux_nic::Socket_backend : public Backend
+{
+	public:
+
+		typedef Genode::String<sizeof(sockaddr_un::sun_path)> Path;
+
+	private:
+
+		enum { BATCH = 64 };
+
+		int _fd = -1;
+
+		sockaddr_un _local, _peer;
+
+		static sockaddr_un _addr(Path const &path)
+		{
+			sockaddr_un addr;
+			Genode::memset(&addr, 0, sizeof(addr));
+			addr.sun_family = AF_UNIX;
+			Genode::strncpy(addr.sun_path, path.string(), sizeof(addr.sun_path));
+			return addr;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param path  path of the socket of the driver
+		 * \param peer  path of the socket frames are sent to
+		 *
+		 * \throw Backend_unavailable
+		 */
+		Socket_backend(Path const &path, Path const &peer)
+		{
+			_fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+			if (_fd < 0) {
+				Genode::error("could not create socket: errno=", errno);
+				throw Backend_unavailable();
+			}
+
+			_local = _addr(path);
+
+			/* remove stale socket of a previous run */
+			unlink(_local.sun_path);
+
+			if (bind(_fd, (sockaddr const *)&_local, sizeof(_local)) != 0) {
+				Genode::error("could not bind socket to ", path, ": errno=", errno);
+				close(_fd);
+				throw Backend_unavailable();
+			}
+
+			/*
+			 * The peer may not exist yet. Instead of connecting the socket,
+			 * each message is addressed to the peer.
+			 */
+			_peer = _addr(peer);
+		}
+
+		~Socket_backend()
+		{
+			close(_fd);
+			unlink(_local.sun_path);
+		}
+
+
+		/*************
+		 ** Backend **
+		 *************/
+
+		unsigned rx_fds(int fds[], unsigned max) const override
+		{
+			if (max == 0)
+				return 0;
+
+			fds[0] = _fd;
+			return 1;
+		}
+
+		unsigned receive(Packet packets[], unsigned num) override
+		{
+			mmsghdr msgs[BATCH];
+			iovec   iovs[BATCH];
+
+			num = Genode::min(num, (unsigned)BATCH);
+
+			for (unsigned i = 0; i < num; i++) {
+				iovs[i] = { packets[i].base, packets[i].size };
+				Genode::memset(&msgs[i], 0, sizeof(msgs[i]));
+				msgs[i].msg_hdr.msg_iov    = &iovs[i];
+				msgs[i].msg_hdr.msg_iovlen = 1;
+			}
+
+			int const ret = recvmmsg(_fd, msgs, num, MSG_DONTWAIT, nullptr);
+			if (ret <= 0)
+				return 0;
+
+			for (int i = 0; i < ret; i++)
+				packets[i].size = msgs[i].msg_len;
+
+			return ret;
+		}
+
+		void transmit(Packet const packets[], unsigned num) override
+		{
+			mmsghdr msgs[BATCH];
+			iovec   iovs[BATCH];
+
+			while (num) {
+
+				unsigned const batch = Genode::min(num, (unsigned)BATCH);
+
+				for (unsigned i = 0; i < batch; i++) {
+					iovs[i] = { packets[i].base, packets[i].size };
+					Genode::memset(&msgs[i], 0, sizeof(msgs[i]));
+					msgs[i].msg_hdr.msg_name    = &_peer;
+					msgs[i].msg_hdr.msg_namelen = sizeof(_peer);
+					msgs[i].msg_hdr.msg_iov     = &iovs[i];
+					msgs[i].msg_hdr.msg_iovlen  = 1;
+				}
+
+				int const ret = sendmmsg(_fd, msgs, batch, MSG_DONTWAIT);
+
+				/*
+				 * The remainder of the batch is dropped if the peer does
+				 * not exist or its receive queue is full.
+				 */
+				if (ret < 0 && errno != EAGAIN && errno != ENOENT
+				 && errno != ECONNREFUSED)
+					Genode::error("sendmmsg: errno=", errno);
+
+				packets += batch;
+				num     -= batch;
+			}
+		}
+};
+
+#endif /* _DRIVERS__NIC__SPEC__LINUX__SOCKET_BACKEND_H_ */
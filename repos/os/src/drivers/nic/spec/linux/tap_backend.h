@@ -0,0 +1,302 @@
+/*
+ * \brief  Backend for Linux TUN/TAP devices
+ * \author agent
+ * \date   2026-10-19
+ *
+ * A TAP device created with 'IFF_MULTI_QUEUE' can be opened several times,
+ * each file descriptor representing one queue. The kernel distributes
+ * received flows over the queues. Transmitted packets are distributed by a
+ * hash of their flow.
+ *
+ * With 'IFF_VNET_HDR', each frame is preceded by a virtio-net header, which
+ * is translated to and from the offload metadata of the packets. The
+ * backend announces the support of partial checksums to the kernel, which
+ * thereby skips the checksum computation of locally generated packets.
+ * Large TCP packets are accepted for transmission. Received large packets
+ * are not enabled because the receive buffers hold one MTU-sized frame
+ * only, so the kernel segments such packets before handing them out.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _DRIVERS__NIC__SPEC__LINUX__TAP_BACKEND_H_
+#define _DRIVERS__NIC__SPEC__LINUX__TAP_BACKEND_H_
+
+/* Genode includes */
+#include <base/log.h>
+#include <util/string.h>
+
+/* local includes */
+#include <backend.h>
+
+/* Linux includes */
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <net/if.h>
+#include <linux/if_tun.h>
+
+namespace Linux_nic { class Tap_backend; }
+
+
+class Linux_nic::Tap_backend : public Backend
+{
+	public:
+
+		typedef Genode::String<IFNAMSIZ> Name;
+
+	private:
+
+		enum { MAX_QUEUES = MAX_FDS };
+
+		/*
+		 * Header preceding each frame if 'IFF_VNET_HDR' is used
+		 *
+		 * The layout corresponds to 'struct virtio_net_hdr' of the Linux
+		 * headers, which cannot be included from C++ code.
+		 */
+		struct Vnet_hdr
+		{
+			enum { F_NEEDS_CSUM = 1, F_DATA_VALID = 2,
+			       GSO_NONE = 0, GSO_TCPV4 = 1 };
+
+			Genode::uint8_t  flags;
+			Genode::uint8_t  gso_type;
+			Genode::uint16_t hdr_len;
+			Genode::uint16_t gso_size;
+			Genode::uint16_t csum_start;
+			Genode::uint16_t csum_offset;
+		} __attribute__((packed));
+
+		bool const _vnet_hdr;
+
+		int      _fds[MAX_QUEUES];
+		unsigned _num_queues = 0;
+
+		unsigned _rx_queue = 0;   /* queue to drain first at the next receive */
+
+		int _open_queue(Name const &name, bool multi_queue)
+		{
+			int fd = open("/dev/net/tun", O_RDWR);
+			if (fd < 0) {
+				Genode::error("could not open /dev/net/tun: no virtual network emulation");
+				throw Backend_unavailable();
+			}
+
+			/* set fd to non-blocking */
+			if (fcntl(fd, F_SETFL, O_NONBLOCK) < 0) {
+				Genode::error("could not set /dev/net/tun to non-blocking");
+				close(fd);
+				throw Backend_unavailable();
+			}
+
+			struct ifreq ifr;
+			Genode::memset(&ifr, 0, sizeof(ifr));
+			ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+
+			if (multi_queue) ifr.ifr_flags |= IFF_MULTI_QUEUE;
+			if (_vnet_hdr)   ifr.ifr_flags |= IFF_VNET_HDR;
+
+			Genode::strncpy(ifr.ifr_name, name.string(), sizeof(ifr.ifr_name));
+
+			if (ioctl(fd, TUNSETIFF, (void *) &ifr) != 0) {
+				Genode::error("could not configure /dev/net/tun: no virtual network emulation");
+				close(fd);
+				throw Backend_unavailable();
+			}
+
+			if (_vnet_hdr && ioctl(fd, TUNSETOFFLOAD, TUN_F_CSUM) != 0)
+				Genode::warning("could not enable checksum offloading of ", name);
+
+			return fd;
+		}
+
+		/**
+		 * Return hash of the flow of a frame for selecting the TX queue
+		 *
+		 * The hash covers the Ethernet addresses and, for IPv4, the IP
+		 * addresses and the first four bytes of the transport header, which
+		 * are the ports of TCP and UDP.
+		 */
+		static unsigned _flow_hash(Packet const &packet)
+		{
+			enum { ETH_HDR = 14, ETH_TYPE = 12, IP_ADDRS = 12, IP_ADDRS_LEN = 8 };
+
+			unsigned char const *data = (unsigned char const *)packet.base;
+
+			Genode::uint32_t hash = 2166136261u;
+			auto hash_bytes = [&] (size_t offset, size_t len) {
+				for (size_t i = offset; i < offset + len && i < packet.size; i++)
+					hash = (hash ^ data[i])*16777619u; };
+
+			hash_bytes(0, 12);
+
+			bool const ipv4 = packet.size > ETH_HDR
+			               && data[ETH_TYPE] == 0x08 && data[ETH_TYPE + 1] == 0x00;
+			if (ipv4) {
+				size_t const ihl = (data[ETH_HDR] & 0xf)*4;
+				hash_bytes(ETH_HDR + IP_ADDRS, IP_ADDRS_LEN);
+				hash_bytes(ETH_HDR + ihl, 4);
+			}
+			return hash;
+		}
+
+		/**
+		 * Receive one packet from queue 'fd'
+		 *
+		 * \return false if no packet is pending
+		 */
+		bool _receive(int fd, Packet &packet)
+		{
+			for (;;) {
+				Vnet_hdr hdr { };
+
+				iovec iov[2] = { { &hdr, sizeof(hdr) },
+				                 { packet.base, packet.size } };
+
+				ssize_t const ret = _vnet_hdr ? readv(fd, iov, 2)
+				                              : read(fd, packet.base, packet.size);
+				if (ret <= 0)
+					return false;
+
+				if (!_vnet_hdr) {
+					packet.size = ret;
+					return true;
+				}
+
+				if ((size_t)ret < sizeof(hdr))
+					continue;
+
+				/* segmentation offloading is not enabled */
+				if (hdr.gso_type != Vnet_hdr::GSO_NONE) {
+					Genode::warning("dropping unexpected GSO packet");
+					continue;
+				}
+
+				packet.size    = ret - sizeof(hdr);
+				packet.offload = Nic::Offload();
+
+				if (hdr.flags & Vnet_hdr::F_NEEDS_CSUM) {
+					packet.offload.flags      |= Nic::Offload::CSUM_PARTIAL;
+					packet.offload.csum_start  = hdr.csum_start;
+					packet.offload.csum_offset = hdr.csum_offset;
+				}
+				if (hdr.flags & Vnet_hdr::F_DATA_VALID)
+					packet.offload.flags |= Nic::Offload::CSUM_VALID;
+
+				return true;
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param name        name of the TAP device
+		 * \param num_queues  number of queues, a value higher than one
+		 *                    requires a multi-queue TAP device
+		 * \param vnet_hdr    use virtio-net headers
+		 *
+		 * \throw Backend_unavailable
+		 */
+		Tap_backend(Name const &name, unsigned num_queues, bool vnet_hdr)
+		:
+			_vnet_hdr(vnet_hdr)
+		{
+			num_queues = Genode::max(1U, Genode::min(num_queues, (unsigned)MAX_QUEUES));
+
+			try {
+				for (unsigned i = 0; i < num_queues; i++)
+					_fds[_num_queues++] = _open_queue(name, num_queues > 1);
+			} catch (...) {
+				for (unsigned i = 0; i < _num_queues; i++)
+					close(_fds[i]);
+				throw;
+			}
+		}
+
+		~Tap_backend()
+		{
+			for (unsigned i = 0; i < _num_queues; i++)
+				close(_fds[i]);
+		}
+
+
+		/*************
+		 ** Backend **
+		 *************/
+
+		bool offload() const override { return _vnet_hdr; }
+
+		unsigned rx_fds(int fds[], unsigned max) const override
+		{
+			unsigned i = 0;
+			for (; i < _num_queues && i < max; i++)
+				fds[i] = _fds[i];
+			return i;
+		}
+
+		unsigned receive(Packet packets[], unsigned num) override
+		{
+			/*
+			 * Drain the queues in round-robin fashion, starting at a
+			 * different queue each time to prevent starvation.
+			 */
+			unsigned received = 0, idle = 0;
+			for (unsigned q = _rx_queue; received < num && idle < _num_queues;
+			     q = (q + 1) % _num_queues) {
+
+				if (_receive(_fds[q], packets[received])) {
+					received++;
+					idle = 0;
+				} else {
+					idle++;
+				}
+			}
+			_rx_queue = (_rx_queue + 1) % _num_queues;
+			return received;
+		}
+
+		void transmit(Packet const packets[], unsigned num) override
+		{
+			for (unsigned i = 0; i < num; i++) {
+
+				Packet       const &packet  = packets[i];
+				Nic::Offload const &offload = packet.offload;
+
+				Vnet_hdr hdr { };
+				if (offload.csum_partial()) {
+					hdr.flags       = Vnet_hdr::F_NEEDS_CSUM;
+					hdr.csum_start  = offload.csum_start;
+					hdr.csum_offset = offload.csum_offset;
+				}
+				if (offload.gso_type == Nic::Offload::GSO_TCPV4) {
+					hdr.gso_type = Vnet_hdr::GSO_TCPV4;
+					hdr.gso_size = offload.gso_size;
+				}
+
+				int const fd = _num_queues > 1
+				             ? _fds[_flow_hash(packet) % _num_queues] : _fds[0];
+
+				iovec iov[2] = { { &hdr, sizeof(hdr) },
+				                 { packet.base, packet.size } };
+
+				ssize_t const ret = _vnet_hdr ? writev(fd, iov, 2)
+				                              : write(fd, packet.base, packet.size);
+
+				/* drop packet if write would block */
+				if (ret < 0 && errno != EAGAIN)
+					Genode::error("write: errno=", errno);
+			}
+		}
+};
+
+#endif /* _DRIVERS__NIC__SPEC__LINUX__TAP_BACKEND_H_ */
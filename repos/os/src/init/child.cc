@@ -15,8 +15,72 @@
 #include <child.h>
 
 
+/**
+ * Return true if the sub nodes of the given type differ
+ */
+static bool sub_node_differs(Genode::Xml_node old_node, Genode::Xml_node new_node,
+                             char const *type)
+{
+	bool const old_present = old_node.has_sub_node(type);
+	bool const new_present = new_node.has_sub_node(type);
+
+	if (!old_present || !new_present)
+		return old_present != new_present;
+
+	Genode::Xml_node const o = old_node.sub_node(type);
+	Genode::Xml_node const n = new_node.sub_node(type);
+
+	return o.size() != n.size() || Genode::memcmp(o.addr(), n.addr(), o.size());
+}
+
+
+/**
+ * Return true if the start nodes differ in resources that cannot be changed
+ * without restarting the child
+ */
+static bool incompatible_resources(Genode::Xml_node old_start,
+                                   Genode::Xml_node new_start)
+{
+	using namespace Init;
+
+	typedef String<32> Value;
+
+	if (old_start.attribute_value("priority", Value())
+	 != new_start.attribute_value("priority", Value()))
+		return true;
+
+	if (sub_node_differs(old_start, new_start, "affinity"))
+		return true;
+
+	struct Fixed_resources
+	{
+		Value cpu_quantum, constrain_phys;
+
+		Fixed_resources(Xml_node start)
+		{
+			start.for_each_sub_node("resource", [&] (Xml_node rsc) {
+
+				typedef String<8> Name;
+				Name const name = rsc.attribute_value("name", Name());
+
+				if (name == "CPU")
+					cpu_quantum = rsc.attribute_value("quantum", Value());
+
+				if (name == "RAM")
+					constrain_phys = rsc.attribute_value("constrain_phys", Value());
+			});
+		}
+	};
+
+	Fixed_resources const old_rsc(old_start), new_rsc(new_start);
+
+	return old_rsc.cpu_quantum    != new_rsc.cpu_quantum
+	    || old_rsc.constrain_phys != new_rsc.constrain_phys;
+}
+
+
 Init::Child::Apply_config_result
-Init::Child::apply_config(Xml_node start_node)
+Init::Child::apply_config(Xml_node start_node, bool routing_changed)
 {
 	if (_state == STATE_ABANDONED)
 		return NO_SIDE_EFFECTS;
@@ -30,6 +94,19 @@ Init::Child::apply_config(Xml_node start_node)
 		return MAY_HAVE_SIDE_EFFECTS;
 	}
 
+	bool const start_node_changed =
+		start_node.size() != _start_node->xml().size() ||
+		Genode::memcmp(start_node.addr(), _start_node->xml().addr(),
+		               start_node.size()) != 0;
+
+	/*
+	 * Nothing to do if neither the start node nor the routing environment
+	 * changed. This is the common case for all unaffected children of a
+	 * large scenario.
+	 */
+	if (!start_node_changed && !routing_changed)
+		return NO_SIDE_EFFECTS;
+
 	bool provided_services_changed = false;
 
 	enum Config_update { CONFIG_APPEARED, CONFIG_VANISHED,
@@ -38,10 +115,10 @@ Init::Child::apply_config(Xml_node start_node)
 	Config_update config_update = CONFIG_UNCHANGED;
 
 	/* import new start node if new version differs */
-	if (start_node.size() != _start_node->xml().size() ||
-	    Genode::memcmp(start_node.addr(), _start_node->xml().addr(),
-	                   start_node.size()) != 0)
+	if (start_node_changed)
 	{
+		Xml_node const old_start_node = _start_node->xml();
+
 		/*
 		 * Check for a change of the version attribute, force restart
 		 * if the version changed.
@@ -51,13 +128,36 @@ Init::Child::apply_config(Xml_node start_node)
 			return MAY_HAVE_SIDE_EFFECTS;
 		}
 
+		/*
+		 * A different binary or a change of a resource that is fixed at the
+		 * creation time of the child requires a restart.
+		 */
+		if (_binary_name != _binary_from_xml(start_node, _unique_name)
+		 || incompatible_resources(old_start_node, start_node)) {
+
+			if (_verbose.enabled())
+				log("restart child \"", _unique_name, "\" because of an "
+				    "incompatible start-node change");
+
+			abandon();
+			return MAY_HAVE_SIDE_EFFECTS;
+		}
+
+		/*
+		 * The routes of the existing sessions must be re-validated only if
+		 * the routing policy of the child changed.
+		 */
+		if (sub_node_differs(old_start_node, start_node, "route")
+		 || sub_node_differs(old_start_node, start_node, "configfile"))
+			routing_changed = true;
+
 		/*
 		 * Start node changed
 		 *
 		 * Determine how the inline config is affected.
 		 */
 		char const * const tag = "config";
-		bool const config_was_present = _start_node->xml().has_sub_node(tag);
+		bool const config_was_present = old_start_node.has_sub_node(tag);
 		bool const config_is_present  = start_node.has_sub_node(tag);
 
 		if (config_was_present && !config_is_present)
@@ -66,15 +166,13 @@ Init::Child::apply_config(Xml_node start_node)
 		if (!config_was_present && config_is_present)
 			config_update = CONFIG_APPEARED;
 
-		if (config_was_present && config_is_present) {
+		if (config_was_present && config_is_present
+		 && sub_node_differs(old_start_node, start_node, tag))
+			config_update = CONFIG_CHANGED;
 
-			Xml_node old_config = _start_node->xml().sub_node(tag);
-			Xml_node new_config = start_node.sub_node(tag);
-
-			if (Genode::memcmp(old_config.addr(), new_config.addr(),
-			                   min(old_config.size(), new_config.size())))
-				config_update = CONFIG_CHANGED;
-		}
+		/* the appearance or disappearance of the config affects its route */
+		if (config_was_present != config_is_present)
+			routing_changed = true;
 
 		/*
 		 * Import updated <provides> node
@@ -111,15 +209,10 @@ Init::Child::apply_config(Xml_node start_node)
 			provided_services_changed = true;
 		});
 
-		/*
-		 * Import new binary name. A change may affect the route for
-		 * the binary's ROM session, triggering the restart of the
-		 * child.
-		 */
-		_binary_name = _binary_from_xml(start_node, _unique_name);
-
 		/* import new start node */
 		_start_node.construct(_alloc, start_node);
+
+		_construct_route_model();
 	}
 
 	/*
@@ -136,13 +229,13 @@ Init::Child::apply_config(Xml_node start_node)
 	}
 
 	/* validate that the routes of all existing sessions remain intact */
-	{
-		bool routing_changed = false;
+	if (routing_changed) {
+		bool route_invalid = false;
 		_child.for_each_session([&] (Session_state const &session) {
 			if (!_route_valid(session))
-				routing_changed = true; });
+				route_invalid = true; });
 
-		if (routing_changed) {
+		if (route_invalid) {
 			abandon();
 			return MAY_HAVE_SIDE_EFFECTS;
 		}
@@ -359,6 +452,10 @@ void Init::Child::init(Pd_session &session, Pd_session_capability cap)
 
 void Init::Child::init(Cpu_session &session, Cpu_session_capability cap)
 {
+	/* the environment sessions of children may be initiated concurrently */
+	static Lock lock;
+	Lock::Guard guard(lock);
+
 	static size_t avail = Cpu_session::quota_lim_upscale(                    100, 100);
 	size_t const   need = Cpu_session::quota_lim_upscale(_resources.cpu_quota_pc, 100);
 	size_t need_adj = 0;
@@ -433,89 +530,74 @@ Init::Child::Route Init::Child::resolve_session_request(Service::Name const &ser
 	 && label.last_element() == Session_requester::rom_name())
 		return Route { _session_requester.service() };
 
-	try {
-		Xml_node route_node = _default_route_accessor.default_route();
-		try {
-			route_node = _start_node->xml().sub_node("route"); }
-		catch (...) { }
-		Xml_node service_node = route_node.sub_node();
+	Route_model const &route_model = _route_model.constructed()
+	                               ? *_route_model
+	                               : _default_route_accessor.default_route();
 
-		for (; ; service_node = service_node.next()) {
+	for (unsigned i = 0; i < route_model.num_rules(); i++) {
 
-			bool service_wildcard = service_node.has_type("any-service");
+		Route_model::Rule const &rule = route_model.rule(i);
 
-			if (!service_node_matches(service_node, label, name(), service_name))
-				continue;
+		if (!rule.matches(label, name(), service_name))
+			continue;
 
-			Xml_node target = service_node.sub_node();
-			for (; ; target = target.next()) {
+		/* a service node without any target ends the route lookup */
+		if (rule.num_targets == 0)
+			break;
 
-				/*
-				 * Determine session label to be provided to the server
-				 *
-				 * By default, the client's identity (accompanied with the a
-				 * client-provided label) is presented as session label to the
-				 * server. However, the target node can explicitly override the
-				 * client's identity by a custom label via the 'label'
-				 * attribute.
-				 */
-				typedef String<Session_label::capacity()> Label;
-				Label const target_label =
-					target.attribute_value("label", Label(label.string()));
+		for (unsigned j = 0; j < rule.num_targets; j++) {
 
-				Session::Diag const
-					target_diag { target.attribute_value("diag", false) };
+			Route_model::Target const &target = rule.targets[j];
 
-				auto no_filter = [] (Service &) -> bool { return false; };
+			Session_label const target_label = target.server_label(label);
 
-				if (target.has_type("parent")) {
+			Session::Diag const target_diag { target.diag };
 
-					try {
-						return Route { find_service(_parent_services, service_name, no_filter),
-						               target_label, target_diag };
-					} catch (Service_denied) { }
-				}
+			auto no_filter = [] (Service &) -> bool { return false; };
 
-				if (target.has_type("child")) {
+			if (target.type == Route_model::Target::PARENT) {
 
-					typedef Name_registry::Name Name;
-					Name server_name = target.attribute_value("name", Name());
-					server_name = _name_registry.deref_alias(server_name);
+				try {
+					return Route { find_service(_parent_services, service_name, no_filter),
+					               target_label, target_diag };
+				} catch (Service_denied) { }
+			}
 
-					auto filter_server_name = [&] (Routed_service &s) -> bool {
-						return s.child_name() != server_name; };
+			if (target.type == Route_model::Target::CHILD) {
 
-					try {
-						return Route { find_service(_child_services, service_name, filter_server_name),
-						               target_label, target_diag };
+				typedef Name_registry::Name Name;
+				Name const server_name = _name_registry.deref_alias(target.server_name);
 
-					} catch (Service_denied) { }
-				}
+				auto filter_server_name = [&] (Routed_service &s) -> bool {
+					return s.child_name() != server_name; };
 
-				if (target.has_type("any-child")) {
+				try {
+					return Route { find_service(_child_services, service_name, filter_server_name),
+					               target_label, target_diag };
 
-					if (is_ambiguous(_child_services, service_name)) {
-						error(name(), ": ambiguous routes to "
-						      "service \"", service_name, "\"");
-						throw Service_denied();
-					}
-					try {
-						return Route { find_service(_child_services, service_name, no_filter),
-						               target_label, target_diag };
+				} catch (Service_denied) { }
+			}
 
-					} catch (Service_denied) { }
-				}
+			if (target.type == Route_model::Target::ANY_CHILD) {
 
-				if (!service_wildcard) {
-					warning(name(), ": lookup for service \"", service_name, "\" failed");
+				if (is_ambiguous(_child_services, service_name)) {
+					error(name(), ": ambiguous routes to "
+					      "service \"", service_name, "\"");
 					throw Service_denied();
 				}
+				try {
+					return Route { find_service(_child_services, service_name, no_filter),
+					               target_label, target_diag };
+
+				} catch (Service_denied) { }
+			}
 
-				if (target.last())
-					break;
+			if (!rule.any_service) {
+				warning(name(), ": lookup for service \"", service_name, "\" failed");
+				throw Service_denied();
 			}
 		}
-	} catch (Xml_node::Nonexistent_sub_node) { }
+	}
 
 	warning(name(), ": no route to service \"", service_name, "\"");
 	throw Service_denied();
@@ -681,6 +763,8 @@ Init::Child::Child(Env                      &env,
 	 */
 	if (start_node.has_sub_node("config"))
 		_config_rom_service.construct(*this);
+
+	_construct_route_model();
 }
 
 
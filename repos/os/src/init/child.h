@@ -19,6 +19,7 @@
 #include <base/child.h>
 #include <os/session_requester.h>
 #include <os/session_policy.h>
+#include <util/avl_string.h>
 
 /* local includes */
 #include <types.h>
@@ -27,11 +28,13 @@
 #include <buffered_xml.h>
 #include <name_registry.h>
 #include <service.h>
+#include <route_model.h>
+#include <worker_pool.h>
 #include <utils.h>
 
 namespace Init { class Child; }
 
-class Init::Child : Child_policy, Routed_service::Wakeup
+class Init::Child : Child_policy, Routed_service::Wakeup, Worker_pool::Job
 {
 	public:
 
@@ -46,7 +49,7 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 		 */
 		struct Id { unsigned value; };
 
-		struct Default_route_accessor { virtual Xml_node default_route() = 0; };
+		struct Default_route_accessor { virtual Route_model const &default_route() = 0; };
 
 		struct Default_caps_accessor { virtual Cap_quota default_caps() = 0; };
 
@@ -83,6 +86,19 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 
 		Default_route_accessor &_default_route_accessor;
 
+		/*
+		 * Routing policy of the '<route>' node, if present
+		 */
+		Constructible<Route_model> _route_model;
+
+		void _construct_route_model()
+		{
+			if (_start_node->xml().has_sub_node("route"))
+				_route_model.construct(_alloc, _start_node->xml().sub_node("route"));
+			else
+				_route_model.destruct();
+		}
+
 		Ram_limit_accessor &_ram_limit_accessor;
 
 		Name_registry &_name_registry;
@@ -105,6 +121,24 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 		typedef String<64> Name;
 		Name const _unique_name { _name_from_xml(_start_node->xml()) };
 
+		/*
+		 * Entry of the child registry's dictionary of child names
+		 */
+		struct Name_node : Avl_string_base
+		{
+			Child &child;
+
+			Name_node(Child &child, char const *name)
+			: Avl_string_base(name), child(child) { }
+		};
+
+		Name_node _name_node { *this, _unique_name.string() };
+
+		/*
+		 * Used by the child registry to detect children without start node
+		 */
+		bool _listed = false;
+
 		static Binary_name _binary_from_xml(Xml_node start_node,
 		                                    Name const &unique_name)
 		{
@@ -484,6 +518,25 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 			}
 		}
 
+		/**
+		 * Return true if the environment sessions are yet to be initiated
+		 */
+		bool env_sessions_pending() const { return _state == STATE_RAM_INITIALIZED; }
+
+		Worker_pool::Job &startup_job() { return *this; }
+
+		/**
+		 * Worker_pool::Job interface
+		 *
+		 * Initiates the environment sessions and loads the binary. The
+		 * method may be executed concurrently for different children.
+		 */
+		void execute() override
+		{
+			try { initiate_env_sessions(); }
+			catch (...) { error(name(), ": failed to initiate environment sessions"); }
+		}
+
 		void abandon()
 		{
 			_state = STATE_ABANDONED;
@@ -500,10 +553,22 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 		/**
 		 * Apply new configuration to child
 		 *
+		 * \param routing_changed  true if a part of the configuration outside
+		 *                         of the start node, which may affect the
+		 *                         routes of the child's sessions, changed
+		 *
+		 * Changes of the start node are applied in place whenever possible.
+		 * The child is restarted only if its binary, version, priority,
+		 * affinity, CPU quota, or 'constrain_phys' attribute changed, or
+		 * if one of its sessions can no longer be routed as before. The
+		 * routes of the existing sessions are not re-validated if neither
+		 * the routing environment nor the routing-related parts of the
+		 * start node changed.
+		 *
 		 * \throw Allocator::Out_of_memory  unable to allocate buffer for new
 		 *                                  config
 		 */
-		Apply_config_result apply_config(Xml_node start_node);
+		Apply_config_result apply_config(Xml_node start_node, bool routing_changed);
 
 		void apply_ram_upgrade();
 		void apply_ram_downgrade();
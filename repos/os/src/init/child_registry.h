@@ -29,13 +29,16 @@ class Init::Child_registry : public Name_registry, Child_list
 
 		List<Alias> _aliases;
 
-		bool _unique(const char *name) const
+		/*
+		 * Dictionary of children for looking up a child by name
+		 */
+		Avl_tree<Avl_string_base> _names;
+
+		bool _unique(const char *name)
 		{
 			/* check for name clash with an existing child */
-			Genode::List_element<Init::Child> const *curr = first();
-			for (; curr; curr = curr->next())
-				if (curr->object()->has_name(name))
-					return false;
+			if (child_by_name(name))
+				return false;
 
 			/* check for name clash with an existing alias */
 			for (Alias const *a = _aliases.first(); a; a = a->next()) {
@@ -59,6 +62,7 @@ class Init::Child_registry : public Name_registry, Child_list
 		void insert(Child *child)
 		{
 			Child_list::insert(&child->_list_element);
+			_names.insert(&child->_name_node);
 		}
 
 		/**
@@ -67,6 +71,40 @@ class Init::Child_registry : public Name_registry, Child_list
 		void remove(Child *child)
 		{
 			Child_list::remove(&child->_list_element);
+			_names.remove(&child->_name_node);
+		}
+
+		/**
+		 * Return child with the specified name, or nullptr if no such child
+		 * exists
+		 */
+		Child *child_by_name(char const *name)
+		{
+			Avl_string_base *node = _names.first()
+			                      ? _names.first()->find_by_name(name) : nullptr;
+
+			return node ? &static_cast<Child::Name_node *>(node)->child : nullptr;
+		}
+
+		/**
+		 * Call 'fn' for each child that has no start node in 'config'
+		 */
+		template <typename FN>
+		void for_each_unlisted_child(Xml_node config, FN const &fn)
+		{
+			config.for_each_sub_node("start", [&] (Xml_node node) {
+				Child_policy::Name const name =
+					node.attribute_value("name", Child_policy::Name());
+
+				if (Child *child = child_by_name(name.string()))
+					child->_listed = true; });
+
+			for_each_child([&] (Child &child) {
+				bool const listed = child._listed;
+				child._listed = false;
+				if (!listed)
+					fn(child);
+			});
 		}
 
 		/**
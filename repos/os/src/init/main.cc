@@ -14,6 +14,7 @@
 /* Genode includes */
 #include <base/component.h>
 #include <base/attached_rom_dataspace.h>
+#include <os/expanding_xml_buffer.h>
 
 /* local includes */
 #include <child_registry.h>
@@ -21,6 +22,7 @@
 #include <alias.h>
 #include <state_reporter.h>
 #include <server.h>
+#include <worker_pool.h>
 
 namespace Init { struct Main; }
 
@@ -42,12 +44,30 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 
 	Reconstructible<Verbose> _verbose { _config_xml };
 
-	Constructible<Buffered_xml> _default_route;
+	Reconstructible<Route_model> _default_route { _heap, Xml_node("<empty/>") };
 
 	Cap_quota _default_caps { 0 };
 
+	/*
+	 * Parts of the current and the previous config that affect the routing
+	 * of all children
+	 *
+	 * If they are unchanged, the routes of a child must be re-validated
+	 * only if its own start node changed.
+	 */
+	Expanding_xml_buffer _routing_env[2] { { _heap, 1024 }, { _heap, 1024 } };
+	unsigned             _routing_env_curr = 0;
+
 	unsigned _child_cnt = 0;
 
+	/*
+	 * Threads for starting children concurrently, configured via the
+	 * 'startup_workers' attribute
+	 */
+	Constructible<Worker_pool> _worker_pool;
+
+	void _initiate_env_sessions();
+
 	static Ram_quota _preserved_ram_from_config(Xml_node config)
 	{
 		Number_of_bytes preserve { 40*sizeof(long)*1024 };
@@ -122,11 +142,7 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 	/**
 	 * Default_route_accessor interface
 	 */
-	Xml_node default_route() override
-	{
-		return _default_route.constructed() ? _default_route->xml()
-		                                    : Xml_node("<empty/>");
-	}
+	Route_model const &default_route() override { return *_default_route; }
 
 	/**
 	 * Default_caps_accessor interface
@@ -142,6 +158,7 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 	void _update_parent_services_from_config();
 	void _abandon_obsolete_children();
 	void _update_children_config();
+	bool _routing_env_changed();
 	void _destroy_abandoned_parent_services();
 	void _handle_config();
 
@@ -236,23 +253,63 @@ void Init::Main::_update_aliases_from_config()
 
 void Init::Main::_abandon_obsolete_children()
 {
-	_children.for_each_child([&] (Child &child) {
+	_children.for_each_unlisted_child(_config_xml, [&] (Child &child) {
+		child.abandon(); });
+}
 
-		Child_policy::Name const name = child.name();
 
-		bool obsolete = true;
-		_config_xml.for_each_sub_node("start", [&] (Xml_node node) {
-			if (node.attribute_value("name", Child_policy::Name()) == name)
-				obsolete = false; });
+bool Init::Main::_routing_env_changed()
+{
+	Expanding_xml_buffer &prev = _routing_env[_routing_env_curr];
+	Expanding_xml_buffer &curr = _routing_env[!_routing_env_curr];
 
-		if (obsolete)
-			child.abandon();
-	});
+	try {
+		curr.generate("routing", [&] (Xml_generator &xml) {
+			_config_xml.for_each_sub_node([&] (Xml_node node) {
+
+				if (node.has_type("default-route")
+				 || node.has_type("parent-provides")
+				 || node.has_type("alias"))
+					xml.append(node.addr(), node.size());
+
+				/* services provided by children */
+				if (node.has_type("start"))
+					xml.node("start", [&] () {
+						xml.attribute("name", node.attribute_value("name",
+						                      Child_policy::Name()));
+						if (node.has_sub_node("provides")) {
+							Xml_node const provides = node.sub_node("provides");
+							xml.append(provides.addr(), provides.size());
+						}
+					});
+			});
+		});
+	}
+	catch (...) {
+		/*
+		 * Conservatively assume a change. The incomplete buffer becomes the
+		 * reference with no content, which enforces the re-validation at
+		 * the next config update as well.
+		 */
+		_routing_env_curr = !_routing_env_curr;
+		return true;
+	}
+
+	_routing_env_curr = !_routing_env_curr;
+
+	return curr.content_size() != prev.content_size()
+	    || Genode::memcmp(curr.content(), prev.content(), curr.content_size());
 }
 
 
 void Init::Main::_update_children_config()
 {
+	/*
+	 * The routes of the children's sessions must be re-validated only if the
+	 * routing-related part of the config changed.
+	 */
+	bool routing_changed = _routing_env_changed();
+
 	for (;;) {
 
 		/*
@@ -268,22 +325,56 @@ void Init::Main::_update_children_config()
 			Child_policy::Name const start_node_name =
 				node.attribute_value("name", Child_policy::Name());
 
-			_children.for_each_child([&] (Child &child) {
-				if (child.name() == start_node_name) {
-					switch (child.apply_config(node)) {
-					case Child::NO_SIDE_EFFECTS: break;
-					case Child::MAY_HAVE_SIDE_EFFECTS: side_effects = true; break;
-					};
-				}
-			});
+			Child *child = _children.child_by_name(start_node_name.string());
+			if (!child)
+				return;
+
+			switch (child->apply_config(node, routing_changed)) {
+			case Child::NO_SIDE_EFFECTS: break;
+			case Child::MAY_HAVE_SIDE_EFFECTS: side_effects = true; break;
+			};
 		});
 
 		if (!side_effects)
 			break;
+
+		/* abandoned children and changed services may affect any route */
+		routing_changed = true;
 	}
 }
 
 
+void Init::Main::_initiate_env_sessions()
+{
+	unsigned num_pending = 0;
+	_children.for_each_child([&] (Child const &child) {
+		num_pending += child.env_sessions_pending(); });
+
+	if (!_worker_pool.constructed() || num_pending < 2) {
+		_children.for_each_child([&] (Child &child) {
+			child.initiate_env_sessions(); });
+		return;
+	}
+
+	size_t const jobs_size = num_pending*sizeof(Worker_pool::Job *);
+	Worker_pool::Job **jobs = nullptr;
+	if (!_heap.alloc(jobs_size, (void **)&jobs)) {
+		_children.for_each_child([&] (Child &child) {
+			child.initiate_env_sessions(); });
+		return;
+	}
+
+	unsigned i = 0;
+	_children.for_each_child([&] (Child &child) {
+		if (child.env_sessions_pending())
+			jobs[i++] = &child.startup_job(); });
+
+	_worker_pool->execute(jobs, num_pending);
+
+	_heap.free(jobs, jobs_size);
+}
+
+
 void Init::Main::_handle_config()
 {
 	_config.update();
@@ -304,6 +395,13 @@ void Init::Main::_handle_config()
 		                                   .attribute_value("caps", 0UL) }; }
 	catch (...) { }
 
+	unsigned const num_workers = min(_config_xml.attribute_value("startup_workers", 0U),
+	                                 (unsigned)Worker_pool::MAX_WORKERS);
+	if (num_workers == 0)
+		_worker_pool.destruct();
+	else if (!_worker_pool.constructed() || _worker_pool->num_workers() != num_workers)
+		_worker_pool.construct(_env, _heap, num_workers);
+
 	Prio_levels     const prio_levels    = prio_levels_from_xml(_config_xml);
 	Affinity::Space const affinity_space = affinity_space_from_xml(_config_xml);
 
@@ -335,13 +433,10 @@ void Init::Main::_handle_config()
 		_config_xml.for_each_sub_node("start", [&] (Xml_node start_node) {
 
 			/* skip start node if corresponding child already exists */
-			bool exists = false;
-			_children.for_each_child([&] (Child const &child) {
-				if (child.name() == start_node.attribute_value("name", Child_policy::Name()))
-					exists = true; });
-			if (exists) {
+			Child_policy::Name const name =
+				start_node.attribute_value("name", Child_policy::Name());
+			if (_children.child_by_name(name.string()))
 				return;
-			}
 
 			if (used_ram.value > avail_ram.value) {
 				error("RAM exhausted while starting childen");
@@ -410,8 +505,7 @@ void Init::Main::_handle_config()
 	/*
 	 * Initiate remaining environment sessions of all new children
 	 */
-	_children.for_each_child([&] (Child &child) {
-		child.initiate_env_sessions(); });
+	_initiate_env_sessions();
 
 	/*
 	 * (Re-)distribute RAM among the childen, given their resource assignments
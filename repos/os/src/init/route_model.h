@@ -0,0 +1,252 @@
+/*
+ * \brief  Pre-processed representation of a routing policy
+ * \author agent
+ * \date   2026-10-19
+ *
+ * Each session request of a child used to be resolved by walking the XML of
+ * the '<route>' or '<default-route>' node. The route model captures the
+ * information of these nodes once when the configuration changes so that
+ * session requests, in particular the many ROM requests at the startup of a
+ * child, are resolved without parsing XML.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SRC__INIT__ROUTE_MODEL_H_
+#define _SRC__INIT__ROUTE_MODEL_H_
+
+/* Genode includes */
+#include <base/log.h>
+#include <base/service.h>
+#include <base/session_label.h>
+#include <util/xml_node.h>
+#include <util/construct_at.h>
+
+/* local includes */
+#include <types.h>
+#include <utils.h>
+
+namespace Init { class Route_model; }
+
+
+class Init::Route_model : Noncopyable
+{
+	public:
+
+		typedef String<Session_label::capacity()> Label;
+
+		struct Target
+		{
+			enum Type { PARENT, CHILD, ANY_CHILD, UNKNOWN };
+
+			Type               type;
+			Child_policy::Name server_name;   /* only used for 'CHILD' */
+			bool               label_present;
+			Label              label;
+			bool               diag;
+
+			/**
+			 * Return label to be provided to the server
+			 *
+			 * By default, the client's identity (accompanied with the a
+			 * client-provided label) is presented as session label to the
+			 * server. However, the target node can explicitly override the
+			 * client's identity by a custom label via the 'label' attribute.
+			 */
+			Session_label server_label(Session_label const &client_label) const {
+				return label_present ? Session_label(label.string()) : client_label; }
+		};
+
+		struct Rule
+		{
+			bool          any_service;
+			Service::Name service;
+
+			bool  unscoped_present;
+			Label unscoped;
+
+			bool  label_present,  prefix_present,  suffix_present;
+			Label label,          prefix,          suffix;
+
+			Target  *targets;
+			unsigned num_targets;
+
+			/**
+			 * Return true if rule matches the session request
+			 *
+			 * This method corresponds to 'service_node_matches'.
+			 */
+			bool matches(Session_label      const &session_label,
+			             Child_policy::Name const &child_name,
+			             Service::Name      const &service_name) const
+			{
+				if (!any_service && service != service_name)
+					return false;
+
+				if (unscoped_present)
+					return session_label == unscoped;
+
+				if (!label_present && !prefix_present && !suffix_present)
+					return true;
+
+				char const * const scoped = skip_label_prefix(
+					child_name.string(), session_label.string());
+
+				if (!scoped)
+					return false;
+
+				Label const l(scoped);
+
+				if (label_present && l != label)
+					return false;
+
+				if (prefix_present
+				 && strcmp(l.string(), prefix.string(), prefix.length() - 1))
+					return false;
+
+				if (suffix_present) {
+					if (l.length() < suffix.length())
+						return false;
+
+					size_t const offset = l.length() - suffix.length();
+					if (strcmp(l.string() + offset, suffix.string()))
+						return false;
+				}
+				return true;
+			}
+		};
+
+	private:
+
+		Allocator &_alloc;
+
+		Rule    *_rules       = nullptr;
+		unsigned _num_rules   = 0;
+		Target  *_targets     = nullptr;
+		unsigned _num_targets = 0;
+
+		static Target::Type _target_type(Xml_node target)
+		{
+			if (target.has_type("parent"))    return Target::PARENT;
+			if (target.has_type("child"))     return Target::CHILD;
+			if (target.has_type("any-child")) return Target::ANY_CHILD;
+			return Target::UNKNOWN;
+		}
+
+		static bool _service_node(Xml_node node) {
+			return node.has_type("service") || node.has_type("any-service"); }
+
+		template <typename T>
+		T *_alloc_array(unsigned n)
+		{
+			if (n == 0)
+				return nullptr;
+
+			T *array = (T *)_alloc.alloc(n*sizeof(T));
+			for (unsigned i = 0; i < n; i++)
+				construct_at<T>(&array[i]);
+			return array;
+		}
+
+		template <typename T>
+		void _free_array(T *array, unsigned n)
+		{
+			if (!array)
+				return;
+
+			for (unsigned i = 0; i < n; i++)
+				array[i].~T();
+			_alloc.free(array, n*sizeof(T));
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param route  '<route>' or '<default-route>' node
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Route_model(Allocator &alloc, Xml_node route) : _alloc(alloc)
+		{
+			route.for_each_sub_node([&] (Xml_node service) {
+				if (!_service_node(service))
+					return;
+
+				_num_rules++;
+				_num_targets += service.num_sub_nodes();
+			});
+
+			_rules = _alloc_array<Rule>(_num_rules);
+			try { _targets = _alloc_array<Target>(_num_targets); }
+			catch (...) { _free_array(_rules, _num_rules); throw; }
+
+			unsigned rule_idx = 0, target_idx = 0;
+
+			route.for_each_sub_node([&] (Xml_node service) {
+				if (!_service_node(service))
+					return;
+
+				Rule &rule = _rules[rule_idx++];
+
+				rule.any_service = service.has_type("any-service");
+				rule.service     = service.attribute_value("name", Service::Name());
+
+				rule.label_present  = service.has_attribute("label");
+				rule.prefix_present = service.has_attribute("label_prefix");
+				rule.suffix_present = service.has_attribute("label_suffix");
+
+				rule.label  = service.attribute_value("label",        Label());
+				rule.prefix = service.attribute_value("label_prefix", Label());
+				rule.suffix = service.attribute_value("label_suffix", Label());
+
+				/*
+				 * If an 'unscoped_label' attribute is provided, don't consider
+				 * any scoped label attribute.
+				 */
+				rule.unscoped_present = service.has_attribute("unscoped_label");
+				rule.unscoped = service.attribute_value("unscoped_label", Label());
+
+				if (rule.unscoped_present && (rule.label_present
+				                           || rule.prefix_present
+				                           || rule.suffix_present))
+					warning("service node contains both scoped and unscoped label attributes");
+
+				rule.targets     = &_targets[target_idx];
+				rule.num_targets = 0;
+
+				service.for_each_sub_node([&] (Xml_node node) {
+
+					Target &target = _targets[target_idx++];
+					rule.num_targets++;
+
+					target.type          = _target_type(node);
+					target.server_name   = node.attribute_value("name", Child_policy::Name());
+					target.label_present = node.has_attribute("label");
+					target.label         = node.attribute_value("label", Label());
+					target.diag          = node.attribute_value("diag", false);
+				});
+			});
+		}
+
+		~Route_model()
+		{
+			_free_array(_rules,   _num_rules);
+			_free_array(_targets, _num_targets);
+		}
+
+		/*
+		 * Rules in the order of the configuration
+		 */
+		unsigned    num_rules()      const { return _num_rules; }
+		Rule const &rule(unsigned i) const { return _rules[i]; }
+};
+
+#endif /* _SRC__INIT__ROUTE_MODEL_H_ */
@@ -39,7 +39,7 @@ class Init::State_reporter : public Report_update_trigger
 
 		Producer &_producer;
 
-		Constructible<Reporter> _reporter;
+		Constructible<Expanding_reporter> _reporter;
 
 		size_t _buffer_size = 0;
 
@@ -60,14 +60,25 @@ class Init::State_reporter : public Report_update_trigger
 		Signal_handler<State_reporter> _timer_periodic_handler {
 			_env.ep(), *this, &State_reporter::_handle_timer };
 
+		/*
+		 * Report updates may be triggered by the startup workers
+		 */
+		Lock _trigger_lock;
+
 		bool _scheduled = false;
 
 		void _handle_timer()
 		{
-			_scheduled = false;
+			{
+				Lock::Guard guard(_trigger_lock);
+				_scheduled = false;
+			}
+
+			if (!_reporter.constructed())
+				return;
 
 			try {
-				Reporter::Xml_generator xml(*_reporter, [&] () {
+				_reporter->generate([&] (Xml_generator &xml) {
 
 					if (_version.valid())
 						xml.attribute("version", _version);
@@ -77,11 +88,11 @@ class Init::State_reporter : public Report_update_trigger
 			}
 			catch(Xml_generator::Buffer_exceeded) {
 
-				error("state report exceeds maximum size");
+				error("state report exceeds available memory");
 
 				/* try to reflect the error condition as state report */
 				try {
-					Reporter::Xml_generator xml(*_reporter, [&] () {
+					_reporter->generate([&] (Xml_generator &xml) {
 						xml.attribute("error", "report buffer exceeded"); });
 				}
 				catch (...) { }
@@ -100,7 +111,11 @@ class Init::State_reporter : public Report_update_trigger
 			try {
 				Xml_node report = config.sub_node("report");
 
-				/* (re-)construct reporter whenever the buffer size is changed */
+				/*
+				 * (Re-)construct reporter whenever the buffer size is changed.
+				 * The buffer size merely denotes the initial size. The
+				 * reporter enlarges the buffer whenever needed.
+				 */
 				Number_of_bytes const buffer_size =
 					report.attribute_value("buffer", Number_of_bytes(4096));
 
@@ -111,13 +126,11 @@ class Init::State_reporter : public Report_update_trigger
 
 				_report_detail.construct(report);
 				_report_delay_ms = report.attribute_value("delay_ms", 100UL);
-				_reporter->enabled(true);
 			}
 			catch (Xml_node::Nonexistent_sub_node) {
 				_report_detail.construct();
 				_report_delay_ms = 0;
-				if (_reporter.constructed())
-					_reporter->enabled(false);
+				_reporter.destruct();
 			}
 
 			bool trigger_update = false;
@@ -154,6 +167,8 @@ class Init::State_reporter : public Report_update_trigger
 
 		void trigger_report_update() override
 		{
+			Lock::Guard guard(_trigger_lock);
+
 			if (!_scheduled && _timer.constructed() && _report_delay_ms) {
 				_timer->trigger_once(_report_delay_ms*1000);
 				_scheduled = true;
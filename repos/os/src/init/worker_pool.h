@@ -0,0 +1,146 @@
+/*
+ * \brief  Pool of threads for starting children concurrently
+ * \author agent
+ * \date   2026-10-19
+ *
+ * Creating the environment sessions of a child and loading its ELF binary
+ * are independent from other children. With many children, performing these
+ * steps on several CPUs shortens the startup of the scenario. The entrypoint
+ * hands out a batch of jobs and blocks until all jobs are completed.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SRC__INIT__WORKER_POOL_H_
+#define _SRC__INIT__WORKER_POOL_H_
+
+/* Genode includes */
+#include <base/thread.h>
+#include <base/semaphore.h>
+#include <base/lock.h>
+#include <base/allocator.h>
+
+/* local includes */
+#include <types.h>
+
+namespace Init { class Worker_pool; }
+
+
+class Init::Worker_pool : Noncopyable
+{
+	public:
+
+		enum { MAX_WORKERS = 32 };
+
+		struct Job
+		{
+			virtual void execute() = 0;
+		};
+
+	private:
+
+		enum { STACK_SIZE = 16*1024*sizeof(long) };
+
+		Lock      _lock;
+		Semaphore _work;
+		Semaphore _done;
+
+		Job    **_jobs     = nullptr;
+		unsigned _num_jobs = 0;
+		unsigned _next_job = 0;
+
+		Job *_fetch_job()
+		{
+			Lock::Guard guard(_lock);
+			return (_next_job < _num_jobs) ? _jobs[_next_job++] : nullptr;
+		}
+
+		struct Worker : Thread
+		{
+			Worker_pool &_pool;
+
+			Worker(Env &env, Worker_pool &pool, Affinity::Location location)
+			:
+				Thread(env, "startup", STACK_SIZE, location, Weight(), env.cpu()),
+				_pool(pool)
+			{
+				start();
+			}
+
+			void entry() override
+			{
+				for (;;) {
+					_pool._work.down();
+
+					if (Job *job = _pool._fetch_job())
+						job->execute();
+
+					_pool._done.up();
+				}
+			}
+		};
+
+		Allocator &_alloc;
+
+		Worker  *_workers[MAX_WORKERS];
+		unsigned _num_workers = 0;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * The workers are distributed over the CPUs of the affinity space.
+		 */
+		Worker_pool(Env &env, Allocator &alloc, unsigned num_workers)
+		:
+			_alloc(alloc)
+		{
+			Affinity::Space space = env.cpu().affinity_space();
+
+			num_workers = min(num_workers, (unsigned)MAX_WORKERS);
+
+			for (unsigned i = 0; i < num_workers; i++)
+				_workers[_num_workers++] = new (_alloc)
+					Worker(env, *this, space.location_of_index(i + 1));
+		}
+
+		~Worker_pool()
+		{
+			/*
+			 * The workers are blocked on the '_work' semaphore while no batch
+			 * is executed, so they can be destroyed safely.
+			 */
+			for (unsigned i = 0; i < _num_workers; i++)
+				destroy(_alloc, _workers[i]);
+		}
+
+		unsigned num_workers() const { return _num_workers; }
+
+		/**
+		 * Execute jobs concurrently and block until all jobs are completed
+		 */
+		void execute(Job *jobs[], unsigned num_jobs)
+		{
+			{
+				Lock::Guard guard(_lock);
+				_jobs = jobs; _num_jobs = num_jobs; _next_job = 0;
+			}
+
+			for (unsigned i = 0; i < num_jobs; i++)
+				_work.up();
+
+			for (unsigned i = 0; i < num_jobs; i++)
+				_done.down();
+
+			Lock::Guard guard(_lock);
+			_jobs = nullptr; _num_jobs = 0; _next_job = 0;
+		}
+};
+
+#endif /* _SRC__INIT__WORKER_POOL_H_ */
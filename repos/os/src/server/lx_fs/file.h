@@ -135,6 +135,8 @@ class Lx_fs::File : public Node
 			return ret == -1 ? 0 : ret;
 		}
 
+		int io_fd() const override { return _fd; }
+
 		Status status() override
 		{
 			Status s;
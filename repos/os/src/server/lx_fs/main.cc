@@ -23,6 +23,7 @@
 /* local includes */
 #include <directory.h>
 #include <open_node.h>
+#include <uring.h>
 
 namespace Lx_fs {
 
@@ -50,6 +51,100 @@ class Lx_fs::Session_component : public Session_rpc_object
 
 		Signal_handler<Session_component> _process_packet_dispatcher;
 
+		/*
+		 * Read and write requests of file nodes are passed to the host
+		 * kernel via io_uring if available. Each in-flight request occupies
+		 * a slot that keeps the packet until its completion is acknowledged.
+		 */
+		enum { MAX_IN_FLIGHT = File_system::Session::TX_QUEUE_SIZE };
+
+		Genode::Constructible<Uring> _uring;
+
+		struct In_flight
+		{
+			Packet_descriptor packet { };
+			bool              used = false;
+
+		} _in_flight[MAX_IN_FLIGHT];
+
+		/**
+		 * Return index of unused in-flight slot, or MAX_IN_FLIGHT
+		 */
+		unsigned _free_slot() const
+		{
+			unsigned slot = 0;
+			for (; slot < MAX_IN_FLIGHT && _in_flight[slot].used; slot++) ;
+			return slot;
+		}
+
+		/**
+		 * Submit read or write operation to the io_uring
+		 *
+		 * \return false if the packet must be processed synchronously
+		 */
+		bool _queue_async(Packet_descriptor const &packet, Node &node,
+		                  void *content, size_t length)
+		{
+			if (!_uring.constructed() || node.io_fd() < 0)
+				return false;
+
+			bool const read   = packet.operation() == Packet_descriptor::READ;
+			bool const append = packet.position() == (seek_off_t)SEEK_TAIL;
+
+			/* reading at the end of the file is answered synchronously */
+			if (read && append)
+				return false;
+
+			unsigned const slot = _free_slot();
+			if (slot == MAX_IN_FLIGHT)
+				return false;
+
+			/*
+			 * Appends are passed through the ring as well, so that they
+			 * are ordered with respect to the writes queued before
+			 */
+			bool const queued = read
+				? _uring->queue_read(node.io_fd(), content, length,
+				                     packet.position(), slot)
+				: append
+				? _uring->queue_append(node.io_fd(), content, length, slot)
+				: _uring->queue_write(node.io_fd(), content, length,
+				                      packet.position(), slot);
+			if (!queued)
+				return false;
+
+			_in_flight[slot].packet = packet;
+			_in_flight[slot].used   = true;
+			return true;
+		}
+
+		/**
+		 * Acknowledge packets of completed asynchronous requests
+		 *
+		 * Completions may arrive in any order. If the acknowledgement queue
+		 * is full, the remaining completions are left in the ring until the
+		 * next ready-to-ack signal.
+		 */
+		void _process_completions()
+		{
+			if (!_uring.constructed())
+				return;
+
+			_uring->for_each_completion([&] (Uring::Tag tag, int result) {
+
+				if (!tx_sink()->ready_to_ack())
+					return false;
+
+				In_flight &slot = _in_flight[tag];
+
+				slot.packet.length(result > 0 ? result : 0);
+				slot.packet.succeeded(result > 0);
+				tx_sink()->acknowledge_packet(slot.packet);
+				slot.used = false;
+				return true;
+			});
+		}
+
 
 		/******************************
 		 ** Packet-stream processing **
@@ -71,13 +166,19 @@ class Lx_fs::Session_component : public Session_rpc_object
 			switch (packet.operation()) {
 
 			case Packet_descriptor::READ:
-				if (content && (packet.length() <= packet.size()))
+				if (content && (packet.length() <= packet.size())) {
+					if (_queue_async(packet, open_node.node(), content, length))
+						return;
 					res_length = open_node.node().read((char *)content, length, packet.position());
+				}
 				break;
 
 			case Packet_descriptor::WRITE:
-				if (content && (packet.length() <= packet.size()))
+				if (content && (packet.length() <= packet.size())) {
+					if (_queue_async(packet, open_node.node(), content, length))
+						return;
 					res_length = open_node.node().write((char const *)content, length, packet.position());
+				}
 				break;
 
 			case Packet_descriptor::CONTENT_CHANGED:
@@ -132,6 +233,8 @@ class Lx_fs::Session_component : public Session_rpc_object
 		 */
 		void _process_packets()
 		{
+			_process_completions();
+
 			while (tx_sink()->packet_avail()) {
 
 				/*
@@ -147,10 +250,23 @@ class Lx_fs::Session_component : public Session_rpc_object
 				 * for receiving any subsequent 'ready-to-ack' signals.
 				 */
 				if (!tx_sink()->ready_to_ack())
-					return;
+					break;
+
+				/*
+				 * Leave further packets in the submit queue while all
+				 * asynchronous-request slots are occupied. The completion
+				 * signal resumes the processing.
+				 */
+				if (_uring.constructed()
+				 && (!_uring->ready_to_queue() || _free_slot() == MAX_IN_FLIGHT))
+					break;
 
 				_process_packet();
 			}
+
+			/* pass all packets collected in this run to the kernel at once */
+			if (_uring.constructed())
+				_uring->submit();
 		}
 
 		/**
@@ -173,6 +289,7 @@ class Lx_fs::Session_component : public Session_rpc_object
 		                  Genode::Env &env,
 		                  char const  *root_dir,
 		                  bool         writable,
+		                  bool         io_uring,
 		                  Allocator   &md_alloc)
 		:
 			Session_rpc_object(env.ram().alloc(tx_buf_size), env.rm(), env.ep().rpc_ep()),
@@ -188,6 +305,21 @@ class Lx_fs::Session_component : public Session_rpc_object
 			 */
 			_tx.sigh_packet_avail(_process_packet_dispatcher);
 			_tx.sigh_ready_to_ack(_process_packet_dispatcher);
+
+			if (!io_uring)
+				return;
+
+			try {
+				_uring.construct(env, (unsigned)MAX_IN_FLIGHT,
+				                 _process_packet_dispatcher);
+			} catch (Uring::Setup_failed) {
+				Genode::warning("io_uring unavailable, using synchronous I/O");
+				return;
+			}
+
+			if (!_uring->register_buffer(tx_sink()->bulk_buffer_local_base(),
+			                             tx_sink()->bulk_buffer_size()))
+				Genode::warning("unable to register packet buffer with io_uring");
 		}
 
 		/**
@@ -195,6 +327,9 @@ class Lx_fs::Session_component : public Session_rpc_object
 		 */
 		~Session_component()
 		{
+			/* wait for outstanding requests that refer to the packet buffer */
+			_uring.destruct();
+
 			Dataspace_capability ds = tx_sink()->dataspace();
 			_env.ram().free(static_cap_cast<Ram_dataspace>(ds));
 			destroy(&_md_alloc, &_root);
@@ -347,6 +482,8 @@ class Lx_fs::Root : public Root_component<Session_component>
 
 		Genode::Attached_rom_dataspace _config { _env, "config" };
 
+		bool const _io_uring = _config.xml().attribute_value("io_uring", true);
+
 	protected:
 
 		Session_component *_create_session(const char *args)
@@ -428,7 +565,8 @@ class Lx_fs::Root : public Root_component<Session_component>
 
 			try {
 				return new (md_alloc())
-				       Session_component(tx_buf_size, _env, root_dir, writeable, *md_alloc());
+				       Session_component(tx_buf_size, _env, root_dir, writeable,
+				                         _io_uring, *md_alloc());
 			}
 			catch (Lookup_failed) {
 				Genode::error("session root directory \"", Genode::Cstring(root), "\" "
@@ -53,6 +53,13 @@ class Lx_fs::Node : public File_system::Node_base
 
 		virtual Status status() = 0;
 
+		/**
+		 * Return host file descriptor for asynchronous I/O
+		 *
+		 * \return -1 if the node must be accessed via 'read' and 'write'
+		 */
+		virtual int io_fd() const { return -1; }
+
 		/*
 		 * File functionality
 		 */
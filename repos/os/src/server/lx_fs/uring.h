@@ -0,0 +1,350 @@
+/*
+ * \brief  Asynchronous host I/O via Linux io_uring
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The ring is operated without liburing by directly using the system-call
+ * interface. Completions are announced by the kernel via an eventfd, which
+ * is monitored by a dedicated thread that merely transforms the event into a
+ * Genode signal for the entrypoint.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _URING_H_
+#define _URING_H_
+
+/* Genode includes */
+#include <base/thread.h>
+#include <base/log.h>
+#include <util/string.h>
+
+/* local includes */
+#include <lx_util.h>
+
+/* Linux includes */
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#ifndef RWF_APPEND
+#define RWF_APPEND 0x10
+#endif
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup    425
+#define __NR_io_uring_enter    426
+#define __NR_io_uring_register 427
+#endif
+
+
+namespace Lx_fs { class Uring; }
+
+
+class Lx_fs::Uring
+{
+	public:
+
+		class Setup_failed : Genode::Exception { };
+
+		typedef Genode::uint64_t Tag;
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Uring(Uring const &);
+		Uring &operator = (Uring const &);
+
+		struct Completion_signal_thread : Genode::Thread
+		{
+			int                               fd;
+			Genode::Signal_context_capability sigh;
+
+			Completion_signal_thread(Genode::Env &env, int fd,
+			                         Genode::Signal_context_capability sigh)
+			: Genode::Thread(env, "uring_signal", 8*1024*sizeof(long)),
+			  fd(fd), sigh(sigh) { }
+
+			void entry()
+			{
+				while (true) {
+					/* wait for completions, the read resets the event counter */
+					Genode::uint64_t count = 0;
+					if (::read(fd, &count, sizeof(count)) != sizeof(count))
+						return;
+
+					Genode::Signal_transmitter(sigh).submit();
+				}
+			}
+		};
+
+		static int _setup(unsigned entries, io_uring_params &params)
+		{
+			Genode::memset(&params, 0, sizeof(params));
+
+			int const fd = syscall(__NR_io_uring_setup, entries, &params);
+			if (fd < 0)
+				throw Setup_failed();
+
+			return fd;
+		}
+
+		static void *_map(int fd, size_t size, off_t offset)
+		{
+			void *ptr = mmap(0, size, PROT_READ | PROT_WRITE,
+			                 MAP_SHARED | MAP_POPULATE, fd, offset);
+			if (ptr == MAP_FAILED) {
+				::close(fd);
+				throw Setup_failed();
+			}
+			return ptr;
+		}
+
+		io_uring_params _params { };
+
+		int const _fd;
+
+		size_t const _sq_ring_size = _params.sq_off.array
+		                           + _params.sq_entries*sizeof(unsigned);
+		size_t const _cq_ring_size = _params.cq_off.cqes
+		                           + _params.cq_entries*sizeof(io_uring_cqe);
+		size_t const _sqes_size    = _params.sq_entries*sizeof(io_uring_sqe);
+
+		char         * const _sq_ring = (char *)_map(_fd, _sq_ring_size, IORING_OFF_SQ_RING);
+		char         * const _cq_ring = (char *)_map(_fd, _cq_ring_size, IORING_OFF_CQ_RING);
+		io_uring_sqe * const _sqes    = (io_uring_sqe *)_map(_fd, _sqes_size, IORING_OFF_SQES);
+
+		unsigned * const _sq_tail  = (unsigned *)(_sq_ring + _params.sq_off.tail);
+		unsigned * const _sq_head  = (unsigned *)(_sq_ring + _params.sq_off.head);
+		unsigned   const _sq_mask  = *(unsigned *)(_sq_ring + _params.sq_off.ring_mask);
+		unsigned * const _sq_array = (unsigned *)(_sq_ring + _params.sq_off.array);
+
+		unsigned     * const _cq_head = (unsigned *)(_cq_ring + _params.cq_off.head);
+		unsigned     * const _cq_tail = (unsigned *)(_cq_ring + _params.cq_off.tail);
+		unsigned       const _cq_mask = *(unsigned *)(_cq_ring + _params.cq_off.ring_mask);
+		io_uring_cqe * const _cqes    = (io_uring_cqe *)(_cq_ring + _params.cq_off.cqes);
+
+		struct Event_fd
+		{
+			int const fd = eventfd(0, EFD_CLOEXEC);
+
+			~Event_fd() { if (fd >= 0) ::close(fd); }
+
+		} const _event { };
+
+		Completion_signal_thread _signal_thread;
+
+		/* number of prepared but not yet submitted requests */
+		unsigned _unsubmitted = 0;
+
+		/* number of submitted requests without completion */
+		unsigned _in_flight = 0;
+
+		/* registered fixed buffer */
+		Genode::addr_t _buf_base = 0;
+		size_t         _buf_size = 0;
+
+		bool _fixed(void const *ptr, size_t len) const
+		{
+			Genode::addr_t const addr = (Genode::addr_t)ptr;
+			return _buf_size && addr >= _buf_base
+			    && addr + len <= _buf_base + _buf_size;
+		}
+
+		bool _queue(Genode::uint8_t op, Genode::uint8_t fixed_op, int fd,
+		            void const *buf, size_t len, seek_off_t offset, Tag tag,
+		            Genode::uint8_t flags = 0, Genode::uint32_t rw_flags = 0)
+		{
+			unsigned const tail = *_sq_tail;
+			unsigned const head = __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE);
+
+			if (tail - head >= _params.sq_entries)
+				return false;
+
+			unsigned const index = tail & _sq_mask;
+			io_uring_sqe  &sqe   = _sqes[index];
+
+			Genode::memset(&sqe, 0, sizeof(sqe));
+			sqe.fd        = fd;
+			sqe.off       = offset;
+			sqe.addr      = (Genode::addr_t)buf;
+			sqe.len       = len;
+			sqe.user_data = tag;
+			sqe.flags     = flags;
+			sqe.rw_flags  = rw_flags;
+
+			if (_fixed(buf, len)) {
+				sqe.opcode    = fixed_op;
+				sqe.buf_index = 0;
+			} else {
+				sqe.opcode    = op;
+			}
+
+			_sq_array[index] = index;
+			__atomic_store_n(_sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+			_unsubmitted++;
+			return true;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param entries  maximum number of requests in flight
+		 * \param sigh     signal handler informed about completions
+		 *
+		 * \throw Setup_failed  host kernel lacks io_uring support
+		 */
+		Uring(Genode::Env &env, unsigned entries,
+		      Genode::Signal_context_capability sigh)
+		:
+			_fd(_setup(entries, _params)),
+			_signal_thread(env, _event.fd, sigh)
+		{
+			if (_event.fd < 0
+			 || syscall(__NR_io_uring_register, _fd, IORING_REGISTER_EVENTFD,
+			            &_event.fd, 1) < 0) {
+				Genode::error("unable to register io_uring completion eventfd");
+				::close(_fd);
+				throw Setup_failed();
+			}
+
+			_signal_thread.start();
+		}
+
+		~Uring()
+		{
+			drain();
+
+			munmap(_sqes,    _sqes_size);
+			munmap(_cq_ring, _cq_ring_size);
+			munmap(_sq_ring, _sq_ring_size);
+			::close(_fd);
+		}
+
+		/**
+		 * Register buffer for the use with fixed-buffer operations
+		 *
+		 * Requests that target memory within the registered buffer spare the
+		 * kernel from pinning the pages for each request.
+		 *
+		 * \return false if the kernel refused the buffer, in which case
+		 *         requests fall back to non-fixed operations
+		 */
+		bool register_buffer(Genode::addr_t base, size_t size)
+		{
+			iovec iov { (void *)base, size };
+
+			if (syscall(__NR_io_uring_register, _fd, IORING_REGISTER_BUFFERS, &iov, 1) < 0)
+				return false;
+
+			_buf_base = base;
+			_buf_size = size;
+			return true;
+		}
+
+		/**
+		 * Return true if another request can be queued
+		 */
+		bool ready_to_queue() const { return _in_flight + _unsubmitted < _params.sq_entries; }
+
+		bool queue_read(int fd, void *dst, size_t len, seek_off_t offset, Tag tag)
+		{
+			return _queue(IORING_OP_READ, IORING_OP_READ_FIXED,
+			              fd, dst, len, offset, tag);
+		}
+
+		bool queue_write(int fd, void const *src, size_t len, seek_off_t offset, Tag tag)
+		{
+			return _queue(IORING_OP_WRITE, IORING_OP_WRITE_FIXED,
+			              fd, src, len, offset, tag);
+		}
+
+		/**
+		 * Queue write to the end of the file
+		 *
+		 * The write is not started before all requests queued earlier are
+		 * completed, and requests queued later wait for its completion.
+		 * Hence, the append is ordered with respect to other writes.
+		 */
+		bool queue_append(int fd, void const *src, size_t len, Tag tag)
+		{
+			return _queue(IORING_OP_WRITE, IORING_OP_WRITE_FIXED,
+			              fd, src, len, 0, tag, IOSQE_IO_DRAIN, RWF_APPEND);
+		}
+
+		/**
+		 * Pass all queued requests to the kernel with one system call
+		 */
+		void submit()
+		{
+			while (_unsubmitted) {
+				int const ret = syscall(__NR_io_uring_enter, _fd, _unsubmitted, 0, 0, 0, 0);
+				if (ret < 0) {
+					if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+						continue;
+
+					Genode::error("io_uring_enter failed, errno=", errno);
+					return;
+				}
+				_unsubmitted -= ret;
+				_in_flight   += ret;
+			}
+		}
+
+		/**
+		 * Apply functor to completed requests
+		 *
+		 * The functor is called with the request tag and the result, which
+		 * is the number of transferred bytes or a negative errno value. If
+		 * it returns false, the completion is left in the ring and the
+		 * iteration stops, e.g., if the completion cannot be acknowledged
+		 * at this time.
+		 */
+		template <typename FN>
+		void for_each_completion(FN const &fn)
+		{
+			unsigned head = *_cq_head;
+
+			while (head != __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE)) {
+
+				io_uring_cqe const &cqe = _cqes[head & _cq_mask];
+
+				if (!fn(Tag(cqe.user_data), cqe.res))
+					break;
+
+				head++;
+				_in_flight--;
+				__atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+			}
+		}
+
+		/**
+		 * Wait for and discard all outstanding requests
+		 *
+		 * Must be called before memory referenced by requests is released.
+		 */
+		void drain()
+		{
+			submit();
+
+			while (_in_flight) {
+				syscall(__NR_io_uring_enter, _fd, 0, _in_flight,
+				        IORING_ENTER_GETEVENTS, 0, 0);
+				for_each_completion([&] (Tag, int) { return true; });
+			}
+		}
+};
+
+#endif /* _URING_H_ */
@@ -13,7 +13,12 @@
  * contains multiple input sessions (Audio_out::Session_elem). For every packet
  * in the output queue the mixer sums the corresponding packets from all input
  * sessions up. The volume level of an input packet is applied in a linear way
- * (sample_value * volume_level) and the output packet is clipped at [1.0,-1.0].
+ * (sample_value * volume_level). The sum is clipped at [1.0,-1.0] and scaled
+ * by the output volume level.
+ *
+ * Sessions that requested a sample rate or period different from the native
+ * ones are served by an 'Audio_out::Converter', which transforms the client
+ * packets into native packets ahead of the output position.
  */
 
 /*
@@ -25,6 +30,8 @@
 
 /* Genode includes */
 #include <mixer/channel.h>
+#include <mixer/dsp.h>
+#include <mixer/resampler.h>
 #include <os/reporter.h>
 #include <root/component.h>
 #include <util/retry.h>
@@ -100,6 +107,7 @@ static void for_each_index(int max_index, FUNC const &func) {
 
 namespace Audio_out
 {
+	class Converter;
 	class Session_elem;
 	class Session_component;
 	class Root;
@@ -110,6 +118,153 @@ namespace Audio_out
 }
 
 
+/**
+ * Conversion of a client stream to the native sample rate and period
+ *
+ * Converted packets are kept in a small queue. The first entry corresponds to
+ * the current output position. Client packets are consumed in order, which
+ * decouples the client position from the output position.
+ */
+class Audio_out::Converter
+{
+	public:
+
+		enum { QUEUE = 16 };   /* maximum of converted packets buffered */
+
+	private:
+
+		Genode::Constructible< ::Mixer::Resampler> _resampler;
+
+		unsigned const _period;
+
+		/*
+		 * Number of slots in use, the slot of the current output position
+		 * plus the native packets covering two client periods
+		 *
+		 * Each buffered packet adds a native period of latency, so the
+		 * queue is not filled beyond what the client period requires.
+		 */
+		unsigned const _limit;
+
+		static unsigned _slots(unsigned sample_rate, unsigned period)
+		{
+			unsigned long const samples = 2UL*period*SAMPLE_RATE / sample_rate;
+			unsigned      const packets = (samples + PERIOD - 1) / PERIOD;
+
+			return Genode::min((unsigned)QUEUE, 1 + Genode::max(2U, packets));
+		}
+
+		Packet   _packets[QUEUE];
+		Packet   _none;          /* returned beyond the converted range */
+		unsigned _first    = 0;  /* slot of the current output position */
+		unsigned _count    = 0;  /* number of valid slots from '_first' */
+		unsigned _fill     = 0;  /* samples of the packet under conversion */
+		unsigned _in_pos   = 0;  /* next client packet to consume */
+		unsigned _out_pos  = 0;  /* output position seen at the last advance */
+
+		/*
+		 * The slot of the current output position is already played, the
+		 * first converted packet belongs to the successive position.
+		 */
+		void _placeholder()
+		{
+			_packets[_first] = Packet();
+			_count = 1;
+			_fill  = 0;
+		}
+
+	public:
+
+		Converter(unsigned sample_rate, unsigned period)
+		:
+			_period(period), _limit(_slots(sample_rate, period))
+		{
+			if (sample_rate != SAMPLE_RATE)
+				_resampler.construct(sample_rate, (unsigned)SAMPLE_RATE);
+		}
+
+		/**
+		 * Synchronize with client stream after the session got started
+		 */
+		void start(unsigned client_pos, unsigned out_pos)
+		{
+			_in_pos  = (client_pos + 1) % QUEUE_SIZE;
+			_out_pos = out_pos;
+			_placeholder();
+		}
+
+		/**
+		 * Return converted packet at the given offset from the output position
+		 */
+		Packet *get(unsigned offset) {
+			return offset < _count ? &_packets[(_first + offset) % QUEUE] : &_none; }
+
+		/**
+		 * Return position of the last consumed client packet
+		 */
+		unsigned consumed_pos() const { return (_in_pos + QUEUE_SIZE - 1) % QUEUE_SIZE; }
+
+		/**
+		 * Convert submitted client packets until the lookahead is reached
+		 */
+		void convert(Stream &stream)
+		{
+			while (_count < _limit) {
+
+				Packet &out = _packets[(_first + _count) % QUEUE];
+
+				while (_fill < PERIOD) {
+
+					if (_resampler.constructed()) {
+						_fill += _resampler->pull(out.content() + _fill, PERIOD - _fill);
+						if (_fill == PERIOD)
+							break;
+					}
+
+					Packet *in = stream.get(_in_pos);
+					if (!in->valid())
+						return;
+
+					if (_resampler.constructed()) {
+						_resampler->push(in->content(), _period);
+					} else {
+						Genode::memcpy(out.content() + _fill, in->content(),
+						               _period*SAMPLE_SIZE);
+						_fill += _period;
+					}
+
+					in->invalidate();
+					_in_pos = (_in_pos + 1) % QUEUE_SIZE;
+				}
+
+				out.mark_as_submitted();
+				_count++;
+				_fill = 0;
+			}
+		}
+
+		/**
+		 * Retire converted packets up to the new output position
+		 */
+		void advance(unsigned out_pos)
+		{
+			for (; _out_pos != out_pos; _out_pos = (_out_pos + 1) % QUEUE_SIZE) {
+				if (!_count)
+					continue;
+
+				_packets[_first].mark_as_played();
+				_packets[_first].invalidate();
+				_first = (_first + 1) % QUEUE;
+				_count--;
+			}
+
+			/* the client did not keep up, resume at the next position */
+			if (!_count)
+				_placeholder();
+		}
+};
+
+
 /**
  * The actual session element
  *
@@ -124,12 +279,18 @@ struct Audio_out::Session_elem : Audio_out::Session_rpc_object,
 	float           volume { 0.f };
 	bool            muted  { true };
 
+	/* only present if the session deviates from the native format */
+	Converter      *converter { nullptr };
+
 	Session_elem(Genode::Env & env,
 	             char const *label, Genode::Signal_context_capability data_cap)
 	: Session_rpc_object(env, data_cap), label(label) { }
 
-	Packet *get_packet(unsigned offset) {
-		return stream()->get(stream()->pos() + offset); }
+	Packet *get_packet(unsigned offset)
+	{
+		return converter ? converter->get(offset)
+		                 : stream()->get(stream()->pos() + offset);
+	}
 };
 
 
@@ -269,6 +430,12 @@ class Audio_out::Mixer
 			Stream *stream  = session->stream();
 			bool const full = stream->full();
 
+			/* the client position follows the consumption of the converter */
+			if (session->converter) {
+				session->converter->advance(pos);
+				pos = session->converter->consumed_pos();
+			}
+
 			/* mark packets as played and icrement position pointer */
 			while (stream->pos() != pos) {
 				stream->get(stream->pos())->mark_as_played();
@@ -296,30 +463,15 @@ class Audio_out::Mixer
 		/*
 		 * Mix input packet into output packet
 		 *
-		 * Packets are mixed in a linear way with min/max clipping.
+		 * Packets are summed up in a linear way. Clipping and the output
+		 * volume are applied once all inputs are mixed, see '_mix_channel'.
 		 */
-		void _mix_packet(Packet *out, Packet *in, bool clear,
-		                 float const out_vol, float const vol)
+		void _mix_packet(Packet *out, Packet *in, bool clear, float const vol)
 		{
-			if (clear) {
-				for_each_index(Audio_out::PERIOD, [&] (int const i) {
-					out->content()[i]  = (in->content()[i] * vol);
-
-					if (out->content()[i] > 1) out->content()[i] = 1;
-					if (out->content()[i] < -1) out->content()[i] = -1;
-
-					out->content()[i] *= out_vol;
-				});
-			} else {
-				for_each_index(Audio_out::PERIOD, [&] (int const i) {
-					out->content()[i] += (in->content()[i] * vol);
-
-					if (out->content()[i] > 1) out->content()[i] = 1;
-					if (out->content()[i] < -1) out->content()[i] = -1;
-
-					out->content()[i] *= out_vol;
-				});
-			}
+			if (clear)
+				::Mixer::Dsp::scale(out->content(), in->content(), vol, PERIOD);
+			else
+				::Mixer::Dsp::accumulate(out->content(), in->content(), vol, PERIOD);
 
 			/* mark the packet as processed by invalidating it */
 			in->invalidate();
@@ -357,7 +509,7 @@ class Audio_out::Mixer
 						/* skip if packet has been processed or was already played */
 						if ((!in->valid() && !mix_all) || in->played()) return;
 
-						_mix_packet(out, in, clear, out_vol, session.volume);
+						_mix_packet(out, in, clear, session.volume);
 
 						clear = false;
 					});
@@ -371,6 +523,9 @@ class Audio_out::Mixer
 					mix_all = true;
 				});
 
+			if (!clear)
+				::Mixer::Dsp::clip_and_scale(out->content(), out_vol, PERIOD);
+
 			return !clear;
 		}
 
@@ -385,6 +540,14 @@ class Audio_out::Mixer
 			pos[LEFT]  = _out[LEFT]->stream()->pos();
 			pos[RIGHT] = _out[RIGHT]->stream()->pos();
 
+			/* prepare native packets for converted sessions */
+			_for_each_channel([&] (Channel::Number, Session_channel *sc) {
+				sc->for_each_session([&] (Session_elem &session) {
+					if (session.converter && !session.stopped())
+						session.converter->convert(*session.stream());
+				});
+			});
+
 			/*
 			 * Look for packets that are valid and mix channels in an alternating
 			 * way.
@@ -605,16 +768,23 @@ class Audio_out::Session_component : public Audio_out::Session_elem
 {
 	private:
 
-		Mixer &_mixer;
+		Mixer             &_mixer;
+		Genode::Allocator &_alloc;
 
 	public:
 
-		Session_component(Genode::Env     &env,
-		                  char const      *label,
-		                  Channel::Number  number,
-		                  Mixer           &mixer)
-		: Session_elem(env, label, mixer.sig_cap()), _mixer(mixer)
+		Session_component(Genode::Env       &env,
+		                  Genode::Allocator &alloc,
+		                  char const        *label,
+		                  Channel::Number    number,
+		                  unsigned           sample_rate,
+		                  unsigned           period,
+		                  Mixer             &mixer)
+		: Session_elem(env, label, mixer.sig_cap()), _mixer(mixer), _alloc(alloc)
 		{
+			if (sample_rate != SAMPLE_RATE || period != PERIOD)
+				converter = new (_alloc) Converter(sample_rate, period);
+
 			Session_elem::number = number;
 			_mixer.add_session(Session_elem::number, *this);
 		}
@@ -623,12 +793,21 @@ class Audio_out::Session_component : public Audio_out::Session_elem
 		{
 			if (Session_rpc_object::active()) stop();
 			_mixer.remove_session(Session_elem::number, *this);
+
+			if (converter)
+				Genode::destroy(_alloc, converter);
 		}
 
 		void start()
 		{
 			Session_rpc_object::start();
-			stream()->pos(_mixer.pos(Session_elem::number));
+
+			unsigned const pos = _mixer.pos(Session_elem::number);
+			stream()->pos(pos);
+
+			if (converter)
+				converter->start(pos, pos);
+
 			_mixer.report_channels();
 		}
 
@@ -670,8 +849,27 @@ class Audio_out::Root : public Audio_out::Root_component
 			size_t ram_quota =
 				Arg_string::find_arg(args, "ram_quota").ulong_value(0);
 
+			unsigned const sample_rate =
+				Arg_string::find_arg(args, "sample_rate").ulong_value(SAMPLE_RATE);
+			unsigned const period =
+				Arg_string::find_arg(args, "period").ulong_value(PERIOD);
+
+			/* the period must evenly divide the native period */
+			if (period < MIN_PERIOD || period > PERIOD || (PERIOD % period)) {
+				Genode::error("unsupported period of ", period, " samples");
+				throw Genode::Service_denied();
+			}
+
+			if (sample_rate < 8000 || sample_rate > 192000) {
+				Genode::error("unsupported sample rate of ", sample_rate, " Hz");
+				throw Genode::Service_denied();
+			}
+
 			size_t session_size = align_addr(sizeof(Session_component), 12);
 
+			if (sample_rate != SAMPLE_RATE || period != PERIOD)
+				session_size += align_addr(sizeof(Converter), 12);
+
 			if ((ram_quota < session_size) ||
 			    (sizeof(Stream) > ram_quota - session_size)) {
 				Genode::error("insufficient 'ram_quota', got ", ram_quota, ", "
@@ -684,7 +882,8 @@ class Audio_out::Root : public Audio_out::Root_component
 				throw Genode::Service_denied();
 
 			Session_component *session = new (md_alloc())
-				Session_component(_env, label, (Channel::Number)ch, _mixer);
+				Session_component(_env, *md_alloc(), label, (Channel::Number)ch,
+				                  sample_rate, period, _mixer);
 
 			if (++_sessions == 1) _mixer.start();
 			return session;
@@ -0,0 +1,147 @@
+/*
+ * \brief  Hash table of address nodes
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The table uses open addressing with linear probing. Each slot holds the
+ * address next to the pointer to the node, so a lookup usually touches a
+ * single cache line and never dereferences nodes of non-matching
+ * addresses. Because the number of clients is bounded by the MAC
+ * allocator, the table has a fixed capacity that keeps the load factor
+ * below one half.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _ADDRESS_TABLE_H_
+#define _ADDRESS_TABLE_H_
+
+/* Genode */
+#include <base/exception.h>
+#include <util/string.h>
+
+namespace Net { template <typename> class Address_table; }
+
+
+template <typename NODE>
+class Net::Address_table
+{
+	public:
+
+		using Address = typename NODE::Address;
+
+		struct Full : Genode::Exception { };
+
+	private:
+
+		enum { CAPACITY = 512, MASK = CAPACITY - 1 };
+
+		struct Slot
+		{
+			Address  addr;
+			NODE    *node;
+		};
+
+		Slot     _slots[CAPACITY];
+		unsigned _count = 0;
+
+		/**
+		 * FNV-1a hash of the address bytes
+		 */
+		static unsigned _hash(Address const &addr)
+		{
+			Genode::uint32_t h = 2166136261u;
+			for (unsigned i = 0; i < sizeof(addr.addr); i++)
+				h = (h ^ addr.addr[i]) * 16777619u;
+			return h & MASK;
+		}
+
+		unsigned _index_of(Address const &addr) const
+		{
+			for (unsigned i = _hash(addr); _slots[i].node; i = (i + 1) & MASK)
+				if (_slots[i].addr == addr)
+					return i;
+			return CAPACITY;
+		}
+
+	public:
+
+		Address_table()
+		{
+			for (unsigned i = 0; i < CAPACITY; i++)
+				_slots[i].node = nullptr;
+		}
+
+		/**
+		 * Return node of the given address, or nullptr
+		 */
+		NODE *find(Address const &addr) const
+		{
+			unsigned const i = _index_of(addr);
+			return i < CAPACITY ? _slots[i].node : nullptr;
+		}
+
+		/**
+		 * Insert node, replacing a node with the same address
+		 *
+		 * \throw Full
+		 */
+		void insert(NODE &node)
+		{
+			Address const addr = node.addr();
+
+			unsigned i = _hash(addr);
+			for (; _slots[i].node; i = (i + 1) & MASK) {
+				if (_slots[i].addr == addr) {
+					_slots[i].node = &node;
+					return;
+				}
+			}
+
+			if (_count >= CAPACITY/2)
+				throw Full();
+
+			_slots[i] = Slot { addr, &node };
+			_count++;
+		}
+
+		/**
+		 * Remove node if it is the one registered for its address
+		 */
+		void remove(NODE &node)
+		{
+			unsigned i = _index_of(node.addr());
+			if (i == CAPACITY || _slots[i].node != &node)
+				return;
+
+			_slots[i].node = nullptr;
+			_count--;
+
+			/*
+			 * Move subsequent entries of the probe sequence into the gap if
+			 * their home slot does not lie between the gap and their
+			 * current position, which keeps all entries reachable without
+			 * tombstones.
+			 */
+			for (unsigned j = (i + 1) & MASK; _slots[j].node; j = (j + 1) & MASK) {
+
+				unsigned const home = _hash(_slots[j].addr);
+
+				bool const reachable = (i <= j) ? (i < home && home <= j)
+				                                : (i < home || home <= j);
+				if (reachable)
+					continue;
+
+				_slots[i] = _slots[j];
+				_slots[j].node = nullptr;
+				i = j;
+			}
+		}
+};
+
+#endif /* _ADDRESS_TABLE_H_ */
@@ -38,12 +38,33 @@ bool Session_component::handle_arp(Ethernet_frame *eth, Genode::size_t size)
 		 if (arp->src_ip() == arp->dst_ip())
 			return false;
 
-		Ipv4_address_node *node = vlan().ip_tree.first();
-		if (node)
-			node = node->find_by_address(arp->dst_ip());
+		Ipv4_address_node *node = vlan().ip_table.find(arp->dst_ip());
 		if (!node) {
 			arp->src_mac(_nic.mac());
+			return true;
 		}
+
+		/*
+		 * The requested address belongs to another client of the bridge.
+		 * Answer the request on behalf of the client instead of flooding it
+		 * to the uplink and all clients.
+		 */
+		Session_component &target = node->component();
+		if (&target == this)
+			return true;
+
+		Mac_address const target_mac(target.mac_address().addr);
+		Ipv4_address const old_src_ip = arp->src_ip();
+
+		arp->opcode(Arp_packet::REPLY);
+		arp->dst_mac(arp->src_mac());
+		arp->src_mac(target_mac);
+		arp->src_ip(arp->dst_ip());
+		arp->dst_ip(old_src_ip);
+		eth->dst(arp->dst_mac());
+		eth->src(target_mac);
+		send(eth, size);
+		return false;
 	}
 	return true;
 }
@@ -74,25 +95,20 @@ bool Session_component::handle_ip(Ethernet_frame *eth, Genode::size_t size)
 void Session_component::finalize_packet(Ethernet_frame *eth,
                                                     Genode::size_t size)
 {
-	Mac_address_node *node = vlan().mac_tree.first();
+	Mac_address_node *node = vlan().mac_table.find(eth->dst());
 	if (node)
-		node = node->find_by_address(eth->dst());
-	if (node)
-		node->component().send(eth, size);
+		node->component().send(eth, size, packet_offload());
 	else {
 		/* set our MAC as sender */
 		eth->src(_nic.mac());
-		_nic.send(eth, size);
+		_nic.send(eth, size, packet_offload());
 	}
 }
 
 
 void Session_component::_unset_ipv4_node()
 {
-	Ipv4_address_node * first = vlan().ip_tree.first();
-	if (!first) return;
-	if (first->find_by_address(_ipv4_node.addr()))
-		vlan().ip_tree.remove(&_ipv4_node);
+	vlan().ip_table.remove(_ipv4_node);
 }
 
 
@@ -103,7 +119,7 @@ void Session_component::set_ipv4_address(Ipv4_address ip_addr)
 {
 	_unset_ipv4_node();
 	_ipv4_node.addr(ip_addr);
-	vlan().ip_tree.insert(&_ipv4_node);
+	vlan().ip_table.insert(_ipv4_node);
 }
 
 
@@ -115,7 +131,8 @@ Session_component::Session_component(Genode::Ram_session        &ram,
                                      Genode::size_t              rx_buf_size,
                                      Mac_address                 vmac,
                                      Net::Nic                   &nic,
-                                     char                       *ip_addr)
+                                     char                       *ip_addr,
+                                     bool                        offload)
 : Stream_allocator(ram, rm, amount),
   Stream_dataspaces(ram, tx_buf_size, rx_buf_size),
   Session_rpc_object(rm,
@@ -127,7 +144,9 @@ Session_component::Session_component(Genode::Ram_session        &ram,
   _ipv4_node(*this),
   _nic(nic)
 {
-	vlan().mac_tree.insert(&_mac_node);
+	_offload = offload;
+
+	vlan().mac_table.insert(_mac_node);
 	vlan().mac_list.insert(&_mac_node);
 
 	/* static ip parsing */
@@ -150,7 +169,7 @@ Session_component::Session_component(Genode::Ram_session        &ram,
 
 
 Session_component::~Session_component() {
-	vlan().mac_tree.remove(&_mac_node);
+	vlan().mac_table.remove(_mac_node);
 	vlan().mac_list.remove(&_mac_node);
 	_unset_ipv4_node();
 }
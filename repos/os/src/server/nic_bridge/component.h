@@ -119,6 +119,7 @@ class Net::Session_component : public  Net::Stream_allocator,
 		 * \param tx_buf_size  buffer size for tx channel
 		 * \param rx_buf_size  buffer size for rx channel
 		 * \param vmac         virtual mac address
+		 * \param offload      client accepts packets with offload metadata
 		 */
 		Session_component(Genode::Ram_session &ram,
 		                  Genode::Region_map  &rm,
@@ -128,7 +129,8 @@ class Net::Session_component : public  Net::Stream_allocator,
 		                  Genode::size_t       rx_buf_size,
 		                  Mac_address          vmac,
 		                  Net::Nic            &nic,
-		                  char                *ip_addr = 0);
+		                  char                *ip_addr = 0,
+		                  bool                 offload = false);
 
 		~Session_component();
 
@@ -155,6 +157,12 @@ class Net::Session_component : public  Net::Stream_allocator,
 
 		bool link_state();
 
+		/*
+		 * Packets with offload metadata are resolved in software if the
+		 * receiver does not support them
+		 */
+		bool offload_supported() override { return true; }
+
 		void link_state_sigh(Genode::Signal_context_capability sigh) {
 			_link_state_sigh = sigh; }
 
@@ -211,12 +219,15 @@ class Net::Root : public Genode::Root_component<Net::Session_component>
 				Arg_string::find_arg(args, "tx_buf_size").ulong_value(0);
 			size_t rx_buf_size =
 				Arg_string::find_arg(args, "rx_buf_size").ulong_value(0);
+			bool const offload =
+				Arg_string::find_arg(args, "offload").bool_value(false);
 
 			try {
 				return new (md_alloc())
 					Session_component(_env.ram(), _env.rm(), _env.ep(),
 					                  ram_quota, tx_buf_size, rx_buf_size,
-					                  _mac_alloc.alloc(), _nic, ip_addr);
+					                  _mac_alloc.alloc(), _nic, ip_addr,
+					                  offload);
 			}
 			catch (Mac_allocator::Alloc_failed) {
 				Genode::warning("Mac address allocation failed!");
@@ -17,6 +17,7 @@
 #include <net/ethernet.h>
 #include <net/ipv4.h>
 #include <net/udp.h>
+#include <nic/offload.h>
 
 #include <component.h>
 #include <packet_handler.h>
@@ -62,15 +63,31 @@ void Packet_handler::_link_state()
 void Packet_handler::broadcast_to_clients(Ethernet_frame *eth, Genode::size_t size)
 {
 	/* check whether it's really a broadcast packet */
-	if (eth->dst() == Ethernet_frame::BROADCAST) {
-		/* iterate through the list of clients */
-		Mac_address_node *node =
-			_vlan.mac_list.first();
-		while (node) {
-			/* deliver packet */
-			node->component().send(eth, size);
-			node = node->next();
-		}
+	if (eth->dst() != Ethernet_frame::BROADCAST)
+		return;
+
+	/*
+	 * Complete a partial checksum once within the received frame, which
+	 * serves as read-only source for all copies. Thereby, the frame is
+	 * merely copied for each client, and the subsequent forwarding to the
+	 * uplink does not need to resolve the checksum either.
+	 */
+	::Nic::Offload offload = packet_offload();
+	if (offload.csum_partial() && !offload.gso()) {
+		::Nic::complete_checksum((char *)eth, size, offload);
+		offload.flags = ::Nic::Offload::CSUM_VALID;
+		_packet.offload(offload);
+	}
+
+	/* iterate through the list of clients, except for the sender */
+	for (Mac_address_node *node = _vlan.mac_list.first(); node;
+	     node = node->next()) {
+
+		Session_component &client = node->component();
+		if (static_cast<Packet_handler *>(&client) == this)
+			continue;
+
+		client.send(eth, size, offload);
 	}
 }
 
@@ -107,16 +124,52 @@ void Packet_handler::handle_ethernet(void* src, Genode::size_t size)
 }
 
 
-void Packet_handler::send(Ethernet_frame *eth, Genode::size_t size)
+void Packet_handler::_submit(Ethernet_frame *eth, Genode::size_t size,
+                             ::Nic::Offload const &offload)
 {
-	try {
+	bool const resolve = !_offload && offload.pending();
+
+	::Nic::Segmenter const segmenter((char const *)eth, size,
+	                                 resolve ? offload : ::Nic::Offload());
+
+	for (unsigned i = 0; i < segmenter.num_segments(); i++) {
+
 		/* copy and submit packet */
-		Packet_descriptor packet  = source()->alloc_packet(size);
+		Packet_descriptor packet  = source()->alloc_packet(segmenter.segment_size(i));
 		char             *content = source()->packet_content(packet);
-		Genode::memcpy((void*)content, (void*)eth, size);
+		segmenter.write_segment(i, content);
+
+		if (_offload)
+			packet.offload(offload);
+		else if (resolve && !offload.gso())
+			::Nic::complete_checksum(content, packet.size(), offload);
+
 		source()->submit_packet(packet);
+	}
+}
+
+
+void Packet_handler::_drop()
+{
+	/* logging each packet would dominate the costs of a broadcast storm */
+	if ((_dropped++ % 1024) == 0)
+		Genode::warning("Packet dropped (", _dropped, " in total)");
+}
+
+
+void Packet_handler::send(Ethernet_frame *eth, Genode::size_t size,
+                          ::Nic::Offload const &offload)
+{
+	/* don't block on a peer that does not keep up */
+	if (!source()->ready_to_submit()) {
+		_drop();
+		return;
+	}
+
+	try {
+		_submit(eth, size, offload);
 	} catch(Packet_stream_source< ::Nic::Session::Policy>::Packet_alloc_failed) {
-		Genode::warning("Packet dropped");
+		_drop();
 	}
 }
 
@@ -41,6 +41,18 @@ class Net::Packet_handler
 
 		Packet_descriptor _packet;
 		Net::Vlan        &_vlan;
+		unsigned long     _dropped = 0;
+
+		/**
+		 * Submit copy of a frame, resolving its offload metadata if needed
+		 */
+		void _submit(Ethernet_frame *eth, Genode::size_t size,
+		             ::Nic::Offload const &offload);
+
+		/**
+		 * Account packet that could not be passed to the peer
+		 */
+		void _drop();
 
 		/**
 		 * submit queue not empty anymore
@@ -81,6 +93,11 @@ class Net::Packet_handler
 		Genode::Signal_handler<Packet_handler> _source_submit;
 		Genode::Signal_handler<Packet_handler> _client_link_state;
 
+		/*
+		 * True if the peer of the handler accepts offload metadata
+		 */
+		bool _offload = false;
+
 	public:
 
 		Packet_handler(Genode::Entrypoint&, Vlan&);
@@ -91,7 +108,12 @@ class Net::Packet_handler
 		Net::Vlan & vlan() { return _vlan; }
 
 		/**
-		 * Broadcasts ethernet frame to all clients,
+		 * Return offload metadata of the packet currently handled
+		 */
+		::Nic::Offload const &packet_offload() const { return _packet.offload(); }
+
+		/**
+		 * Broadcasts ethernet frame to all clients except for the sender,
 		 * as long as its really a broadcast packtet.
 		 *
 		 * \param eth   ethernet frame to send.
@@ -103,10 +125,13 @@ class Net::Packet_handler
 		/**
 		 * Send ethernet frame
 		 *
-		 * \param eth   ethernet frame to send.
-		 * \param size  ethernet frame's size.
+		 * \param eth      ethernet frame to send.
+		 * \param size     ethernet frame's size.
+		 * \param offload  offload metadata of the frame, resolved in
+		 *                 software if the peer does not support it
 		 */
-		void send(Ethernet_frame *eth, Genode::size_t size);
+		void send(Ethernet_frame *eth, Genode::size_t size,
+		          ::Nic::Offload const &offload = ::Nic::Offload());
 
 		/**
 		 * Handle an ethernet packet
@@ -16,9 +16,9 @@
 #ifndef _VLAN_H_
 #define _VLAN_H_
 
-#include <util/avl_tree.h>
 #include <util/list.h>
 #include <address_node.h>
+#include <address_table.h>
 
 namespace Net {
 
@@ -28,13 +28,13 @@ namespace Net {
 	 */
 	struct Vlan
 	{
-		using Mac_address_tree  = Genode::Avl_tree<Mac_address_node>;
-		using Ipv4_address_tree = Genode::Avl_tree<Ipv4_address_node>;
-		using Mac_address_list  = Genode::List<Mac_address_node>;
+		using Mac_address_table  = Address_table<Mac_address_node>;
+		using Ipv4_address_table = Address_table<Ipv4_address_node>;
+		using Mac_address_list   = Genode::List<Mac_address_node>;
 
-		Mac_address_tree  mac_tree;
-		Mac_address_list  mac_list;
-		Ipv4_address_tree ip_tree;
+		Mac_address_table  mac_table;
+		Mac_address_list   mac_list;
+		Ipv4_address_table ip_table;
 	};
 }
 
@@ -0,0 +1,245 @@
+/*
+ * \brief  Capturing of NIC traffic to PCAPNG files
+ * \author agent
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/log.h>
+#include <file_system/util.h>
+
+/* local includes */
+#include <capture.h>
+#include <pcapng.h>
+
+using namespace Net;
+using namespace Genode;
+
+typedef File_system::Packet_descriptor Fs_packet;
+
+
+bool Capture::_alloc_batch()
+{
+	/* the batch must be submittable without blocking */
+	if (!_fs.tx()->ready_to_submit())
+		return false;
+
+	try { _batch = _fs.tx()->alloc_packet(BATCH_SIZE); }
+	catch (File_system::Session::Tx::Source::Packet_alloc_failed) {
+		return false; }
+
+	_batch_valid = true;
+	_batch_used  = 0;
+
+	/* each file starts with the section header and interface descriptions */
+	if (_file_offset == 0) {
+		_batch_used += Pcapng::write_section_header(_batch_content());
+		for (unsigned i = 0; i < 2; i++)
+			_batch_used += Pcapng::write_interface_description(
+				_batch_content(), _if_name[i].string(), _snaplen);
+	}
+	return true;
+}
+
+
+void Capture::_submit_batch()
+{
+	if (!_batch_valid)
+		return;
+
+	_fs.tx()->submit_packet(Fs_packet(_batch, _file(_curr_file),
+	                                  Fs_packet::WRITE,
+	                                  _batch_used, _file_offset));
+	_file_offset += _batch_used;
+	_batch_valid  = false;
+	_pending[_curr_file]++;
+}
+
+
+void Capture::_ack(Fs_packet const &packet)
+{
+	for (unsigned i = 0; i < _num_files; i++) {
+		if (packet.handle().value != _file_ids[i])
+			continue;
+
+		if (_pending[i])
+			_pending[i]--;
+
+		if (!packet.succeeded() && _write_errors++ == 0)
+			warning("failed to write capture to ", _file_name(i));
+		break;
+	}
+	_fs.tx()->release_packet(packet);
+}
+
+
+void Capture::_drain(unsigned i)
+{
+	while (_pending[i])
+		_ack(_fs.tx()->get_acked_packet());
+}
+
+
+void Capture::_start_file(unsigned i)
+{
+	/*
+	 * Writes of the previous round, or of the completed file if the ring
+	 * consists of a single file, must not land after the truncation.
+	 */
+	_drain(i);
+
+	/* drop the preallocated but unused tail of the completed file */
+	_fs.truncate(_file(_curr_file), _file_offset);
+
+	/* discard the content of the previous round and preallocate the file */
+	_curr_file   = i;
+	_file_offset = 0;
+	_fs.truncate(_file(i), 0);
+	_fs.truncate(_file(i), _file_size);
+}
+
+
+bool Capture::_reserve(size_t size)
+{
+	size_t const used = _batch_valid ? _batch_used : 0;
+
+	bool const fits_batch = _batch_valid && used + size <= BATCH_SIZE;
+	bool const fits_file  = _file_offset + used + size <= _file_size;
+
+	if (fits_batch && fits_file)
+		return true;
+
+	_submit_batch();
+
+	if (!fits_file)
+		_start_file((_curr_file + 1) % _num_files);
+
+	return _alloc_batch();
+}
+
+
+void Capture::capture(Interface_id interface, void const *eth, size_t size)
+{
+	if (!_filter.matches(eth, size)) {
+		_filtered++;
+		return;
+	}
+
+	size_t const caplen = min(size, _snaplen);
+
+	if (!_reserve(Pcapng::enhanced_packet_size(caplen))) {
+		_dropped++;
+		return;
+	}
+
+	uint64_t const time_us = _timer.curr_time().trunc_to_plain_us().value;
+
+	_batch_used += Pcapng::write_enhanced_packet(_batch_content(), interface,
+	                                             time_us, eth, caplen, size);
+	_captured++;
+	_bytes += caplen;
+}
+
+
+void Capture::_report()
+{
+	if (!_reporter.enabled() || _reported == _captured + _filtered + _dropped)
+		return;
+
+	_reported = _captured + _filtered + _dropped;
+
+	try {
+		Reporter::Xml_generator xml(_reporter, [&] () {
+			xml.attribute("captured",     _captured);
+			xml.attribute("filtered",     _filtered);
+			xml.attribute("dropped",      _dropped);
+			xml.attribute("bytes",        _bytes);
+			xml.attribute("write_errors", _write_errors);
+			xml.attribute("file",         _file_name(_curr_file));
+		});
+	} catch (Xml_generator::Buffer_exceeded) { }
+}
+
+
+void Capture::_handle_fs_ack()
+{
+	while (_fs.tx()->ack_avail())
+		_ack(_fs.tx()->get_acked_packet());
+}
+
+
+void Capture::_handle_flush_timeout(Duration)
+{
+	if (_batch_valid && _batch_used)
+		_submit_batch();
+
+	_report();
+}
+
+
+Capture::Capture(Env                  &env,
+                 Allocator            &alloc,
+                 Xml_node              config,
+                 Interface_name const &downlink,
+                 Interface_name const &uplink,
+                 Timer::Connection    &timer)
+:
+	_fs_block_alloc(&alloc),
+	_fs(env, _fs_block_alloc, "capture", "/", true, FS_BUF_SIZE),
+	_fs_ack_handler(env.ep(), *this, &Capture::_handle_fs_ack),
+	_filter(config.attribute_value("filter", Filter_expr()).string()),
+	_if_name { downlink, uplink },
+	_name(config.attribute_value("name", File_name("nic_dump"))),
+	_snaplen(max((size_t)64, min((size_t)MAX_SNAPLEN,
+	                             (size_t)config.attribute_value("snaplen",
+	                                     Number_of_bytes(MAX_SNAPLEN))))),
+	_file_size(max((size_t)4*BATCH_SIZE, (size_t)config.attribute_value("file_size",
+	                                  Number_of_bytes(16*1024*1024)))),
+	_num_files(max(1U, min((unsigned)MAX_FILES,
+	                       config.attribute_value("files", 4U)))),
+	_reporter(env, "capture"),
+	_timer(timer),
+	_flush_timeout(timer, *this, &Capture::_handle_flush_timeout,
+	               Microseconds(FLUSH_US))
+{
+	_fs.sigh_ack_avail(_fs_ack_handler);
+
+	_reporter.enabled(config.attribute_value("report", false));
+
+	/* open the ring files and remove the captures of a previous run */
+	File_system::Dir_handle const dir = _fs.dir("/", false);
+	File_system::Handle_guard guard(_fs, dir);
+
+	for (unsigned i = 0; i < _num_files; i++) {
+
+		File_name const name = _file_name(i);
+
+		try {
+			_file_ids[i] = _fs.file(dir, name.string(), File_system::WRITE_ONLY, true).value; }
+		catch (File_system::Node_already_exists) {
+			_file_ids[i] = _fs.file(dir, name.string(), File_system::WRITE_ONLY, false).value; }
+
+		_fs.truncate(_file(i), 0);
+	}
+
+	_fs.truncate(_file(0), _file_size);
+
+	log("capturing to ", _file_name(0), " (", _num_files, " files of ",
+	    _file_size / 1024, " KiB, snaplen ", _snaplen, ")");
+}
+
+
+Capture::~Capture()
+{
+	_submit_batch();
+
+	for (unsigned i = 0; i < _num_files; i++)
+		_fs.close(_file(i));
+}
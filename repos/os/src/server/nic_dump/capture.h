@@ -0,0 +1,146 @@
+/*
+ * \brief  Capturing of NIC traffic to PCAPNG files
+ * \author agent
+ * \date   2026-10-19
+ *
+ * Captured packets are appended to a batch that resides directly in the
+ * bulk buffer of the file-system session. A batch is submitted as one write
+ * request once it is full or when the flush period expires. Acknowledgements
+ * are collected asynchronously, so capturing never blocks the forwarding of
+ * packets. If no batch can be allocated because the file system lags behind,
+ * packets are dropped from the capture and counted.
+ *
+ * The capture is written to a ring of files, each preallocated to its
+ * maximum size. When the current file is full, it is truncated to the
+ * written size and the next file of the ring is overwritten.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _CAPTURE_H_
+#define _CAPTURE_H_
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <file_system_session/connection.h>
+#include <os/reporter.h>
+#include <timer_session/connection.h>
+#include <util/xml_node.h>
+
+/* local includes */
+#include <capture_filter.h>
+
+namespace Net { class Capture; }
+
+
+class Net::Capture
+{
+	public:
+
+		/**
+		 * Interfaces a packet can be received from
+		 */
+		enum Interface_id { DOWNLINK = 0, UPLINK = 1 };
+
+		typedef Genode::String<64> Interface_name;
+
+	private:
+
+		enum {
+			BATCH_SIZE  = 64*1024,
+			FS_BUF_SIZE = File_system::Session::TX_QUEUE_SIZE*BATCH_SIZE,
+			MAX_FILES   = 16,
+			MAX_SNAPLEN = BATCH_SIZE/2,
+			FLUSH_US    = 500*1000,
+		};
+
+		typedef Genode::String<File_system::MAX_NAME_LEN> File_name;
+		typedef Genode::String<128>                       Filter_expr;
+
+		Genode::Allocator_avl   _fs_block_alloc;
+		File_system::Connection _fs;
+
+		Genode::Signal_handler<Capture> _fs_ack_handler;
+
+		Capture_filter const _filter;
+		Interface_name const _if_name[2];
+		File_name      const _name;
+		Genode::size_t const _snaplen;
+		Genode::size_t const _file_size;
+		unsigned       const _num_files;
+
+		unsigned long           _file_ids[MAX_FILES];
+		unsigned                _pending[MAX_FILES] { };  /* writes in flight */
+		unsigned                _curr_file   = 0;
+		File_system::seek_off_t _file_offset = 0;
+
+		File_system::File_handle _file(unsigned i) const {
+			return File_system::File_handle(_file_ids[i]); }
+
+		File_system::Packet_descriptor _batch { };
+		bool                           _batch_valid = false;
+		Genode::size_t                 _batch_used  = 0;
+
+		/*
+		 * Statistics
+		 */
+		unsigned long      _captured     = 0;
+		unsigned long      _filtered     = 0;
+		unsigned long      _dropped      = 0;
+		unsigned long long _bytes        = 0;
+		unsigned long      _write_errors = 0;
+		unsigned long      _reported     = ~0UL;
+
+		Genode::Reporter _reporter;
+
+		Timer::Connection                 &_timer;
+		Timer::Periodic_timeout<Capture>   _flush_timeout;
+
+		File_name _file_name(unsigned i) const {
+			return File_name(_name, ".", i, ".pcapng"); }
+
+		char *_batch_content() {
+			return _fs.tx()->packet_content(_batch) + _batch_used; }
+
+		bool _alloc_batch();
+		void _submit_batch();
+		void _ack(File_system::Packet_descriptor const &packet);
+		void _drain(unsigned i);
+		void _start_file(unsigned i);
+		bool _reserve(Genode::size_t size);
+		void _report();
+
+		void _handle_fs_ack();
+		void _handle_flush_timeout(Genode::Duration);
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param config  '<capture>' node
+		 *
+		 * \throw Capture_filter::Invalid_expression
+		 * \throw File_system::Exception              ring files unavailable
+		 */
+		Capture(Genode::Env          &env,
+		        Genode::Allocator    &alloc,
+		        Genode::Xml_node      config,
+		        Interface_name const &downlink,
+		        Interface_name const &uplink,
+		        Timer::Connection    &timer);
+
+		~Capture();
+
+		/**
+		 * Capture Ethernet frame received from the given interface
+		 */
+		void capture(Interface_id interface, void const *eth, Genode::size_t size);
+};
+
+#endif /* _CAPTURE_H_ */
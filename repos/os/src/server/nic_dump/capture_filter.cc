@@ -0,0 +1,327 @@
+/*
+ * \brief  Compiled filter expression for selecting captured packets
+ * \author agent
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/log.h>
+
+/* local includes */
+#include <capture_filter.h>
+
+using namespace Net;
+using namespace Genode;
+
+
+/************
+ ** Parser **
+ ************/
+
+static bool word_char(char c)
+{
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+	    || (c >= '0' && c <= '9') || c == '.';
+}
+
+
+/**
+ * Read decimal number not exceeding 'max'
+ *
+ * \return  number of consumed characters, 0 on error
+ */
+static size_t parse_decimal(char const *s, uint32_t max, uint32_t &result)
+{
+	size_t   i = 0;
+	uint32_t v = 0;
+
+	for (; s[i] >= '0' && s[i] <= '9'; i++) {
+		v = v*10 + (s[i] - '0');
+		if (v > max)
+			return 0;
+	}
+	result = v;
+	return i;
+}
+
+
+/**
+ * Read IPv4 address in dotted-decimal notation spanning the whole string
+ *
+ * In contrast to 'ascii_to', octets beyond 255 are rejected.
+ */
+static bool parse_ipv4(char const *s, uint32_t &result)
+{
+	result = 0;
+	for (unsigned i = 0; i < 4; i++) {
+
+		uint32_t     octet = 0;
+		size_t const n     = parse_decimal(s, 255, octet);
+		if (!n)
+			return false;
+
+		s += n;
+		result = (result << 8) | octet;
+
+		if (i < 3 && *s++ != '.')
+			return false;
+	}
+	return *s == 0;
+}
+
+
+void Capture_filter::_next_token()
+{
+	while (*_pos == ' ' || *_pos == '\t' || *_pos == '\n')
+		_pos++;
+
+	char const *start = _pos;
+
+	if (!*_pos) {
+		_token = Token();
+		return;
+	}
+
+	/* C-style operators are aliases of the keywords */
+	if (!strcmp(_pos, "&&", 2)) { _pos += 2; _token = Token("and"); return; }
+	if (!strcmp(_pos, "||", 2)) { _pos += 2; _token = Token("or");  return; }
+	if (*_pos == '!')           { _pos += 1; _token = Token("not"); return; }
+
+	if (*_pos == '(' || *_pos == ')') {
+		_pos++;
+	} else {
+		while (word_char(*_pos))
+			_pos++;
+	}
+
+	if (_pos == start || (size_t)(_pos - start) >= Token::capacity()) {
+		error("invalid capture filter at '", Cstring(start), "'");
+		throw Invalid_expression();
+	}
+	_token = Token(Cstring(start, _pos - start));
+}
+
+
+bool Capture_filter::_accept(char const *token)
+{
+	if (_token != token)
+		return false;
+
+	_next_token();
+	return true;
+}
+
+
+void Capture_filter::_emit(Opcode op, uint32_t arg)
+{
+	if (_length == MAX_INSTRUCTIONS) {
+		error("capture filter too complex");
+		throw Invalid_expression();
+	}
+	_program[_length++] = Instruction { op, arg };
+}
+
+
+void Capture_filter::_expr()
+{
+	_term();
+	while (_accept("or")) {
+		_term();
+		_emit(OR);
+	}
+}
+
+
+void Capture_filter::_term()
+{
+	_factor();
+	while (_accept("and")) {
+		_factor();
+		_emit(AND);
+	}
+}
+
+
+void Capture_filter::_factor()
+{
+	if (_accept("not")) {
+		_factor();
+		_emit(NOT);
+		return;
+	}
+
+	if (_accept("(")) {
+		_expr();
+		if (!_accept(")")) {
+			error("capture filter lacks closing parenthesis");
+			throw Invalid_expression();
+		}
+		return;
+	}
+
+	_primitive();
+}
+
+
+void Capture_filter::_primitive()
+{
+	int dir = 0;
+	if      (_accept("src")) dir = 1;
+	else if (_accept("dst")) dir = 2;
+
+	if (_accept("host")) {
+		uint32_t ip = 0;
+		if (!parse_ipv4(_token.string(), ip)) {
+			error("invalid IPv4 address '", _token, "' in capture filter");
+			throw Invalid_expression();
+		}
+		_next_token();
+		_emit((Opcode)(HOST + dir), ip);
+		return;
+	}
+
+	if (_accept("port")) {
+		uint32_t port = 0;
+		size_t const n = parse_decimal(_token.string(), 0xffff, port);
+		if (!n || n + 1 != _token.length()) {
+			error("invalid port '", _token, "' in capture filter");
+			throw Invalid_expression();
+		}
+		_next_token();
+		_emit((Opcode)(PORT + dir), port);
+		return;
+	}
+
+	if (dir == 0) {
+		if (_accept("arp"))  { _emit(ARP);  return; }
+		if (_accept("ip"))   { _emit(IPV4); return; }
+		if (_accept("icmp")) { _emit(ICMP); return; }
+		if (_accept("tcp"))  { _emit(TCP);  return; }
+		if (_accept("udp"))  { _emit(UDP);  return; }
+	}
+
+	error("unexpected '", _token, "' in capture filter");
+	throw Invalid_expression();
+}
+
+
+Capture_filter::Capture_filter(char const *expression)
+:
+	_pos(expression)
+{
+	_next_token();
+
+	if (_token.length() <= 1)
+		return;
+
+	_expr();
+
+	if (_token.length() > 1) {
+		error("unexpected '", _token, "' at the end of the capture filter");
+		throw Invalid_expression();
+	}
+}
+
+
+/****************
+ ** Evaluation **
+ ****************/
+
+namespace {
+
+	/**
+	 * Header fields referred to by the filter primitives
+	 */
+	struct Fields
+	{
+		enum { ETH_HDR = 14, ETH_TYPE = 12,
+		       ETH_TYPE_IPV4 = 0x0800, ETH_TYPE_ARP = 0x0806,
+		       IP_PROTO_ICMP = 1, IP_PROTO_TCP = 6, IP_PROTO_UDP = 17 };
+
+		bool     arp   = false;
+		bool     ipv4  = false;
+		bool     ports = false;
+		uint8_t  proto = 0;
+		uint32_t src   = 0, dst   = 0;
+		uint16_t sport = 0, dport = 0;
+
+		static uint16_t be16(uint8_t const *p) { return (p[0] << 8) | p[1]; }
+
+		static uint32_t be32(uint8_t const *p) {
+			return ((uint32_t)be16(p) << 16) | be16(p + 2); }
+
+		Fields(uint8_t const *eth, size_t size)
+		{
+			if (size < ETH_HDR)
+				return;
+
+			uint16_t const type = be16(eth + ETH_TYPE);
+
+			arp = (type == ETH_TYPE_ARP);
+			if (type != ETH_TYPE_IPV4 || size < ETH_HDR + 20)
+				return;
+
+			uint8_t const *ip  = eth + ETH_HDR;
+			size_t   const ihl = (ip[0] & 0xf)*4;
+
+			ipv4  = true;
+			proto = ip[9];
+			src   = be32(ip + 12);
+			dst   = be32(ip + 16);
+
+			/* only the first fragment contains the transport header */
+			bool const first_fragment = (be16(ip + 6) & 0x1fff) == 0;
+
+			if ((proto == IP_PROTO_TCP || proto == IP_PROTO_UDP)
+			 && first_fragment && size >= ETH_HDR + ihl + 4) {
+				ports = true;
+				sport = be16(ip + ihl);
+				dport = be16(ip + ihl + 2);
+			}
+		}
+	};
+}
+
+
+bool Capture_filter::matches(void const *eth, size_t size) const
+{
+	if (!_length)
+		return true;
+
+	Fields const f((uint8_t const *)eth, size);
+
+	uint64_t stack = 0;
+
+	auto push = [&] (bool v) { stack = (stack << 1) | v; };
+	auto pop  = [&] () { bool const v = stack & 1; stack >>= 1; return v; };
+
+	for (unsigned i = 0; i < _length; i++) {
+
+		uint32_t const arg = _program[i].arg;
+
+		switch (_program[i].op) {
+		case ARP:      push(f.arp); break;
+		case IPV4:     push(f.ipv4); break;
+		case ICMP:     push(f.ipv4 && f.proto == Fields::IP_PROTO_ICMP); break;
+		case TCP:      push(f.ipv4 && f.proto == Fields::IP_PROTO_TCP); break;
+		case UDP:      push(f.ipv4 && f.proto == Fields::IP_PROTO_UDP); break;
+		case HOST:     push(f.ipv4 && (f.src == arg || f.dst == arg)); break;
+		case SRC_HOST: push(f.ipv4 && f.src == arg); break;
+		case DST_HOST: push(f.ipv4 && f.dst == arg); break;
+		case PORT:     push(f.ports && (f.sport == arg || f.dport == arg)); break;
+		case SRC_PORT: push(f.ports && f.sport == arg); break;
+		case DST_PORT: push(f.ports && f.dport == arg); break;
+		case NOT:      push(!pop()); break;
+		case AND:      { bool const b = pop(), a = pop(); push(a && b); } break;
+		case OR:       { bool const b = pop(), a = pop(); push(a || b); } break;
+		}
+	}
+	return stack & 1;
+}
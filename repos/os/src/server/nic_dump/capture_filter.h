@@ -0,0 +1,96 @@
+/*
+ * \brief  Compiled filter expression for selecting captured packets
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The expression syntax follows the basic primitives known from tcpdump:
+ *
+ *   expr      := term { "or" term }
+ *   term      := factor { "and" factor }
+ *   factor    := "not" factor | "(" expr ")" | primitive
+ *   primitive := "arp" | "ip" | "icmp" | "tcp" | "udp"
+ *              | [ "src" | "dst" ] "host" <IPv4 address>
+ *              | [ "src" | "dst" ] "port" <number>
+ *
+ * The expression is translated into a postfix program once. For each
+ * packet, the relevant header fields are extracted once and the program is
+ * evaluated on a stack of bits.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _CAPTURE_FILTER_H_
+#define _CAPTURE_FILTER_H_
+
+/* Genode includes */
+#include <base/exception.h>
+#include <util/string.h>
+
+namespace Net { class Capture_filter; }
+
+
+class Net::Capture_filter
+{
+	public:
+
+		struct Invalid_expression : Genode::Exception { };
+
+		typedef Genode::String<32> Token;
+
+	private:
+
+		enum Opcode {
+			ARP, IPV4, ICMP, TCP, UDP,
+			HOST, SRC_HOST, DST_HOST,
+			PORT, SRC_PORT, DST_PORT,
+			NOT, AND, OR };
+
+		struct Instruction
+		{
+			Opcode           op;
+			Genode::uint32_t arg;
+		};
+
+		/* the evaluation stack is a 64-bit word */
+		enum { MAX_INSTRUCTIONS = 64 };
+
+		Instruction _program[MAX_INSTRUCTIONS];
+		unsigned    _length = 0;
+
+		/*
+		 * Parser state, only used during construction
+		 */
+		char const *_pos   = nullptr;
+		Token       _token { };
+
+		void _next_token();
+		bool _accept(char const *token);
+		void _emit(Opcode op, Genode::uint32_t arg = 0);
+		void _expr();
+		void _term();
+		void _factor();
+		void _primitive();
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * An empty expression matches all packets.
+		 *
+		 * \throw Invalid_expression
+		 */
+		Capture_filter(char const *expression);
+
+		/**
+		 * Return true if the Ethernet frame matches the expression
+		 */
+		bool matches(void const *eth, Genode::size_t size) const;
+};
+
+#endif /* _CAPTURE_FILTER_H_ */
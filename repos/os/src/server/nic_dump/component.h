@@ -97,7 +97,8 @@ class Net::Session_component : public Session_component_base,
 		                  Genode::Xml_node      config,
 		                  Timer::Connection    &timer,
 		                  Genode::Duration     &curr_time,
-		                  Genode::Env          &env);
+		                  Genode::Env          &env,
+		                  Capture              *capture);
 
 
 		/******************
@@ -120,6 +121,7 @@ class Net::Root : public Genode::Root_component<Session_component,
 		Genode::Xml_node   _config;
 		Timer::Connection &_timer;
 		Genode::Duration  &_curr_time;
+		Capture           *_capture;
 
 
 		/********************
@@ -134,7 +136,8 @@ class Net::Root : public Genode::Root_component<Session_component,
 		     Genode::Allocator &alloc,
 		     Genode::Xml_node   config,
 		     Timer::Connection &timer,
-		     Genode::Duration  &curr_time);
+		     Genode::Duration  &curr_time,
+		     Capture           *capture);
 };
 
 #endif /* _COMPONENT_H_ */
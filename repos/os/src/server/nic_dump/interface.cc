@@ -31,7 +31,12 @@ void Interface::_handle_eth(void              *const  eth_base,
 		Interface &remote = _remote.deref();
 		Packet_log_config log_cfg;
 
-		if (_log_time) {
+		if (_capture)
+			_capture->capture(_capture_id, eth_base, eth_size);
+
+		if (!_log) {
+			/* skip logging */
+		} else if (_log_time) {
 			Genode::Duration const new_time    = _timer.curr_time();
 			unsigned long    const new_time_ms = new_time.trunc_to_plain_us().value / 1000;
 			unsigned long    const old_time_ms = _curr_time.trunc_to_plain_us().value / 1000;
@@ -97,13 +102,16 @@ Interface::Interface(Entrypoint        &ep,
                      Interface_label    label,
                      Timer::Connection &timer,
                      Duration          &curr_time,
+                     bool               log,
                      bool               log_time,
-                     Allocator         &alloc)
+                     Allocator         &alloc,
+                     Capture           *capture,
+                     Capture::Interface_id capture_id)
 :
 	_sink_ack     (ep, *this, &Interface::_ack_avail),
 	_sink_submit  (ep, *this, &Interface::_ready_to_submit),
 	_source_ack   (ep, *this, &Interface::_ready_to_ack),
 	_source_submit(ep, *this, &Interface::_packet_avail),
 	_alloc(alloc), _label(label), _timer(timer), _curr_time(curr_time),
-	_log_time(log_time)
+	_log(log), _log_time(log_time), _capture(capture), _capture_id(capture_id)
 { }
@@ -16,6 +16,7 @@
 
 /* local includes */
 #include <pointer.h>
+#include <capture.h>
 
 /* Genode includes */
 #include <nic_session/nic_session.h>
@@ -51,7 +52,10 @@ class Net::Interface
 		Interface_label     _label;
 		Timer::Connection  &_timer;
 		Genode::Duration   &_curr_time;
+		bool                _log;
 		bool                _log_time;
+		Capture            *_capture;
+		Capture::Interface_id const _capture_id;
 
 		void _send(Ethernet_frame &eth, Genode::size_t const eth_size);
 
@@ -79,8 +83,11 @@ class Net::Interface
 		          Interface_label     label,
 		          Timer::Connection  &timer,
 		          Genode::Duration   &curr_time,
+		          bool                log,
 		          bool                log_time,
-		          Genode::Allocator  &alloc);
+		          Genode::Allocator  &alloc,
+		          Capture            *capture,
+		          Capture::Interface_id capture_id);
 
 		void remote(Interface &remote) { _remote.set(remote); }
 };
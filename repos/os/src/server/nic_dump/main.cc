@@ -16,6 +16,7 @@
 #include <base/heap.h>
 #include <base/attached_rom_dataspace.h>
 #include <timer_session/connection.h>
+#include <util/reconstructible.h>
 
 /* local includes */
 #include <component.h>
@@ -32,18 +33,44 @@ class Main
 		Timer::Connection      _timer;
 		Duration               _curr_time { Microseconds(0UL) };
 		Heap                   _heap;
+		Constructible<Capture> _capture;
 		Net::Root              _root;
 
+		Capture *_init_capture(Env &env);
+
 	public:
 
 		Main(Env &env);
 };
 
 
+Capture *Main::_init_capture(Env &env)
+{
+	Xml_node const config = _config.xml();
+
+	try {
+		_capture.construct(env, _heap, config.sub_node("capture"),
+		                   config.attribute_value("downlink", Capture::Interface_name()),
+		                   config.attribute_value("uplink",   Capture::Interface_name()),
+		                   _timer);
+		return &*_capture;
+	}
+	catch (Xml_node::Nonexistent_sub_node) { }
+	catch (Capture_filter::Invalid_expression) {
+		error("capturing disabled because of invalid filter"); }
+	catch (File_system::Exception) {
+		error("capturing disabled because of inaccessible files"); }
+	catch (Service_denied) {
+		error("capturing disabled because of missing file system"); }
+
+	return nullptr;
+}
+
+
 Main::Main(Env &env)
 :
 	_config(env, "config"), _timer(env), _heap(&env.ram(), &env.rm()),
-	_root(env, _heap, _config.xml(), _timer, _curr_time)
+	_root(env, _heap, _config.xml(), _timer, _curr_time, _init_capture(env))
 {
 	env.parent().announce(env.ep().manage(_root));
 }
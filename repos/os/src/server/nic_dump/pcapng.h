@@ -0,0 +1,151 @@
+/*
+ * \brief  Generation of PCAPNG blocks
+ * \author agent
+ * \date   2026-10-19
+ *
+ * Only the blocks needed for a capture file are supported: the section
+ * header, one interface description per capturing interface, and the
+ * enhanced packet block. All values are written in host byte order, which
+ * readers detect by the byte-order magic of the section header.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _PCAPNG_H_
+#define _PCAPNG_H_
+
+/* Genode includes */
+#include <util/string.h>
+
+namespace Net {
+namespace Pcapng {
+
+	using Genode::size_t;
+	using Genode::uint16_t;
+	using Genode::uint32_t;
+	using Genode::uint64_t;
+
+	enum {
+		SHB_TYPE      = 0x0a0d0d0a,
+		IDB_TYPE      = 0x00000001,
+		EPB_TYPE      = 0x00000006,
+		BYTE_ORDER    = 0x1a2b3c4d,
+		LINKTYPE_ETH  = 1,
+		OPT_END       = 0,
+		OPT_IF_NAME   = 2,
+		MAX_NAME_LEN  = 64,
+	};
+
+	static inline size_t pad4(size_t size) { return (size + 3) & ~(size_t)3; }
+
+	/**
+	 * Sequential writer of 32-bit aligned block content
+	 */
+	class Writer
+	{
+		private:
+
+			char *_dst;
+
+		public:
+
+			Writer(char *dst) : _dst(dst) { }
+
+			void u16(uint16_t v) { Genode::memcpy(_dst, &v, 2); _dst += 2; }
+			void u32(uint32_t v) { Genode::memcpy(_dst, &v, 4); _dst += 4; }
+			void u64(uint64_t v) { Genode::memcpy(_dst, &v, 8); _dst += 8; }
+
+			void data(void const *src, size_t len)
+			{
+				Genode::memcpy(_dst, src, len);
+				Genode::memset(_dst + len, 0, pad4(len) - len);
+				_dst += pad4(len);
+			}
+	};
+
+	static inline size_t section_header_size() { return 28; }
+
+	static inline size_t write_section_header(char *dst)
+	{
+		size_t const size = section_header_size();
+
+		Writer w(dst);
+		w.u32(SHB_TYPE);
+		w.u32(size);
+		w.u32(BYTE_ORDER);
+		w.u16(1);                 /* major version */
+		w.u16(0);                 /* minor version */
+		w.u64(~(uint64_t)0);      /* unspecified section length */
+		w.u32(size);
+		return size;
+	}
+
+	static inline size_t interface_description_size(char const *name)
+	{
+		size_t const name_len = Genode::min(Genode::strlen(name),
+		                                    (size_t)MAX_NAME_LEN);
+		return 20 + (name_len ? 4 + pad4(name_len) : 0) + 4;
+	}
+
+	/**
+	 * Write description of an Ethernet interface
+	 *
+	 * Interfaces are numbered in the order of their descriptions.
+	 */
+	static inline size_t write_interface_description(char *dst,
+	                                                 char const *name,
+	                                                 uint32_t snaplen)
+	{
+		size_t const size     = interface_description_size(name);
+		size_t const name_len = Genode::min(Genode::strlen(name),
+		                                    (size_t)MAX_NAME_LEN);
+		Writer w(dst);
+		w.u32(IDB_TYPE);
+		w.u32(size);
+		w.u16(LINKTYPE_ETH);
+		w.u16(0);
+		w.u32(snaplen);
+		if (name_len) {
+			w.u16(OPT_IF_NAME);
+			w.u16(name_len);
+			w.data(name, name_len);
+		}
+		w.u16(OPT_END);
+		w.u16(0);
+		w.u32(size);
+		return size;
+	}
+
+	static inline size_t enhanced_packet_size(size_t caplen) {
+		return 32 + pad4(caplen); }
+
+	/**
+	 * Write packet with a timestamp in microseconds
+	 */
+	static inline size_t write_enhanced_packet(char *dst, uint32_t interface,
+	                                           uint64_t time_us,
+	                                           void const *data,
+	                                           size_t caplen, size_t len)
+	{
+		size_t const size = enhanced_packet_size(caplen);
+
+		Writer w(dst);
+		w.u32(EPB_TYPE);
+		w.u32(size);
+		w.u32(interface);
+		w.u32(time_us >> 32);
+		w.u32(time_us & 0xffffffff);
+		w.u32(caplen);
+		w.u32(len);
+		w.data(data, caplen);
+		w.u32(size);
+		return size;
+	}
+} }
+
+#endif /* _PCAPNG_H_ */
@@ -3,5 +3,6 @@ TARGET = nic_dump
 LIBS += base net
 
 SRC_CC += component.cc main.cc packet_log.cc uplink.cc interface.cc
+SRC_CC += capture.cc capture_filter.cc
 
 INC_DIR += $(PRG_DIR)
@@ -48,7 +48,8 @@ class Net::Uplink : public Nic::Packet_allocator,
 		       Genode::Xml_node   config,
 		       Timer::Connection &timer,
 		       Genode::Duration  &curr_time,
-		       Genode::Allocator &alloc);
+		       Genode::Allocator &alloc,
+		       Capture           *capture);
 };
 
 #endif /* _UPLINK_H_ */
@@ -20,6 +20,7 @@
 #include <util/misc_math.h>
 #include <nic/component.h>
 #include <nic/packet_allocator.h>
+#include <nic/offload.h>
 
 namespace Nic_loopback {
 	class Session_component;
@@ -67,13 +68,15 @@ class Nic_loopback::Session_component : public Nic::Session_component
 			return true;
 		}
 
+		bool offload_supported() override { return true; }
+
 		void _handle_packet_stream() override;
 };
 
 
 void Nic_loopback::Session_component::_handle_packet_stream()
 {
-	size_t const alloc_size = Nic::Packet_allocator::DEFAULT_PACKET_SIZE;
+	enum { MAX_SEGMENTS = 64 };
 
 	/* loop while we can make progress */
 	for (;;) {
@@ -100,41 +103,74 @@ void Nic_loopback::Session_component::_handle_packet_stream()
 		 * able it receive the corresponding acknowledgement.
 		 */
 
+		Nic::Packet_descriptor const packet_from_client = _tx.sink()->peek_packet();
+
+		char const *content = _tx.sink()->packet_content(packet_from_client);
+		if (!packet_from_client.size() || !content) {
+			warning("received invalid packet");
+			_tx.sink()->acknowledge_packet(_tx.sink()->get_packet());
+			continue;
+		}
+
 		/*
-		 * The client fails to pick up the packets from the rx channel. So we
-		 * won't try to submit new packets.
+		 * A client without offload support receives large packets split
+		 * into segments and packets with completed checksums.
 		 */
-		if (!_rx.source()->ready_to_submit())
-			return;
+		Nic::Offload const offload = packet_from_client.offload();
+		bool         const resolve = !_client_offload && offload.pending();
+
+		Nic::Segmenter const segmenter(content, packet_from_client.size(),
+		                               resolve ? offload : Nic::Offload());
+
+		unsigned const num = segmenter.num_segments();
+		if (num > MAX_SEGMENTS) {
+			warning("dropping packet with too many segments");
+			_tx.sink()->acknowledge_packet(_tx.sink()->get_packet());
+			continue;
+		}
 
 		/*
-		 * We are safe to process one packet without blocking.
+		 * The client fails to pick up the packets from the rx channel. So we
+		 * won't try to submit new packets.
 		 */
+		if (_rx.source()->submit_slots_free() < num)
+			return;
 
+		Nic::Packet_descriptor packets_to_client[MAX_SEGMENTS];
 
-		Packet_descriptor packet_to_client;
+		unsigned allocated = 0;
 		try {
-			packet_to_client = _rx.source()->alloc_packet(alloc_size); }
+			for (; allocated < num; allocated++)
+				packets_to_client[allocated] =
+					_rx.source()->alloc_packet(segmenter.segment_size(allocated));
+		}
 		catch (Session::Rx::Source::Packet_alloc_failed) {
-			continue; }
 
-		/* obtain packet */
-		Packet_descriptor const packet_from_client = _tx.sink()->get_packet();
-		if (!packet_from_client.size()) {
-			warning("received zero-size packet");
-			_rx.source()->release_packet(packet_to_client);
-			continue;
+			/* retry when the client acknowledged received packets */
+			for (unsigned i = 0; i < allocated; i++)
+				_rx.source()->release_packet(packets_to_client[i]);
+			return;
 		}
 
-		memcpy(_rx.source()->packet_content(packet_to_client),
-		       _tx.sink()->packet_content(packet_from_client),
-		       packet_from_client.size());
+		/*
+		 * We are safe to process the packet without blocking.
+		 */
+		for (unsigned i = 0; i < num; i++) {
+
+			Nic::Packet_descriptor &packet = packets_to_client[i];
+			char *dst = _rx.source()->packet_content(packet);
+
+			segmenter.write_segment(i, dst);
 
-		packet_to_client = Packet_descriptor(packet_to_client.offset(),
-		                                     packet_from_client.size());
-		_rx.source()->submit_packet(packet_to_client);
+			if (!resolve && _client_offload)
+				packet.offload(offload);
+			else if (resolve && !offload.gso())
+				Nic::complete_checksum(dst, packet.size(), offload);
 
-		_tx.sink()->acknowledge_packet(packet_from_client);
+			_rx.source()->submit_packet(packet);
+		}
+
+		_tx.sink()->acknowledge_packet(_tx.sink()->get_packet());
 	}
 }
 
@@ -169,8 +205,11 @@ class Nic_loopback::Root : public Root_component<Session_component>
 				throw Insufficient_ram_quota();
 			}
 
-			return new (md_alloc()) Session_component(tx_buf_size, rx_buf_size,
-			                                          *md_alloc(), _env);
+			Session_component *session = new (md_alloc())
+				Session_component(tx_buf_size, rx_buf_size, *md_alloc(), _env);
+
+			session->client_offload(Arg_string::find_arg(args, "offload").bool_value(false));
+			return session;
 		}
 
 	public:
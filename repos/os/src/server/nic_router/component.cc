@@ -64,12 +64,17 @@ Net::Session_component::Session_component(Allocator         &alloc,
                                           Mac_address const  mac,
                                           Entrypoint        &ep,
                                           Mac_address const &router_mac,
-                                          Domain            &domain)
+                                          Domain            &domain,
+                                          bool        const  offload,
+                                          bool        const  client_offload)
 :
 	Session_component_base(alloc, amount, buf_ram, tx_buf_size, rx_buf_size),
 	Session_rpc_object(region_map, _tx_buf, _rx_buf, &_range_alloc, ep.rpc_ep()),
-	Interface(ep, timer, router_mac, _guarded_alloc, mac, domain)
+	Interface(ep, timer, router_mac, _guarded_alloc, mac, domain),
+	_offload_supported(offload)
 {
+	_offload = offload && client_offload;
+
 	_tx.sigh_ready_to_ack(_sink_ack);
 	_tx.sigh_packet_avail(_sink_submit);
 	_rx.sigh_ack_avail(_source_ack);
@@ -114,6 +119,9 @@ Session_component *Net::Root::_create_session(char const *args)
 		size_t const rx_buf_size =
 			Arg_string::find_arg(args, "rx_buf_size").ulong_value(0);
 
+		bool const client_offload =
+			Arg_string::find_arg(args, "offload").bool_value(false);
+
 		size_t const session_size =
 			max((size_t)4096, sizeof(Session_component));
 
@@ -131,7 +139,7 @@ Session_component *Net::Root::_create_session(char const *args)
 			Session_component(*md_alloc(), _timer, ram_quota - session_size,
 			                  _buf_ram, tx_buf_size, rx_buf_size, _region_map,
 			                  _mac_alloc.alloc(), _ep, _router_mac,
-			                  domain);
+			                  domain, _config.offload(), client_offload);
 	}
 	catch (Session_policy::No_policy_defined) {
 		error("no matching policy");
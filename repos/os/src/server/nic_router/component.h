@@ -81,6 +81,8 @@ class Net::Session_component : public Session_component_base,
 		Packet_stream_sink   &_sink()   { return *_tx.sink(); }
 		Packet_stream_source &_source() { return *_rx.source(); }
 
+		bool const _offload_supported;
+
 	public:
 
 		Session_component(Genode::Allocator    &alloc,
@@ -93,7 +95,9 @@ class Net::Session_component : public Session_component_base,
 		                  Mac_address    const  mac,
 		                  Genode::Entrypoint   &ep,
 		                  Mac_address    const &router_mac,
-		                  Domain               &domain);
+		                  Domain               &domain,
+		                  bool           const  offload,
+		                  bool           const  client_offload);
 
 
 		/******************
@@ -103,6 +107,7 @@ class Net::Session_component : public Session_component_base,
 		Mac_address mac_address() { return _mac; }
 		bool link_state() { return true; }
 		void link_state_sigh(Genode::Signal_context_capability) { }
+		bool offload_supported() override { return _offload_supported; }
 };
 
 
@@ -39,6 +39,7 @@ Configuration::Configuration(Xml_node const  node,
                              Allocator      &alloc)
 :
 	_alloc(alloc), _verbose(node.attribute_value("verbose", false)),
+	_offload(node.attribute_value("offload", true)),
 	_rtt(_init_rtt(node)), _node(node)
 {
 	/* read domains */
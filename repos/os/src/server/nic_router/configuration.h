@@ -31,6 +31,7 @@ class Net::Configuration
 
 		Genode::Allocator          &_alloc;
 		bool                 const  _verbose;
+		bool                 const  _offload;
 		Genode::Microseconds const  _rtt;
 		Domain_tree                 _domains;
 		Genode::Xml_node     const  _node;
@@ -49,6 +50,7 @@ class Net::Configuration
 		 ***************/
 
 		bool                  verbose() const { return _verbose; }
+		bool                  offload() const { return _offload; }
 		Genode::Microseconds  rtt()     const { return _rtt; }
 		Domain_tree          &domains()       { return _domains; }
 		Genode::Xml_node      node()    const { return _node; }
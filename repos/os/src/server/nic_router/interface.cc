@@ -15,6 +15,7 @@
 #include <net/tcp.h>
 #include <net/udp.h>
 #include <net/arp.h>
+#include <nic/offload.h>
 
 /* local includes */
 #include <interface.h>
@@ -153,19 +154,25 @@ void Interface::_pass_prot(Ethernet_frame       &eth,
                            Ipv4_packet          &ip,
                            L3_protocol    const  prot,
                            void          *const  prot_base,
-                           size_t         const  prot_size)
+                           size_t         const  prot_size,
+                           Nic::Offload   const &offload)
 {
-	_update_checksum(prot, prot_base, prot_size, ip.src(), ip.dst());
-	_pass_ip(eth, eth_size, ip);
+	/* a partial checksum is updated in '_pass_ip' */
+	if (!offload.csum_partial())
+		_update_checksum(prot, prot_base, prot_size, ip.src(), ip.dst());
+
+	_pass_ip(eth, eth_size, ip, offload);
 }
 
 
-void Interface::_pass_ip(Ethernet_frame &eth,
-                         size_t   const  eth_size,
-                         Ipv4_packet    &ip)
+void Interface::_pass_ip(Ethernet_frame     &eth,
+                         size_t       const  eth_size,
+                         Ipv4_packet        &ip,
+                         Nic::Offload const &offload)
 {
 	ip.checksum(Ipv4_packet::calculate_checksum(ip));
-	send(eth, eth_size);
+	Nic::update_partial_checksum((char *)&eth, eth_size, offload);
+	send(eth, eth_size, offload);
 }
 
 
@@ -290,7 +297,8 @@ void Interface::_nat_link_and_pass(Ethernet_frame        &eth,
                                    void           *const  prot_base,
                                    size_t          const  prot_size,
                                    Link_side_id    const &local,
-                                   Interface             &interface)
+                                   Interface             &interface,
+                                   Nic::Offload    const &offload)
 {
 	Pointer<Port_allocator_guard> remote_port_alloc;
 	try {
@@ -306,7 +314,8 @@ void Interface::_nat_link_and_pass(Ethernet_frame        &eth,
 	Link_side_id const remote = { ip.dst(), _dst_port(prot, prot_base),
 	                              ip.src(), _src_port(prot, prot_base) };
 	_new_link(prot, local, remote_port_alloc, interface, remote);
-	interface._pass_prot(eth, eth_size, ip, prot, prot_base, prot_size);
+	interface._pass_prot(eth, eth_size, ip, prot, prot_base, prot_size,
+	                     offload);
 }
 
 
@@ -587,7 +596,8 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 			_src_port(prot, prot_base, remote_side.dst_port());
 			_dst_port(prot, prot_base, remote_side.src_port());
 
-			interface._pass_prot(eth, eth_size, ip, prot, prot_base, prot_size);
+			interface._pass_prot(eth, eth_size, ip, prot, prot_base, prot_size,
+			                     pkt.offload());
 			_link_packet(prot, prot_base, link, client);
 			return;
 		}
@@ -606,7 +616,7 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 				_adapt_eth(eth, eth_size, rule.to(), pkt, interface);
 				ip.dst(rule.to());
 				_nat_link_and_pass(eth, eth_size, ip, prot, prot_base, prot_size,
-				                   local, interface);
+				                   local, interface, pkt.offload());
 				return;
 			}
 			catch (Forward_rule_tree::No_match) { }
@@ -626,7 +636,7 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 
 			_adapt_eth(eth, eth_size, local.dst_ip, pkt, interface);
 			_nat_link_and_pass(eth, eth_size, ip, prot, prot_base, prot_size,
-			                   local, interface);
+			                   local, interface, pkt.offload());
 			return;
 		}
 		catch (Transport_rule_list::No_match) { }
@@ -644,7 +654,7 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 			log("Using IP rule: ", rule); }
 
 		_adapt_eth(eth, eth_size, ip.dst(), pkt, interface);
-		interface._pass_ip(eth, eth_size, ip);
+		interface._pass_ip(eth, eth_size, ip, pkt.offload());
 		return;
 	}
 	catch (Ip_rule_list::No_match) { }
@@ -872,16 +882,32 @@ void Interface::_handle_eth(void              *const  eth_base,
 }
 
 
-void Interface::send(Ethernet_frame &eth, Genode::size_t const size)
+void Interface::send(Ethernet_frame     &eth,
+                     Genode::size_t const size,
+                     Nic::Offload   const &offload)
 {
 	if (_config().verbose()) {
 		log("\033[33m(", _domain, " <- router)\033[0m ", eth); }
+
+	bool const resolve = !_offload && offload.pending();
+
+	Nic::Segmenter const segmenter((char const *)&eth, size,
+	                               resolve ? offload : Nic::Offload());
 	try {
-		/* copy and submit packet */
-		Packet_descriptor const pkt = _source().alloc_packet(size);
-		char *content = _source().packet_content(pkt);
-		Genode::memcpy((void *)content, (void *)&eth, size);
-		_source().submit_packet(pkt);
+		for (unsigned i = 0; i < segmenter.num_segments(); i++) {
+
+			/* copy and submit packet */
+			Packet_descriptor pkt = _source().alloc_packet(segmenter.segment_size(i));
+			char *content = _source().packet_content(pkt);
+			segmenter.write_segment(i, content);
+
+			if (_offload)
+				pkt.offload(offload);
+			else if (resolve && !offload.gso())
+				Nic::complete_checksum(content, pkt.size(), offload);
+
+			_source().submit_packet(pkt);
+		}
 	}
 	catch (Packet_stream_source::Packet_alloc_failed) {
 		if (_config().verbose()) {
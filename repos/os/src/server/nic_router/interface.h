@@ -56,6 +56,11 @@ class Net::Interface
 		Mac_address const _router_mac;
 		Mac_address const _mac;
 
+		/*
+		 * True if the peer of the interface accepts offload metadata
+		 */
+		bool _offload = false;
+
 		void _init();
 
 	private:
@@ -125,7 +130,8 @@ class Net::Interface
 		                        void            *const  prot_base,
 		                        Genode::size_t   const  prot_size,
 		                        Link_side_id     const &local_id,
-		                        Interface              &interface);
+		                        Interface              &interface,
+		                        Nic::Offload     const &offload);
 
 		void _broadcast_arp_request(Ipv4_address const &ip);
 
@@ -134,11 +140,13 @@ class Net::Interface
 		                Ipv4_packet            &ip,
 		                L3_protocol      const  prot,
 		                void            *const  prot_base,
-		                Genode::size_t   const  prot_size);
+		                Genode::size_t   const  prot_size,
+		                Nic::Offload     const &offload);
 
 		void _pass_ip(Ethernet_frame       &eth,
 		              Genode::size_t const  eth_size,
-		              Ipv4_packet          &ip);
+		              Ipv4_packet          &ip,
+		              Nic::Offload   const &offload);
 
 		void _continue_handle_eth(Packet_descriptor const &pkt);
 
@@ -206,7 +214,15 @@ class Net::Interface
 
 		void dissolve_link(Link_side &link_side, L3_protocol const prot);
 
-		void send(Ethernet_frame &eth, Genode::size_t const eth_size);
+		/**
+		 * Send copy of a frame
+		 *
+		 * Offload metadata is resolved in software if the peer of the
+		 * interface does not support it.
+		 */
+		void send(Ethernet_frame     &eth,
+		          Genode::size_t const eth_size,
+		          Nic::Offload   const &offload = Nic::Offload());
 
 
 		/*********
@@ -29,7 +29,7 @@ Net::Uplink::Uplink(Env               &env,
                     Configuration     &config)
 :
 	Nic::Packet_allocator(&alloc),
-	Nic::Connection(env, this, BUF_SIZE, BUF_SIZE),
+	Nic::Connection(env, this, BUF_SIZE, BUF_SIZE, "", config.offload()),
 	Interface(env.ep(), timer, mac_address(), alloc, Mac_address(),
 	          config.domains().find_by_name(Cstring("uplink")))
 {
@@ -37,5 +37,6 @@ Net::Uplink::Uplink(Env               &env,
 	rx_channel()->sigh_packet_avail(_sink_submit);
 	tx_channel()->sigh_ack_avail(_source_ack);
 	tx_channel()->sigh_ready_to_submit(_source_submit);
+	_offload = config.offload() && offload_supported();
 	Interface::_init();
 }
@@ -192,6 +192,25 @@ struct Framebuffer::Session_component : Genode::Rpc_object<Framebuffer::Session>
 		_nit_fb.refresh(x, y, w, h);
 	}
 
+	/*
+	 * The damage dataspace of the nitpicker session is handed out as is
+	 * because the coordinates of both framebuffers are the same.
+	 */
+	Genode::Dataspace_capability damage_dataspace() override
+	{
+		return _nit_fb.damage_dataspace();
+	}
+
+	void refresh_batch() override
+	{
+		if (_dataspace_is_new) {
+			_view_updater.update_view();
+			_dataspace_is_new = false;
+		}
+
+		_nit_fb.refresh_batch();
+	}
+
 	void sync_sigh(Genode::Signal_context_capability sigh) override
 	{
 		/*
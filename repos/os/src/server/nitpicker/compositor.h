@@ -0,0 +1,210 @@
+/*
+ * \brief  Parallel composition of the view stack
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The dirty areas are split into screen tiles, which are drawn by a pool of
+ * worker threads. Each tile is processed by exactly one thread using a
+ * canvas of its own, clipped to the tile. Within a tile, the dirty areas are
+ * drawn in order, which preserves the result of the sequential composition
+ * even if dirty areas overlap.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _COMPOSITOR_H_
+#define _COMPOSITOR_H_
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/semaphore.h>
+#include <base/thread.h>
+#include <util/reconstructible.h>
+#include <cpu/atomic.h>
+
+/* local includes */
+#include "view_stack.h"
+#include "clip_guard.h"
+
+
+template <typename PT>
+class Compositor : Genode::Noncopyable
+{
+	public:
+
+		enum { MAX_WORKERS = 8, TILE_SIZE = 128 };
+
+	private:
+
+		enum { MAX_RECTS = 8, STACK_SIZE = 16*1024*sizeof(long) };
+
+		struct Worker : Genode::Thread
+		{
+			Compositor         &_compositor;
+			Genode::Semaphore   _start { };
+			bool                _exit = false;
+
+			Worker(Genode::Env &env, Compositor &compositor, unsigned index)
+			:
+				Genode::Thread(env, "compositor", STACK_SIZE,
+				               env.cpu().affinity_space().location_of_index(index),
+				               Weight(), env.cpu()),
+				_compositor(compositor)
+			{ }
+
+			void entry() override
+			{
+				for (;;) {
+					_start.down();
+
+					if (_exit)
+						return;
+
+					_compositor._process_tiles();
+					_compositor._done.up();
+				}
+			}
+		};
+
+		/*
+		 * The main thread composes tiles as well. Hence, one worker thread
+		 * less than the configured number of workers is needed.
+		 */
+		unsigned const _num_threads;
+
+		Genode::Constructible<Worker> _workers[MAX_WORKERS];
+
+		Genode::Semaphore _done { };
+
+		/*
+		 * State of the current frame, written by the main thread before the
+		 * workers are started
+		 */
+		View_stack const *_view_stack = nullptr;
+		PT               *_base       = nullptr;
+		Area              _size;
+		Rect              _rects[MAX_RECTS];
+		unsigned          _num_rects  = 0;
+		Rect              _bounds;
+		unsigned          _tiles_x    = 0;
+		unsigned          _num_tiles  = 0;
+
+		int volatile _next_tile = 0;
+
+		int _fetch_tile()
+		{
+			for (;;) {
+				int const tile = _next_tile;
+				if (Genode::cmpxchg(&_next_tile, tile, tile + 1))
+					return tile;
+			}
+		}
+
+		void _process_tiles()
+		{
+			Canvas<PT> canvas(_base, _size);
+
+			for (;;) {
+				unsigned const tile = _fetch_tile();
+				if (tile >= _num_tiles)
+					return;
+
+				Point const pos(_bounds.x1() + (tile % _tiles_x)*TILE_SIZE,
+				                _bounds.y1() + (tile / _tiles_x)*TILE_SIZE);
+
+				Rect const tile_rect = Rect::intersect(_bounds,
+					Rect(pos, Area(TILE_SIZE, TILE_SIZE)));
+
+				Clip_guard clip_guard(canvas, tile_rect);
+
+				for (unsigned i = 0; i < _num_rects; i++) {
+					Rect const rect = Rect::intersect(_rects[i], tile_rect);
+					if (rect.valid())
+						_view_stack->draw(canvas, rect);
+				}
+			}
+		}
+
+	public:
+
+		Compositor(Genode::Env &env, unsigned num_workers)
+		:
+			_num_threads(Genode::min(Genode::max(num_workers, 1U),
+			                         (unsigned)MAX_WORKERS) - 1)
+		{
+			/* leave the first CPU to the main thread */
+			for (unsigned i = 0; i < _num_threads; i++) {
+				_workers[i].construct(env, *this, i + 1);
+				_workers[i]->start();
+			}
+		}
+
+		~Compositor()
+		{
+			for (unsigned i = 0; i < _num_threads; i++) {
+				_workers[i]->_exit = true;
+				_workers[i]->_start.up();
+				_workers[i]->join();
+			}
+		}
+
+		unsigned num_workers() const { return _num_threads + 1; }
+
+		/**
+		 * Draw dirty areas of view stack
+		 *
+		 * \param base  pixel buffer of the screen
+		 * \param size  screen size
+		 *
+		 * \return  drawn areas
+		 */
+		Dirty_rect compose(View_stack const &view_stack, PT *base, Area size)
+		{
+			Dirty_rect const result = view_stack.take_dirty_rect();
+
+			_num_rects = 0;
+			_bounds    = Rect();
+
+			Dirty_rect dirty = result;
+			dirty.flush([&] (Rect const &rect) {
+
+				Rect const clipped = Rect::intersect(rect, Rect(Point(), size));
+				if (!clipped.valid() || _num_rects == MAX_RECTS)
+					return;
+
+				_rects[_num_rects++] = clipped;
+				_bounds = _bounds.valid() ? Rect::compound(_bounds, clipped)
+				                          : clipped;
+			});
+
+			if (!_num_rects)
+				return result;
+
+			_view_stack = &view_stack;
+			_base       = base;
+			_size       = size;
+			_tiles_x    = (_bounds.w() + TILE_SIZE - 1)/TILE_SIZE;
+			_num_tiles  = _tiles_x*((_bounds.h() + TILE_SIZE - 1)/TILE_SIZE);
+			_next_tile  = 0;
+
+			/* do not wake up more threads than there are tiles */
+			unsigned const num_started = Genode::min(_num_threads, _num_tiles - 1);
+
+			for (unsigned i = 0; i < num_started; i++)
+				_workers[i]->_start.up();
+
+			_process_tiles();
+
+			for (unsigned i = 0; i < num_started; i++)
+				_done.down();
+
+			return result;
+		}
+};
+
+#endif /* _COMPOSITOR_H_ */
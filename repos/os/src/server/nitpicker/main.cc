@@ -28,6 +28,7 @@
 #include <input_session/input_session.h>
 #include <nitpicker_session/nitpicker_session.h>
 #include <framebuffer_session/connection.h>
+#include <framebuffer_session/damage.h>
 #include <util/color.h>
 #include <os/pixel_rgb565.h>
 #include <os/session_policy.h>
@@ -39,6 +40,7 @@
 #include "clip_guard.h"
 #include "pointer_origin.h"
 #include "domain_registry.h"
+#include "compositor.h"
 
 namespace Input       { class Session_component; }
 namespace Framebuffer { class Session_component; }
@@ -158,6 +160,13 @@ class Buffer
 struct Buffer_provider
 {
 	virtual Buffer *realloc_buffer(Framebuffer::Mode mode, bool use_alpha) = 0;
+
+	/**
+	 * Allocate dataspace for batched refreshes
+	 *
+	 * \return  nullptr if the session quota is exhausted
+	 */
+	virtual Attached_ram_dataspace *alloc_damage_buffer() = 0;
 };
 
 
@@ -321,6 +330,7 @@ class Framebuffer::Session_component : public Genode::Rpc_object<Session>
 		Signal_context_capability _sync_sigh;
 		Framebuffer::Mode         _mode;
 		bool                      _alpha = false;
+		Attached_ram_dataspace   *_damage_ds = nullptr;
 
 	public:
 
@@ -395,6 +405,26 @@ class Framebuffer::Session_component : public Genode::Rpc_object<Session>
 
 			_view_stack.mark_session_views_as_dirty(_session, rect);
 		}
+
+		Dataspace_capability damage_dataspace() override
+		{
+			if (!_damage_ds)
+				_damage_ds = _buffer_provider.alloc_damage_buffer();
+
+			if (!_damage_ds)
+				return Dataspace_capability();
+
+			return _damage_ds->cap();
+		}
+
+		void refresh_batch() override
+		{
+			if (!_damage_ds)
+				return;
+
+			_damage_ds->local_addr<Framebuffer::Damage const>()->for_each_merged(_mode,
+				[&] (int x, int y, int w, int h) { refresh(x, y, w, h); });
+		}
 };
 
 
@@ -448,6 +478,9 @@ class Nitpicker::Session_component : public Genode::Rpc_object<Session>,
 		Attached_ram_dataspace _command_ds { _env.ram(), _env.rm(),
 		                                     sizeof(Command_buffer) };
 
+		/* dataspace for batched framebuffer refreshes, allocated on demand */
+		Genode::Constructible<Attached_ram_dataspace> _damage_ds;
+
 		Command_buffer &_command_buffer = *_command_ds.local_addr<Command_buffer>();
 
 		typedef Genode::Handle_registry<View_handle, View> View_handle_registry;
@@ -1014,6 +1047,19 @@ class Nitpicker::Session_component : public Genode::Rpc_object<Session>,
 
 			return texture;
 		}
+
+		Attached_ram_dataspace *alloc_damage_buffer() override
+		{
+			size_t const size = Genode::align_addr(sizeof(Framebuffer::Damage), 12);
+
+			if (!_damage_ds.constructed()) {
+				if (!_session_alloc.withdraw(size))
+					return nullptr;
+
+				_damage_ds.construct(_env.ram(), _env.rm(), size);
+			}
+			return &*_damage_ds;
+		}
 };
 
 
@@ -1146,6 +1192,12 @@ struct Nitpicker::Main
 
 	Genode::Reconstructible<Framebuffer_screen> fb_screen = { env.rm(), framebuffer };
 
+	/*
+	 * Regions flushed to the framebuffer per frame, submitted at once if
+	 * supported by the framebuffer driver
+	 */
+	Framebuffer::Refresh_batch refresh_batch = { env.rm(), framebuffer };
+
 	void handle_fb_mode();
 
 	Signal_handler<Main> fb_mode_handler = { env.ep(), *this, &Main::handle_fb_mode };
@@ -1237,14 +1289,85 @@ struct Nitpicker::Main
 	 */
 	bool user_active = false;
 
+	/*
+	 * Pool of threads for composing the screen in parallel, configured via
+	 * the 'compose_workers' config attribute
+	 */
+	Genode::Constructible<Compositor<PT> > compositor;
+
+	/*
+	 * Statistics about the composition time, enabled via the
+	 * 'compose_stats' config attribute
+	 */
+	bool               compose_stats  = false;
+	unsigned           compose_cnt    = 0;
+	unsigned long long compose_pixels = 0;
+	unsigned long long compose_us     = 0;
+
+	void configure_compositor(Genode::Xml_node config)
+	{
+		unsigned const num_workers =
+			config.attribute_value("compose_workers", 1U);
+
+		unsigned const current = compositor.constructed()
+		                       ? compositor->num_workers() : 1;
+
+		if (num_workers != current) {
+			compositor.destruct();
+			if (num_workers > 1)
+				compositor.construct(env, num_workers);
+		}
+
+		compose_stats = config.attribute_value("compose_stats", false);
+		compose_cnt = 0; compose_pixels = 0; compose_us = 0;
+	}
+
+	/**
+	 * Draw dirty areas of the view stack into the framebuffer
+	 */
+	Dirty_rect draw()
+	{
+		unsigned long const start_us = compose_stats ? timer.elapsed_us() : 0;
+
+		Dirty_rect const result = compositor.constructed()
+			? compositor->compose(user_state, fb_screen->fb_ds.local_addr<PT>(),
+			                      fb_screen->screen.size())
+			: user_state.draw(fb_screen->screen);
+
+		if (!compose_stats)
+			return result;
+
+		Dirty_rect dirty = result;
+		unsigned long pixels = 0;
+		dirty.flush([&] (Rect const &rect) { pixels += rect.area().count(); });
+
+		if (!pixels)
+			return result;
+
+		compose_pixels += pixels;
+		compose_us     += timer.elapsed_us() - start_us;
+
+		enum { REPORT_INTERVAL = 100 };
+		if (++compose_cnt == REPORT_INTERVAL) {
+			Genode::log("composition: workers=",
+			            compositor.constructed() ? compositor->num_workers() : 1, " "
+			            "frames=", compose_cnt, " "
+			            "avg pixels=", compose_pixels/compose_cnt, " "
+			            "avg time=", compose_us/compose_cnt, " us");
+			compose_cnt = 0; compose_pixels = 0; compose_us = 0;
+		}
+		return result;
+	}
+
 	/**
 	 * Perform redraw and flush pixels to the framebuffer
 	 */
 	void draw_and_flush()
 	{
-		user_state.draw(fb_screen->screen).flush([&] (Rect const &rect) {
-			framebuffer.refresh(rect.x1(), rect.y1(),
-			                    rect.w(),  rect.h()); });
+		draw().flush([&] (Rect const &rect) {
+			refresh_batch.add(rect.x1(), rect.y1(), rect.w(), rect.h()); });
+
+		refresh_batch.flush();
 	}
 
 	Main(Env &env) : env(env)
@@ -1334,9 +1457,10 @@ void Nitpicker::Main::handle_input()
 		user_state.geometry(pointer_origin, Rect(new_pointer_pos, Area()));
 
 	/* perform redraw and flush pixels to the framebuffer */
-	user_state.draw(fb_screen->screen).flush([&] (Rect const &rect) {
-		framebuffer.refresh(rect.x1(), rect.y1(),
-		                    rect.w(),  rect.h()); });
+	draw().flush([&] (Rect const &rect) {
+		refresh_batch.add(rect.x1(), rect.y1(), rect.w(), rect.h()); });
+
+	refresh_batch.flush();
 
 	user_state.mark_all_views_as_clean();
 
@@ -1383,6 +1507,8 @@ void Nitpicker::Main::handle_config()
 	configure_reporter(config.xml(), focus_reporter);
 	configure_reporter(config.xml(), keystate_reporter);
 
+	configure_compositor(config.xml());
+
 	/* update domain registry and session policies */
 	for (::Session *s = session_list.first(); s; s = s->next())
 		s->reset_domain();
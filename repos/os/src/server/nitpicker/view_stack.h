@@ -122,6 +122,28 @@ class View_stack
 			return result;
 		}
 
+		/**
+		 * Draw specified area of the whole view stack
+		 *
+		 * The view stack is not modified. Hence, the method may be called
+		 * by multiple threads at a time as long as each thread uses its own
+		 * canvas and the areas do not overlap.
+		 */
+		void draw(Canvas_base &canvas, Rect rect) const
+		{
+			draw_rec(canvas, _first_view_const(), rect);
+		}
+
+		/**
+		 * Return dirty areas and reset them, without drawing
+		 */
+		Dirty_rect take_dirty_rect() const
+		{
+			Dirty_rect result = _dirty_rect;
+			_dirty_rect = Dirty_rect();
+			return result;
+		}
+
 		/**
 		 * Trigger redraw of the whole view stack
 		 */
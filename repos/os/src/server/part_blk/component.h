@@ -37,8 +37,9 @@ class Block::Session_component : public Block::Session_rpc_object,
 {
 	private:
 
-		Ram_dataspace_capability          _rq_ds;
+		Dataspace_capability              _rq_ds;
 		addr_t                            _rq_phys;
+		Window                           *_window;
 		Partition                        *_partition;
 		Signal_handler<Session_component> _sink_ack;
 		Signal_handler<Session_component> _sink_submit;
@@ -65,7 +66,8 @@ class Block::Session_component : public Block::Session_rpc_object,
 		 * Range check packet request
 		 */
 		inline bool _range_check(Packet_descriptor &p) {
-			return p.block_number() + p.block_count() <= _partition->sectors; }
+			return p.block_count()  <= _partition->sectors
+			    && p.block_number() <= _partition->sectors - p.block_count(); }
 
 		/**
 		 * Handle a single request
@@ -75,15 +77,22 @@ class Block::Session_component : public Block::Session_rpc_object,
 			_p_to_handle = packet;
 			_p_to_handle.succeeded(false);
 
-			/* ignore invalid packets */
-			if (!packet.size() || !_range_check(_p_to_handle)) {
+			bool write   = _p_to_handle.operation() == Packet_descriptor::WRITE;
+			sector_t off = _p_to_handle.block_number() + _partition->lba;
+			size_t cnt   = _p_to_handle.block_count();
+
+			/*
+			 * Ignore invalid packets, the payload must lie within the
+			 * packet buffer, which is a window of the back-end buffer
+			 * shared with other clients in the zero-copy case
+			 */
+			if (!packet.size() || !_range_check(_p_to_handle)
+			 || !tx_sink()->packet_valid(packet)
+			 || cnt > packet.size() / _driver.blk_size()) {
 				_ack_packet(_p_to_handle);
 				return;
 			}
 
-			bool write   = _p_to_handle.operation() == Packet_descriptor::WRITE;
-			sector_t off = _p_to_handle.block_number() + _partition->lba;
-			size_t cnt   = _p_to_handle.block_count();
 			void* addr   = tx_sink()->packet_content(_p_to_handle);
 
 			if (write && !_writeable) {
@@ -92,7 +101,11 @@ class Block::Session_component : public Block::Session_rpc_object,
 			}
 
 			try {
-				_driver.io(write, off, cnt, addr, *this, _p_to_handle);
+				if (_window)
+					_driver.forward(write, off, cnt, *_window,
+					                _p_to_handle.offset(), *this, _p_to_handle);
+				else
+					_driver.io(write, off, cnt, addr, *this, _p_to_handle);
 			} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
 				if (!_req_queue_full) {
 					_req_queue_full = true;
@@ -128,8 +141,12 @@ class Block::Session_component : public Block::Session_rpc_object,
 
 		/**
 		 * Constructor
+		 *
+		 * \param window  window of the back-end buffer used as 'rq_ds',
+		 *                or nullptr if requests are copied
 		 */
-		Session_component(Ram_dataspace_capability  rq_ds,
+		Session_component(Dataspace_capability      rq_ds,
+		                  Window                   *window,
 		                  Partition                *partition,
 		                  Genode::Entrypoint       &ep,
 		                  Genode::Region_map       &rm,
@@ -138,6 +155,7 @@ class Block::Session_component : public Block::Session_rpc_object,
 		: Session_rpc_object(rm, rq_ds, ep.rpc_ep()),
 		  _rq_ds(rq_ds),
 		  _rq_phys(Dataspace_client(_rq_ds).phys_addr()),
+		  _window(window),
 		  _partition(partition),
 		  _sink_ack(ep, *this, &Session_component::_ready_to_ack),
 		  _sink_submit(ep, *this, &Session_component::_packet_avail),
@@ -159,12 +177,14 @@ class Block::Session_component : public Block::Session_rpc_object,
 				wait_queue().remove(this);
 		}
 
-		Ram_dataspace_capability const rq_ds() const { return _rq_ds; }
+		Dataspace_capability const rq_ds() const { return _rq_ds; }
+		Window *window() { return _window; }
 		Partition *partition() { return _partition; }
 
 		void dispatch(Packet_descriptor &request, Packet_descriptor &reply)
 		{
-			if (request.operation() == Block::Packet_descriptor::READ) {
+			/* the back end accessed the payload of a forwarded request */
+			if (request.operation() == Block::Packet_descriptor::READ && !_window) {
 				void *src =
 					_driver.session().tx()->packet_content(reply);
 				Genode::size_t sz =
@@ -191,7 +211,16 @@ class Block::Session_component : public Block::Session_rpc_object,
 				wait_queue().remove(c);
 				c->_req_queue_full = false;
 				c->_handle_packet(c->_p_to_handle);
-				c->_packet_avail();
+				if (!c->_req_queue_full)
+					c->_packet_avail();
+
+				/*
+				 * The back end is congested again and the session was put
+				 * back into the wait queue, the next acknowledgement
+				 * resumes the processing
+				 */
+				if (c->_req_queue_full)
+					return;
 			}
 		}
 
@@ -232,14 +261,46 @@ class Block::Root :
 		Genode::Xml_node        _config;
 		Block::Driver          &_driver;
 		Block::Partition_table &_table;
+		bool const              _zero_copy;
+
+		Session_component *_create_zero_copy_session(size_t tx_buf_size,
+		                                             Partition *partition,
+		                                             bool writeable)
+		{
+			Window *window = nullptr;
+			try {
+				window = _driver.alloc_window(_env, tx_buf_size);
+			} catch (Window::Exhausted) {
+				error("back-end buffer exhausted, denying session");
+				throw Service_denied();
+			} catch (...) {
+				warning("zero-copy forwarding unavailable, copying requests");
+				return nullptr;
+			}
+
+			try {
+				return new (md_alloc())
+					Session_component(window->dataspace(), window, partition,
+					                  _env.ep(), _env.rm(), _driver, writeable);
+			} catch (...) {
+				_driver.free_window(*window);
+				throw;
+			}
+		}
 
 	protected:
 
 		void _destroy_session(Session_component *session) override
 		{
-			Ram_dataspace_capability rq_ds = session->rq_ds();
+			Dataspace_capability rq_ds  = session->rq_ds();
+			Window              *window = session->window();
 			Genode::Root_component<Session_component>::_destroy_session(session);
-			_env.ram().free(rq_ds);
+
+			/* the window is freed once the back end acked its requests */
+			if (window)
+				_driver.free_window(*window);
+			else
+				_env.ram().free(static_cap_cast<Ram_dataspace>(rq_ds));
 		}
 
 		/**
@@ -305,12 +366,20 @@ class Block::Root :
 			if (writeable)
 				writeable = Arg_string::find_arg(args, "writeable").bool_value(true);
 
-			Ram_dataspace_capability ds_cap;
-			ds_cap = _env.ram().alloc(tx_buf_size);
-			Session_component *session = new (md_alloc())
-				Session_component(ds_cap, _table.partition(num),
-				                  _env.ep(), _env.rm(), _driver,
-				                  writeable);
+			Session_component *session = nullptr;
+
+			if (_zero_copy)
+				session = _create_zero_copy_session(tx_buf_size,
+				                                    _table.partition(num),
+				                                    writeable);
+			if (!session) {
+				Ram_dataspace_capability ds_cap;
+				ds_cap = _env.ram().alloc(tx_buf_size);
+				session = new (md_alloc())
+					Session_component(ds_cap, nullptr, _table.partition(num),
+					                  _env.ep(), _env.rm(), _driver,
+					                  writeable);
+			}
 
 			log("session opened at partition ", num, " for '", label_str, "'");
 			return session;
@@ -321,7 +390,8 @@ class Block::Root :
 		Root(Genode::Env &env, Genode::Xml_node config, Genode::Heap &heap,
 		     Block::Driver &driver, Block::Partition_table &table)
 		: Root_component(env.ep(), heap), _env(env), _config(config),
-		  _driver(driver), _table(table) { }
+		  _driver(driver), _table(table),
+		  _zero_copy(config.attribute_value("zero_copy", false)) { }
 };
 
 #endif /* _PART_BLK__COMPONENT_H_ */
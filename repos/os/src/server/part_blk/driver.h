@@ -21,10 +21,13 @@
 #include <base/heap.h>
 #include <util/list.h>
 #include <block_session/connection.h>
+#include <region_map/client.h>
+#include <rm_session/connection.h>
 
 namespace Block {
 	class Block_dispatcher;
 	class Driver;
+	class Window;
 };
 
 
@@ -41,7 +44,8 @@ bool operator== (const Block::Packet_descriptor& p1,
 {
 	return p1.operation()    == p2.operation()    &&
 	       p1.block_number() == p2.block_number() &&
-	       p1.block_count()  == p2.block_count();
+	       p1.block_count()  == p2.block_count()  &&
+	       p1.offset()       == p2.offset();
 }
 
 
@@ -53,36 +57,53 @@ class Block::Driver
 	{
 		private:
 
-			Block_dispatcher &_dispatcher;
+			Block_dispatcher *_dispatcher;
 			Packet_descriptor _cli;
 			Packet_descriptor _srv;
+			Window           *_window;
 
 		public:
 
 			Request(Block_dispatcher &d,
 			        Packet_descriptor &cli,
-			        Packet_descriptor &srv)
-			: _dispatcher(d), _cli(cli), _srv(srv) {}
+			        Packet_descriptor &srv,
+			        Window *window = nullptr)
+			: _dispatcher(&d), _cli(cli), _srv(srv), _window(window) {}
 
 			bool handle(Packet_descriptor& reply)
 			{
 				bool ret =  reply == _srv;
-				if (ret) _dispatcher.dispatch(_cli, reply);
+				if (ret && _dispatcher) _dispatcher->dispatch(_cli, reply);
 				return ret;
 			}
 
 			bool same_dispatcher(Block_dispatcher &same) {
-				return &same == &_dispatcher; }
+				return &same == _dispatcher; }
+
+			/*
+			 * Detach request from its dispatcher, the request is kept until
+			 * acknowledged by the back end
+			 */
+			void orphan() { _dispatcher = nullptr; }
+
+			/*
+			 * Forwarded requests refer to the buffer of a window, which
+			 * is not managed by the packet allocator
+			 */
+			Window *window() const { return _window; }
 	};
 
 	private:
 
 		enum { BLK_SZ = Session::TX_QUEUE_SIZE*sizeof(Request) };
 
+		Genode::Heap                  &_heap;
 		Genode::Tslab<Request, BLK_SZ> _r_slab;
 		Genode::List<Request>          _r_list;
 		Genode::Allocator_avl          _block_alloc;
 		Block::Connection              _session;
+		Genode::size_t const           _window_limit;
+		Genode::size_t                 _window_bytes = 0;
 		Block::sector_t                _blk_cnt;
 		Genode::size_t                 _blk_size;
 		Genode::Signal_handler<Driver> _source_ack;
@@ -91,19 +112,27 @@ class Block::Driver
 
 		void _ready_to_submit();
 
+		inline void _window_request_acked(Window &);
+		inline void _destroy_window(Window &);
+
 		void _ack_avail()
 		{
 			/* check for acknowledgements */
 			while (_session.tx()->ack_avail()) {
 				Packet_descriptor p = _session.tx()->get_acked_packet();
+				Window *window = nullptr;
 				for (Request *r = _r_list.first(); r; r = r->next()) {
 					if (r->handle(p)) {
+						window = r->window();
 						_r_list.remove(r);
 						Genode::destroy(&_r_slab, r);
 						break;
 					}
 				}
-				_session.tx()->release_packet(p);
+				if (window)
+					_window_request_acked(*window);
+				else
+					_session.tx()->release_packet(p);
 			}
 
 			_ready_to_submit();
@@ -111,10 +140,22 @@ class Block::Driver
 
 	public:
 
-		Driver(Genode::Env &env, Genode::Heap &heap)
-		: _r_slab(&heap),
+		/**
+		 * Constructor
+		 *
+		 * \param buffer_size  size of the packet buffer shared with the
+		 *                     back-end, which also hosts the windows of
+		 *                     zero-copy clients
+		 *
+		 * A quarter of the buffer is reserved for copied requests. Windows
+		 * cannot occupy this part.
+		 */
+		Driver(Genode::Env &env, Genode::Heap &heap, Genode::size_t buffer_size)
+		: _heap(heap),
+		  _r_slab(&heap),
 		  _block_alloc(&heap),
-		  _session(env, &_block_alloc, 4 * 1024 * 1024),
+		  _session(env, &_block_alloc, buffer_size),
+		  _window_limit(buffer_size - buffer_size/4),
 		  _source_ack(env.ep(), *this, &Driver::_ack_avail),
 		  _source_submit(env.ep(), *this, &Driver::_ready_to_submit)
 		{
@@ -156,6 +197,34 @@ class Block::Driver
 			_session.tx()->submit_packet(p);
 		}
 
+		/**
+		 * Forward request without copying
+		 *
+		 * \param offset  offset of the request's payload within the window
+		 */
+		inline void forward(bool write, sector_t nr, Genode::size_t cnt,
+		                    Window &window, Genode::off_t offset,
+		                    Block_dispatcher &dispatcher,
+		                    Packet_descriptor &cli);
+
+		/**
+		 * Allocate window of the back-end buffer
+		 *
+		 * \throw Window::Exhausted    no space left for windows
+		 * \throw Window::Unavailable  window cannot be provided
+		 */
+		inline Window *alloc_window(Genode::Env &env, Genode::size_t size);
+
+		/**
+		 * Free window once all requests forwarded from it are acknowledged
+		 */
+		inline void free_window(Window &window);
+
+		Genode::Range_allocator &buffer_alloc() { return _block_alloc; }
+
+		Genode::Dataspace_capability buffer_ds() {
+			return _session.tx()->dataspace(); }
+
 		void remove_dispatcher(Block_dispatcher &dispatcher)
 		{
 			for (Request *r = _r_list.first(); r;) {
@@ -167,10 +236,147 @@ class Block::Driver
 				Request *remove = r;
 				r = r->next();
 
+				/* the packet of a forwarded request must not be released */
+				if (remove->window()) {
+					remove->orphan();
+					continue;
+				}
+
 				_r_list.remove(remove);
 				Genode::destroy(&_r_slab, remove);
 			}
 		}
 };
 
+
+/**
+ * Part of the back-end buffer used as packet buffer of a client
+ *
+ * The window is allocated from the back-end buffer and made available as
+ * a managed dataspace. Hence, the back-end driver accesses the payload of
+ * the client's packets directly.
+ */
+class Block::Window
+{
+	private:
+
+		friend class Driver;
+
+		Genode::Range_allocator   &_alloc;
+		Genode::addr_t             _offset = 0;
+		Genode::size_t const       _size;
+		Genode::Rm_connection      _rm;
+		Genode::Region_map_client  _map;
+
+		/* requests forwarded to the back end and not yet acknowledged */
+		unsigned _pending = 0;
+
+		/* the session of the window is gone */
+		bool _retired = false;
+
+		enum { PAGE_SIZE_LOG2 = 12 };
+
+	public:
+
+		class Exhausted   : Genode::Exception { };
+		class Unavailable : Genode::Exception { };
+
+		static Genode::size_t page_aligned(Genode::size_t size) {
+			return Genode::align_addr(size, PAGE_SIZE_LOG2); }
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Exhausted    back-end buffer exhausted
+		 * \throw Unavailable  managed dataspace cannot be provided
+		 */
+		Window(Genode::Env &env, Driver &driver, Genode::size_t size)
+		:
+			_alloc(driver.buffer_alloc()), _size(page_aligned(size)),
+			_rm(env), _map(_rm.create(_size))
+		{
+			void *offset = nullptr;
+			if (_alloc.alloc_aligned(_size, &offset, PAGE_SIZE_LOG2).error())
+				throw Exhausted();
+
+			_offset = (Genode::addr_t)offset;
+
+			try { _map.attach(driver.buffer_ds(), _size, _offset); }
+			catch (...) {
+				_alloc.free(offset, _size);
+				throw Unavailable();
+			}
+		}
+
+		~Window() { _alloc.free((void *)_offset, _size); }
+
+		/**
+		 * Offset of the window within the back-end buffer
+		 */
+		Genode::off_t offset() const { return _offset; }
+
+		Genode::Dataspace_capability dataspace() { return _map.dataspace(); }
+};
+
+
+void Block::Driver::forward(bool write, sector_t nr, Genode::size_t cnt,
+                            Window &window, Genode::off_t offset,
+                            Block_dispatcher &dispatcher,
+                            Packet_descriptor &cli)
+{
+	if (!_session.tx()->ready_to_submit())
+		throw Block::Session::Tx::Source::Packet_alloc_failed();
+
+	Block::Packet_descriptor::Opcode op = write
+	    ? Block::Packet_descriptor::WRITE
+	    : Block::Packet_descriptor::READ;
+	Packet_descriptor p(Packet_descriptor(window.offset() + offset,
+	                                      _blk_size * cnt),
+	                    op, nr, cnt);
+	Request *r = new (&_r_slab) Request(dispatcher, cli, p, &window);
+	_r_list.insert(r);
+	window._pending++;
+
+	_session.tx()->submit_packet(p);
+}
+
+
+Block::Window *Block::Driver::alloc_window(Genode::Env &env, Genode::size_t size)
+{
+	Genode::size_t const aligned = Window::page_aligned(size);
+
+	if (aligned > _window_limit - _window_bytes)
+		throw Window::Exhausted();
+
+	Window *window = new (&_heap) Window(env, *this, size);
+	_window_bytes += aligned;
+	return window;
+}
+
+
+void Block::Driver::_destroy_window(Window &window)
+{
+	_window_bytes -= window._size;
+	Genode::destroy(&_heap, &window);
+}
+
+
+void Block::Driver::free_window(Window &window)
+{
+	if (window._pending) {
+		window._retired = true;
+		return;
+	}
+	_destroy_window(window);
+}
+
+
+void Block::Driver::_window_request_acked(Window &window)
+{
+	if (--window._pending || !window._retired)
+		return;
+
+	_destroy_window(window);
+}
+
 #endif /* _PART_BLK__DRIVER_H_ */
@@ -32,12 +32,18 @@ class Main
 
 		Block::Partition_table & _table();
 
+		Genode::size_t _buffer_size()
+		{
+			Genode::Number_of_bytes const default_size = 4*1024*1024;
+			return _config.xml().attribute_value("buffer_size", default_size);
+		}
+
 		Genode::Env &_env;
 
 		Genode::Attached_rom_dataspace _config { _env, "config" };
 
 		Genode::Heap        _heap     { _env.ram(), _env.rm() };
-		Block::Driver       _driver   { _env, _heap      };
+		Block::Driver       _driver   { _env, _heap, _buffer_size() };
 		Genode::Reporter    _reporter { _env, "partitions" };
 		Mbr_partition_table _mbr      { _heap, _driver, _reporter };
 		Gpt                 _gpt      { _heap, _driver, _reporter };
@@ -22,6 +22,8 @@
 #include <base/log.h>
 #include <block/component.h>
 #include <block/driver.h>
+#include <block/sparse_image.h>
+#include <util/reconstructible.h>
 
 
 using namespace Genode;
@@ -31,15 +33,95 @@ class Ram_blk : public Block::Driver
 {
 	private:
 
+		typedef Genode::uint64_t uint64_t;
+
 		Env       &_env;
 		Allocator *_alloc { nullptr };
 
 		Attached_rom_dataspace *_rom_ds { nullptr };
-		size_t                  _size;
+		uint64_t                _size;
 		size_t                  _block_size;
-		size_t                  _block_count;
-		Attached_ram_dataspace  _ram_ds;
-		addr_t                  _ram_addr;
+		Block::sector_t         _block_count;
+
+		/*
+		 * Empty device
+		 */
+		Constructible<Attached_ram_dataspace> _ram_ds { };
+		addr_t                                _ram_addr = 0;
+
+		/*
+		 * Device populated by a file
+		 *
+		 * The file content is not copied. Instead, chunks are copied into
+		 * an overlay when written for the first time. A sparse image is
+		 * expanded on access.
+		 */
+		enum { OVERLAY_CHUNK_SIZE = 64*1024 };
+
+		Constructible<Block::Sparse_image> _sparse { };
+
+		size_t         _chunk_size = OVERLAY_CHUNK_SIZE;
+		unsigned long  _num_chunks = 0;
+		char         **_chunks     = nullptr;
+		unsigned long  _num_copied = 0;
+
+		size_t _chunk_length(unsigned long nr) const {
+			return (size_t)min((uint64_t)_chunk_size, _size - (uint64_t)nr*_chunk_size); }
+
+		/**
+		 * Copy part of the file content
+		 */
+		bool _read_file(uint64_t offset, size_t size, char *dst)
+		{
+			if (_sparse.constructed())
+				return _sparse->read(offset, size, dst);
+
+			memcpy(dst, _rom_ds->local_addr<char>() + offset, size);
+			return true;
+		}
+
+		bool _io_overlay(uint64_t offset, size_t size, char *buffer, bool read)
+		{
+			while (size) {
+				unsigned long const nr     = offset / _chunk_size;
+				size_t        const within = offset % _chunk_size;
+				size_t        const n      = min(size, _chunk_size - within);
+
+				char *chunk = _chunks[nr];
+
+				if (read) {
+					if (chunk)
+						memcpy(buffer, chunk + within, n);
+					else if (!_read_file(offset, n, buffer))
+						return false;
+				} else {
+					if (!chunk) {
+						size_t const length = _chunk_length(nr);
+
+						try { chunk = (char *)_alloc->alloc(_chunk_size); }
+						catch (...) {
+							error("overlay exhausted");
+							return false;
+						}
+
+						/* keep content of the file not overwritten */
+						if (n < length && !_read_file(offset - within, length, chunk)) {
+							_alloc->free(chunk, _chunk_size);
+							return false;
+						}
+
+						_chunks[nr] = chunk;
+						_num_copied++;
+					}
+					memcpy(chunk + within, buffer, n);
+				}
+
+				offset += n;
+				size   -= n;
+				buffer += n;
+			}
+			return true;
+		}
 
 		void _io(Block::sector_t           block_number,
 		         size_t                    block_count,
@@ -54,8 +136,13 @@ class Ram_blk : public Block::Driver
 				return;
 			}
 
-			size_t offset = (size_t) block_number * _block_size;
-			size_t size   = block_count  * _block_size;
+			uint64_t offset = (uint64_t) block_number * _block_size;
+			size_t   size   = block_count  * _block_size;
+
+			if (!_ram_ds.constructed()) {
+				ack_packet(packet, _io_overlay(offset, size, buffer, read));
+				return;
+			}
 
 			void *src = read ? (void *)(_ram_addr + offset) : (void *)buffer;
 			void *dst = read ? (void *)buffer : (void *)(_ram_addr + offset);
@@ -68,21 +155,38 @@ class Ram_blk : public Block::Driver
 	public:
 
 		/**
-		 * Construct populated RAM dataspace
+		 * Construct RAM device backed by file
+		 *
+		 * \param cache_size  memory used for decompressed chunks of a
+		 *                    sparse image
 		 */
 		Ram_blk(Env &env, Allocator &alloc,
-		        const char *name, size_t block_size)
+		        const char *name, size_t block_size, size_t cache_size)
 		:	Block::Driver(env.ram()),
 			_env(env), _alloc(&alloc),
 			_rom_ds(new (_alloc) Attached_rom_dataspace(_env, name)),
 			_size(_rom_ds->size()),
-			_block_size(block_size),
-			_block_count(_size/_block_size),
-			_ram_ds(_env.ram(), _env.rm(), _size),
-			_ram_addr((addr_t)_ram_ds.local_addr<addr_t>())
+			_block_size(block_size)
 		{
-			/* populate backing store from file */
-			memcpy(_ram_ds.local_addr<void>(), _rom_ds->local_addr<void>(), _size);
+			if (Block::Sparse_image::detect(_rom_ds->local_addr<void>(),
+			                                _rom_ds->size())) {
+				try {
+					_sparse.construct(alloc, _rom_ds->local_addr<void>(),
+					                  _rom_ds->size(), cache_size);
+				} catch (...) {
+					destroy(_alloc, _rom_ds);
+					throw;
+				}
+				_size       = _sparse->size();
+				_chunk_size = _sparse->chunk_size();
+			}
+
+			_block_count = _size/_block_size;
+			_num_chunks  = (_size + _chunk_size - 1)/_chunk_size;
+			_chunks      = (char **)_alloc->alloc(_num_chunks*sizeof(char *));
+
+			for (unsigned long i = 0; i < _num_chunks; i++)
+				_chunks[i] = nullptr;
 		}
 
 		/**
@@ -93,12 +197,30 @@ class Ram_blk : public Block::Driver
 			_env(env),
 			_size(size),
 			_block_size(block_size),
-			_block_count(_size/_block_size),
-			_ram_ds(_env.ram(), _env.rm(), _size),
-			_ram_addr((addr_t)_ram_ds.local_addr<addr_t>())
-		{ }
+			_block_count(_size/_block_size)
+		{
+			_ram_ds.construct(_env.ram(), _env.rm(), size);
+			_ram_addr = (addr_t)_ram_ds->local_addr<addr_t>();
+		}
+
+		~Ram_blk()
+		{
+			if (_chunks) {
+				for (unsigned long i = 0; i < _num_chunks; i++)
+					if (_chunks[i])
+						_alloc->free(_chunks[i], _chunk_size);
 
-		~Ram_blk() { destroy(_alloc, _rom_ds); }
+				_alloc->free(_chunks, _num_chunks*sizeof(char *));
+			}
+
+			_sparse.destruct();
+			destroy(_alloc, _rom_ds);
+		}
+
+		/**
+		 * Return number of bytes copied into the overlay
+		 */
+		uint64_t overlay_size() const { return (uint64_t)_num_copied*_chunk_size; }
 
 
 		/****************************
@@ -151,6 +273,8 @@ struct Main
 
 		size_t       size { 0 };
 		size_t block_size { 512 };
+		size_t cache_size { 1024*1024 };
+		bool      verbose { false };
 
 		Factory(Env &env, Allocator &alloc,
 		        Xml_node config)
@@ -172,6 +296,9 @@ struct Main
 			}
 
 			block_size = config.attribute_value("block_size", block_size);
+			cache_size = config.attribute_value("cache_size",
+			                                    Number_of_bytes(cache_size));
+			verbose    = config.attribute_value("verbose", verbose);
 		}
 
 		Block::Driver *create()
@@ -180,7 +307,13 @@ struct Main
 				if (use_file) {
 					Genode::log("Creating RAM-basd block device populated by file='",
 					            Genode::Cstring(file), "' with block size ", block_size);
-					return new (&alloc) Ram_blk(env, alloc, file, block_size);
+					Ram_blk *driver = new (&alloc)
+						Ram_blk(env, alloc, file, block_size, cache_size);
+
+					if (verbose)
+						log("RAM in use: ", env.pd().used_ram().value / 1024, " KiB");
+
+					return driver;
 				} else {
 					Genode::log("Creating RAM-based block device with size ",
 					            size, " and block size ", block_size);
@@ -190,8 +323,15 @@ struct Main
 			catch (...) { throw Service_denied(); }
 		}
 
-		void destroy(Block::Driver *driver) {
-			Genode::destroy(&alloc, driver); }
+		void destroy(Block::Driver *driver)
+		{
+			if (verbose)
+				log("RAM in use: ", env.pd().used_ram().value / 1024, " KiB, ",
+				    "overlay: ", static_cast<Ram_blk *>(driver)->overlay_size() / 1024,
+				    " KiB");
+
+			Genode::destroy(&alloc, driver);
+		}
 	} factory { env, heap, config_rom.xml() };
 
 	enum { WRITEABLE = true };
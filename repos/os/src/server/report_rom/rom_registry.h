@@ -18,7 +18,10 @@
 #include <report_rom/rom_registry.h>
 #include <os/session_policy.h>
 
-namespace Rom { struct Registry; }
+namespace Rom {
+	struct Registry;
+	using Genode::Xml_node;
+}
 
 
 struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopyable
@@ -71,8 +74,13 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 			/* XXX proper accounting for the used memory is missing */
 			/* XXX if we run out of memory, the server will abort */
 
+			Xml_node const config = _config_rom.xml();
+
 			Module * const module = new (&_md_alloc)
-				Module(_ram, _rm, name, _read_write_policy, _read_write_policy);
+				Module(_ram, _rm, _md_alloc, name,
+				       _read_write_policy, _read_write_policy,
+				       config.attribute_value("shared_snapshots", false),
+				       config.attribute_value("deduplicate",      false));
 
 			_modules.insert(module);
 			return *module;
@@ -15,7 +15,9 @@
 #include <base/component.h>
 #include <base/log.h>
 #include <block/component.h>
+#include <block/sparse_image.h>
 #include <rom_session/connection.h>
+#include <util/reconstructible.h>
 
 using namespace Genode;
 
@@ -29,15 +31,38 @@ class Rom_blk : public Block::Driver
 		Dataspace_capability _file_cap  = _rom.dataspace();
 		addr_t               _file_addr = _env.rm().attach(_file_cap);
 		size_t               _file_sz   = Dataspace_client(_file_cap).size();
-		size_t               _blk_cnt   = _file_sz / _blk_sz;
+
+		/* sparse image, chunks are expanded on access */
+		Constructible<Block::Sparse_image> _sparse { };
+
+		Block::sector_t      _blk_cnt   = 0;
 
 	public:
 
 		using String = Genode::String<64UL>;
 
-		Rom_blk(Env &env, String &name, size_t blk_sz)
+		/**
+		 * Constructor
+		 *
+		 * \param cache_size  memory used for decompressed chunks of a
+		 *                    sparse image
+		 */
+		Rom_blk(Env &env, Allocator &alloc, String &name, size_t blk_sz,
+		        size_t cache_size)
 		: Block::Driver(env.ram()), _env(env), _rom(env, name.string()),
-		  _blk_sz(blk_sz) {}
+		  _blk_sz(blk_sz)
+		{
+			if (Block::Sparse_image::detect((void *)_file_addr, _file_sz)) {
+				try { _sparse.construct(alloc, (void *)_file_addr, _file_sz, cache_size); }
+				catch (...) { _env.rm().detach(_file_addr); throw; }
+
+				_blk_cnt = _sparse->size() / _blk_sz;
+				log("sparse image of ", _sparse->size() / 1024, " KiB");
+			} else
+				_blk_cnt = _file_sz / _blk_sz;
+		}
+
+		~Rom_blk() { _env.rm().detach(_file_addr); }
 
 
 		/****************************
@@ -60,15 +85,22 @@ class Rom_blk : public Block::Driver
 		          Block::Packet_descriptor &packet)
 		{
 			/* sanity check block number */
-			if ((block_number + block_count > _file_sz / _blk_sz)
+			if ((block_number + block_count > _blk_cnt)
 				|| block_number < 0) {
 				warning("requested blocks ", block_number, "-",
 				        block_number + block_count, " out of range!");
 				return;
 			}
 
+			size_t size = block_count * _blk_sz;
+
+			if (_sparse.constructed()) {
+				ack_packet(packet, _sparse->read(block_number * _blk_sz,
+				                                 size, buffer));
+				return;
+			}
+
 			size_t offset = (size_t) block_number * _blk_sz;
-			size_t size   = block_count  * _blk_sz;
 
 			/* copy file content to packet payload */
 			memcpy((void*)buffer, (void*)(_file_addr + offset), size);
@@ -95,9 +127,11 @@ struct Main
 		{
 			Rom_blk::String file;
 			size_t blk_sz = 512;
+			Number_of_bytes cache_sz = 1024*1024;
 
 			try {
 				Attached_rom_dataspace config(env, "config");
+				cache_sz = config.xml().attribute_value("cache_size", cache_sz);
 				config.xml().attribute("file").value(&file);
 				config.xml().attribute("block_size").value(&blk_sz);
 			}
@@ -106,9 +140,11 @@ struct Main
 			log("Using file=", file, " as device with block size ", blk_sz, ".");
 
 			try {
-				return new (&heap) Rom_blk(env, file, blk_sz);
+				return new (&heap) Rom_blk(env, heap, file, blk_sz, cache_sz);
 			} catch(Rom_connection::Rom_connection_failed) {
 				error("cannot open file ", file);
+			} catch (Block::Sparse_image::Invalid) {
+				error("invalid sparse image ", file);
 			}
 			throw Service_denied();
 		}
@@ -15,10 +15,10 @@
 #include <util/reconstructible.h>
 #include <util/arg_string.h>
 #include <util/xml_generator.h>
-#include <util/retry.h>
 #include <base/heap.h>
 #include <base/component.h>
 #include <base/attached_ram_dataspace.h>
+#include <os/expanding_xml_buffer.h>
 #include <root/component.h>
 
 /* local includes */
@@ -165,9 +165,7 @@ struct Rom_filter::Main : Input_rom_registry::Input_rom_changed_fn,
 
 	Input_rom_registry _input_rom_registry { _env, _heap, *this };
 
-	Genode::Constructible<Genode::Attached_ram_dataspace> _xml_ds;
-
-	size_t _xml_output_len = 0;
+	Genode::Constructible<Genode::Expanding_xml_buffer> _xml_buffer;
 
 	void _evaluate_node(Xml_node node, Xml_generator &xml);
 	void _evaluate();
@@ -184,14 +182,15 @@ struct Rom_filter::Main : Input_rom_registry::Input_rom_changed_fn,
 		_config.update();
 
 		/*
-		 * Create buffer for generated XML data
+		 * Create buffer for generated XML data, the configured size is
+		 * merely the initial size of the expanding buffer
 		 */
-		Genode::Number_of_bytes xml_ds_size = 4096;
+		Genode::Number_of_bytes xml_buffer_size = 4096;
 
-		xml_ds_size = _config.xml().attribute_value("buffer", xml_ds_size);
+		xml_buffer_size = _config.xml().attribute_value("buffer", xml_buffer_size);
 
-		if (!_xml_ds.constructed() || xml_ds_size != _xml_ds->size())
-			_xml_ds.construct(_env.ram(), _env.rm(), xml_ds_size);
+		if (!_xml_buffer.constructed())
+			_xml_buffer.construct(_heap, xml_buffer_size);
 
 		/*
 		 * Obtain inputs
@@ -219,15 +218,17 @@ struct Rom_filter::Main : Input_rom_registry::Input_rom_changed_fn,
 	/**
 	 * Output_buffer interface
 	 */
-	size_t content_size() const override { return _xml_output_len; }
+	size_t content_size() const override {
+		return _xml_buffer.constructed() ? _xml_buffer->content_size() : 0; }
 
 	/**
 	 * Output_buffer interface
 	 */
 	size_t export_content(char *dst, size_t dst_len) const
 	{
-		size_t const len = Genode::min(dst_len, _xml_output_len);
-		Genode::memcpy(dst, _xml_ds->local_addr<char>(), len);
+		size_t const len = Genode::min(dst_len, content_size());
+		if (len)
+			Genode::memcpy(dst, _xml_buffer->content(), len);
 		return len;
 	}
 
@@ -331,21 +332,10 @@ void Rom_filter::Main::_evaluate()
 			output.attribute_value("node", Node_type_name(""));
 
 		/*
-		 * Generate output, expand dataspace on demand
+		 * Generate output, the buffer expands on demand
 		 */
-		enum { UPGRADE = 4096, NUM_ATTEMPTS = ~0L };
-		Genode::retry<Xml_generator::Buffer_exceeded>(
-			[&] () {
-				Xml_generator xml(_xml_ds->local_addr<char>(),
-				                  _xml_ds->size(), node_type.string(),
-				                  [&] () { _evaluate_node(output, xml); });
-				_xml_output_len = xml.used();
-			},
-			[&] () {
-				Genode::log("UPGRADING XML DATASPACE");
-				_xml_ds.construct(_env.ram(), _env.rm(), _xml_ds->size() + UPGRADE);
-			},
-			NUM_ATTEMPTS);
+		_xml_buffer->generate(node_type.string(), [&] (Xml_generator &xml) {
+			_evaluate_node(output, xml); });
 
 	} catch (Xml_node::Nonexistent_sub_node) { }
 
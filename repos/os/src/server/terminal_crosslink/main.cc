@@ -14,6 +14,7 @@
 /* Genode includes */
 #include <base/component.h>
 #include <base/heap.h>
+#include <base/attached_rom_dataspace.h>
 
 /* local includes */
 #include "terminal_root.h"
@@ -30,7 +31,18 @@ struct Terminal_crosslink::Main
 	Env  &_env;
 	Heap  _heap { _env.ram(), _env.rm() };
 
-	Root  _terminal_root { _env, _heap };
+	/*
+	 * The configuration is optional
+	 */
+	static bool _ring_enabled(Env &env)
+	{
+		try {
+			Attached_rom_dataspace config(env, "config");
+			return config.xml().attribute_value("ring", true);
+		} catch (...) { return true; }
+	}
+
+	Root  _terminal_root { _env, _heap, _ring_enabled(_env) };
 
 	Main(Env &env) : _env(env)
 	{
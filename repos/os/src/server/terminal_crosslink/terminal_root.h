@@ -67,10 +67,10 @@ namespace Terminal_crosslink {
 			/**
 			 * Constructor
 			 */
-			Root(Env &env, Allocator &alloc)
+			Root(Env &env, Allocator &alloc, bool ring_enabled)
 			: Root_component(&env.ep().rpc_ep(), &alloc),
-			  _session_component1(env, _session_component2),
-			  _session_component2(env, _session_component1),
+			  _session_component1(env, _session_component2, ring_enabled),
+			  _session_component2(env, _session_component1, ring_enabled),
 			  _session_state(0)
 			{ }
 	};
@@ -18,6 +18,7 @@
 #include <base/rpc_server.h>
 #include <base/signal.h>
 #include <util/misc_math.h>
+#include <util/construct_at.h>
 
 /* local includes */
 #include "terminal_session_component.h"
@@ -25,12 +26,17 @@
 using namespace Genode;
 
 Terminal_crosslink::Session_component::Session_component(Env &env,
-                                                         Session_component &partner)
+                                                         Session_component &partner,
+                                                         bool ring_enabled)
 : _env(env),
   _partner(partner),
   _session_cap(_env.ep().rpc_ep().manage(this)),
   _io_buffer(env.ram(), env.rm(), BUFFER_SIZE),
-  _cross_num_bytes_avail(0)
+  _cross_num_bytes_avail(0),
+  _ring_enabled(ring_enabled),
+  _ring_ds(env.ram(), env.rm(), sizeof(Terminal::Rings)),
+  _rings(*construct_at<Terminal::Rings>(_ring_ds.local_addr<void>())),
+  _ring_handler(env.ep(), *this, &Session_component::_handle_ring)
 {
 }
 
@@ -75,28 +81,63 @@ void Terminal_crosslink::Session_component::cross_write()
 }
 
 
-Terminal::Session::Size Terminal_crosslink::Session_component::size()
-{ return Terminal::Session::Size(0, 0); }
+size_t Terminal_crosslink::Session_component::deliver(char const *src, size_t len)
+{
+	bool wakeup = false;
+	size_t num_bytes = 0;
+	try { num_bytes = _rings.to_client.write(src, len, wakeup); }
+	catch (Terminal::Ring::Protocol_violation) {
+		_ring_violated();
+		return 0;
+	}
+
+	if (wakeup)
+		Signal_transmitter(_read_avail_sigh).submit();
+
+	return num_bytes;
+}
 
 
-bool Terminal_crosslink::Session_component::avail()
+void Terminal_crosslink::Session_component::transfer()
 {
-	return _partner.cross_avail();
+	if (!_ring_used)
+		return;
+
+	/*
+	 * The client never waits for space in the 'to_server' ring but falls
+	 * back to the RPC interface, so no wakeup is needed.
+	 */
+	bool wakeup = false;
+	try {
+		_rings.to_server.consume([&] (char const *src, size_t len) {
+			return _forward(src, len); }, wakeup);
+	}
+	catch (Terminal::Ring::Protocol_violation) { _ring_violated(); }
 }
 
 
-size_t Terminal_crosslink::Session_component::_read(size_t dst_len)
+void Terminal_crosslink::Session_component::_ring_violated()
 {
-	return _partner.cross_read(_io_buffer.local_addr<unsigned char>(), dst_len);
+	error("client corrupted the terminal rings, falling back to RPC");
+	_ring_used = false;
 }
 
 
-size_t Terminal_crosslink::Session_component::_write(size_t num_bytes)
+void Terminal_crosslink::Session_component::_handle_ring()
 {
-	unsigned char *src = _io_buffer.local_addr<unsigned char>();
+	/* the client wrote data or made room for data of the partner */
+	transfer();
+	_partner.transfer();
+}
+
+
+size_t Terminal_crosslink::Session_component::_forward(char const *src, size_t len)
+{
+	if (_partner.ring_used())
+		return _partner.deliver(src, len);
 
 	size_t num_bytes_written = 0;
-	while (num_bytes_written < num_bytes)
+	while (num_bytes_written < len)
 		try {
 			_buffer.add(src[num_bytes_written]);
 			++num_bytes_written;
@@ -111,10 +152,67 @@ size_t Terminal_crosslink::Session_component::_write(size_t num_bytes)
 }
 
 
+Terminal::Session::Size Terminal_crosslink::Session_component::size()
+{ return Terminal::Session::Size(0, 0); }
+
+
+bool Terminal_crosslink::Session_component::avail()
+{
+	return _partner.cross_avail();
+}
+
+
+size_t Terminal_crosslink::Session_component::_read(size_t dst_len)
+{
+	size_t const num_bytes =
+		_partner.cross_read(_io_buffer.local_addr<unsigned char>(), dst_len);
+
+	/* refill the buffer from the ring of the partner */
+	_partner.transfer();
+
+	return num_bytes;
+}
+
+
+size_t Terminal_crosslink::Session_component::_write(size_t num_bytes)
+{
+	/* retain the order of data written via the ring and via RPC */
+	transfer();
+	if (_ring_used && _rings.to_server.avail())
+		return 0;
+
+	return _forward(_io_buffer.local_addr<char>(), num_bytes);
+}
+
+
 Dataspace_capability Terminal_crosslink::Session_component::_dataspace()
 { return _io_buffer.cap(); }
 
 
+Dataspace_capability Terminal_crosslink::Session_component::_ring_dataspace()
+{
+	if (!_ring_enabled)
+		return Dataspace_capability();
+
+	/* start with empty rings if the session is re-opened */
+	construct_at<Terminal::Rings>(_ring_ds.local_addr<void>());
+	_ring_used = true;
+
+	/* move data that the partner wrote before the ring was in use */
+	size_t const num_bytes =
+		_partner.cross_read(_io_buffer.local_addr<unsigned char>(), BUFFER_SIZE);
+	deliver(_io_buffer.local_addr<char>(), num_bytes);
+
+	return _ring_ds.cap();
+}
+
+
+Signal_context_capability Terminal_crosslink::Session_component::_ring_sigh()
+{
+	return _ring_handler;
+}
+
+
 void Terminal_crosslink::Session_component::connected_sigh(Signal_context_capability sigh)
 {
 	/*
@@ -129,6 +227,10 @@ void Terminal_crosslink::Session_component::connected_sigh(Signal_context_capabi
 void Terminal_crosslink::Session_component::read_avail_sigh(Signal_context_capability sigh)
 {
 	_read_avail_sigh = sigh;
+
+	/* a wakeup may have been due before the handler was registered */
+	if (_ring_used && _rings.to_client.avail())
+		Signal_transmitter(_read_avail_sigh).submit();
 }
 
 
@@ -19,6 +19,7 @@
 #include <base/attached_ram_dataspace.h>
 #include <os/ring_buffer.h>
 #include <terminal_session/terminal_session.h>
+#include <terminal_session/ring.h>
 
 namespace Terminal_crosslink {
 
@@ -45,24 +46,55 @@ namespace Terminal_crosslink {
 			size_t                      _cross_num_bytes_avail;
 			Signal_context_capability   _read_avail_sigh;
 
+			/*
+			 * Shared-memory rings, used once requested by the client
+			 */
+			bool                         const _ring_enabled;
+			Attached_ram_dataspace             _ring_ds;
+			Terminal::Rings                   &_rings;
+			bool                               _ring_used = false;
+			Signal_handler<Session_component>  _ring_handler;
+
+			void _handle_ring();
+
+			/**
+			 * Stop using the rings after the client forged their counters
+			 */
+			void _ring_violated();
+
+			/**
+			 * Pass data written by the client to the partner
+			 *
+			 * \return number of bytes taken
+			 */
+			size_t _forward(char const *src, size_t len);
+
 		public:
 
 			/**
 			 * Constructor
 			 */
-			Session_component(Env &env, Session_component &partner);
+			Session_component(Env &env, Session_component &partner,
+			                  bool ring_enabled);
 
 			Session_capability cap();
 
 			/**
 			 * Return true if capability belongs to session object
 			 */
-            bool belongs_to(Genode::Session_capability cap);
+			bool belongs_to(Genode::Session_capability cap);
 
 			/* to be called by the partner component */
 			bool cross_avail();
 			size_t cross_read(unsigned char *buf, size_t dst_len);
 			void cross_write();
+			bool ring_used() const { return _ring_used; }
+			size_t deliver(char const *src, size_t len);
+
+			/**
+			 * Pass pending data of the 'to_server' ring to the partner
+			 */
+			void transfer();
 
 			/********************************
 			 ** Terminal session interface **
@@ -78,6 +110,10 @@ namespace Terminal_crosslink {
 
 			Genode::Dataspace_capability _dataspace();
 
+			Genode::Dataspace_capability _ring_dataspace() override;
+
+			Genode::Signal_context_capability _ring_sigh() override;
+
 			void connected_sigh(Genode::Signal_context_capability sigh);
 
 			void read_avail_sigh(Genode::Signal_context_capability sigh);
@@ -0,0 +1,194 @@
+/*
+ * \brief  File-system throughput and IOPS benchmark
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The benchmark keeps the packet stream of the file-system session filled
+ * to measure how well a server overlaps independent requests. For each
+ * '<fs>' node of the configuration, a session with the given label is
+ * opened and the following phases are executed:
+ *
+ * - sequential write of 'file_size' bytes in 'block_size' chunks
+ * - sequential read of the written file
+ * - 'random_ops' reads of 4 KiB at random offsets
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/allocator_avl.h>
+#include <base/attached_rom_dataspace.h>
+#include <file_system_session/connection.h>
+#include <file_system/util.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+	using namespace Genode;
+	struct Bench;
+	struct Main;
+}
+
+
+struct Test::Bench
+{
+	typedef File_system::Packet_descriptor Packet_descriptor;
+	typedef File_system::Session::Tx::Source Source;
+
+	enum { QUEUE_SIZE = File_system::Session::TX_QUEUE_SIZE,
+	       RANDOM_BLOCK_SIZE = 4096 };
+
+	typedef String<64> Label;
+
+	Env               &_env;
+	Timer::Connection &_timer;
+	Label const        _label;
+	Allocator_avl      _tx_alloc;
+	size_t const       _block_size;
+	size_t const       _file_size;
+
+	File_system::Connection _fs;
+
+	File_system::File_handle _file;
+
+	unsigned long _random_seed = 0x2545f491;
+
+	unsigned long _random_offset()
+	{
+		_random_seed = _random_seed*1103515245 + 12345;
+		size_t const blocks = _file_size / RANDOM_BLOCK_SIZE;
+		return ((_random_seed >> 8) % blocks)*RANDOM_BLOCK_SIZE;
+	}
+
+	static File_system::File_handle _open(File_system::Connection &fs)
+	{
+		File_system::Dir_handle root = fs.dir("/", false);
+		File_system::Handle_guard guard(fs, root);
+		return fs.file(root, "fs_bench.dat", File_system::READ_WRITE, true);
+	}
+
+	/**
+	 * Issue 'count' requests with up to 'QUEUE_SIZE' packets in flight
+	 *
+	 * \param offset_fn  functor returning the file offset of the n-th request
+	 *
+	 * \return number of successfully transferred bytes
+	 */
+	template <typename FN>
+	size_t _run(Packet_descriptor::Opcode op, size_t size, unsigned long count,
+	            FN const &offset_fn)
+	{
+		Source &source = *_fs.tx();
+
+		unsigned long submitted = 0, completed = 0;
+		size_t        bytes     = 0;
+
+		while (completed < count) {
+
+			while (submitted < count && source.ready_to_submit()) {
+				Packet_descriptor p;
+				try { p = source.alloc_packet(size); }
+				catch (Source::Packet_alloc_failed) { break; }
+
+				source.submit_packet(Packet_descriptor(p, _file, op, size,
+				                                       offset_fn(submitted)));
+				submitted++;
+			}
+
+			/* block for at least one acknowledgement, then drain the queue */
+			do {
+				Packet_descriptor const p = source.get_acked_packet();
+				if (p.succeeded())
+					bytes += p.length();
+				source.release_packet(p);
+				completed++;
+			} while (source.ack_avail());
+		}
+		return bytes;
+	}
+
+	void _report(char const *phase, size_t bytes, unsigned long ops,
+	             unsigned long start_ms)
+	{
+		unsigned long const ms = max(1UL, _timer.elapsed_ms() - start_ms);
+
+		log(_label, ": ", phase, ": ", bytes / 1024, " KiB in ", ms,
+		    " ms, ", (bytes / 1024) * 1000 / 1024 / ms, " MiB/s, ",
+		    ops * 1000 / ms, " IOPS");
+	}
+
+	Bench(Env &env, Allocator &alloc, Timer::Connection &timer,
+	      char const *label, size_t block_size, size_t file_size,
+	      unsigned long random_ops)
+	:
+		_env(env), _timer(timer), _label(label), _tx_alloc(&alloc),
+		_block_size(block_size), _file_size(file_size),
+		_fs(env, _tx_alloc, label, "/", true, QUEUE_SIZE*block_size + 4096),
+		_file(_open(_fs))
+	{
+		unsigned long const blocks = _file_size / _block_size;
+
+		auto sequential = [&] (unsigned long i) { return i*_block_size; };
+		auto random     = [&] (unsigned long)   { return _random_offset(); };
+
+		unsigned long start = _timer.elapsed_ms();
+		size_t bytes = _run(Packet_descriptor::WRITE, _block_size, blocks, sequential);
+		_report("sequential write", bytes, blocks, start);
+
+		start = _timer.elapsed_ms();
+		bytes = _run(Packet_descriptor::READ, _block_size, blocks, sequential);
+		_report("sequential read", bytes, blocks, start);
+
+		start = _timer.elapsed_ms();
+		bytes = _run(Packet_descriptor::READ, RANDOM_BLOCK_SIZE, random_ops, random);
+		_report("random 4K read", bytes, random_ops, start);
+	}
+
+	~Bench() { _fs.close(_file); }
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Main(Env &env) : _env(env)
+	{
+		Xml_node const config = _config.xml();
+
+		size_t const block_size =
+			config.attribute_value("block_size", Number_of_bytes(64*1024));
+		size_t const file_size =
+			config.attribute_value("file_size", Number_of_bytes(64*1024*1024));
+		unsigned long const random_ops =
+			config.attribute_value("random_ops", 20000UL);
+
+		log("--- file-system benchmark started ---");
+
+		config.for_each_sub_node("fs", [&] (Xml_node fs) {
+			typedef Bench::Label Label;
+			Label const label = fs.attribute_value("label", Label());
+
+			Bench bench(_env, _heap, _timer, label.string(),
+			            block_size, file_size, random_ops);
+		});
+
+		log("--- file-system benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
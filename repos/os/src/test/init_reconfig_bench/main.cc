@@ -0,0 +1,247 @@
+/*
+ * \brief  Benchmark of the reconfiguration of init with many children
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The benchmark starts a large number of children in a nested init and
+ * applies a sequence of typical configuration changes. For each step, it
+ * measures the time until the state report of init reflects the new
+ * configuration and counts the children that were restarted. A restart is
+ * detected by a changed child ID in the state report. The test fails if the
+ * number of restarts differs from the expected one.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/heap.h>
+#include <base/attached_rom_dataspace.h>
+#include <os/reporter.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+	using namespace Genode;
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Attached_rom_dataspace _state { _env, "state" };
+
+	Expanding_reporter _init_config { _env, "config", "init.config" };
+
+	Signal_handler<Main> _state_handler { _env.ep(), *this, &Main::_handle_state };
+
+	unsigned const _num_children =
+		_config.xml().attribute_value("children", 100U);
+
+	/*
+	 * Configuration steps
+	 */
+	enum Step { STARTUP, UNCHANGED, RAM_UPGRADE, ROUTE_ADDED, CONFIG_CHANGED,
+	            DEFAULT_ROUTE_CHANGED, VERSION_CHANGED, DONE };
+
+	static char const *_step_name(Step step)
+	{
+		switch (step) {
+		case STARTUP:               return "startup";
+		case UNCHANGED:             return "unchanged config";
+		case RAM_UPGRADE:           return "RAM upgrade of one child";
+		case ROUTE_ADDED:           return "route added to one child";
+		case CONFIG_CHANGED:        return "config change of one child";
+		case DEFAULT_ROUTE_CHANGED: return "default route changed";
+		case VERSION_CHANGED:       return "version change of one child";
+		case DONE:                  break;
+		}
+		return "";
+	}
+
+	static unsigned _expected_restarts(Step step) {
+		return step == VERSION_CHANGED ? 1 : 0; }
+
+	Step _step = STARTUP;
+
+	/*
+	 * Parameters of the generated configuration, modified by the steps
+	 */
+	bool _ram_upgraded          = false;
+	bool _route_added           = false;
+	bool _config_changed        = false;
+	bool _default_route_changed = false;
+	bool _version_changed       = false;
+
+	void _apply_step()
+	{
+		switch (_step) {
+		case RAM_UPGRADE:           _ram_upgraded          = true; break;
+		case ROUTE_ADDED:           _route_added           = true; break;
+		case CONFIG_CHANGED:        _config_changed        = true; break;
+		case DEFAULT_ROUTE_CHANGED: _default_route_changed = true; break;
+		case VERSION_CHANGED:       _version_changed       = true; break;
+		default: break;
+		}
+	}
+
+	/*
+	 * IDs of the children as reported by init, indexed by child number
+	 */
+	unsigned *_ids = nullptr;
+
+	unsigned long _start_ms = 0;
+
+	typedef String<32> Version;
+
+	Version _version() const { return Version("step ", (unsigned)_step); }
+
+	void _generate_init_config()
+	{
+		_init_config.generate([&] (Xml_generator &xml) {
+
+			xml.attribute("version", _version());
+
+			xml.node("report", [&] () {
+				xml.attribute("ids",      "yes");
+				xml.attribute("delay_ms", 10); });
+
+			xml.node("parent-provides", [&] () {
+				char const *services[] = { "ROM", "CPU", "PD", "LOG" };
+				for (char const *service : services)
+					xml.node("service", [&] () {
+						xml.attribute("name", service); }); });
+
+			xml.node("default-route", [&] () {
+				if (_default_route_changed)
+					xml.node("service", [&] () {
+						xml.attribute("name", "Nitpicker");
+						xml.node("parent", [&] () { }); });
+				xml.node("any-service", [&] () {
+					xml.node("parent", [&] () { }); }); });
+
+			xml.node("default", [&] () { xml.attribute("caps", 100); });
+
+			for (unsigned i = 0; i < _num_children; i++) {
+				xml.node("start", [&] () {
+					xml.attribute("name", String<32>("dummy_", i));
+
+					if (i == 3 && _version_changed)
+						xml.attribute("version", "2");
+
+					xml.node("binary", [&] () { xml.attribute("name", "dummy"); });
+					xml.node("resource", [&] () {
+						xml.attribute("name", "RAM");
+						xml.attribute("quantum", (i == 0 && _ram_upgraded) ? "2M" : "1M");
+					});
+
+					xml.node("config", [&] () {
+						if (i == 2 && _config_changed)
+							xml.attribute("version", "changed"); });
+
+					if (i != 1)
+						return;
+
+					xml.node("route", [&] () {
+						if (_route_added)
+							xml.node("service", [&] () {
+								xml.attribute("name", "Nitpicker");
+								xml.node("parent", [&] () { }); });
+						xml.node("any-service", [&] () {
+							xml.node("parent", [&] () { }); });
+					});
+				});
+			}
+		});
+	}
+
+	static unsigned _child_index(Xml_node child)
+	{
+		typedef String<32> Name;
+		Name const name = child.attribute_value("name", Name());
+
+		unsigned index = ~0U;
+		ascii_to(name.string() + strlen("dummy_"), index);
+		return index;
+	}
+
+	void _handle_state()
+	{
+		_state.update();
+
+		Xml_node const state = _state.xml();
+
+		if (state.attribute_value("version", Version()) != _version())
+			return;
+
+		unsigned num_children = 0, restarts = 0;
+		state.for_each_sub_node("child", [&] (Xml_node child) {
+
+			unsigned const index = _child_index(child);
+			unsigned const id    = child.attribute_value("id", 0U);
+
+			if (index >= _num_children)
+				return;
+
+			num_children++;
+
+			if (_step != STARTUP && _ids[index] != id)
+				restarts++;
+
+			_ids[index] = id;
+		});
+
+		if (num_children < _num_children)
+			return;
+
+		unsigned long const duration_ms = _timer.elapsed_ms() - _start_ms;
+
+		log(_step_name(_step), ": ", duration_ms, " ms, ", restarts, " restarts");
+
+		if (restarts != _expected_restarts(_step)) {
+			error("unexpected number of restarts, expected ",
+			      _expected_restarts(_step));
+			_env.parent().exit(-1);
+			return;
+		}
+
+		_step = (Step)(_step + 1);
+
+		if (_step == DONE) {
+			log("--- init reconfiguration benchmark finished ---");
+			return;
+		}
+
+		_apply_step();
+		_start_ms = _timer.elapsed_ms();
+		_generate_init_config();
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- init reconfiguration benchmark started ---");
+
+		_heap.alloc(_num_children*sizeof(unsigned), (void **)&_ids);
+
+		_state.sigh(_state_handler);
+
+		_start_ms = _timer.elapsed_ms();
+		_generate_init_config();
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
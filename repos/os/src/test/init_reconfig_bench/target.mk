@@ -0,0 +1,3 @@
+TARGET = test-init_reconfig_bench
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,174 @@
+/*
+ * \brief  Benchmark of the startup of many children by init
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The benchmark supplies a configuration with a large number of children to
+ * a nested init and measures the time until the state report of the init
+ * lists all children. Because init processes a new configuration as a whole
+ * before generating a state report, the report reflects the completion of
+ * the startup. Between the rounds, all children are removed.
+ *
+ * Each round is configured by a '<round>' node, whose 'workers' attribute
+ * is passed as 'startup_workers' to the nested init. Every other child
+ * has an explicit '<route>' node whereas the others use the default route.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/attached_rom_dataspace.h>
+#include <os/reporter.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+	using namespace Genode;
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Attached_rom_dataspace _state { _env, "state" };
+
+	Expanding_reporter _init_config { _env, "config", "init.config" };
+
+	Signal_handler<Main> _state_handler { _env.ep(), *this, &Main::_handle_state };
+
+	unsigned const _num_children =
+		_config.xml().attribute_value("children", 200U);
+
+	unsigned const _num_rounds = _config.xml().num_sub_nodes();
+
+	unsigned _round = 0;
+
+	bool _idle = true;   /* waiting for the removal of all children */
+
+	unsigned long _start_ms = 0;
+
+	typedef String<32> Version;
+
+	Version _version() const {
+		return Version(_idle ? "idle " : "round ", _round); }
+
+	unsigned _workers() const
+	{
+		return _config.xml().sub_node(_round)
+		                    .attribute_value("workers", 0U);
+	}
+
+	void _generate_init_config()
+	{
+		unsigned const num_children = _idle ? 0 : _num_children;
+
+		_init_config.generate([&] (Xml_generator &xml) {
+
+			xml.attribute("version", _version());
+
+			if (!_idle)
+				xml.attribute("startup_workers", _workers());
+
+			xml.node("report", [&] () { xml.attribute("delay_ms", 10); });
+
+			xml.node("parent-provides", [&] () {
+				char const *services[] = { "ROM", "CPU", "PD", "LOG" };
+				for (char const *service : services)
+					xml.node("service", [&] () {
+						xml.attribute("name", service); }); });
+
+			xml.node("default-route", [&] () {
+				xml.node("any-service", [&] () {
+					xml.node("parent", [&] () { }); }); });
+
+			xml.node("default", [&] () { xml.attribute("caps", 100); });
+
+			for (unsigned i = 0; i < num_children; i++) {
+				xml.node("start", [&] () {
+					xml.attribute("name", String<32>("dummy_", i));
+					xml.node("binary", [&] () { xml.attribute("name", "dummy"); });
+					xml.node("resource", [&] () {
+						xml.attribute("name", "RAM");
+						xml.attribute("quantum", "1M");
+					});
+
+					if (i % 2)
+						return;
+
+					xml.node("route", [&] () {
+						xml.node("service", [&] () {
+							xml.attribute("name", "ROM");
+							xml.attribute("label", "config");
+							xml.node("parent", [&] () { }); });
+						xml.node("service", [&] () {
+							xml.attribute("name", "LOG");
+							xml.node("parent", [&] () { }); });
+						xml.node("any-service", [&] () {
+							xml.node("parent", [&] () { }); });
+					});
+				});
+			}
+		});
+	}
+
+	void _handle_state()
+	{
+		_state.update();
+
+		Xml_node const state = _state.xml();
+
+		if (state.attribute_value("version", Version()) != _version())
+			return;
+
+		unsigned num_children = 0;
+		state.for_each_sub_node("child", [&] (Xml_node) { num_children++; });
+
+		if (_idle) {
+			if (num_children > 0)
+				return;
+
+			if (_round == _num_rounds) {
+				log("--- init startup benchmark finished ---");
+				return;
+			}
+
+			_idle     = false;
+			_start_ms = _timer.elapsed_ms();
+			_generate_init_config();
+			return;
+		}
+
+		if (num_children < _num_children)
+			return;
+
+		log(_num_children, " children, ", _workers(), " startup workers: ",
+		    _timer.elapsed_ms() - _start_ms, " ms");
+
+		_round++;
+		_idle = true;
+		_generate_init_config();
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- init startup benchmark started ---");
+
+		_state.sigh(_state_handler);
+		_generate_init_config();
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-init_startup_bench
+SRC_CC = main.cc
+LIBS   = base
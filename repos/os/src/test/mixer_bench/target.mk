@@ -0,0 +1,3 @@
+TARGET = test-mixer_bench
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,163 @@
+/*
+ * \brief  Test for the capture filter of nic_dump
+ * \author agent
+ * \date   2026-10-19
+ *
+ * Valid and malformed filter expressions are compiled and the valid ones
+ * are applied to a set of synthetic Ethernet frames. For each expression,
+ * the frames that match are printed.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+
+/* nic_dump includes */
+#include <capture_filter.h>
+
+using namespace Genode;
+
+
+struct Frame
+{
+	enum { MAX_SIZE = 64, ETH_HDR = 14, IP_HDR = 20 };
+
+	char const *name;
+	uint8_t     data[MAX_SIZE];
+	size_t      size;
+
+	void _be16(size_t offset, uint16_t v) {
+		data[offset] = v >> 8; data[offset + 1] = v; }
+
+	void _be32(size_t offset, uint32_t v) {
+		_be16(offset, v >> 16); _be16(offset + 2, v); }
+
+	Frame(char const *name, uint16_t type) : name(name), data(), size(MAX_SIZE)
+	{
+		_be16(12, type);
+	}
+
+	/**
+	 * Constructor of an IPv4 frame
+	 *
+	 * \param frag  value of the flags and fragment-offset field
+	 */
+	Frame(char const *name, uint8_t proto, uint32_t src, uint32_t dst,
+	      uint16_t sport, uint16_t dport, uint16_t frag = 0)
+	:
+		Frame(name, 0x0800)
+	{
+		data[ETH_HDR]     = 0x45;
+		data[ETH_HDR + 9] = proto;
+		_be16(ETH_HDR + 6,  frag);
+		_be32(ETH_HDR + 12, src);
+		_be32(ETH_HDR + 16, dst);
+		_be16(ETH_HDR + IP_HDR,     sport);
+		_be16(ETH_HDR + IP_HDR + 2, dport);
+	}
+};
+
+
+static uint32_t ip(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+	return (a << 24) | (b << 16) | (c << 8) | d; }
+
+
+static Frame const frames[] = {
+	Frame("arp",  0x0806),
+	Frame("udp",  17, ip(10,0,0,1), ip(10,0,0,2), 1234, 53),
+	Frame("tcp",  6,  ip(10,0,0,2), ip(10,0,0,3), 80, 40000),
+	Frame("icmp", 1,  ip(10,0,0,3), ip(10,0,0,1), 0, 0),
+	Frame("frag", 6,  ip(10,0,0,1), ip(10,0,0,2), 80, 80, 0x00b9),
+};
+
+
+static void test(char const *expression)
+{
+	try {
+		Net::Capture_filter const filter(expression);
+
+		String<64> matches;
+		for (Frame const &frame : frames)
+			if (filter.matches(frame.data, frame.size))
+				matches = String<64>(matches, " ", frame.name);
+
+		log("filter \"", expression, "\":", matches);
+	}
+	catch (Net::Capture_filter::Invalid_expression) {
+		log("filter \"", expression, "\": invalid"); }
+}
+
+
+void Component::construct(Env &env)
+{
+	log("--- capture-filter test ---");
+
+	/* valid expressions */
+	test("");
+	test("arp");
+	test("ip");
+	test("tcp or icmp");
+	test("udp || arp");
+	test("host 10.0.0.1");
+	test("src host 10.0.0.2");
+	test("dst host 10.0.0.1");
+	test("port 80");
+	test("dst port 53");
+	test("src port 80 and tcp");
+	test("not ip");
+	test("!(udp || icmp)");
+	test("ip && not port 80");
+	test("(tcp or udp) and host 10.0.0.2 and not src port 1234");
+	test("  tcp  and  not port 40000 ");
+
+	/* truncated frame is neither ARP nor IPv4 */
+	{
+		Frame short_frame("short", 6, ip(10,0,0,1), ip(10,0,0,2), 80, 80);
+		short_frame.size = Frame::ETH_HDR + Frame::IP_HDR + 2;
+
+		Net::Capture_filter const filter("tcp and not port 80");
+		log("truncated transport header: ",
+		    filter.matches(short_frame.data, short_frame.size) ? "match" : "no match");
+	}
+
+	/* malformed expressions */
+	test("tcp and");
+	test("or udp");
+	test("(udp");
+	test("udp)");
+	test("tcp udp");
+	test("src tcp");
+	test("host");
+	test("host 10.0.0");
+	test("host 10.0.0.256");
+	test("port 65536");
+	test("port 8o");
+	test("ether");
+	test("udp # comment");
+	test("port 123456789012345678901234567890123");
+
+	/* program exceeding the maximum number of instructions */
+	{
+		String<512> chain("arp");
+		for (unsigned i = 0; i < 40; i++)
+			chain = String<512>(chain, " or arp");
+
+		try {
+			Net::Capture_filter const filter(chain.string());
+			log("long filter: valid");
+		}
+		catch (Net::Capture_filter::Invalid_expression) {
+			log("long filter: invalid"); }
+	}
+
+	log("--- capture-filter test finished ---");
+
+	env.parent().exit(0);
+}
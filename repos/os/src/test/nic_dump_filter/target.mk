@@ -0,0 +1,6 @@
+TARGET   = test-nic_dump_filter
+SRC_CC   = main.cc capture_filter.cc
+INC_DIR += $(REP_DIR)/src/server/nic_dump
+LIBS     = base
+
+vpath capture_filter.cc $(REP_DIR)/src/server/nic_dump
@@ -0,0 +1,167 @@
+/*
+ * \brief  Throughput test for NIC servers that reflect packets
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The test transmits a configurable number of packets as fast as the NIC
+ * server accepts them and counts the reflected packets. It expects a
+ * loop-back server, e.g., nic_loopback or a Linux NIC driver whose socket
+ * backend is connected to itself. Packets may be dropped on the way. Once
+ * all packets are acknowledged, the test waits until no further packets
+ * arrive and prints the achieved packet rate and throughput.
+ *
+ * Configuration attributes:
+ *
+ * - 'packets'  number of packets to transmit
+ * - 'size'     size of each packet in bytes
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/heap.h>
+#include <base/allocator_avl.h>
+#include <base/attached_rom_dataspace.h>
+#include <nic_session/connection.h>
+#include <nic/packet_allocator.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+	using namespace Genode;
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _num_packets = _config.xml().attribute_value("packets", 100000U);
+	size_t   const _packet_size = _config.xml().attribute_value("size", 1500UL);
+
+	Allocator_avl _tx_block_alloc { &_heap };
+
+	enum { BUF_SIZE = Nic::Packet_allocator::DEFAULT_PACKET_SIZE * 256 };
+
+	Nic::Connection _nic { _env, &_tx_block_alloc, BUF_SIZE, BUF_SIZE };
+
+	Timer::Connection _timer { _env };
+
+	unsigned _tx_cnt = 0, _acked_cnt = 0, _rx_cnt = 0;
+
+	unsigned long _start_ms   = 0;
+	unsigned long _last_rx_ms = 0;
+
+	bool _done = false;
+
+	Signal_handler<Main> _nic_handler   { _env.ep(), *this, &Main::_handle_nic };
+	Signal_handler<Main> _timer_handler { _env.ep(), *this, &Main::_handle_timer };
+
+	void _send_packets()
+	{
+		while (_tx_cnt < _num_packets && _nic.tx()->ready_to_submit()) {
+			try {
+				Packet_descriptor const packet = _nic.tx()->alloc_packet(_packet_size);
+
+				/* broadcast frame with a sequence number as payload */
+				char *content = _nic.tx()->packet_content(packet);
+				memset(content, 0xff, 12);
+				content[12] = 0x88; content[13] = 0xb5;
+				memcpy(content + 14, &_tx_cnt, sizeof(_tx_cnt));
+
+				_nic.tx()->submit_packet(packet);
+				_tx_cnt++;
+			}
+			catch (Nic::Session::Tx::Source::Packet_alloc_failed) { break; }
+		}
+	}
+
+	void _handle_nic()
+	{
+		if (_done)
+			return;
+
+		while (_nic.tx()->ack_avail()) {
+			_nic.tx()->release_packet(_nic.tx()->get_acked_packet());
+			_acked_cnt++;
+		}
+
+		unsigned received = 0;
+		while (_nic.rx()->packet_avail() && _nic.rx()->ready_to_ack()) {
+			_nic.rx()->acknowledge_packet(_nic.rx()->get_packet());
+			received++;
+		}
+
+		if (received) {
+			_rx_cnt    += received;
+			_last_rx_ms = _timer.elapsed_ms();
+		}
+
+		_send_packets();
+
+		if (_rx_cnt == _num_packets)
+			_finish();
+	}
+
+	void _finish()
+	{
+		_done = true;
+
+		unsigned long const duration_ms =
+			max(1UL, (_rx_cnt == _num_packets ? _timer.elapsed_ms() : _last_rx_ms)
+			         - _start_ms);
+
+		unsigned long const kpps  = _rx_cnt / duration_ms;
+		unsigned long const mbits = ((unsigned long long)_rx_cnt*_packet_size*8)
+		                          / (duration_ms*1000);
+
+		log("sent ", _tx_cnt, " packets of ", _packet_size, " bytes, "
+		    "received ", _rx_cnt, " (", _tx_cnt - _rx_cnt, " dropped) in ",
+		    duration_ms, " ms: ", kpps, " kpps, ", mbits, " Mbit/s");
+
+		log("--- NIC throughput test finished ---");
+		_env.parent().exit(0);
+	}
+
+	/*
+	 * Detect the end of the test if packets were dropped
+	 */
+	void _handle_timer()
+	{
+		if (_done || _acked_cnt < _num_packets)
+			return;
+
+		if (_timer.elapsed_ms() - _last_rx_ms > 500)
+			_finish();
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- NIC throughput test ---");
+
+		_nic.tx_channel()->sigh_ready_to_submit(_nic_handler);
+		_nic.tx_channel()->sigh_ack_avail      (_nic_handler);
+		_nic.rx_channel()->sigh_ready_to_ack   (_nic_handler);
+		_nic.rx_channel()->sigh_packet_avail   (_nic_handler);
+
+		_timer.sigh(_timer_handler);
+		_timer.trigger_periodic(100*1000);
+
+		_start_ms = _last_rx_ms = _timer.elapsed_ms();
+		_send_packets();
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,130 @@
+/*
+ * \brief  Load generator for benchmarking nitpicker's composition
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The client stacks several screen-sized views, every other of which is
+ * translucent, and refreshes its whole buffer each frame. This way,
+ * nitpicker has to compose the entire screen including alpha blending for
+ * each frame. The composition time is reported by nitpicker itself if
+ * configured with the 'compose_stats' attribute.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_dataspace.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/log.h>
+#include <nitpicker_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	typedef Nitpicker::Session::View_handle View_handle;
+	typedef Nitpicker::Session::Command     Command;
+
+	enum { MAX_VIEWS = 16 };
+
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _num_views =
+		min((unsigned)MAX_VIEWS, _config.xml().attribute_value("views", 4U));
+
+	Nitpicker::Connection _nitpicker { _env, "compose_bench" };
+
+	Framebuffer::Mode const _mode = _nitpicker.mode();
+
+	/* each view shows a horizontal stripe of the buffer */
+	Framebuffer::Mode const _buffer_mode { _mode.width(),
+	                                       (int)(_mode.height()*_num_views),
+	                                       _mode.format() };
+
+	Framebuffer::Session &_fb = *_nitpicker.framebuffer();
+
+	Constructible<Attached_dataspace> _fb_ds;
+
+	unsigned _frame_cnt = 0;
+
+	Signal_handler<Main> _sync_handler { _env.ep(), *this, &Main::_handle_sync };
+
+	void _init_buffer()
+	{
+		unsigned const w = _buffer_mode.width(), h = _buffer_mode.height();
+
+		uint16_t * const pixels = _fb_ds->local_addr<uint16_t>();
+		uint8_t  * const alpha  = (uint8_t *)(pixels + w*h);
+
+		for (unsigned y = 0; y < h; y++) {
+
+			bool const translucent = (y / _mode.height()) & 1;
+
+			for (unsigned x = 0; x < w; x++) {
+				pixels[y*w + x] = (uint16_t)(x*0x21 + y*0x801);
+				alpha [y*w + x] = translucent ? (uint8_t)((x + y) & 0xff) : 255;
+			}
+		}
+	}
+
+	void _create_views()
+	{
+		for (unsigned i = 0; i < _num_views; i++) {
+
+			View_handle const handle = _nitpicker.create_view();
+
+			Nitpicker::Rect const rect(Nitpicker::Point(0, 0),
+			                           Nitpicker::Area(_mode.width(), _mode.height()));
+
+			_nitpicker.enqueue<Command::Geometry>(handle, rect);
+			_nitpicker.enqueue<Command::Offset>(handle,
+				Nitpicker::Point(0, -(int)(i*_mode.height())));
+			_nitpicker.enqueue<Command::To_front>(handle);
+			_nitpicker.execute();
+		}
+	}
+
+	void _handle_sync()
+	{
+		/* modify one pixel row per frame to keep the content changing */
+		unsigned const w = _buffer_mode.width();
+		unsigned const y = _frame_cnt++ % _buffer_mode.height();
+
+		uint16_t * const pixels = _fb_ds->local_addr<uint16_t>();
+		for (unsigned x = 0; x < w; x++)
+			pixels[y*w + x] = ~pixels[y*w + x];
+
+		_fb.refresh(0, 0, _buffer_mode.width(), _buffer_mode.height());
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- nitpicker composition benchmark, ", _num_views, " views of ",
+		    _mode.width(), "x", _mode.height(), " ---");
+
+		_nitpicker.buffer(_buffer_mode, true);
+		_fb_ds.construct(_env.rm(), _fb.dataspace());
+
+		_init_buffer();
+		_create_views();
+
+		_fb.sync_sigh(_sync_handler);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-nitpicker_compose_bench
+SRC_CC = main.cc
+LIBS   = base
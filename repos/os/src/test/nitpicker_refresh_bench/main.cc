@@ -0,0 +1,178 @@
+/*
+ * \brief  Benchmark of individual versus batched framebuffer refreshes
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The benchmark animates many small nitpicker views, each showing a tile of
+ * the session's buffer. Each frame, all tiles are repainted and refreshed,
+ * first by calling 'refresh' per tile, then by submitting all tiles via a
+ * single 'refresh_batch' call.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_dataspace.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/log.h>
+#include <framebuffer_session/damage.h>
+#include <nitpicker_session/connection.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	typedef Nitpicker::Session::View_handle View_handle;
+	typedef Nitpicker::Session::Command     Command;
+
+	enum { TILE = 16, GAP = 4, MAX_TILES_PER_ROW = 32 };
+
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _tiles_per_row =
+		min((unsigned)MAX_TILES_PER_ROW,
+		    _config.xml().attribute_value("tiles_per_row", 16U));
+
+	unsigned const _num_tiles = _tiles_per_row*_tiles_per_row;
+
+	unsigned const _frames = _config.xml().attribute_value("frames", 200U);
+
+	Nitpicker::Connection _nitpicker { _env, "bench" };
+
+	Timer::Connection _timer { _env };
+
+	Framebuffer::Mode const _mode { (int)(_tiles_per_row*TILE),
+	                                (int)(_tiles_per_row*TILE),
+	                                Framebuffer::Mode::RGB565 };
+
+	Framebuffer::Session &_fb = *_nitpicker.framebuffer();
+
+	Constructible<Attached_dataspace> _fb_ds;
+
+	Constructible<Framebuffer::Refresh_batch> _refresh_batch;
+
+	enum Phase { INDIVIDUAL, BATCHED, DONE } _phase = INDIVIDUAL;
+
+	unsigned           _frame_cnt   = 0;
+	unsigned long long _rpc_cnt     = 0;
+	unsigned long long _duration_us = 0;
+
+	Signal_handler<Main> _sync_handler { _env.ep(), *this, &Main::_handle_sync };
+
+	void _create_views()
+	{
+		for (unsigned i = 0; i < _num_tiles; i++) {
+
+			int const col = i % _tiles_per_row, row = i / _tiles_per_row;
+
+			View_handle const handle = _nitpicker.create_view();
+
+			Nitpicker::Point const pos(col*(TILE + GAP), row*(TILE + GAP));
+			Nitpicker::Rect  const rect(pos, Nitpicker::Area(TILE, TILE));
+
+			_nitpicker.enqueue<Command::Geometry>(handle, rect);
+			_nitpicker.enqueue<Command::Offset>(handle,
+				Nitpicker::Point(-col*TILE, -row*TILE));
+			_nitpicker.enqueue<Command::To_front>(handle);
+			_nitpicker.execute();
+		}
+	}
+
+	void _paint_tile(unsigned i, unsigned frame)
+	{
+		int const col = i % _tiles_per_row, row = i / _tiles_per_row;
+
+		uint16_t * const pixels = _fb_ds->local_addr<uint16_t>();
+		uint16_t   const color  = (uint16_t)(frame*0x0841 + i*0x1234);
+
+		for (int y = row*TILE; y < (row + 1)*TILE; y++)
+			for (int x = col*TILE; x < (col + 1)*TILE; x++)
+				pixels[y*_mode.width() + x] = color;
+	}
+
+	void _report(char const *phase)
+	{
+		log(phase, ": tiles=", _num_tiles, " frames=", _frame_cnt, " "
+		    "refresh RPCs/frame=", _rpc_cnt/_frame_cnt, " "
+		    "frame time=", _duration_us/_frame_cnt, " us");
+	}
+
+	void _handle_sync()
+	{
+		if (_phase == DONE)
+			return;
+
+		unsigned long const start_us = _timer.elapsed_us();
+
+		for (unsigned i = 0; i < _num_tiles; i++) {
+
+			_paint_tile(i, _frame_cnt);
+
+			int const col = i % _tiles_per_row, row = i / _tiles_per_row;
+
+			if (_phase == INDIVIDUAL) {
+				_fb.refresh(col*TILE, row*TILE, TILE, TILE);
+				_rpc_cnt++;
+			} else {
+				_refresh_batch->add(col*TILE, row*TILE, TILE, TILE);
+				if (!_refresh_batch->batched())
+					_rpc_cnt++;
+			}
+		}
+
+		if (_phase == BATCHED && _refresh_batch->batched()) {
+			_refresh_batch->flush();
+			_rpc_cnt++;
+		}
+
+		_duration_us += _timer.elapsed_us() - start_us;
+
+		if (++_frame_cnt < _frames)
+			return;
+
+		if (_phase == INDIVIDUAL) {
+			_report("individual");
+			_phase = BATCHED;
+		} else {
+			_report("batched");
+			_phase = DONE;
+			log("--- nitpicker refresh benchmark finished ---");
+		}
+
+		_frame_cnt = 0; _rpc_cnt = 0; _duration_us = 0;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- nitpicker refresh benchmark ---");
+
+		_nitpicker.buffer(_mode, false);
+		_fb_ds.construct(_env.rm(), _fb.dataspace());
+		_refresh_batch.construct(_env.rm(), _fb);
+
+		if (!_refresh_batch->batched())
+			warning("batched refresh not supported by nitpicker");
+
+		_create_views();
+
+		_fb.sync_sigh(_sync_handler);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
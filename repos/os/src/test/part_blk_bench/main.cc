@@ -0,0 +1,166 @@
+/*
+ * \brief  Sequential read throughput of part_blk compared to its back end
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The block sessions labeled "direct" and "partition" are read one after
+ * another. The run script routes the former to the back-end driver and the
+ * latter to part_blk.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <block_session/connection.h>
+#include <timer_session/connection.h>
+#include <util/reconstructible.h>
+
+using namespace Genode;
+
+
+struct Main
+{
+	enum { TX_BUFFER = 2*1024*1024 };
+
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Heap              _heap  { _env.ram(), _env.rm() };
+	Timer::Connection _timer { _env };
+
+	Number_of_bytes const _total_size =
+		_config.xml().attribute_value("total_size", Number_of_bytes(1024*1024*1024));
+
+	Number_of_bytes const _request_size =
+		_config.xml().attribute_value("request_size", Number_of_bytes(64*1024));
+
+	Constructible<Allocator_avl>     _alloc   { };
+	Constructible<Block::Connection> _session { };
+
+	Signal_handler<Main> _ack_handler {
+		_env.ep(), *this, &Main::_handle_ack };
+
+	Signal_handler<Main> _submit_handler {
+		_env.ep(), *this, &Main::_submit };
+
+	static char const *_label(unsigned run) {
+		return run == 0 ? "direct" : "partition"; }
+
+	enum { NUM_RUNS = 2 };
+
+	unsigned        _run       = 0;
+	Block::sector_t _blk_count = 0;
+	size_t          _blk_size  = 0;
+	size_t          _count     = 0;
+	Block::sector_t _current   = 0;
+	size_t          _submitted = 0;
+	size_t          _acked     = 0;
+	unsigned long   _start_ms  = 0;
+
+	void _start_run()
+	{
+		_alloc.construct(&_heap);
+		_session.construct(_env, &*_alloc, TX_BUFFER, _label(_run));
+
+		_session->tx_channel()->sigh_ack_avail(_ack_handler);
+		_session->tx_channel()->sigh_ready_to_submit(_submit_handler);
+
+		Block::Session::Operations ops;
+		_session->info(&_blk_count, &_blk_size, &ops);
+
+		_count     = _request_size / _blk_size;
+		_current   = 0;
+		_submitted = _acked = 0;
+
+		if (!_count || _blk_count < _count) {
+			error(_label(_run), ": invalid request size");
+			return;
+		}
+
+		_start_ms = _timer.elapsed_ms();
+		_submit();
+	}
+
+	void _finish_run()
+	{
+		unsigned long const ms = max(_timer.elapsed_ms() - _start_ms, 1UL);
+		size_t        const kb = _acked*_count*_blk_size/1024;
+
+		log(_label(_run), ": read ", kb, " KiB in ", ms, " ms (",
+		    kb*1000/ms/1024, " MiB/s)");
+
+		_session.destruct();
+		_alloc.destruct();
+
+		if (++_run < NUM_RUNS) {
+			_start_run();
+			return;
+		}
+
+		log("--- part_blk benchmark finished ---");
+	}
+
+	size_t _requests() const { return _total_size / (_count*_blk_size); }
+
+	void _submit()
+	{
+		if (!_session.constructed())
+			return;
+
+		try {
+			while (_submitted < _requests() && _session->tx()->ready_to_submit()) {
+
+				Block::Packet_descriptor p(
+					_session->tx()->alloc_packet(_count*_blk_size),
+					Block::Packet_descriptor::READ, _current, _count);
+
+				_session->tx()->submit_packet(p);
+				_submitted++;
+
+				_current += _count;
+				if (_current + _count > _blk_count)
+					_current = 0;
+			}
+		} catch (Block::Session::Tx::Source::Packet_alloc_failed) { }
+	}
+
+	void _handle_ack()
+	{
+		if (!_session.constructed())
+			return;
+
+		while (_session->tx()->ack_avail()) {
+
+			Block::Packet_descriptor p = _session->tx()->get_acked_packet();
+			if (!p.succeeded())
+				error("packet error: block: ", p.block_number(), " "
+				      "count: ", p.block_count());
+
+			_session->tx()->release_packet(p);
+			_acked++;
+		}
+
+		if (_acked == _requests()) {
+			_finish_run();
+			return;
+		}
+
+		_submit();
+	}
+
+	Main(Env &env) : _env(env) { _start_run(); }
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
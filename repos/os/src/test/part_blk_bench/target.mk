@@ -0,0 +1,3 @@
+TARGET = test-part_blk_bench
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,265 @@
+/*
+ * \brief  Benchmark of report distribution by the report-ROM server
+ * \author agent
+ * \date   2026-10-19
+ *
+ * A single writer reports an XML document at a fixed rate, which is
+ * consumed by a number of ROM readers. Only every 'change_every'-th report
+ * alters the content, the others repeat the previous one. For each reader,
+ * the benchmark measures the number of updates and the latency between
+ * issuing a report and the reader having parsed it.
+ *
+ * The phases are executed one after another for each '<report_rom>' node of
+ * the configuration. The node's label is used for the report session and
+ * the ROM sessions.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/attached_rom_dataspace.h>
+#include <os/reporter.h>
+#include <util/xml_generator.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+	using namespace Genode;
+
+	typedef String<64> Label;
+
+	struct Reader;
+	struct Phase;
+	struct Main;
+}
+
+
+struct Test::Reader
+{
+	Timer::Connection &_timer;
+
+	Attached_rom_dataspace _rom;
+
+	Signal_handler<Reader> _handler;
+
+	unsigned long _updates     = 0;
+	unsigned long _redundant   = 0;   /* updates without changed content */
+	unsigned long _latency_us  = 0;
+	unsigned long _max_latency = 0;
+	unsigned long _last_time   = 0;
+
+	void _handle()
+	{
+		_rom.update();
+
+		Xml_node const xml = _rom.xml();
+
+		/* visit all nodes as a typical consumer would */
+		unsigned long entries = 0;
+		xml.for_each_sub_node("entry", [&] (Xml_node) { entries++; });
+
+		if (!entries)
+			return;
+
+		_updates++;
+
+		unsigned long const time_us = xml.attribute_value("time_us", 0UL);
+		if (time_us == _last_time) {
+			_redundant++;
+			return;
+		}
+		_last_time = time_us;
+
+		unsigned long const latency = _timer.elapsed_us() - time_us;
+
+		_latency_us += latency;
+		_max_latency = max(_max_latency, latency);
+	}
+
+	Reader(Env &env, Timer::Connection &timer, Label const &label)
+	:
+		_timer(timer), _rom(env, label.string()),
+		_handler(env.ep(), *this, &Reader::_handle)
+	{
+		_rom.sigh(_handler);
+	}
+};
+
+
+struct Test::Phase
+{
+	enum { MAX_READERS = 64 };
+
+	Env               &_env;
+	Allocator         &_alloc;
+	Timer::Connection &_timer;
+	Label const        _label;
+
+	unsigned      const _num_readers;
+	unsigned      const _change_every;
+	unsigned      const _entries;
+	unsigned long const _num_reports;
+
+	enum { BUFFER_SIZE = 64*1024 };
+
+	Reporter _reporter { _env, "state", _label.string(), BUFFER_SIZE };
+
+	char   _buffer[BUFFER_SIZE];
+	size_t _length = 0;
+
+	Reader *_readers[MAX_READERS];
+
+	unsigned long _reports = 0, _content = 0;
+
+	Phase(Env &env, Allocator &alloc, Timer::Connection &timer,
+	      Label const &label, unsigned num_readers, unsigned change_every,
+	      unsigned entries, unsigned long num_reports)
+	:
+		_env(env), _alloc(alloc), _timer(timer), _label(label),
+		_num_readers(min(num_readers, (unsigned)MAX_READERS)),
+		_change_every(max(change_every, 1U)), _entries(entries),
+		_num_reports(num_reports)
+	{
+		_reporter.enabled(true);
+
+		for (unsigned i = 0; i < _num_readers; i++)
+			_readers[i] = new (_alloc) Reader(_env, _timer, _label);
+	}
+
+	~Phase()
+	{
+		for (unsigned i = 0; i < _num_readers; i++)
+			destroy(_alloc, _readers[i]);
+	}
+
+	/**
+	 * Issue next report
+	 *
+	 * \return false if the phase is complete
+	 */
+	bool report()
+	{
+		if (_reports == _num_reports)
+			return false;
+
+		/* otherwise, repeat the previous content */
+		if (_reports++ % _change_every == 0) {
+			_content++;
+
+			Xml_generator xml(_buffer, sizeof(_buffer), "state", [&] () {
+				xml.attribute("time_us", _timer.elapsed_us());
+				for (unsigned i = 0; i < _entries; i++) {
+					xml.node("entry", [&] () {
+						xml.attribute("id", i);
+						xml.attribute("value", _content*i);
+					});
+				}
+			});
+			_length = xml.used();
+		}
+
+		_reporter.report(_buffer, _length);
+		return true;
+	}
+
+	void print_result()
+	{
+		unsigned long updates = 0, redundant = 0, latency = 0, max_latency = 0;
+		for (unsigned i = 0; i < _num_readers; i++) {
+			updates     += _readers[i]->_updates;
+			redundant   += _readers[i]->_redundant;
+			latency     += _readers[i]->_latency_us;
+			max_latency  = max(max_latency, _readers[i]->_max_latency);
+		}
+
+		unsigned const readers = max(_num_readers, 1U);
+
+		log(_label, ": ", _reports, " reports, ", _content, " changes, ",
+		    updates / readers, " updates per reader (",
+		    redundant / readers, " redundant), "
+		    "latency avg ", latency / max(updates - redundant, 1UL), " us, "
+		    "max ", max_latency, " us");
+	}
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	Signal_handler<Main> _timer_handler { _env.ep(), *this, &Main::_handle_timer };
+
+	Constructible<Phase> _phase;
+
+	unsigned _phase_index = 0;
+
+	/**
+	 * Start phase for the n-th '<report_rom>' node
+	 *
+	 * \return false if no such node exists
+	 */
+	bool _start_phase(unsigned n)
+	{
+		Xml_node const config = _config.xml();
+
+		unsigned i = 0;
+		bool found = false;
+		config.for_each_sub_node("report_rom", [&] (Xml_node node) {
+			if (i++ != n)
+				return;
+
+			found = true;
+			_phase.construct(_env, _heap, _timer,
+			                 node.attribute_value("label", Label()),
+			                 config.attribute_value("readers",      20U),
+			                 config.attribute_value("change_every", 2U),
+			                 config.attribute_value("entries",      32U),
+			                 config.attribute_value("reports",      1000UL));
+		});
+		return found;
+	}
+
+	void _handle_timer()
+	{
+		if (!_phase.constructed() || _phase->report())
+			return;
+
+		_phase->print_result();
+		_phase.destruct();
+
+		if (!_start_phase(++_phase_index)) {
+			_timer.trigger_periodic(0);
+			log("--- report-ROM benchmark finished ---");
+		}
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		unsigned const rate_hz =
+			max(_config.xml().attribute_value("rate_hz", 100U), 1U);
+
+		log("--- report-ROM benchmark started ---");
+
+		if (!_start_phase(0))
+			return;
+
+		_timer.sigh(_timer_handler);
+		_timer.trigger_periodic(1000*1000 / rate_hz);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-report_rom_bench
+SRC_CC = main.cc
+LIBS   = base
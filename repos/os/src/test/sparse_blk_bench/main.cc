@@ -0,0 +1,205 @@
+/*
+ * \brief  Start-up time and memory use of block devices backed by sparse images
+ * \author agent
+ * \date   2026-10-19
+ *
+ * For each block session, the time until the first block was read is
+ * measured. The content is checked against the layout of the image created
+ * by the run script. Writable devices are written at scattered positions,
+ * which populates the copy-on-write overlay of ram_blk, and read back.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <block_session/connection.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+struct Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Heap              _heap  { _env.ram(), _env.rm() };
+	Timer::Connection _timer { _env };
+
+	unsigned const _writes = _config.xml().attribute_value("writes", 256U);
+
+	/*
+	 * Layout of the image, the first '_raw_chunks' chunks contain the
+	 * pattern 'offset % 251', the middle chunk is LZ4-compressed and filled
+	 * with 0xaa, all other chunks are empty
+	 */
+	uint64_t const _chunk_size = _config.xml().attribute_value("chunk_size", (uint64_t)65536);
+	unsigned const _raw_chunks = _config.xml().attribute_value("raw_chunks", 16U);
+
+	typedef String<32> Label;
+
+	bool _transfer(Block::Connection &session, Block::Packet_descriptor::Opcode op,
+	               Block::sector_t nr, size_t count, size_t blk_size, char *data)
+	{
+		Block::Packet_descriptor p(session.tx()->alloc_packet(count*blk_size),
+		                           op, nr, count);
+
+		if (op == Block::Packet_descriptor::WRITE)
+			memcpy(session.tx()->packet_content(p), data, count*blk_size);
+
+		session.tx()->submit_packet(p);
+		p = session.tx()->get_acked_packet();
+
+		bool const ok = p.succeeded();
+
+		if (ok && op == Block::Packet_descriptor::READ)
+			memcpy(data, session.tx()->packet_content(p), count*blk_size);
+
+		session.tx()->release_packet(p);
+		return ok;
+	}
+
+	/**
+	 * Read block and compare it with the expected content
+	 *
+	 * \param expected  functor returning the byte at a device offset
+	 */
+	template <typename FN>
+	bool _check(Block::Connection &session, Label const &label,
+	            Block::sector_t nr, size_t blk_size, char *block,
+	            FN const &expected)
+	{
+		if (!_transfer(session, Block::Packet_descriptor::READ, nr, 1,
+		               blk_size, block)) {
+			error(label, ": reading block ", nr, " failed");
+			return false;
+		}
+
+		for (size_t j = 0; j < blk_size; j++)
+			if (block[j] != (char)expected(nr*blk_size + j)) {
+				error(label, ": block ", nr, " has unexpected content at ", j);
+				return false;
+			}
+
+		return true;
+	}
+
+	/**
+	 * Check raw, compressed, and empty chunks of the image
+	 */
+	bool _check_image(Block::Connection &session, Label const &label,
+	                  Block::sector_t blk_count, size_t blk_size, char *block)
+	{
+		uint64_t const chunk_blocks = _chunk_size / blk_size;
+		uint64_t const num_chunks   = _chunk_size
+		                            ? (blk_count*blk_size + _chunk_size - 1) / _chunk_size : 0;
+		uint64_t const lz4_first    = (num_chunks / 2)*chunk_blocks;
+		uint64_t const raw_end      = _raw_chunks*chunk_blocks;
+
+		/* the compressed chunk lies between raw and empty chunks */
+		if (!chunk_blocks || _chunk_size % blk_size || !_raw_chunks
+		 || num_chunks / 2 <= _raw_chunks || num_chunks / 2 + 1 >= num_chunks) {
+			error(label, ": device does not match the image layout");
+			return false;
+		}
+
+		auto raw   = [&] (uint64_t offset) { return (offset % _chunk_size) % 251; };
+		auto lz4   = [&] (uint64_t)        { return 0xaa; };
+		auto empty = [&] (uint64_t)        { return 0; };
+
+		return _check(session, label, 0, blk_size, block, raw)
+		    && _check(session, label, raw_end - 1, blk_size, block, raw)
+		    && _check(session, label, raw_end, blk_size, block, empty)
+		    && _check(session, label, lz4_first, blk_size, block, lz4)
+		    && _check(session, label, lz4_first + chunk_blocks/2, blk_size, block, lz4)
+		    && _check(session, label, lz4_first + chunk_blocks - 1, blk_size, block, lz4)
+		    && _check(session, label, lz4_first + chunk_blocks, blk_size, block, empty);
+	}
+
+	bool _bench(Label const &label)
+	{
+		unsigned long const start_ms = _timer.elapsed_ms();
+
+		Allocator_avl     alloc(&_heap);
+		Block::Connection session(_env, &alloc, 128*1024, label.string());
+
+		Block::sector_t            blk_count = 0;
+		size_t                     blk_size  = 0;
+		Block::Session::Operations ops;
+		session.info(&blk_count, &blk_size, &ops);
+
+		char block[4096];
+		if (blk_size > sizeof(block)) {
+			error(label, ": unsupported block size ", blk_size);
+			return false;
+		}
+
+		if (!_transfer(session, Block::Packet_descriptor::READ, 0, 1, blk_size, block))
+			return false;
+
+		log(label, ": ", blk_count*blk_size/(1024*1024), " MiB device, ",
+		    "first block read after ", _timer.elapsed_ms() - start_ms, " ms");
+
+		if (!_check_image(session, label, blk_count, blk_size, block))
+			return false;
+
+		log(label, ": content of raw, compressed, and empty chunks verified");
+
+		if (!ops.supported(Block::Packet_descriptor::WRITE))
+			return true;
+
+		/* write blocks spread across the device and read them back */
+		Block::sector_t const stride = blk_count / max(_writes, 1U);
+
+		unsigned long const write_ms = _timer.elapsed_ms();
+
+		for (unsigned i = 0; i < _writes; i++) {
+			memset(block, i + 1, blk_size);
+			if (!_transfer(session, Block::Packet_descriptor::WRITE, i*stride, 1,
+			               blk_size, block))
+				return false;
+		}
+
+		for (unsigned i = 0; i < _writes; i++) {
+			if (!_transfer(session, Block::Packet_descriptor::READ, i*stride, 1,
+			               blk_size, block))
+				return false;
+
+			for (size_t j = 0; j < blk_size; j++)
+				if (block[j] != (char)(i + 1)) {
+					error(label, ": block ", i*stride, " corrupted");
+					return false;
+				}
+		}
+
+		log(label, ": wrote and verified ", _writes, " scattered blocks in ",
+		    _timer.elapsed_ms() - write_ms, " ms");
+		return true;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		bool ok = true;
+
+		_config.xml().for_each_sub_node("device", [&] (Xml_node device) {
+			if (ok)
+				ok = _bench(device.attribute_value("label", Label()));
+		});
+
+		log("--- sparse_blk benchmark ", ok ? "finished" : "failed", " ---");
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-sparse_blk_bench
+SRC_CC = main.cc
+LIBS   = base
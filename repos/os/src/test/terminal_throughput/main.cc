@@ -0,0 +1,153 @@
+/*
+ * \brief  Throughput benchmark for terminal sessions
+ * \author agent
+ * \date   2026-10-19
+ *
+ * For each '<crosslink>' node of the configuration, the benchmark opens two
+ * sessions with the node's label at a 'terminal_crosslink' server. A writer
+ * thread streams 'size' bytes through the first session while a reader
+ * thread consumes them from the second one.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/thread.h>
+#include <base/attached_rom_dataspace.h>
+#include <terminal_session/connection.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	enum { STACK_SIZE = sizeof(addr_t)*2048, BUFFER_SIZE = 16*1024 };
+
+	typedef String<64> Label;
+
+	struct Writer;
+	struct Reader;
+	struct Main;
+}
+
+
+struct Test::Writer : Thread
+{
+	Terminal::Connection _terminal;
+
+	size_t const _total;
+	size_t const _chunk;
+
+	char _buffer[BUFFER_SIZE];
+
+	Writer(Env &env, Label const &label, size_t total, size_t chunk)
+	:
+		Thread(env, "writer", STACK_SIZE),
+		_terminal(env, label.string()),
+		_total(total), _chunk(min(chunk, (size_t)BUFFER_SIZE))
+	{
+		for (size_t i = 0; i < sizeof(_buffer); i++)
+			_buffer[i] = 'a' + i % 26;
+	}
+
+	void entry() override
+	{
+		for (size_t written = 0; written < _total; ) {
+			size_t const n = min(_chunk, _total - written);
+			written += _terminal.write(_buffer, n);
+		}
+	}
+};
+
+
+struct Test::Reader : Thread
+{
+	Terminal::Connection _terminal;
+
+	size_t const _total;
+	size_t       _received = 0;
+	unsigned     _wakeups  = 0;
+
+	Signal_receiver _sig_rec;
+	Signal_context  _sig_ctx;
+
+	char _buffer[BUFFER_SIZE];
+
+	Reader(Env &env, Label const &label, size_t total)
+	:
+		Thread(env, "reader", STACK_SIZE),
+		_terminal(env, label.string()), _total(total)
+	{
+		_terminal.read_avail_sigh(_sig_rec.manage(&_sig_ctx));
+	}
+
+	~Reader() { _sig_rec.dissolve(&_sig_ctx); }
+
+	void entry() override
+	{
+		while (_received < _total) {
+			_sig_rec.wait_for_signal();
+			_wakeups++;
+
+			for (size_t n; (n = _terminal.read(_buffer, sizeof(_buffer))); )
+				_received += n;
+		}
+	}
+
+	unsigned wakeups() const { return _wakeups; }
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	void _run(Label const &label, size_t total, size_t chunk)
+	{
+		/* the reader must hold the second session of the crosslink */
+		Writer writer(_env, label, total, chunk);
+		Reader reader(_env, label, total);
+
+		unsigned long const start_ms = _timer.elapsed_ms();
+
+		reader.start();
+		writer.start();
+		writer.join();
+		reader.join();
+
+		unsigned long const ms = max(1UL, _timer.elapsed_ms() - start_ms);
+
+		log(label, ": ", total / 1024, " KiB in ", ms, " ms, ",
+		    (total / 1024) * 1000 / 1024 / ms, " MiB/s, ",
+		    reader.wakeups(), " reader wakeups");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		Xml_node const config = _config.xml();
+
+		size_t const total = config.attribute_value("size",  Number_of_bytes(16*1024*1024));
+		size_t const chunk = config.attribute_value("chunk", Number_of_bytes(4096));
+
+		log("--- terminal throughput benchmark started ---");
+
+		config.for_each_sub_node("crosslink", [&] (Xml_node node) {
+			_run(node.attribute_value("label", Label()), total, chunk); });
+
+		log("--- terminal throughput benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
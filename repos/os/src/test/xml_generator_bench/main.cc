@@ -0,0 +1,130 @@
+/*
+ * \brief  Benchmark of generating a large XML report
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The benchmark generates a state report of 4 MiB in three ways. The first
+ * variant mimics the traditional pattern of starting with a small buffer and
+ * regenerating the whole report with a buffer of twice the size whenever the
+ * buffer is exceeded. The second variant generates the report once into a
+ * heap-backed expanding buffer. The third variant streams the report into the
+ * dataspace of a report session, which is enlarged on demand.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/attached_ram_dataspace.h>
+#include <os/expanding_xml_buffer.h>
+#include <os/reporter.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+	using namespace Genode;
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	enum {
+		NUM_CHILDREN = 22000,   /* results in a report of about 4 MiB */
+		INITIAL_SIZE = 4096,
+		ITERATIONS   = 5,
+	};
+
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	unsigned _generations = 0;
+
+	size_t _size = 0;
+
+	void _generate(Xml_generator &xml)
+	{
+		_generations++;
+
+		for (unsigned i = 0; i < NUM_CHILDREN; i++) {
+			xml.node("child", [&] () {
+				xml.attribute("name",   String<32>("child_", i));
+				xml.attribute("binary", "init");
+				xml.attribute("id",     i);
+				xml.node("ram", [&] () {
+					xml.attribute("assigned", "4M");
+					xml.attribute("quota",    4096*1024 + i);
+					xml.attribute("used",     1024*1024);
+					xml.attribute("avail",    3072*1024 + i);
+				});
+				xml.node("caps", [&] () {
+					xml.attribute("assigned", "100");
+					xml.attribute("quota",    100 + i % 50);
+					xml.attribute("used",     40);
+					xml.attribute("avail",    60 + i % 50);
+				});
+			});
+		}
+	}
+
+	template <typename FN>
+	void _measure(char const *name, FN const &fn)
+	{
+		_generations = 0;
+
+		unsigned long const start_ms = _timer.elapsed_ms();
+
+		for (unsigned i = 0; i < ITERATIONS; i++)
+			fn();
+
+		unsigned long const ms = _timer.elapsed_ms() - start_ms;
+
+		log(name, ": ", ms / ITERATIONS, " ms per report, ",
+		    _generations / ITERATIONS, " generation passes");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- XML generator benchmark started ---");
+
+		_measure("regenerate on overflow", [&] () {
+			size_t capacity = INITIAL_SIZE;
+			for (;;) {
+				try {
+					Attached_ram_dataspace ds(_env.ram(), _env.rm(), capacity);
+					Xml_generator xml(ds.local_addr<char>(), capacity, "state",
+					                  [&] () { _generate(xml); });
+					return;
+				}
+				catch (Xml_generator::Buffer_exceeded) { capacity *= 2; }
+			}
+		});
+
+		_measure("expanding buffer", [&] () {
+			Expanding_xml_buffer buffer(_heap, INITIAL_SIZE);
+			buffer.generate("state", [&] (Xml_generator &xml) { _generate(xml); });
+			_size = buffer.content_size();
+		});
+
+		log("report size: ", _size, " bytes");
+
+		_measure("expanding reporter", [&] () {
+			Expanding_reporter reporter(_env, "state", "state", INITIAL_SIZE);
+			reporter.generate([&] (Xml_generator &xml) { _generate(xml); });
+		});
+
+		log("--- XML generator benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
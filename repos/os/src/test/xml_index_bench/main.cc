@@ -0,0 +1,145 @@
+/*
+ * \brief  Benchmark of indexed versus scanning XML-node access
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The benchmark generates a state report of about 1 MiB as produced by init
+ * for a large scenario. It then measures the time needed to visit all
+ * children including their resource sub nodes and to look up children by
+ * index, once by using the scanning 'Xml_node' and once by using an
+ * 'Xml_index'. Both variants must yield the same checksum.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/attached_ram_dataspace.h>
+#include <util/xml_generator.h>
+#include <util/xml_node.h>
+#include <util/xml_index.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+	using namespace Genode;
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	enum {
+		NUM_CHILDREN = 5600,   /* results in a document of about 1 MiB */
+		BUFFER_SIZE  = 2*1024*1024,
+		ITERATIONS   = 10,
+		LOOKUPS      = 200,
+	};
+
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Attached_ram_dataspace _ds { _env.ram(), _env.rm(), BUFFER_SIZE };
+
+	char * const _xml = _ds.local_addr<char>();
+	size_t       _xml_len = 0;
+
+	void _generate()
+	{
+		Xml_generator xml(_xml, BUFFER_SIZE, "state", [&] () {
+			for (unsigned i = 0; i < NUM_CHILDREN; i++) {
+				xml.node("child", [&] () {
+					xml.attribute("name",   String<32>("child_", i));
+					xml.attribute("binary", "init");
+					xml.attribute("id",     i);
+					xml.node("ram", [&] () {
+						xml.attribute("assigned", "4M");
+						xml.attribute("quota",    4096*1024 + i);
+						xml.attribute("used",     1024*1024);
+						xml.attribute("avail",    3072*1024 + i);
+					});
+					xml.node("caps", [&] () {
+						xml.attribute("assigned", "100");
+						xml.attribute("quota",    100 + i % 50);
+						xml.attribute("used",     40);
+						xml.attribute("avail",    60 + i % 50);
+					});
+				});
+			}
+		});
+		_xml_len = xml.used();
+	}
+
+	/**
+	 * Visit all children and look up a number of children by index
+	 */
+	static unsigned long _walk(Xml_node state)
+	{
+		unsigned long sum = 0;
+		unsigned      num = 0;
+
+		state.for_each_sub_node("child", [&] (Xml_node child) {
+			sum += child.attribute_value("id", 0UL);
+			sum += child.sub_node("ram") .attribute_value("quota", 0UL);
+			sum += child.sub_node("caps").attribute_value("avail", 0UL);
+			num++;
+		});
+
+		for (unsigned i = 0; i < LOOKUPS; i++) {
+			Xml_node const child = state.sub_node((i*7919) % num);
+			sum += child.attribute_value("id", 0UL);
+		}
+		return sum;
+	}
+
+	template <typename FN>
+	unsigned long _measure(char const *name, FN const &fn)
+	{
+		unsigned long const start_ms = _timer.elapsed_ms();
+
+		unsigned long sum = 0;
+		for (unsigned i = 0; i < ITERATIONS; i++)
+			sum = fn();
+
+		unsigned long const ms = max(1UL, _timer.elapsed_ms() - start_ms);
+
+		log(name, ": ", ms / ITERATIONS, " ms per pass (checksum ", sum, ")");
+		return sum;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- XML index benchmark started ---");
+
+		_generate();
+		log("document size: ", _xml_len, " bytes");
+
+		unsigned long const scanned = _measure("scanning access", [&] () {
+			return _walk(Xml_node(_xml, _xml_len)); });
+
+		unsigned long const indexed = _measure("indexed access", [&] () {
+			Xml_index index(_heap, _xml, _xml_len);
+			return _walk(Xml_node(index)); });
+
+		_measure("index construction", [&] () {
+			Xml_index index(_heap, _xml, _xml_len);
+			return (unsigned long)index.num_nodes(); });
+
+		if (scanned != indexed)
+			error("checksum mismatch");
+
+		log("--- XML index benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -12,7 +12,10 @@
  */
 
 #include <util/xml_node.h>
+#include <util/xml_index.h>
+#include <util/xml_generator.h>
 #include <base/component.h>
+#include <base/heap.h>
 #include <base/log.h>
 
 using namespace Genode;
@@ -314,6 +317,47 @@ static void log_xml_info(const char *xml_string)
 }
 
 
+/**
+ * Compare indexed with scanning access to a document with many nodes
+ *
+ * The number of nodes exceeds the initial capacity of the index, which
+ * forces the index to grow while it is built.
+ */
+static void log_indexed_access(Allocator &alloc)
+{
+	enum { NUM_CHILDREN = 200 };
+
+	static char buf[16*1024];
+	Xml_generator xml(buf, sizeof(buf), "config", [&] () {
+		for (unsigned i = 0; i < NUM_CHILDREN; i++)
+			xml.node("child", [&] () {
+				xml.attribute("id", i);
+				xml.node("sub", [&] () { });
+			});
+	});
+
+	auto count = [] (Xml_node node, unsigned long &sum) {
+		unsigned num = 0;
+		node.for_each_sub_node("child", [&] (Xml_node child) {
+			sum += child.attribute_value("id", 0UL)
+			     + child.sub_node("sub").num_sub_nodes();
+			num++;
+		});
+		return num;
+	};
+
+	Xml_index index(alloc, buf, xml.used());
+
+	unsigned long scanned_sum = 0, indexed_sum = 0;
+	unsigned const scanned = count(Xml_node(buf, xml.used()), scanned_sum);
+	unsigned const indexed = count(Xml_node(index), indexed_sum);
+
+	log("index valid=", index.valid(), ", nodes=", index.num_nodes());
+	log("scanning: ", scanned, " sub nodes, checksum ", scanned_sum);
+	log("indexed: ",  indexed, " sub nodes, checksum ", indexed_sum);
+}
+
+
 void Component::construct(Genode::Env &env)
 {
 	log("--- XML-token test ---");
@@ -351,6 +395,10 @@ void Component::construct(Genode::Env &env)
 	log("-- Test parsing XML with comments --");
 	log_xml_info(xml_test_comments);
 
+	log("-- Test indexed access to many nodes --");
+	static Heap heap(env.ram(), env.rm());
+	log_indexed_access(heap);
+
 	log("--- End of XML-parser test ---");
 	env.parent().exit(0);
 }
@@ -88,6 +88,7 @@ namespace Noux {
 			SYSCALL_SYNC,
 			SYSCALL_KILL,
 			SYSCALL_GETDTABLESIZE,
+			SYSCALL_SPAWN,
 			SYSCALL_INVALID = -1
 		};
 
@@ -138,6 +139,7 @@ namespace Noux {
 			NOUX_DECL_SYSCALL_NAME(SYNC)
 			NOUX_DECL_SYSCALL_NAME(KILL)
 			NOUX_DECL_SYSCALL_NAME(GETDTABLESIZE)
+			NOUX_DECL_SYSCALL_NAME(SPAWN)
 			case SYSCALL_INVALID: return 0;
 			}
 			return 0;
@@ -241,6 +241,25 @@ struct Noux::Sysio
 		bool zero() const { return (sec == 0) && (usec == 0); }
 	};
 
+	/**
+	 * File-descriptor operation applied to a spawned child before it starts
+	 *
+	 * The actions are applied in order to the file descriptors the child
+	 * inherited from its parent. Files to be opened for the child are
+	 * opened by the parent and handed over via 'DUP2' and 'CLOSE', hence
+	 * there is room for two actions per 'posix_spawn' file action.
+	 */
+	struct Spawn_fd_action
+	{
+		enum Type { DUP2, CLOSE };
+
+		Type type;
+		int  fd;
+		int  to_fd;
+	};
+
+	enum { MAX_SPAWN_FD_ACTIONS = 32 };
+
 	/**
 	 * Socket related structures
 	 */
@@ -319,6 +338,8 @@ struct Noux::Sysio
 
 	enum Execve_error    { EXECVE_NONEXISTENT    = Vfs::Directory_service::NUM_GENERAL_ERRORS, EXECVE_NOMEM };
 	enum Fork_error      { FORK_NOMEM = Vfs::Directory_service::NUM_GENERAL_ERRORS };
+	enum Spawn_error     { SPAWN_NONEXISTENT = Vfs::Directory_service::NUM_GENERAL_ERRORS,
+	                       SPAWN_NOMEM, SPAWN_BADF };
 	enum Select_error    { SELECT_ERR_INTERRUPT };
 
 	/**
@@ -394,6 +415,7 @@ struct Noux::Sysio
 		Wait4_error    wait4;
 		Kill_error     kill;
 		Fork_error     fork;
+		Spawn_error    spawn;
 
 	} error;
 
@@ -439,6 +461,11 @@ struct Noux::Sysio
 		                          addr_t parent_cap_addr; },
 		                        { int pid; });
 
+		SYSIO_DECL(spawn,       { Path filename; Args args; Env env;
+		                          Spawn_fd_action fd_actions[MAX_SPAWN_FD_ACTIONS];
+		                          unsigned num_fd_actions; },
+		                        { int pid; });
+
 		SYSIO_DECL(getpid,      { }, { int pid; });
 
 		SYSIO_DECL(wait4,       { int pid; bool nohang; },
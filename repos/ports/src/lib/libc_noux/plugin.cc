@@ -28,6 +28,7 @@
 /* libc plugin includes */
 #include <libc-plugin/plugin.h>
 #include <libc-plugin/fd_alloc.h>
+#include <libc-plugin/spawn.h>
 
 /* libc component includes */
 #include <libc/component.h>
@@ -417,6 +418,45 @@ static bool serialize_string_array(char const * const * array, char *dst, Genode
 }
 
 
+/**
+ * Marshal arguments and environment of a new program into sysio buffers
+ *
+ * The current working directory is passed to the new program as environment
+ * variable 'NOUX_CWD'.
+ *
+ * \return 0 on success, or error number
+ */
+static int serialize_exec_args(char const *filename, char *const argv[],
+                               char *const envp[],
+                               Noux::Sysio::Path &dst_filename,
+                               Noux::Sysio::Args &dst_args,
+                               Noux::Sysio::Env  &dst_env)
+{
+	Genode::strncpy(dst_filename, filename, sizeof(dst_filename));
+
+	if (!serialize_string_array(argv, dst_args, sizeof(dst_args))) {
+		Genode::error("argument buffer exceeded for '", filename, "'");
+		return E2BIG;
+	}
+
+	size_t noux_cwd_len = Genode::snprintf(dst_env, sizeof(dst_env), "NOUX_CWD=");
+
+	if (!getcwd(&dst_env[noux_cwd_len], sizeof(dst_env) - noux_cwd_len)) {
+		Genode::error("environment buffer exceeded for '", filename, "'");
+		return E2BIG;
+	}
+
+	noux_cwd_len = strlen(dst_env) + 1;
+
+	if (!serialize_string_array(envp, &dst_env[noux_cwd_len],
+	                            sizeof(dst_env) - noux_cwd_len)) {
+		Genode::error("environment buffer exceeded for '", filename, "'");
+		return E2BIG;
+	}
+	return 0;
+}
+
+
 /**
  * Return number of marhalled file descriptors into select argument buffer
  *
@@ -975,6 +1015,7 @@ namespace {
 			bool supports_stat(char const *)                       { return true; }
 			bool supports_symlink(char const *, char const*)       { return true; }
 			bool supports_pipe()                                   { return true; }
+			bool supports_posix_spawn(char const *)                { return true; }
 			bool supports_unlink(char const *)                     { return true; }
 			bool supports_readlink(const char *, char *, ::size_t) { return true; }
 			bool supports_rename(const char *, const char *)       { return true; }
@@ -991,6 +1032,10 @@ namespace {
 			int dup2(Libc::File_descriptor *, Libc::File_descriptor *);
 			int execve(char const *filename, char *const argv[],
 			           char *const envp[]);
+			int posix_spawn(pid_t *, char const *,
+			                posix_spawn_file_actions_t const *,
+			                posix_spawnattr_t const *,
+			                char *const argv[], char *const envp[]);
 			int fstat(Libc::File_descriptor *, struct stat *);
 			int fsync(Libc::File_descriptor *);
 			int fstatfs(Libc::File_descriptor *, struct statfs *);
@@ -1066,34 +1111,13 @@ namespace {
 				log(__func__, "envp[", i, "]='", Genode::Cstring(envp[i]), "'");
 		}
 
-		Genode::strncpy(sysio()->execve_in.filename, filename, sizeof(sysio()->execve_in.filename));
-		if (!serialize_string_array(argv, sysio()->execve_in.args,
-		                            sizeof(sysio()->execve_in.args))) {
-		    error("execve: argument buffer exceeded");
-		    errno = E2BIG;
-		    return -1;
-		}
-
-		/* communicate the current working directory as environment variable */
-
-		size_t noux_cwd_len = Genode::snprintf(sysio()->execve_in.env,
-		                                       sizeof(sysio()->execve_in.env),
-		                                       "NOUX_CWD=");
-
-		if (!getcwd(&(sysio()->execve_in.env[noux_cwd_len]),
-		            sizeof(sysio()->execve_in.env) - noux_cwd_len)) {
-		    error("execve: environment buffer exceeded");
-		    errno = E2BIG;
-		    return -1;
-		}
-
-		noux_cwd_len = strlen(sysio()->execve_in.env) + 1;
-
-		if (!serialize_string_array(envp, &(sysio()->execve_in.env[noux_cwd_len]),
-                                   sizeof(sysio()->execve_in.env) - noux_cwd_len)) {
-		    error("execve: environment buffer exceeded");
-		    errno = E2BIG;
-		    return -1;
+		int const err = serialize_exec_args(filename, argv, envp,
+		                                    sysio()->execve_in.filename,
+		                                    sysio()->execve_in.args,
+		                                    sysio()->execve_in.env);
+		if (err) {
+			errno = err;
+			return -1;
 		}
 
 		if (!noux_syscall(Noux::Session::SYSCALL_EXECVE)) {
@@ -1114,6 +1138,146 @@ namespace {
 	}
 
 
+	/*
+	 * In contrast to 'vfork' followed by 'execve', which Noux implements by
+	 * copying the address space of the calling process, 'posix_spawn'
+	 * creates the new process directly from the executable.
+	 *
+	 * Spawn attributes are ignored. Noux has neither process groups nor
+	 * scheduling policies, and a spawned process starts with the default
+	 * signal dispositions and an empty signal mask anyway.
+	 */
+	int Plugin::posix_spawn(pid_t *pid, char const *path,
+	                        posix_spawn_file_actions_t const *file_actions,
+	                        posix_spawnattr_t const *,
+	                        char *const argv[], char *const envp[])
+	{
+		typedef Noux::Sysio::Spawn_fd_action     Fd_action;
+		typedef __posix_spawn_file_actions::Action Action;
+
+		enum { MAX_FD_ACTIONS = Noux::Sysio::MAX_SPAWN_FD_ACTIONS };
+
+		unsigned const num_actions = (file_actions && *file_actions)
+		                           ? (*file_actions)->num : 0;
+
+		Action const *actions = num_actions ? (*file_actions)->action : nullptr;
+
+		/*
+		 * Files to be opened for the child are opened by us. The child
+		 * inherits the file descriptor, which is moved to its designated
+		 * number. Descriptors that are referenced by a preceding action
+		 * cannot be used for this purpose and are closed in the child
+		 * before any other action is applied.
+		 */
+		Fd_action leading[MAX_FD_ACTIONS], trailing[MAX_FD_ACTIONS];
+		unsigned  num_leading = 0, num_trailing = 0;
+
+		int      opened[MAX_FD_ACTIONS];
+		unsigned num_opened = 0;
+
+		auto close_opened = [&] () {
+			for (unsigned i = 0; i < num_opened; i++)
+				::close(opened[i]); };
+
+		auto referenced_before = [&] (unsigned i, int fd) {
+			for (unsigned j = 0; j < i; j++)
+				if (actions[j].fd == fd
+				 || (actions[j].type == Action::DUP2 && actions[j].new_fd == fd))
+					return true;
+			return false;
+		};
+
+		int err = 0;
+
+		for (unsigned i = 0; i < num_actions && !err; i++) {
+
+			Action const &action = actions[i];
+
+			if (num_trailing + 2 > MAX_FD_ACTIONS) {
+				err = ENOMEM;
+				break;
+			}
+
+			switch (action.type) {
+
+			case Action::OPEN:
+				{
+					int fd = ::open(action.path, action.oflag, action.mode);
+
+					while (fd >= 0 && referenced_before(i, fd)
+					    && num_opened < MAX_FD_ACTIONS) {
+						opened[num_opened++] = fd;
+						leading[num_leading++] = Fd_action { Fd_action::CLOSE, fd, 0 };
+						fd = ::dup(fd);
+					}
+
+					if (fd < 0) {
+						err = errno;
+						break;
+					}
+
+					if (num_opened == MAX_FD_ACTIONS) {
+						::close(fd);
+						err = ENOMEM;
+						break;
+					}
+
+					opened[num_opened++] = fd;
+
+					if (fd != action.fd) {
+						trailing[num_trailing++] = Fd_action { Fd_action::DUP2, fd, action.fd };
+						trailing[num_trailing++] = Fd_action { Fd_action::CLOSE, fd, 0 };
+					}
+					break;
+				}
+
+			case Action::DUP2:
+				trailing[num_trailing++] = Fd_action { Fd_action::DUP2, action.fd, action.new_fd };
+				break;
+
+			case Action::CLOSE:
+				trailing[num_trailing++] = Fd_action { Fd_action::CLOSE, action.fd, 0 };
+				break;
+			}
+		}
+
+		if (!err && num_leading + num_trailing > MAX_FD_ACTIONS)
+			err = ENOMEM;
+
+		if (!err)
+			err = serialize_exec_args(path, argv, envp,
+			                          sysio()->spawn_in.filename,
+			                          sysio()->spawn_in.args,
+			                          sysio()->spawn_in.env);
+		if (err) {
+			close_opened();
+			return err;
+		}
+
+		Fd_action *dst = sysio()->spawn_in.fd_actions;
+		for (unsigned i = 0; i < num_leading; i++)
+			*dst++ = leading[i];
+		for (unsigned i = 0; i < num_trailing; i++)
+			*dst++ = trailing[i];
+
+		sysio()->spawn_in.num_fd_actions = num_leading + num_trailing;
+
+		if (!noux_syscall(Noux::Session::SYSCALL_SPAWN)) {
+			switch (sysio()->error.spawn) {
+			case Noux::Sysio::SPAWN_NONEXISTENT: err = ENOENT; break;
+			case Noux::Sysio::SPAWN_NOMEM:       err = ENOMEM; break;
+			case Noux::Sysio::SPAWN_BADF:        err = EBADF;  break;
+			default:                             err = EAGAIN; break;
+			}
+		} else if (pid) {
+			*pid = sysio()->spawn_out.pid;
+		}
+
+		close_opened();
+		return err;
+	}
+
+
 	int Plugin::stat(char const *path, struct stat *buf)
 	{
 		if (verbose)
@@ -250,6 +250,74 @@ class Noux::Child : public Rpc_object<Session>,
 					child->add_io_channel(io_channel_by_fd(fd), fd);
 		}
 
+		/**
+		 * Return true if the file-descriptor actions of the pending spawn
+		 * request refer to open file descriptors only
+		 *
+		 * The actions are checked against the file descriptors the new
+		 * child would inherit, so that an invalid request is rejected
+		 * before any child is created.
+		 */
+		bool _spawn_fd_actions_valid() const
+		{
+			unsigned const num = _sysio.spawn_in.num_fd_actions;
+			if (num > Sysio::MAX_SPAWN_FD_ACTIONS)
+				return false;
+
+			bool in_use[MAX_FILE_DESCRIPTORS];
+			for (int fd = 0; fd < MAX_FILE_DESCRIPTORS; fd++)
+				in_use[fd] = fd_in_use(fd);
+
+			auto valid = [] (int fd) { return fd >= 0 && fd < MAX_FILE_DESCRIPTORS; };
+
+			for (unsigned i = 0; i < num; i++) {
+				Sysio::Spawn_fd_action const &action = _sysio.spawn_in.fd_actions[i];
+
+				if (!valid(action.fd))
+					return false;
+
+				switch (action.type) {
+				case Sysio::Spawn_fd_action::DUP2:
+					if (!in_use[action.fd] || !valid(action.to_fd))
+						return false;
+					in_use[action.to_fd] = true;
+					break;
+				case Sysio::Spawn_fd_action::CLOSE:
+					in_use[action.fd] = false;
+					break;
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * Apply file-descriptor actions of the pending spawn request to the
+		 * file descriptors inherited by 'child'
+		 */
+		void _apply_spawn_fd_actions(Child *child)
+		{
+			for (unsigned i = 0; i < _sysio.spawn_in.num_fd_actions; i++) {
+				Sysio::Spawn_fd_action const &action = _sysio.spawn_in.fd_actions[i];
+
+				switch (action.type) {
+				case Sysio::Spawn_fd_action::DUP2:
+					if (action.fd == action.to_fd)
+						break;
+					{
+						Shared_pointer<Io_channel> io = child->io_channel_by_fd(action.fd);
+						if (child->fd_in_use(action.to_fd))
+							child->remove_io_channel(action.to_fd);
+						child->add_io_channel(io, action.to_fd);
+					}
+					break;
+				case Sysio::Spawn_fd_action::CLOSE:
+					if (child->fd_in_use(action.fd))
+						child->remove_io_channel(action.fd);
+					break;
+				}
+			}
+		}
+
 		/**
 		 * Block until the IO channel is ready for reading or writing or an
 		 * exception occured.
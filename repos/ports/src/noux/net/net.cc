@@ -114,6 +114,7 @@ bool Noux::Child::_syscall_net(Noux::Session::Syscall sc)
 		case SYSCALL_SYNC:
 		case SYSCALL_KILL:
 		case SYSCALL_GETDTABLESIZE:
+		case SYSCALL_SPAWN:
 			break;
 		case SYSCALL_SOCKET:
 			{
@@ -579,6 +579,91 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 				break;
 			}
 
+		case SYSCALL_SPAWN:
+			{
+				/*
+				 * Create the child directly from the executable as done by
+				 * 'execve', but as new process of our own. In contrast to
+				 * 'fork', our address space is not copied, which makes this
+				 * the fast path for the common fork-exec sequence.
+				 */
+				if (!_spawn_fd_actions_valid()) {
+					_sysio.error.spawn = Sysio::SPAWN_BADF;
+					break;
+				}
+
+				Genode::Reconstructible<Vfs_dataspace> binary_ds {
+					_root_dir, _vfs_io_waiter_registry,
+					_sysio.spawn_in.filename, _env.ram(), _env.rm(), _heap
+				};
+
+				if (!binary_ds->ds.valid()) {
+					_sysio.error.spawn = Sysio::SPAWN_NONEXISTENT;
+					break;
+				}
+
+				Child_env<sizeof(_sysio.spawn_in.args)>
+					child_env(_env.rm(),
+					          _sysio.spawn_in.filename, binary_ds->ds,
+					          _sysio.spawn_in.args, _sysio.spawn_in.env);
+
+				binary_ds.construct(_root_dir, _vfs_io_waiter_registry,
+				                    child_env.binary_name(), _env.ram(),
+				                    _env.rm(), _heap);
+
+				if (!binary_ds->ds.valid()) {
+					_sysio.error.spawn = Sysio::SPAWN_NONEXISTENT;
+					break;
+				}
+
+				binary_ds.destruct();
+
+				int const new_pid = _pid_allocator.alloc();
+				Child * child = nullptr;
+
+				try {
+					child = new (_heap) Child(child_env.binary_name(),
+					                          _verbose,
+					                          _user_info,
+					                          this,
+					                          _kill_broadcaster,
+					                          _timeout_scheduler,
+					                          *this,
+					                          _pid_allocator,
+					                          new_pid,
+					                          _env,
+					                          _root_dir,
+					                          _vfs_io_waiter_registry,
+					                          child_env.args(),
+					                          child_env.env(),
+					                          _heap,
+					                          _ref_pd, _ref_pd_cap,
+					                          _parent_services,
+					                          false,
+					                          _destruct_queue);
+				}
+				catch (Child::Binary_does_not_exist) {
+					_sysio.error.spawn = Sysio::SPAWN_NONEXISTENT;
+					break;
+				}
+				catch (Child::Insufficient_memory) {
+					_sysio.error.spawn = Sysio::SPAWN_NOMEM;
+					break;
+				}
+
+				Family_member::insert(child);
+
+				_assign_io_channels_to(child);
+				_apply_spawn_fd_actions(child);
+
+				child->start();
+
+				_sysio.spawn_out.pid = new_pid;
+
+				result = true;
+				break;
+			}
+
 		case SYSCALL_GETPID:
 			{
 				_sysio.getpid_out.pid = pid();
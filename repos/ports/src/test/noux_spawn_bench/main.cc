@@ -0,0 +1,178 @@
+/*
+ * \brief  Benchmark of process creation via 'vfork'/'execve' and 'posix_spawn'
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The benchmark mimics the job execution of a make-driven build. Like make,
+ * the driver holds a sizeable heap for its dependency graph and runs one
+ * recipe command per target, with the output of the command redirected to
+ * the target file. The build is performed twice, once the way GNU make
+ * starts jobs ('vfork', which is a full 'fork' in Noux, followed by the
+ * redirection and 'execve') and once via 'posix_spawn'.
+ *
+ * Usage: test-noux_spawn_bench [<jobs> [<heap MiB>]]
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+enum { DEFAULT_JOBS = 100, DEFAULT_HEAP_MB = 16, OBJECT_SIZE = 4096 };
+
+static char const *self;
+
+/* stands in for the dependency graph of make */
+static char *graph;
+
+
+static unsigned long long now_us()
+{
+	struct timeval tv;
+	gettimeofday(&tv, nullptr);
+	return tv.tv_sec*1000000ULL + tv.tv_usec;
+}
+
+
+/**
+ * Recipe command, writes the object to standard output
+ */
+static int compile(char const *target)
+{
+	char obj[OBJECT_SIZE];
+
+	size_t const len = strlen(target);
+	for (size_t i = 0; i < sizeof(obj); i++)
+		obj[i] = target[i % len];
+
+	return write(1, obj, sizeof(obj)) == (ssize_t)sizeof(obj) ? 0 : 1;
+}
+
+
+static pid_t start_job_vfork(char *const argv[], char const *target)
+{
+	pid_t const pid = vfork();
+
+	if (pid == 0) {
+		int const fd = open(target, O_CREAT | O_WRONLY | O_TRUNC, 0644);
+		if (fd < 0 || dup2(fd, 1) < 0)
+			_exit(126);
+
+		close(fd);
+		execve(self, argv, environ);
+		_exit(127);
+	}
+	return pid;
+}
+
+
+static pid_t start_job_spawn(char *const argv[], char const *target)
+{
+	posix_spawn_file_actions_t actions;
+	if (posix_spawn_file_actions_init(&actions) != 0)
+		return -1;
+
+	pid_t pid = -1;
+
+	int err = posix_spawn_file_actions_addopen(&actions, 1, target,
+	                                           O_CREAT | O_WRONLY | O_TRUNC, 0644);
+	if (!err)
+		err = posix_spawn(&pid, self, &actions, nullptr, argv, environ);
+
+	posix_spawn_file_actions_destroy(&actions);
+
+	if (err) {
+		errno = err;
+		return -1;
+	}
+	return pid;
+}
+
+
+typedef pid_t (*Start_job)(char *const argv[], char const *target);
+
+
+static bool build(char const *method, unsigned jobs, Start_job start_job)
+{
+	unsigned long long const start = now_us();
+
+	for (unsigned i = 0; i < jobs; i++) {
+
+		char target[64];
+		snprintf(target, sizeof(target), "/tmp/obj/%u.o", i);
+
+		char *argv[] = { (char *)self, (char *)"compile", target, nullptr };
+
+		int   status = 0;
+		pid_t pid    = start_job(argv, target);
+
+		if (pid < 0 || waitpid(pid, &status, 0) != pid
+		 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+			printf("Error: %s: job for %s failed (errno=%d)\n", method, target, errno);
+			return false;
+		}
+
+		struct stat st;
+		if (stat(target, &st) != 0 || st.st_size != OBJECT_SIZE) {
+			printf("Error: %s: %s has unexpected content\n", method, target);
+			return false;
+		}
+	}
+
+	unsigned long long const duration = now_us() - start;
+
+	printf("%s: %u jobs in %llu ms (%llu us per job)\n",
+	       method, jobs, duration/1000, duration/jobs);
+	return true;
+}
+
+
+int main(int argc, char **argv)
+{
+	self = argv[0];
+
+	if (argc == 3 && strcmp(argv[1], "compile") == 0)
+		return compile(argv[2]);
+
+	unsigned const jobs    = argc > 1 ? atoi(argv[1]) : DEFAULT_JOBS;
+	unsigned const heap_mb = argc > 2 ? atoi(argv[2]) : DEFAULT_HEAP_MB;
+
+	if (jobs == 0) {
+		printf("Error: invalid number of jobs\n");
+		return 1;
+	}
+
+	size_t const graph_size = (size_t)heap_mb*1024*1024;
+	graph = (char *)malloc(graph_size);
+	if (graph_size && !graph) {
+		printf("Error: could not allocate %u MiB heap\n", heap_mb);
+		return 1;
+	}
+	memset(graph, 0x5a, graph_size);
+
+	mkdir("/tmp/obj", 0755);
+
+	printf("--- noux_spawn_bench: %u jobs, %u MiB heap ---\n", jobs, heap_mb);
+
+	if (!build("vfork/execve", jobs, start_job_vfork)
+	 || !build("posix_spawn",  jobs, start_job_spawn))
+		return 1;
+
+	printf("--- noux_spawn_bench done ---\n");
+	return 0;
+}
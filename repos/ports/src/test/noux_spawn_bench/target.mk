@@ -0,0 +1,3 @@
+TARGET = test-noux_spawn_bench
+SRC_CC = main.cc
+LIBS   = posix libc_noux